@@ -42,6 +42,8 @@
         {{as_cType(member.type.name)}}Transfer
     {%- elif member.type.category == "bitmask" -%}
         {{as_cType(member.type.name)}}Flags
+    {%- elif as_cType(member.type.name) == "void" -%}
+        uint8_t
     {%- else -%}
         {{ assert(as_cType(member.type.name) != "size_t") }}
         {{as_cType(member.type.name)}}
@@ -274,9 +276,13 @@ namespace {
                 //* This loop cannot overflow because it iterates up to |memberLength|. Even if
                 //* memberLength were the maximum integer value, |i| would become equal to it just before
                 //* exiting the loop, but not increment past or wrap around.
-                for (decltype(memberLength) i = 0; i < memberLength; ++i) {
-                    {{serialize_member(member, "record." + memberName + "[i]", "memberBuffer[i]" )}}
-                }
+                {% if as_cType(member.type.name) == "void" %}
+                    memcpy(memberBuffer, record.{{memberName}}, memberLength);
+                {% else %}
+                    for (decltype(memberLength) i = 0; i < memberLength; ++i) {
+                        {{serialize_member(member, "record." + memberName + "[i]", "memberBuffer[i]" )}}
+                    }
+                {% endif %}
             }
         {% endfor %}
         return WireResult::Success;
@@ -370,7 +376,7 @@ namespace {
                 const volatile {{member_transfer_type(member)}}* memberBuffer;
                 WIRE_TRY(deserializeBuffer->ReadN(memberLength, &memberBuffer));
 
-                {{as_cType(member.type.name)}}* copiedMembers;
+                {{member_transfer_type(member) if as_cType(member.type.name) == "void" else as_cType(member.type.name)}}* copiedMembers;
                 WIRE_TRY(GetSpace(allocator, memberLength, &copiedMembers));
                 {% if member.annotation == "const*const*" %}
                     {{as_cType(member.type.name)}}** pointerArray;
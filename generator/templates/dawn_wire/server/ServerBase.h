@@ -29,6 +29,21 @@ namespace dawn_wire { namespace server {
         ServerBase() = default;
         virtual ~ServerBase() = default;
 
+        // Returns the links in the list of device children of an allocated object of any type,
+        // or nullptr if there is no such object.
+        DeviceChildLinks* GetDeviceChildLinks(ObjectType type, ObjectId id) {
+            switch (type) {
+                {% for type in by_category["object"] %}
+                    case ObjectType::{{type.name.CamelCase()}}: {
+                        auto* data = mKnown{{type.name.CamelCase()}}.Get(id);
+                        return data != nullptr ? &data->deviceChildLinks : nullptr;
+                    }
+                {% endfor %}
+                default:
+                    return nullptr;
+            }
+        }
+
       protected:
         void DestroyAllObjects(const DawnProcTable& procs) {
             //* Free all objects when the server is destroyed
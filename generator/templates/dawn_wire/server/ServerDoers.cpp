@@ -93,11 +93,11 @@ namespace dawn_wire { namespace server {
                             //* are destroyed before their device. We should have a solution in
                             //* Dawn native that makes all child objects internally null if their
                             //* Device is destroyed.
-                            while (data->info->childObjectTypesAndIds.size() > 0) {
+                            while (data->info->firstChild != 0) {
                                 ObjectType childObjectType;
                                 ObjectId childObjectId;
-                                std::tie(childObjectType, childObjectId) = UnpackObjectTypeAndId(
-                                    *data->info->childObjectTypesAndIds.begin());
+                                std::tie(childObjectType, childObjectId) =
+                                    UnpackObjectTypeAndId(data->info->firstChild);
                                 if (!DoDestroyObject(childObjectType, childObjectId)) {
                                     return false;
                                 }
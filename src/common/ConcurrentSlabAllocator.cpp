@@ -0,0 +1,231 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/ConcurrentSlabAllocator.h"
+
+#include "common/Assert.h"
+#include "common/Compiler.h"
+#include "common/Math.h"
+
+#include <algorithm>
+
+namespace {
+
+    // The maximum number of blocks in a magazine. Smaller slabs use smaller magazines so that a
+    // thread cache doesn't hold several slabs worth of blocks.
+    constexpr uint32_t kMaxMagazineSize = 64;
+
+    // The index of the cache used by the calling thread, assigned on its first use. Consecutive
+    // threads use consecutive caches so that up to kCacheCount threads don't share one.
+    constexpr uint32_t kUnassignedIndex = ~0u;
+    thread_local uint32_t tThreadCacheIndex = kUnassignedIndex;
+
+    uint32_t GetThreadCacheIndex() {
+        if (DAWN_UNLIKELY(tThreadCacheIndex == kUnassignedIndex)) {
+            static std::atomic<uint32_t> sNextThreadIndex{0};
+            tThreadCacheIndex = sNextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+        }
+        return tThreadCacheIndex % ConcurrentSlabAllocatorImpl::kCacheCount;
+    }
+
+    // Move the calling thread to the next cache after it found its cache used by another thread.
+    void MoveToNextThreadCache() {
+        tThreadCacheIndex++;
+    }
+
+}  // anonymous namespace
+
+// Magazine
+
+void ConcurrentSlabAllocatorImpl::Magazine::Push(FreeBlock* block) {
+    block->next = head;
+    head = block;
+    if (tail == nullptr) {
+        tail = block;
+    }
+    count++;
+}
+
+ConcurrentSlabAllocatorImpl::FreeBlock* ConcurrentSlabAllocatorImpl::Magazine::Pop() {
+    ASSERT(count != 0);
+    FreeBlock* block = head;
+    head = block->next;
+    if (head == nullptr) {
+        tail = nullptr;
+    }
+    count--;
+    return block;
+}
+
+// ConcurrentSlabAllocatorImpl
+
+ConcurrentSlabAllocatorImpl::ConcurrentSlabAllocatorImpl(uint32_t blocksPerSlab,
+                                                         uint32_t objectSize,
+                                                         uint32_t objectAlignment)
+    : mBlockStride(Align(std::max(objectSize, static_cast<uint32_t>(sizeof(FreeBlock))),
+                         std::max(objectAlignment, static_cast<uint32_t>(alignof(FreeBlock))))),
+      mBlockAlignment(std::max(objectAlignment, static_cast<uint32_t>(alignof(FreeBlock)))),
+      mBlocksPerSlab(std::max(blocksPerSlab, 1u)),
+      mMagazineSize(std::max(std::min(mBlocksPerSlab / 2, kMaxMagazineSize), 1u)) {
+    ASSERT(IsPowerOfTwo(mBlockAlignment));
+
+    mCacheAllocation.reset(new char[sizeof(Cache) * kCacheCount + alignof(Cache)]);
+    mCaches = reinterpret_cast<Cache*>(AlignPtr(mCacheAllocation.get(), alignof(Cache)));
+    for (uint32_t i = 0; i < kCacheCount; ++i) {
+        new (&mCaches[i]) Cache();
+    }
+}
+
+ConcurrentSlabAllocatorImpl::~ConcurrentSlabAllocatorImpl() {
+    for (uint32_t i = 0; i < kCacheCount; ++i) {
+        ASSERT(!mCaches[i].locked.load(std::memory_order_relaxed));
+        mCaches[i].~Cache();
+    }
+}
+
+ConcurrentSlabAllocatorImpl::Cache* ConcurrentSlabAllocatorImpl::TryLockCache() {
+    Cache* cache = &mCaches[GetThreadCacheIndex()];
+    if (DAWN_LIKELY(!cache->locked.exchange(true, std::memory_order_acquire))) {
+        return cache;
+    }
+
+    // Threads that end up sharing a cache, for example after other threads exited, are spread
+    // over the other caches for their next allocations.
+    MoveToNextThreadCache();
+    return nullptr;
+}
+
+void ConcurrentSlabAllocatorImpl::UnlockCache(Cache* cache) {
+    cache->locked.store(false, std::memory_order_release);
+}
+
+void* ConcurrentSlabAllocatorImpl::Allocate() {
+    Cache* cache = TryLockCache();
+    if (cache == nullptr) {
+        return AllocateFromDepot();
+    }
+
+    if (cache->loaded.count == 0) {
+        if (cache->previous.count != 0) {
+            std::swap(cache->loaded, cache->previous);
+        } else {
+            RefillFromDepot(&cache->loaded);
+        }
+    }
+    FreeBlock* block = cache->loaded.Pop();
+
+    UnlockCache(cache);
+    return block;
+}
+
+void ConcurrentSlabAllocatorImpl::Deallocate(void* ptr) {
+    ASSERT(ptr != nullptr);
+    FreeBlock* block = new (ptr) FreeBlock;
+
+    Cache* cache = TryLockCache();
+    if (cache == nullptr) {
+        ReturnBlocks(block, block);
+        return;
+    }
+
+    if (cache->loaded.count >= mMagazineSize) {
+        // The previous magazine is either empty or full. Keep the full magazines in the cache
+        // for the following allocations when it's possible.
+        if (cache->previous.count != 0) {
+            ReturnBlocks(cache->previous.head, cache->previous.tail);
+            cache->previous = Magazine();
+        }
+        std::swap(cache->loaded, cache->previous);
+    }
+    cache->loaded.Push(block);
+
+    UnlockCache(cache);
+}
+
+void ConcurrentSlabAllocatorImpl::ReturnBlocks(FreeBlock* head, FreeBlock* tail) {
+    FreeBlock* returnedHead = mReturnedBlocks.load(std::memory_order_relaxed);
+    do {
+        tail->next = returnedHead;
+    } while (!mReturnedBlocks.compare_exchange_weak(returnedHead, head, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+}
+
+void ConcurrentSlabAllocatorImpl::RefillFromDepot(Magazine* magazine) {
+    ASSERT(magazine->count == 0);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mFullMagazines.empty()) {
+        SplitReturnedBlocksLocked();
+    }
+
+    if (!mFullMagazines.empty()) {
+        *magazine = mFullMagazines.back();
+        mFullMagazines.pop_back();
+        return;
+    }
+
+    CarveBlocksLocked(magazine, mMagazineSize);
+}
+
+ConcurrentSlabAllocatorImpl::FreeBlock* ConcurrentSlabAllocatorImpl::AllocateFromDepot() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mFullMagazines.empty()) {
+        SplitReturnedBlocksLocked();
+    }
+
+    if (!mFullMagazines.empty()) {
+        FreeBlock* block = mFullMagazines.back().Pop();
+        if (mFullMagazines.back().count == 0) {
+            mFullMagazines.pop_back();
+        }
+        return block;
+    }
+
+    Magazine magazine;
+    CarveBlocksLocked(&magazine, 1);
+    return magazine.Pop();
+}
+
+void ConcurrentSlabAllocatorImpl::SplitReturnedBlocksLocked() {
+    // Taking the whole stack at once doesn't have the ABA problem of popping a single block.
+    FreeBlock* block = mReturnedBlocks.exchange(nullptr, std::memory_order_acquire);
+
+    while (block != nullptr) {
+        Magazine magazine;
+        magazine.head = block;
+        while (block != nullptr && magazine.count < mMagazineSize) {
+            magazine.tail = block;
+            magazine.count++;
+            block = block->next;
+        }
+        magazine.tail->next = nullptr;
+        mFullMagazines.push_back(magazine);
+    }
+}
+
+void ConcurrentSlabAllocatorImpl::CarveBlocksLocked(Magazine* magazine, uint32_t count) {
+    if (mBlocksLeftInSlab == 0) {
+        mSlabs.emplace_back(new char[static_cast<size_t>(mBlocksPerSlab) * mBlockStride +
+                                     mBlockAlignment]);
+        mNextBlock = AlignPtr(mSlabs.back().get(), mBlockAlignment);
+        mBlocksLeftInSlab = mBlocksPerSlab;
+    }
+
+    count = std::min(count, mBlocksLeftInSlab);
+    for (uint32_t i = 0; i < count; ++i) {
+        magazine->Push(new (mNextBlock) FreeBlock);
+        mNextBlock += mBlockStride;
+    }
+    mBlocksLeftInSlab -= count;
+}
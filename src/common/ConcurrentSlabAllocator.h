@@ -0,0 +1,149 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_CONCURRENTSLABALLOCATOR_H_
+#define COMMON_CONCURRENTSLABALLOCATOR_H_
+
+#include "common/NonCopyable.h"
+#include "common/PlacementAllocated.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// The ConcurrentSlabAllocator is a variant of the SlabAllocator that can be used from multiple
+// threads at the same time. Like the SlabAllocator, it allocates fixed-size objects out of large
+// contiguous slabs of memory. It is organized like a magazine allocator:
+//
+// Free blocks are kept in "magazines", singly linked lists of at most |mMagazineSize| blocks. The
+// link to the next free block is stored in the memory of the free block itself.
+//
+// Thread caches: each thread uses one of |kCacheCount| caches, assigned on its first use. A cache
+// holds a loaded magazine, that allocations pop from and deallocations push to, and a previous
+// magazine, which is either full or empty. When the loaded magazine is empty on allocation, or
+// full on deallocation, it is swapped with the previous one if that helps. So threads that
+// allocate and deallocate around the boundary of a magazine don't go back and forth with the
+// depot. A cache is used under a try-lock so that threads never wait on each other's cache: when
+// a thread finds its cache busy, the operation goes to the depot directly and the thread moves to
+// the next cache.
+//
+// Depot: the full magazines that don't fit in the caches are pushed onto a lock-free stack of
+// returned blocks, as well as the blocks deallocated while the thread's cache is busy. So
+// deallocating never takes a lock. The stack is only ever emptied all at once, which makes it
+// immune to the ABA problem. Refilling an empty cache takes the depot lock once per magazine,
+// splits the returned blocks into magazines, and takes one of them, or carves a new magazine out
+// of the current slab.
+//
+// Slabs are only released when the allocator is destroyed. Objects can be deallocated by any
+// thread, not only the one that allocated them.
+class ConcurrentSlabAllocatorImpl : NonCopyable {
+  public:
+    // The number of thread caches. Threads beyond it share the caches.
+    static constexpr uint32_t kCacheCount = 32;
+
+  protected:
+    ConcurrentSlabAllocatorImpl(uint32_t blocksPerSlab,
+                                uint32_t objectSize,
+                                uint32_t objectAlignment);
+    ~ConcurrentSlabAllocatorImpl();
+
+    // Allocate a new block of memory.
+    void* Allocate();
+
+    // Deallocate a block of memory.
+    void Deallocate(void* ptr);
+
+  private:
+    struct FreeBlock : PlacementAllocated {
+        FreeBlock* next;
+    };
+
+    struct Magazine {
+        FreeBlock* head = nullptr;
+        FreeBlock* tail = nullptr;
+        uint32_t count = 0;
+
+        void Push(FreeBlock* block);
+        FreeBlock* Pop();
+    };
+
+    // Caches are aligned to separate cache lines so that threads don't invalidate each other's
+    // caches.
+    struct alignas(64) Cache : PlacementAllocated {
+        std::atomic<bool> locked{false};
+        Magazine loaded;
+        Magazine previous;
+    };
+
+    // Get the cache of the calling thread, or nullptr if another thread is using it.
+    Cache* TryLockCache();
+    void UnlockCache(Cache* cache);
+
+    // Push blocks on the stack of returned blocks, without locking.
+    void ReturnBlocks(FreeBlock* head, FreeBlock* tail);
+
+    // Fill the empty |magazine| from the depot.
+    void RefillFromDepot(Magazine* magazine);
+
+    // Take a single block from the depot, for threads that can't use their cache.
+    FreeBlock* AllocateFromDepot();
+
+    // Move the returned blocks in magazines of |mFullMagazines|. Requires |mMutex|.
+    void SplitReturnedBlocksLocked();
+
+    // Carve up to |count| new blocks out of the current slab, or a new one if it is full.
+    // Requires |mMutex|.
+    void CarveBlocksLocked(Magazine* magazine, uint32_t count);
+
+    const uint32_t mBlockStride;
+    const uint32_t mBlockAlignment;
+    const uint32_t mBlocksPerSlab;
+    const uint32_t mMagazineSize;
+
+    std::unique_ptr<char[]> mCacheAllocation;
+    Cache* mCaches = nullptr;
+
+    std::atomic<FreeBlock*> mReturnedBlocks{nullptr};
+
+    std::mutex mMutex;
+    std::vector<Magazine> mFullMagazines;
+    std::vector<std::unique_ptr<char[]>> mSlabs;
+    char* mNextBlock = nullptr;
+    uint32_t mBlocksLeftInSlab = 0;
+};
+
+template <typename T>
+class ConcurrentSlabAllocator : public ConcurrentSlabAllocatorImpl {
+  public:
+    ConcurrentSlabAllocator(size_t totalObjectBytes,
+                            uint32_t objectSize = sizeof(T),
+                            uint32_t objectAlignment = alignof(T))
+        : ConcurrentSlabAllocatorImpl(totalObjectBytes / objectSize, objectSize, objectAlignment) {
+    }
+
+    template <typename... Args>
+    T* Allocate(Args&&... args) {
+        void* ptr = ConcurrentSlabAllocatorImpl::Allocate();
+        return new (ptr) T(std::forward<Args>(args)...);
+    }
+
+    void Deallocate(T* object) {
+        ConcurrentSlabAllocatorImpl::Deallocate(object);
+    }
+};
+
+#endif  // COMMON_CONCURRENTSLABALLOCATOR_H_
@@ -41,6 +41,21 @@ static constexpr uint32_t kMaxDynamicStorageBuffersPerPipelineLayout = 4u;
 // Max size of uniform buffer binding
 static constexpr uint64_t kMaxUniformBufferBindingSize = 16384u;
 
+// Immediate data is backed by root constants on D3D12, which share the 64 DWORDs of the root
+// signature with two descriptor tables per bind group, one root descriptor per dynamic buffer (2
+// DWORDs each) and the 2 constants of firstIndex/baseVertex. The immediate data gets what is left
+// at the maximum limits, which also fits in the 128 bytes Vulkan guarantees for push constants.
+// Shaders read it from a uniform buffer declared with [[group(kImmediateDataBindGroup),
+// binding(0)]].
+static constexpr uint32_t kMaxRootSignatureDWords = 64u;
+static constexpr uint32_t kMaxImmediateDataSize =
+    (kMaxRootSignatureDWords - 2 * kMaxBindGroups -
+     2 * (kMaxDynamicUniformBuffersPerPipelineLayout + kMaxDynamicStorageBuffersPerPipelineLayout) -
+     2) *
+    sizeof(uint32_t);
+static_assert(kMaxImmediateDataSize == 120u, "Unexpected immediate data size budget");
+static constexpr uint32_t kImmediateDataBindGroup = kMaxBindGroups;
+
 // Indirect command sizes
 static constexpr uint64_t kDispatchIndirectSize = 3 * sizeof(uint32_t);
 static constexpr uint64_t kDrawIndirectSize = 4 * sizeof(uint32_t);
@@ -20,6 +20,8 @@
 #include "common/ityp_bitset.h"
 
 #include <bitset>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 
 // Wrapper around std::hash to make it a templated function instead of a functor. It is marginally
@@ -35,6 +37,77 @@ size_t Hash(const TypedInteger<Tag, T>& value) {
     return Hash(static_cast<T>(value));
 }
 
+// Constants and the multiply-fold mixing step of wyhash. The 64x64->128 bit multiplication is a
+// single instruction on 64-bit platforms and spreads every input bit over the whole result, which
+// std::hash (usually the identity for integers) doesn't do.
+namespace detail {
+    constexpr uint64_t kHashP0 = 0xa0761d6478bd642full;
+    constexpr uint64_t kHashP1 = 0xe7037ed1a0b428dbull;
+    constexpr uint64_t kHashP2 = 0x8ebc6af09c88c6e3ull;
+    constexpr uint64_t kHashP3 = 0x589965cc75374cc3ull;
+
+    inline uint64_t HashMultiplyFold(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        __uint128_t product = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+        uint64_t aLow = a & 0xffffffff;
+        uint64_t aHigh = a >> 32;
+        uint64_t bLow = b & 0xffffffff;
+        uint64_t bHigh = b >> 32;
+
+        uint64_t lowLow = aLow * bLow;
+        uint64_t highLow = aHigh * bLow;
+        uint64_t lowHigh = aLow * bHigh;
+        uint64_t highHigh = aHigh * bHigh;
+
+        uint64_t cross = (lowLow >> 32) + (highLow & 0xffffffff) + lowHigh;
+        uint64_t low = (cross << 32) | (lowLow & 0xffffffff);
+        uint64_t high = (highLow >> 32) + (cross >> 32) + highHigh;
+        return low ^ high;
+#endif
+    }
+
+    inline uint64_t HashRead64(const uint8_t* data) {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+}  // namespace detail
+
+// Hashes two 64-bit values together.
+inline uint64_t HashMix64(uint64_t a, uint64_t b) {
+    return detail::HashMultiplyFold(a ^ detail::kHashP0, b ^ detail::kHashP1);
+}
+
+// Hashes a contiguous range of bytes, 16 bytes at a time. This is much faster than combining the
+// hash of each element when hashing strings or SPIR-V code.
+inline size_t HashBytes(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = detail::kHashP0 ^ static_cast<uint64_t>(size);
+
+    size_t remaining = size;
+    while (remaining >= 16) {
+        hash = detail::HashMultiplyFold(detail::HashRead64(bytes) ^ detail::kHashP1,
+                                        detail::HashRead64(bytes + 8) ^ hash);
+        bytes += 16;
+        remaining -= 16;
+    }
+    if (remaining >= 8) {
+        hash = detail::HashMultiplyFold(detail::HashRead64(bytes) ^ detail::kHashP1,
+                                        hash ^ detail::kHashP2);
+        bytes += 8;
+        remaining -= 8;
+    }
+    if (remaining > 0) {
+        uint64_t tail = 0;
+        memcpy(&tail, bytes, remaining);
+        hash = detail::HashMultiplyFold(tail ^ detail::kHashP1, hash ^ detail::kHashP3);
+    }
+
+    return static_cast<size_t>(detail::HashMultiplyFold(hash ^ detail::kHashP2, detail::kHashP3));
+}
+
 // When hashing sparse structures we want to iteratively build a hash value with only parts of the
 // data. HashCombine "hashes" together an existing hash and hashable values.
 //
@@ -46,13 +119,13 @@ size_t Hash(const TypedInteger<Tag, T>& value) {
 template <typename T>
 void HashCombine(size_t* hash, const T& value) {
 #if defined(DAWN_PLATFORM_64_BIT)
-    const size_t offset = 0x9e3779b97f4a7c16;
+    *hash = HashMix64(*hash, Hash(value));
 #elif defined(DAWN_PLATFORM_32_BIT)
     const size_t offset = 0x9e3779b9;
+    *hash ^= Hash(value) + offset + (*hash << 6) + (*hash >> 2);
 #else
 #    error "Unsupported platform"
 #endif
-    *hash ^= Hash(value) + offset + (*hash << 6) + (*hash >> 2);
 }
 
 template <typename T, typename... Args>
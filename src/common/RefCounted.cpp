@@ -38,6 +38,12 @@ uint64_t RefCounted::GetRefCountPayload() const {
     return kPayloadMask & mRefCount.load(std::memory_order_relaxed);
 }
 
+bool RefCounted::HasOneRef() const {
+    // The acquire ordering makes sure all the releases from other threads happen-before the
+    // caller acts on the object being uniquely owned.
+    return (mRefCount.load(std::memory_order_acquire) >> kPayloadBits) == 1;
+}
+
 void RefCounted::Reference() {
     ASSERT((mRefCount & ~kPayloadMask) != 0);
 
@@ -27,6 +27,9 @@ class RefCounted {
     uint64_t GetRefCountForTesting() const;
     uint64_t GetRefCountPayload() const;
 
+    // Returns whether the caller holds the only reference to this object.
+    bool HasOneRef() const;
+
     void Reference();
     void Release();
 
@@ -15,72 +15,389 @@
 #ifndef COMMON_SERIALQUEUE_H_
 #define COMMON_SERIALQUEUE_H_
 
-#include "common/SerialStorage.h"
+#include "common/Assert.h"
 
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
 #include <vector>
 
+// SerialQueue stores values associated to serials that are given in (not strictly) increasing
+// order, typically to release objects when the GPU is done with them.
+//
+// The values are stored in the order they were enqueued in a single growable ring buffer, and a
+// second ring buffer holds the serials with the end of their range of values. Unlike a vector of
+// vectors, enqueuing doesn't allocate memory once the rings are large enough, and clearing the
+// front of the queue doesn't move the remaining values.
+//
+// Positions in the rings are indices that only ever increase and are wrapped with a mask when
+// accessing the rings, so that growing the rings doesn't need to renumber them.
 template <typename Serial, typename Value>
-class SerialQueue;
+class SerialQueue {
+    union Slot {
+        Slot() {
+        }
+        ~Slot() {
+        }
+        Value value;
+    };
 
-template <typename SerialT, typename ValueT>
-struct SerialStorageTraits<SerialQueue<SerialT, ValueT>> {
-    using Serial = SerialT;
-    using Value = ValueT;
-    using SerialPair = std::pair<Serial, std::vector<Value>>;
-    using Storage = std::vector<SerialPair>;
-    using StorageIterator = typename Storage::iterator;
-    using ConstStorageIterator = typename Storage::const_iterator;
-};
+    struct SerialRange {
+        Serial serial;
+        // The position after the last value of the serial.
+        size_t end;
+    };
 
-// SerialQueue stores an associative list mapping a Serial to Value.
-// It enforces that the Serials enqueued are strictly non-decreasing.
-// This makes it very efficient iterate or clear all items added up
-// to some Serial value because they are stored contiguously in memory.
-template <typename Serial, typename Value>
-class SerialQueue : public SerialStorage<SerialQueue<Serial, Value>> {
   public:
+    template <typename V, typename S>
+    class IteratorBase {
+      public:
+        IteratorBase(S* slots, size_t mask, size_t position)
+            : mSlots(slots), mMask(mask), mPosition(position) {
+        }
+
+        IteratorBase& operator++() {
+            mPosition++;
+            return *this;
+        }
+
+        bool operator==(const IteratorBase& other) const {
+            return mPosition == other.mPosition;
+        }
+        bool operator!=(const IteratorBase& other) const {
+            return mPosition != other.mPosition;
+        }
+
+        V& operator*() const {
+            return mSlots[mPosition & mMask].value;
+        }
+
+      private:
+        S* mSlots;
+        size_t mMask;
+        size_t mPosition;
+    };
+
+    using Iterator = IteratorBase<Value, Slot>;
+    using ConstIterator = IteratorBase<const Value, const Slot>;
+
+    template <typename It>
+    class BeginEndBase {
+      public:
+        BeginEndBase(It begin, It end) : mBegin(begin), mEnd(end) {
+        }
+
+        It begin() const {
+            return mBegin;
+        }
+        It end() const {
+            return mEnd;
+        }
+
+      private:
+        It mBegin;
+        It mEnd;
+    };
+
+    using BeginEnd = BeginEndBase<Iterator>;
+    using ConstBeginEnd = BeginEndBase<ConstIterator>;
+
+    SerialQueue() = default;
+    SerialQueue(const SerialQueue& other);
+    SerialQueue(SerialQueue&& other);
+    SerialQueue& operator=(const SerialQueue& other);
+    SerialQueue& operator=(SerialQueue&& other);
+    ~SerialQueue();
 
     // The serial must be given in (not strictly) increasing order.
     void Enqueue(const Value& value, Serial serial);
     void Enqueue(Value&& value, Serial serial);
     void Enqueue(const std::vector<Value>& values, Serial serial);
     void Enqueue(std::vector<Value>&& values, Serial serial);
+
+    bool Empty() const;
+
+    // The UpTo variants of Iterate and Clear affect all values associated to a serial
+    // that is smaller OR EQUAL to the given serial. Iterating is done like so:
+    //     for (const T& value : queue.IterateAll()) { stuff(T); }
+    // Enqueuing values invalidates the iterators.
+    ConstBeginEnd IterateAll() const;
+    ConstBeginEnd IterateUpTo(Serial serial) const;
+    BeginEnd IterateAll();
+    BeginEnd IterateUpTo(Serial serial);
+
+    void Clear();
+    void ClearUpTo(Serial serial);
+
+    Serial FirstSerial() const;
+    Serial LastSerial() const;
+
+  private:
+    static constexpr size_t kMinValueCapacity = 16;
+    static constexpr size_t kMinRangeCapacity = 8;
+
+    template <typename... Args>
+    void EmplaceBack(Serial serial, Args&&... args);
+    void GrowValues();
+    void GrowRanges();
+
+    SerialRange& GetRange(size_t index);
+    const SerialRange& GetRange(size_t index) const;
+
+    // Returns the number of serials smaller or equal to |serial|.
+    size_t CountRangesUpTo(Serial serial) const;
+    // Returns the position after the last value of a serial smaller or equal to |serial|.
+    size_t FindEndUpTo(Serial serial) const;
+
+    void DestroyValues(size_t begin, size_t end);
+
+    std::unique_ptr<Slot[]> mSlots;
+    size_t mValueCapacity = 0;
+    size_t mValuesBegin = 0;
+    size_t mValuesEnd = 0;
+
+    std::vector<SerialRange> mRanges;
+    size_t mRangesBegin = 0;
+    size_t mRangeCount = 0;
 };
 
 // SerialQueue
 
 template <typename Serial, typename Value>
-void SerialQueue<Serial, Value>::Enqueue(const Value& value, Serial serial) {
-    DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
+SerialQueue<Serial, Value>::SerialQueue(const SerialQueue& other) {
+    *this = other;
+}
 
-    if (this->Empty() || this->mStorage.back().first < serial) {
-        this->mStorage.emplace_back(serial, std::vector<Value>{});
+template <typename Serial, typename Value>
+SerialQueue<Serial, Value>::SerialQueue(SerialQueue&& other) {
+    *this = std::move(other);
+}
+
+template <typename Serial, typename Value>
+SerialQueue<Serial, Value>& SerialQueue<Serial, Value>::operator=(const SerialQueue& other) {
+    if (this != &other) {
+        Clear();
+        for (size_t i = 0; i < other.mRangeCount; ++i) {
+            const SerialRange& range = other.GetRange(i);
+            size_t begin = i == 0 ? other.mValuesBegin : other.GetRange(i - 1).end;
+            for (size_t position = begin; position != range.end; ++position) {
+                EmplaceBack(range.serial,
+                            other.mSlots[position & (other.mValueCapacity - 1)].value);
+            }
+        }
     }
-    this->mStorage.back().second.push_back(value);
+    return *this;
 }
 
 template <typename Serial, typename Value>
-void SerialQueue<Serial, Value>::Enqueue(Value&& value, Serial serial) {
-    DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
+SerialQueue<Serial, Value>& SerialQueue<Serial, Value>::operator=(SerialQueue&& other) {
+    if (this != &other) {
+        Clear();
+        mSlots = std::move(other.mSlots);
+        mValueCapacity = other.mValueCapacity;
+        mValuesBegin = other.mValuesBegin;
+        mValuesEnd = other.mValuesEnd;
+        mRanges = std::move(other.mRanges);
+        mRangesBegin = other.mRangesBegin;
+        mRangeCount = other.mRangeCount;
 
-    if (this->Empty() || this->mStorage.back().first < serial) {
-        this->mStorage.emplace_back(serial, std::vector<Value>{});
+        other.mRanges.clear();
+        other.mValueCapacity = 0;
+        other.mValuesBegin = 0;
+        other.mValuesEnd = 0;
+        other.mRangesBegin = 0;
+        other.mRangeCount = 0;
     }
-    this->mStorage.back().second.push_back(std::move(value));
+    return *this;
+}
+
+template <typename Serial, typename Value>
+SerialQueue<Serial, Value>::~SerialQueue() {
+    Clear();
+}
+
+template <typename Serial, typename Value>
+void SerialQueue<Serial, Value>::Enqueue(const Value& value, Serial serial) {
+    EmplaceBack(serial, value);
+}
+
+template <typename Serial, typename Value>
+void SerialQueue<Serial, Value>::Enqueue(Value&& value, Serial serial) {
+    EmplaceBack(serial, std::move(value));
 }
 
 template <typename Serial, typename Value>
 void SerialQueue<Serial, Value>::Enqueue(const std::vector<Value>& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
-    DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-    this->mStorage.emplace_back(serial, values);
+    for (const Value& value : values) {
+        EmplaceBack(serial, value);
+    }
 }
 
 template <typename Serial, typename Value>
 void SerialQueue<Serial, Value>::Enqueue(std::vector<Value>&& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
-    DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-    this->mStorage.emplace_back(serial, values);
+    for (Value& value : values) {
+        EmplaceBack(serial, std::move(value));
+    }
+}
+
+template <typename Serial, typename Value>
+bool SerialQueue<Serial, Value>::Empty() const {
+    return mRangeCount == 0;
+}
+
+template <typename Serial, typename Value>
+typename SerialQueue<Serial, Value>::ConstBeginEnd SerialQueue<Serial, Value>::IterateAll() const {
+    return {{mSlots.get(), mValueCapacity - 1, mValuesBegin},
+            {mSlots.get(), mValueCapacity - 1, mValuesEnd}};
+}
+
+template <typename Serial, typename Value>
+typename SerialQueue<Serial, Value>::ConstBeginEnd SerialQueue<Serial, Value>::IterateUpTo(
+    Serial serial) const {
+    return {{mSlots.get(), mValueCapacity - 1, mValuesBegin},
+            {mSlots.get(), mValueCapacity - 1, FindEndUpTo(serial)}};
+}
+
+template <typename Serial, typename Value>
+typename SerialQueue<Serial, Value>::BeginEnd SerialQueue<Serial, Value>::IterateAll() {
+    return {{mSlots.get(), mValueCapacity - 1, mValuesBegin},
+            {mSlots.get(), mValueCapacity - 1, mValuesEnd}};
+}
+
+template <typename Serial, typename Value>
+typename SerialQueue<Serial, Value>::BeginEnd SerialQueue<Serial, Value>::IterateUpTo(
+    Serial serial) {
+    return {{mSlots.get(), mValueCapacity - 1, mValuesBegin},
+            {mSlots.get(), mValueCapacity - 1, FindEndUpTo(serial)}};
+}
+
+template <typename Serial, typename Value>
+void SerialQueue<Serial, Value>::Clear() {
+    DestroyValues(mValuesBegin, mValuesEnd);
+    mValuesBegin = 0;
+    mValuesEnd = 0;
+    mRangesBegin = 0;
+    mRangeCount = 0;
+}
+
+template <typename Serial, typename Value>
+void SerialQueue<Serial, Value>::ClearUpTo(Serial serial) {
+    size_t rangeCount = CountRangesUpTo(serial);
+    if (rangeCount == 0) {
+        return;
+    }
+
+    size_t end = GetRange(rangeCount - 1).end;
+    DestroyValues(mValuesBegin, end);
+    mValuesBegin = end;
+    mRangesBegin += rangeCount;
+    mRangeCount -= rangeCount;
+}
+
+template <typename Serial, typename Value>
+Serial SerialQueue<Serial, Value>::FirstSerial() const {
+    DAWN_ASSERT(!Empty());
+    return GetRange(0).serial;
+}
+
+template <typename Serial, typename Value>
+Serial SerialQueue<Serial, Value>::LastSerial() const {
+    DAWN_ASSERT(!Empty());
+    return GetRange(mRangeCount - 1).serial;
+}
+
+template <typename Serial, typename Value>
+template <typename... Args>
+void SerialQueue<Serial, Value>::EmplaceBack(Serial serial, Args&&... args) {
+    DAWN_ASSERT(Empty() || LastSerial() <= serial);
+
+    if (Empty() || LastSerial() < serial) {
+        if (mRangeCount == mRanges.size()) {
+            GrowRanges();
+        }
+        mRangeCount++;
+        GetRange(mRangeCount - 1).serial = serial;
+    }
+
+    if (mValuesEnd - mValuesBegin == mValueCapacity) {
+        GrowValues();
+    }
+    new (&mSlots[mValuesEnd & (mValueCapacity - 1)].value) Value(std::forward<Args>(args)...);
+    mValuesEnd++;
+    GetRange(mRangeCount - 1).end = mValuesEnd;
+}
+
+template <typename Serial, typename Value>
+void SerialQueue<Serial, Value>::GrowValues() {
+    size_t newCapacity = mValueCapacity == 0 ? kMinValueCapacity : mValueCapacity * 2;
+    std::unique_ptr<Slot[]> newSlots(new Slot[newCapacity]);
+
+    for (size_t position = mValuesBegin; position != mValuesEnd; ++position) {
+        Value& value = mSlots[position & (mValueCapacity - 1)].value;
+        new (&newSlots[position & (newCapacity - 1)].value) Value(std::move(value));
+        value.~Value();
+    }
+
+    mSlots = std::move(newSlots);
+    mValueCapacity = newCapacity;
+}
+
+template <typename Serial, typename Value>
+void SerialQueue<Serial, Value>::GrowRanges() {
+    size_t newCapacity = mRanges.empty() ? kMinRangeCapacity : mRanges.size() * 2;
+    std::vector<SerialRange> newRanges(newCapacity);
+    for (size_t i = 0; i < mRangeCount; ++i) {
+        newRanges[i] = GetRange(i);
+    }
+
+    mRanges = std::move(newRanges);
+    mRangesBegin = 0;
+}
+
+template <typename Serial, typename Value>
+typename SerialQueue<Serial, Value>::SerialRange& SerialQueue<Serial, Value>::GetRange(
+    size_t index) {
+    DAWN_ASSERT(index < mRangeCount);
+    return mRanges[(mRangesBegin + index) & (mRanges.size() - 1)];
+}
+
+template <typename Serial, typename Value>
+const typename SerialQueue<Serial, Value>::SerialRange& SerialQueue<Serial, Value>::GetRange(
+    size_t index) const {
+    DAWN_ASSERT(index < mRangeCount);
+    return mRanges[(mRangesBegin + index) & (mRanges.size() - 1)];
+}
+
+template <typename Serial, typename Value>
+size_t SerialQueue<Serial, Value>::CountRangesUpTo(Serial serial) const {
+    // The serials are sorted so the ranges can be binary searched.
+    size_t low = 0;
+    size_t high = mRangeCount;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (GetRange(middle).serial <= serial) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+template <typename Serial, typename Value>
+size_t SerialQueue<Serial, Value>::FindEndUpTo(Serial serial) const {
+    size_t rangeCount = CountRangesUpTo(serial);
+    return rangeCount == 0 ? mValuesBegin : GetRange(rangeCount - 1).end;
+}
+
+template <typename Serial, typename Value>
+void SerialQueue<Serial, Value>::DestroyValues(size_t begin, size_t end) {
+    for (size_t position = begin; position != end; ++position) {
+        mSlots[position & (mValueCapacity - 1)].value.~Value();
+    }
 }
 
 #endif  // COMMON_SERIALQUEUE_H_
@@ -14,6 +14,8 @@
 
 #include "dawn_native/Adapter.h"
 
+#include "common/Log.h"
+#include "dawn_native/Device.h"
 #include "dawn_native/Instance.h"
 
 namespace dawn_native {
@@ -64,9 +66,14 @@ namespace dawn_native {
         WGPUDeviceProperties adapterProperties = {};
 
         mSupportedExtensions.InitializeDeviceProperties(&adapterProperties);
+        adapterProperties.maxDrawIndirectCount = mMaxDrawIndirectCount;
         return adapterProperties;
     }
 
+    uint32_t AdapterBase::GetMaxDrawIndirectCount() const {
+        return mMaxDrawIndirectCount;
+    }
+
     DeviceBase* AdapterBase::CreateDevice(const DeviceDescriptor* descriptor) {
         DeviceBase* result = nullptr;
 
@@ -88,6 +95,17 @@ namespace dawn_native {
         // TODO(cwallez@chromium.org): This will eventually have validation that the device
         // descriptor is valid and is a subset what's allowed on this adapter.
         DAWN_TRY_ASSIGN(*result, CreateDeviceImpl(descriptor));
+
+        if (descriptor != nullptr && descriptor->warmInternalPipelines) {
+            // Warming is best-effort: the internal pipelines are created again on first use if it
+            // failed, so the error is only logged instead of becoming an error of the device.
+            MaybeError maybeError = (*result)->WarmInternalPipelines();
+            if (maybeError.IsError()) {
+                std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+                dawn::WarningLog() << "Failed to warm the internal pipelines: "
+                                   << error->GetMessage();
+            }
+        }
         return {};
     }
 
@@ -21,6 +21,7 @@
 #include "dawn_native/Extensions.h"
 #include "dawn_native/dawn_platform.h"
 
+#include <limits>
 #include <string>
 
 namespace dawn_native {
@@ -46,12 +47,16 @@ namespace dawn_native {
         bool SupportsAllRequestedExtensions(
             const std::vector<const char*>& requestedExtensions) const;
         WGPUDeviceProperties GetAdapterProperties() const;
+        uint32_t GetMaxDrawIndirectCount() const;
 
       protected:
         PCIInfo mPCIInfo = {};
         wgpu::AdapterType mAdapterType = wgpu::AdapterType::Unknown;
         std::string mDriverDescription;
         ExtensionsSet mSupportedExtensions;
+        // The largest maxDrawCount of MultiDrawIndexedIndirect. Backends that have no limit keep
+        // the default.
+        uint32_t mMaxDrawIndirectCount = std::numeric_limits<uint32_t>::max();
 
       private:
         virtual ResultOrError<DeviceBase*> CreateDeviceImpl(const DeviceDescriptor* descriptor) = 0;
@@ -581,6 +581,12 @@ namespace dawn_native {
         return a->mBindingMap == b->mBindingMap;
     }
 
+    uint64_t BindGroupLayoutBase::GetEstimatedRetainedSize() const {
+        // Each binding is stored once in the frontend and once in the backend layout.
+        return CachedObject::GetEstimatedRetainedSize() +
+               2 * sizeof(BindingInfo) * static_cast<uint64_t>(mBindingInfo.size());
+    }
+
     BindingIndex BindGroupLayoutBase::GetBindingCount() const {
         return mBindingInfo.size();
     }
@@ -63,6 +63,8 @@ namespace dawn_native {
             bool operator()(const BindGroupLayoutBase* a, const BindGroupLayoutBase* b) const;
         };
 
+        uint64_t GetEstimatedRetainedSize() const override;
+
         BindingIndex GetBindingCount() const;
         // Returns |BindingIndex| because buffers are packed at the front.
         BindingIndex GetBufferCount() const;
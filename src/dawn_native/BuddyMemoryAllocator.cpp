@@ -70,6 +70,7 @@ namespace dawn_native {
             std::unique_ptr<ResourceHeapBase> memory;
             DAWN_TRY_ASSIGN(memory, mHeapAllocator->AllocateResourceHeap(mMemoryBlockSize));
             mTrackedSubAllocations[memoryIndex] = {/*refcount*/ 0, std::move(memory)};
+            mHeapCount++;
         }
 
         mTrackedSubAllocations[memoryIndex].refcount++;
@@ -98,6 +99,7 @@ namespace dawn_native {
         if (mTrackedSubAllocations[memoryIndex].refcount == 0) {
             mHeapAllocator->DeallocateResourceHeap(
                 std::move(mTrackedSubAllocations[memoryIndex].mMemoryAllocation));
+            mHeapCount--;
         }
 
         mBuddyBlockAllocator.Deallocate(info.mBlockOffset);
@@ -107,6 +109,10 @@ namespace dawn_native {
         return mMemoryBlockSize;
     }
 
+    uint64_t BuddyMemoryAllocator::GetHeapCount() const {
+        return mHeapCount;
+    }
+
     uint64_t BuddyMemoryAllocator::ComputeTotalNumOfHeapsForTesting() const {
         uint64_t count = 0;
         for (const TrackedSubAllocations& allocation : mTrackedSubAllocations) {
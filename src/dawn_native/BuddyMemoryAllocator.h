@@ -49,6 +49,8 @@ namespace dawn_native {
         void Deallocate(const ResourceMemoryAllocation& allocation);
 
         uint64_t GetMemoryBlockSize() const;
+        // The number of heaps that contain at least one sub-allocation.
+        uint64_t GetHeapCount() const;
 
         // For testing purposes.
         uint64_t ComputeTotalNumOfHeapsForTesting() const;
@@ -67,6 +69,7 @@ namespace dawn_native {
         };
 
         std::vector<TrackedSubAllocations> mTrackedSubAllocations;
+        uint64_t mHeapCount = 0;
     };
 
 }  // namespace dawn_native
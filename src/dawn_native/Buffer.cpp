@@ -214,9 +214,8 @@ namespace dawn_native {
         } else {
             // If any of these fail, the buffer will be deleted and replaced with an
             // error buffer.
-            // TODO(enga): Suballocate and reuse memory from a larger staging buffer so we don't
-            // create many small buffers.
-            DAWN_TRY_ASSIGN(mStagingBuffer, GetDevice()->CreateStagingBuffer(GetSize()));
+            DAWN_TRY_ASSIGN(mStagingAllocation,
+                            GetDevice()->GetDynamicUploader()->AllocateForMapAtCreation(GetSize()));
         }
 
         return {};
@@ -304,8 +303,8 @@ namespace dawn_native {
             return nullptr;
         }
 
-        if (mStagingBuffer != nullptr) {
-            return static_cast<uint8_t*>(mStagingBuffer->GetMappedPointer()) + offset;
+        if (mStagingAllocation.stagingBuffer != nullptr) {
+            return mStagingAllocation.mappedBuffer + offset;
         }
         if (mSize == 0) {
             return reinterpret_cast<uint8_t*>(intptr_t(0xCAFED00D));
@@ -329,8 +328,8 @@ namespace dawn_native {
         if (mState == BufferState::Mapped) {
             UnmapInternal(WGPUBufferMapAsyncStatus_DestroyedBeforeCallback);
         } else if (mState == BufferState::MappedAtCreation) {
-            if (mStagingBuffer != nullptr) {
-                mStagingBuffer.reset();
+            if (mStagingAllocation.stagingBuffer != nullptr) {
+                ReleaseStagingAllocation();
             } else if (mSize != 0) {
                 ASSERT(IsCPUWritableAtCreation());
                 UnmapInternal(WGPUBufferMapAsyncStatus_DestroyedBeforeCallback);
@@ -341,17 +340,23 @@ namespace dawn_native {
     }
 
     MaybeError BufferBase::CopyFromStagingBuffer() {
-        ASSERT(mStagingBuffer);
+        ASSERT(mStagingAllocation.stagingBuffer != nullptr);
         if (GetSize() == 0) {
             return {};
         }
 
-        DAWN_TRY(GetDevice()->CopyFromStagingToBuffer(mStagingBuffer.get(), 0, this, 0, GetSize()));
+        // The staging memory is released even if the copy fails.
+        MaybeError result = GetDevice()->CopyFromStagingToBuffer(
+            mStagingAllocation.stagingBuffer, mStagingAllocation.startOffset, this, 0, GetSize());
+        ReleaseStagingAllocation();
 
-        DynamicUploader* uploader = GetDevice()->GetDynamicUploader();
-        uploader->ReleaseStagingBuffer(std::move(mStagingBuffer));
+        return result;
+    }
 
-        return {};
+    void BufferBase::ReleaseStagingAllocation() {
+        ASSERT(mStagingAllocation.stagingBuffer != nullptr);
+        GetDevice()->GetDynamicUploader()->ReleaseForMapAtCreation(mStagingAllocation);
+        mStagingAllocation = UploadHandle();
     }
 
     void BufferBase::APIUnmap() {
@@ -386,7 +391,7 @@ namespace dawn_native {
             mMapUserdata = 0;
 
         } else if (mState == BufferState::MappedAtCreation) {
-            if (mStagingBuffer != nullptr) {
+            if (mStagingAllocation.stagingBuffer != nullptr) {
                 GetDevice()->ConsumedError(CopyFromStagingBuffer());
             } else if (mSize != 0) {
                 ASSERT(IsCPUWritableAtCreation());
@@ -538,6 +543,10 @@ namespace dawn_native {
     }
 
     void BufferBase::DestroyInternal() {
+        // Buffers dropped while mapped at creation never copy their staging memory.
+        if (mStagingAllocation.stagingBuffer != nullptr) {
+            ReleaseStagingAllocation();
+        }
         if (mState != BufferState::Destroyed) {
             DestroyImpl();
         }
@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_BUFFER_H_
 #define DAWNNATIVE_BUFFER_H_
 
+#include "dawn_native/DynamicUploader.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/IntegerTypes.h"
@@ -94,6 +95,7 @@ namespace dawn_native {
 
         virtual bool IsCPUWritableAtCreation() const = 0;
         MaybeError CopyFromStagingBuffer();
+        void ReleaseStagingAllocation();
         void CallMapCallback(MapRequestID mapID, WGPUBufferMapAsyncStatus status);
 
         MaybeError ValidateMap(wgpu::BufferUsage requiredUsage,
@@ -112,7 +114,8 @@ namespace dawn_native {
         BufferState mState;
         bool mIsDataInitialized = false;
 
-        std::unique_ptr<StagingBufferBase> mStagingBuffer;
+        // The staging memory of buffers mapped at creation that aren't CPU writable.
+        UploadHandle mStagingAllocation;
 
         WGPUBufferMapCallback mMapCallback = nullptr;
         void* mMapUserdata = 0;
@@ -18,6 +18,12 @@
 
 namespace dawn_native {
 
+    namespace {
+
+        constexpr uint64_t kCachedObjectEstimatedSize = 1024;
+
+    }  // anonymous namespace
+
     bool CachedObject::IsCachedReference() const {
         return mIsCachedReference;
     }
@@ -41,4 +47,8 @@ namespace dawn_native {
         mIsContentHashInitialized = true;
     }
 
+    uint64_t CachedObject::GetEstimatedRetainedSize() const {
+        return kCachedObjectEstimatedSize;
+    }
+
 }  // namespace dawn_native
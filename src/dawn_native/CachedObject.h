@@ -39,6 +39,11 @@ namespace dawn_native {
         size_t GetContentHash() const;
         void SetContentHash(size_t contentHash);
 
+        // Estimate of the memory kept alive by this object, used to enforce the byte budget
+        // when the device retains released cached objects. The default is a fixed cost for the
+        // frontend, backend and driver objects, that objects with variable size add to.
+        virtual uint64_t GetEstimatedRetainedSize() const;
+
       private:
         friend class DeviceBase;
         void SetIsCachedReference();
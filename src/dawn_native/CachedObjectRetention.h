@@ -0,0 +1,168 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_CACHEDOBJECTRETENTION_H_
+#define DAWNNATIVE_CACHEDOBJECTRETENTION_H_
+
+#include "common/Assert.h"
+#include "common/RefCounted.h"
+#include "dawn_native/DawnNative.h"
+
+#include <iterator>
+#include <list>
+#include <unordered_map>
+
+namespace dawn_native {
+
+    // CachedObjectRetention keeps a bounded number of recently used cached objects alive after
+    // the application dropped its last reference to them, so that recreating the same object
+    // shortly after finds it in the device cache instead of compiling it again.
+    //
+    // Every object returned by the device cache is recorded with Touch() and stays referenced
+    // by the retention. Objects start in the in-use list. Trim() moves the ones that only the
+    // retention references anymore to the released list, which is ordered from the most to the
+    // least recently used and is the only one counted against the budget. It then drops the
+    // least recently used released objects until the budget is met, which lets them be destroyed
+    // and uncached as usual.
+    template <typename T>
+    class CachedObjectRetention {
+      public:
+        explicit CachedObjectRetention(const CachedObjectRetentionBudget& budget)
+            : mBudget(budget) {
+        }
+
+        ~CachedObjectRetention() {
+            ASSERT(mInUse.empty());
+            ASSERT(mReleased.empty());
+        }
+
+        bool IsEnabled() const {
+            return mBudget.maxCount > 0;
+        }
+
+        // Records a use of |object| which was either found in the device cache (|hit| is
+        // true) or was just created and inserted into it.
+        void Touch(T* object, bool hit) {
+            if (!IsEnabled()) {
+                return;
+            }
+
+            auto it = mIndex.find(object);
+            if (it == mIndex.end()) {
+                if (!hit) {
+                    mStats.misses++;
+                }
+                mInUse.push_front({object, object->GetEstimatedRetainedSize(), false});
+                mIndex.emplace(object, mInUse.begin());
+                return;
+            }
+
+            // Only the retention referenced the object, so it was brought back.
+            EntryIterator entry = it->second;
+            if (hit && object->HasOneRef()) {
+                mStats.hits++;
+            }
+            if (entry->released) {
+                entry->released = false;
+                mStats.retainedCount--;
+                mStats.retainedBytes -= entry->size;
+                mInUse.splice(mInUse.begin(), mReleased, entry);
+            } else {
+                mInUse.splice(mInUse.begin(), mInUse, entry);
+            }
+        }
+
+        // Moves the objects that were released since the last call to the released list, and
+        // drops the least recently used released objects that don't fit in the budget.
+        void Trim() {
+            CollectReleased();
+            while (!mReleased.empty() && !FitsBudget()) {
+                Evict(std::prev(mReleased.end()));
+            }
+        }
+
+        // Drops the references to all released objects, for example on memory pressure.
+        void ReleaseRetained() {
+            CollectReleased();
+            while (!mReleased.empty()) {
+                Evict(mReleased.begin());
+            }
+        }
+
+        void Clear() {
+            // Release the references outside of the containers since destroying an object can
+            // cascade into other caches.
+            std::list<Entry> inUse = std::move(mInUse);
+            std::list<Entry> released = std::move(mReleased);
+            mInUse.clear();
+            mReleased.clear();
+            mIndex.clear();
+            mStats.retainedCount = 0;
+            mStats.retainedBytes = 0;
+        }
+
+        const CachedObjectRetentionStats& GetStats() const {
+            return mStats;
+        }
+
+      private:
+        struct Entry {
+            Ref<T> object;
+            uint64_t size;
+            bool released;
+        };
+        using EntryIterator = typename std::list<Entry>::iterator;
+
+        // Objects released since the previous call are all more recently used than the ones
+        // already in the released list, so they are moved to its front.
+        void CollectReleased() {
+            const EntryIterator previouslyReleased = mReleased.begin();
+            auto it = mInUse.begin();
+            while (it != mInUse.end()) {
+                EntryIterator entry = it++;
+                if (entry->object->HasOneRef()) {
+                    entry->released = true;
+                    mStats.retainedCount++;
+                    mStats.retainedBytes += entry->size;
+                    mReleased.splice(previouslyReleased, mInUse, entry);
+                }
+            }
+        }
+
+        bool FitsBudget() const {
+            return mStats.retainedCount <= mBudget.maxCount &&
+                   (mBudget.maxBytes == 0 || mStats.retainedBytes <= mBudget.maxBytes);
+        }
+
+        void Evict(EntryIterator entry) {
+            ASSERT(entry->released);
+            mStats.evictions++;
+            mStats.retainedCount--;
+            mStats.retainedBytes -= entry->size;
+            mIndex.erase(entry->object.Get());
+            mReleased.erase(entry);
+        }
+
+        CachedObjectRetentionBudget mBudget;
+        CachedObjectRetentionStats mStats;
+
+        // Both lists are ordered from the most to the least recently used.
+        std::list<Entry> mInUse;
+        std::list<Entry> mReleased;
+        std::unordered_map<T*, EntryIterator> mIndex;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_CACHEDOBJECTRETENTION_H_
@@ -127,6 +127,12 @@ namespace dawn_native {
                     cmd->~InsertDebugMarkerCmd();
                     break;
                 }
+                case Command::MultiDrawIndexedIndirect: {
+                    MultiDrawIndexedIndirectCmd* draw =
+                        commands->NextCommand<MultiDrawIndexedIndirectCmd>();
+                    draw->~MultiDrawIndexedIndirectCmd();
+                    break;
+                }
                 case Command::PopDebugGroup: {
                     PopDebugGroupCmd* cmd = commands->NextCommand<PopDebugGroupCmd>();
                     cmd->~PopDebugGroupCmd();
@@ -181,6 +187,12 @@ namespace dawn_native {
                     cmd->~SetBindGroupCmd();
                     break;
                 }
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = commands->NextCommand<SetImmediateDataCmd>();
+                    commands->NextData<uint8_t>(cmd->size);
+                    cmd->~SetImmediateDataCmd();
+                    break;
+                }
                 case Command::SetIndexBuffer: {
                     SetIndexBufferCmd* cmd = commands->NextCommand<SetIndexBufferCmd>();
                     cmd->~SetIndexBufferCmd();
@@ -280,6 +292,10 @@ namespace dawn_native {
                 break;
             }
 
+            case Command::MultiDrawIndexedIndirect:
+                commands->NextCommand<MultiDrawIndexedIndirectCmd>();
+                break;
+
             case Command::PopDebugGroup:
                 commands->NextCommand<PopDebugGroupCmd>();
                 break;
@@ -327,6 +343,12 @@ namespace dawn_native {
                 break;
             }
 
+            case Command::SetImmediateData: {
+                SetImmediateDataCmd* cmd = commands->NextCommand<SetImmediateDataCmd>();
+                commands->NextData<uint8_t>(cmd->size);
+                break;
+            }
+
             case Command::SetIndexBuffer:
                 commands->NextCommand<SetIndexBufferCmd>();
                 break;
@@ -51,6 +51,7 @@ namespace dawn_native {
         EndRenderPass,
         ExecuteBundles,
         InsertDebugMarker,
+        MultiDrawIndexedIndirect,
         PopDebugGroup,
         PushDebugGroup,
         ResolveQuerySet,
@@ -61,6 +62,7 @@ namespace dawn_native {
         SetScissorRect,
         SetBlendConstant,
         SetBindGroup,
+        SetImmediateData,
         SetIndexBuffer,
         SetVertexBuffer,
         WriteTimestamp,
@@ -197,6 +199,15 @@ namespace dawn_native {
         uint32_t length;
     };
 
+    struct MultiDrawIndexedIndirectCmd {
+        Ref<BufferBase> indirectBuffer;
+        uint64_t indirectOffset;
+        uint32_t maxDrawCount;
+        // Null when the draw count is maxDrawCount.
+        Ref<BufferBase> drawCountBuffer;
+        uint64_t drawCountBufferOffset;
+    };
+
     struct PopDebugGroupCmd {};
 
     struct PushDebugGroupCmd {
@@ -241,6 +252,12 @@ namespace dawn_native {
         uint32_t dynamicOffsetCount;
     };
 
+    // The data follows the command, and is |size| bytes that go at |offset| in the immediate data.
+    struct SetImmediateDataCmd {
+        uint32_t offset;
+        uint32_t size;
+    };
+
     struct SetIndexBufferCmd {
         Ref<BufferBase> buffer;
         wgpu::IndexFormat format;
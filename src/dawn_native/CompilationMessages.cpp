@@ -76,6 +76,16 @@ namespace dawn_native {
         }
     }
 
+    void OwnedCompilationMessages::AddMessages(const OwnedCompilationMessages& other) {
+        // Cannot add messages after GetCompilationInfo has been called.
+        ASSERT(mCompilationInfo.messages == nullptr);
+        ASSERT(other.mCompilationInfo.messages == nullptr);
+
+        mMessageStrings.insert(mMessageStrings.end(), other.mMessageStrings.begin(),
+                               other.mMessageStrings.end());
+        mMessages.insert(mMessages.end(), other.mMessages.begin(), other.mMessages.end());
+    }
+
     void OwnedCompilationMessages::ClearMessages() {
         // Cannot clear messages after GetCompilationInfo has been called.
         ASSERT(mCompilationInfo.messages == nullptr);
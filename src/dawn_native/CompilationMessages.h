@@ -40,6 +40,8 @@ namespace dawn_native {
                         uint64_t linePos = 0);
         void AddMessage(const tint::diag::Diagnostic& diagnostic);
         void AddMessages(const tint::diag::List& diagnostics);
+        // Copies the messages of |other|, whose GetCompilationInfo must not have been called.
+        void AddMessages(const OwnedCompilationMessages& other);
         void ClearMessages();
 
         const WGPUCompilationInfo* GetCompilationInfo();
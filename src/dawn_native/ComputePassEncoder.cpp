@@ -119,6 +119,11 @@ namespace dawn_native {
 
     void ComputePassEncoder::APISetPipeline(ComputePipelineBase* pipeline) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (pipeline != nullptr && pipeline == mBoundPipeline) {
+                GetDevice()->CountElidedCommand(&ElidedCommandStats::setPipeline);
+                return {};
+            }
+
             if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(pipeline));
             }
@@ -129,6 +134,8 @@ namespace dawn_native {
                 allocator->Allocate<SetComputePipelineCmd>(Command::SetComputePipeline);
             cmd->pipeline = pipeline;
 
+            mBoundPipeline = pipeline;
+
             return {};
         });
     }
@@ -16,6 +16,10 @@
 
 #include "dawn_native/Device.h"
 #include "dawn_native/ObjectContentHasher.h"
+#include "dawn_native/PipelineLayout.h"
+#include "dawn_native/ShaderModule.h"
+
+#include <cstring>
 
 namespace dawn_native {
 
@@ -66,4 +70,28 @@ namespace dawn_native {
         return PipelineBase::EqualForCache(a, b);
     }
 
+    // static
+    size_t ComputePipelineBase::ComputeDescriptorContentHash(
+        const ComputePipelineDescriptor* descriptor) {
+        ASSERT(descriptor->layout != nullptr);
+
+        // This must match PipelineBase::ComputeContentHash, where the entry point is recorded as
+        // a range of bytes.
+        const char* entryPoint = descriptor->computeStage.entryPoint;
+        size_t hash = 0;
+        HashCombine(&hash, descriptor->layout->GetContentHash());
+        HashCombine(&hash, wgpu::ShaderStage::Compute);
+        HashCombine(&hash, descriptor->computeStage.module->GetContentHash());
+        HashCombine(&hash, HashBytes(entryPoint, strlen(entryPoint)));
+        return hash;
+    }
+
+    bool ComputePipelineBase::MatchesDescriptor(const ComputePipelineDescriptor* descriptor) const {
+        // The layout and the module are deduplicated so they can be compared by pointer.
+        const ProgrammableStage& stage = GetStage(SingleShaderStage::Compute);
+        return GetLayout() == descriptor->layout &&
+               stage.module.Get() == descriptor->computeStage.module &&
+               stage.entryPoint == descriptor->computeStage.entryPoint;
+    }
+
 }  // namespace dawn_native
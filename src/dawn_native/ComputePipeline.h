@@ -39,6 +39,12 @@ namespace dawn_native {
             bool operator()(const ComputePipelineBase* a, const ComputePipelineBase* b) const;
         };
 
+        // Computes the same hash as ComputeContentHash, and compares with the layout and stage
+        // of a pipeline, directly from a descriptor with a deduplicated layout. This lets the
+        // device cache be probed without reflecting the entry point into a blueprint.
+        static size_t ComputeDescriptorContentHash(const ComputePipelineDescriptor* descriptor);
+        bool MatchesDescriptor(const ComputePipelineDescriptor* descriptor) const;
+
       private:
         ComputePipelineBase(DeviceBase* device, ObjectBase::ErrorTag tag);
     };
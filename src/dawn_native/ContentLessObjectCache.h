@@ -0,0 +1,176 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_CONTENTLESSOBJECTCACHE_H_
+#define DAWNNATIVE_CONTENTLESSOBJECTCACHE_H_
+
+#include "common/Assert.h"
+#include "common/Math.h"
+
+#include <utility>
+#include <vector>
+
+namespace dawn_native {
+
+    // ContentLessObjectCache is a set of pointers to objects that are compared by value, using
+    // the Object::HashFunc and Object::EqualityFunc functors. It is used by the device to
+    // deduplicate objects.
+    //
+    // It is an open-addressing hash set with linear probing that stores the hash of each object
+    // next to its pointer, so that probing only dereferences objects whose hash matches. Erasing
+    // shifts the following entries back instead of leaving tombstones, so lookups never get
+    // slower as objects are created and destroyed.
+    template <typename Object>
+    class ContentLessObjectCache {
+      public:
+        using HashFunc = typename Object::HashFunc;
+        using EqualityFunc = typename Object::EqualityFunc;
+
+        ContentLessObjectCache() = default;
+        ContentLessObjectCache(const ContentLessObjectCache&) = delete;
+        ContentLessObjectCache& operator=(const ContentLessObjectCache&) = delete;
+
+        // Returns the cached object equal to |blueprint| or nullptr.
+        Object* Find(const Object* blueprint) const {
+            return Find(HashFunc()(blueprint), [&](const Object* object) {
+                return EqualityFunc()(object, blueprint);
+            });
+        }
+
+        // Returns a cached object with the given hash for which |matches| returns true, or
+        // nullptr. This allows looking up objects without building a blueprint.
+        template <typename Predicate>
+        Object* Find(size_t hash, Predicate&& matches) const {
+            if (mCount == 0) {
+                return nullptr;
+            }
+            for (size_t i = hash & mMask;; i = (i + 1) & mMask) {
+                const Slot& slot = mSlots[i];
+                if (slot.object == nullptr) {
+                    return nullptr;
+                }
+                if (slot.hash == hash && matches(slot.object)) {
+                    return slot.object;
+                }
+            }
+        }
+
+        // Inserts |object| unless an equal object is already cached. Returns the cached object
+        // and whether the insertion took place.
+        std::pair<Object*, bool> Insert(Object* object) {
+            ASSERT(object != nullptr);
+            if ((mCount + 1) * 4 > mSlots.size() * 3) {
+                Grow();
+            }
+
+            size_t hash = HashFunc()(object);
+            size_t i = hash & mMask;
+            for (; mSlots[i].object != nullptr; i = (i + 1) & mMask) {
+                if (mSlots[i].hash == hash && EqualityFunc()(mSlots[i].object, object)) {
+                    return {mSlots[i].object, false};
+                }
+            }
+
+            mSlots[i] = {hash, object};
+            mCount++;
+            return {object, true};
+        }
+
+        // Removes |object| itself (and not an object equal to it) from the cache. Returns the
+        // number of removed objects.
+        size_t Erase(const Object* object) {
+            if (mCount == 0) {
+                return 0;
+            }
+
+            size_t hash = HashFunc()(object);
+            for (size_t i = hash & mMask; mSlots[i].object != nullptr; i = (i + 1) & mMask) {
+                if (mSlots[i].object == object) {
+                    EraseSlot(i);
+                    return 1;
+                }
+            }
+            return 0;
+        }
+
+        bool Empty() const {
+            return mCount == 0;
+        }
+
+        size_t Size() const {
+            return mCount;
+        }
+
+      private:
+        struct Slot {
+            size_t hash = 0;
+            Object* object = nullptr;
+        };
+
+        static constexpr size_t kInitialCapacity = 16;
+
+        void Grow() {
+            std::vector<Slot> oldSlots = std::move(mSlots);
+            size_t newCapacity = oldSlots.empty() ? kInitialCapacity : oldSlots.size() * 2;
+            ASSERT(IsPowerOfTwo(newCapacity));
+
+            mSlots.clear();
+            mSlots.resize(newCapacity);
+            mMask = newCapacity - 1;
+
+            for (const Slot& slot : oldSlots) {
+                if (slot.object == nullptr) {
+                    continue;
+                }
+                size_t i = slot.hash & mMask;
+                while (mSlots[i].object != nullptr) {
+                    i = (i + 1) & mMask;
+                }
+                mSlots[i] = slot;
+            }
+        }
+
+        // Backward-shift deletion: move back the entries of the probe sequence that follows
+        // |hole| if their ideal position allows it, so that no probe sequence gets interrupted.
+        void EraseSlot(size_t hole) {
+            size_t i = hole;
+            while (true) {
+                i = (i + 1) & mMask;
+                if (mSlots[i].object == nullptr) {
+                    break;
+                }
+
+                // The entry at i can fill the hole only if its ideal position isn't cyclically in
+                // (hole, i].
+                size_t ideal = mSlots[i].hash & mMask;
+                bool idealInRange = hole <= i ? (hole < ideal && ideal <= i)
+                                              : (hole < ideal || ideal <= i);
+                if (!idealInRange) {
+                    mSlots[hole] = mSlots[i];
+                    hole = i;
+                }
+            }
+
+            mSlots[hole] = {};
+            mCount--;
+        }
+
+        std::vector<Slot> mSlots;
+        size_t mMask = 0;
+        size_t mCount = 0;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_CONTENTLESSOBJECTCACHE_H_
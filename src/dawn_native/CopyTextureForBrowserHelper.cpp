@@ -101,6 +101,15 @@ namespace dawn_native {
             }
         )";
 
+        // The destination formats accepted by ValidateCopyTextureFormatConversion, for which a
+        // pipeline can be created ahead of time.
+        constexpr wgpu::TextureFormat kSupportedDstFormats[] = {
+            wgpu::TextureFormat::RGBA8Unorm,  wgpu::TextureFormat::BGRA8Unorm,
+            wgpu::TextureFormat::RGBA32Float, wgpu::TextureFormat::RG8Unorm,
+            wgpu::TextureFormat::RGBA16Float, wgpu::TextureFormat::RG16Float,
+            wgpu::TextureFormat::RGB10A2Unorm,
+        };
+
         // TODO(shaobo.yan@intel.com): Expand copyTextureForBrowser to support any
         // non-depth, non-stencil, non-compressed texture format pair copy. Now this API
         // supports CopyImageBitmapToTexture normal format pairs.
@@ -247,6 +256,13 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError CreateCopyTextureForBrowserPipelines(DeviceBase* device) {
+        for (wgpu::TextureFormat dstFormat : kSupportedDstFormats) {
+            DAWN_TRY(GetOrCreateCopyTextureForBrowserPipeline(device, dstFormat));
+        }
+        return {};
+    }
+
     MaybeError DoCopyTextureForBrowser(DeviceBase* device,
                                        const ImageCopyTexture* source,
                                        const ImageCopyTexture* destination,
@@ -30,6 +30,10 @@ namespace dawn_native {
                                              const Extent3D* copySize,
                                              const CopyTextureForBrowserOptions* options);
 
+    // Creates the internal pipelines for all the supported destination formats so that the first
+    // copy doesn't have to compile them.
+    MaybeError CreateCopyTextureForBrowserPipelines(DeviceBase* device);
+
     MaybeError DoCopyTextureForBrowser(DeviceBase* device,
                                        const ImageCopyTexture* source,
                                        const ImageCopyTexture* destination,
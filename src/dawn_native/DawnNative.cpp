@@ -15,9 +15,12 @@
 #include "dawn_native/DawnNative.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/Instance.h"
+#include "dawn_native/ShaderModule.h"
 #include "dawn_native/Texture.h"
 #include "dawn_platform/DawnPlatform.h"
 
+#include <algorithm>
+
 // Contains the entry-points into dawn_native
 
 namespace dawn_native {
@@ -137,6 +140,10 @@ namespace dawn_native {
         mImpl->DiscoverDefaultAdapters();
     }
 
+    void Instance::DiscoverDefaultAdapters(WGPUBackendType backendType) {
+        mImpl->DiscoverDefaultAdapters(static_cast<wgpu::BackendType>(backendType));
+    }
+
     bool Instance::DiscoverAdapters(const AdapterDiscoveryOptionsBase* options) {
         return mImpl->DiscoverAdapters(options);
     }
@@ -211,6 +218,75 @@ namespace dawn_native {
         return deviceBase->APITick();
     }
 
+    bool DeviceWaitForPendingWork(WGPUDevice device, uint64_t timeoutNs) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        ExecutionSerial serial = std::max(deviceBase->GetLastSubmittedCommandSerial(),
+                                          deviceBase->GetFutureSerial());
+
+        bool completed = false;
+        if (deviceBase->ConsumedError(deviceBase->WaitForSerial(serial, timeoutNs), &completed)) {
+            return false;
+        }
+        return completed;
+    }
+
+    CachedObjectsRetentionStats GetCachedObjectsRetentionStats(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetCachedObjectsRetentionStats();
+    }
+
+    void ReleaseRetainedCachedObjects(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        deviceBase->ReleaseRetainedCachedObjects();
+    }
+
+    ObjectCacheStats GetTextureViewCacheStats(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetTextureViewCacheStats();
+    }
+
+    ElidedCommandStats GetElidedCommandStats(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetElidedCommandStats();
+    }
+
+    ShaderModuleMemoryInfo GetShaderModuleMemoryInfo(WGPUShaderModule module) {
+        dawn_native::ShaderModuleBase* moduleBase =
+            reinterpret_cast<dawn_native::ShaderModuleBase*>(module);
+        ShaderModuleMemoryInfo info;
+        info.retainedBytes = moduleBase->ComputeRetainedBytes();
+        info.retainsTintProgram = moduleBase->RetainsTintProgram();
+        return info;
+    }
+
+    void CreateBuffers(WGPUDevice device,
+                       uint32_t count,
+                       const WGPUBufferDescriptor* descriptors,
+                       WGPUBuffer* buffers) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        deviceBase->CreateBuffers(count, reinterpret_cast<const BufferDescriptor*>(descriptors),
+                                  reinterpret_cast<BufferBase**>(buffers));
+    }
+
+    void CreateTextures(WGPUDevice device,
+                        uint32_t count,
+                        const WGPUTextureDescriptor* descriptors,
+                        WGPUTexture* textures) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        deviceBase->CreateTextures(count, reinterpret_cast<const TextureDescriptor*>(descriptors),
+                                   reinterpret_cast<TextureBase**>(textures));
+    }
+
+    void CreateBindGroups(WGPUDevice device,
+                          uint32_t count,
+                          const WGPUBindGroupDescriptor* descriptors,
+                          WGPUBindGroup* bindGroups) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        deviceBase->CreateBindGroups(count,
+                                     reinterpret_cast<const BindGroupDescriptor*>(descriptors),
+                                     reinterpret_cast<BindGroupBase**>(bindGroups));
+    }
+
     // ExternalImageDescriptor
 
     ExternalImageDescriptor::ExternalImageDescriptor(ExternalImageType type) : type(type) {
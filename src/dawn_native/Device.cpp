@@ -20,10 +20,13 @@
 #include "dawn_native/BindGroup.h"
 #include "dawn_native/BindGroupLayout.h"
 #include "dawn_native/Buffer.h"
+#include "dawn_native/CachedObjectRetention.h"
 #include "dawn_native/CommandBuffer.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/CompilationMessages.h"
 #include "dawn_native/ComputePipeline.h"
+#include "dawn_native/ContentLessObjectCache.h"
+#include "dawn_native/CopyTextureForBrowserHelper.h"
 #include "dawn_native/CreatePipelineAsyncTracker.h"
 #include "dawn_native/DynamicUploader.h"
 #include "dawn_native/ErrorData.h"
@@ -34,6 +37,7 @@
 #include "dawn_native/InternalPipelineStore.h"
 #include "dawn_native/PersistentCache.h"
 #include "dawn_native/PipelineLayout.h"
+#include "dawn_native/QueryHelper.h"
 #include "dawn_native/QuerySet.h"
 #include "dawn_native/Queue.h"
 #include "dawn_native/RenderBundleEncoder.h"
@@ -43,29 +47,94 @@
 #include "dawn_native/Surface.h"
 #include "dawn_native/SwapChain.h"
 #include "dawn_native/Texture.h"
+#include "dawn_native/TextureDataConversionHelper.h"
 #include "dawn_native/ValidationUtils_autogen.h"
+#include "dawn_platform/DawnPlatform.h"
 
+#include <chrono>
+#include <thread>
 #include <unordered_set>
 
 namespace dawn_native {
 
-    // DeviceBase sub-structures
+    namespace {
+
+        // Shared implementation of the bulk creation of objects. The descriptors are validated
+        // first, then the objects of the valid ones are created with |createBatch|, or with
+        // |createOne| if the batch failed. The invalid descriptors and the objects that failed
+        // their creation or |finish| are replaced with error objects from |makeError|.
+        template <typename T,
+                  typename Descriptor,
+                  typename Validate,
+                  typename CreateBatch,
+                  typename CreateOne,
+                  typename Finish,
+                  typename MakeError>
+        void CreateObjectsInBulk(DeviceBase* device,
+                                 uint32_t count,
+                                 const Descriptor* descriptors,
+                                 T** objects,
+                                 Validate&& validate,
+                                 CreateBatch&& createBatch,
+                                 CreateOne&& createOne,
+                                 Finish&& finish,
+                                 MakeError&& makeError) {
+            std::vector<uint32_t> validIndices;
+            std::vector<const Descriptor*> validDescriptors;
+            validIndices.reserve(count);
+            validDescriptors.reserve(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                if (device->ConsumedError(validate(i))) {
+                    objects[i] = makeError(i);
+                } else {
+                    validIndices.push_back(i);
+                    validDescriptors.push_back(&descriptors[i]);
+                }
+            }
+            if (validIndices.empty()) {
+                return;
+            }
+
+            const uint32_t validCount = static_cast<uint32_t>(validIndices.size());
+            std::vector<Ref<T>> results(validCount);
+            MaybeError batchResult =
+                createBatch(validCount, validDescriptors.data(), results.data());
+            if (batchResult.IsError()) {
+                // Drop the error, creating the objects one by one reports it for the objects that
+                // cause it.
+                std::unique_ptr<ErrorData> batchError = batchResult.AcquireError();
+                for (uint32_t i = 0; i < validCount; ++i) {
+                    results[i] = nullptr;
+                    device->ConsumedError(createOne(validDescriptors[i]), &results[i]);
+                }
+            }
 
-    // The caches are unordered_sets of pointers with special hash and compare functions
-    // to compare the value of the objects, instead of the pointers.
-    template <typename Object>
-    using ContentLessObjectCache =
-        std::unordered_set<Object*, typename Object::HashFunc, typename Object::EqualityFunc>;
+            for (uint32_t i = 0; i < validCount; ++i) {
+                const uint32_t index = validIndices[i];
+                if (results[i] == nullptr ||
+                    device->ConsumedError(finish(results[i].Get(), index))) {
+                    objects[index] = makeError(index);
+                } else {
+                    objects[index] = results[i].Detach();
+                }
+            }
+        }
+
+    }  // anonymous namespace
+
+    // DeviceBase sub-structures
 
+    // The caches are sets of pointers with special hash and compare functions to compare the
+    // value of the objects, instead of the pointers.
     struct DeviceBase::Caches {
         ~Caches() {
-            ASSERT(attachmentStates.empty());
-            ASSERT(bindGroupLayouts.empty());
-            ASSERT(computePipelines.empty());
-            ASSERT(pipelineLayouts.empty());
-            ASSERT(renderPipelines.empty());
-            ASSERT(samplers.empty());
-            ASSERT(shaderModules.empty());
+            ASSERT(attachmentStates.Empty());
+            ASSERT(bindGroupLayouts.Empty());
+            ASSERT(computePipelines.Empty());
+            ASSERT(pipelineLayouts.Empty());
+            ASSERT(renderPipelines.Empty());
+            ASSERT(samplers.Empty());
+            ASSERT(shaderModules.Empty());
         }
 
         ContentLessObjectCache<AttachmentStateBlueprint> attachmentStates;
@@ -77,6 +146,21 @@ namespace dawn_native {
         ContentLessObjectCache<ShaderModuleBase> shaderModules;
     };
 
+    // Keeps the most recently used released objects alive, see CachedObjectRetention.
+    struct DeviceBase::CachedObjectRetentions {
+        explicit CachedObjectRetentions(const DeviceDescriptor& descriptor)
+            : bindGroupLayouts(descriptor.bindGroupLayoutRetention),
+              computePipelines(descriptor.computePipelineRetention),
+              renderPipelines(descriptor.renderPipelineRetention),
+              samplers(descriptor.samplerRetention) {
+        }
+
+        CachedObjectRetention<BindGroupLayoutBase> bindGroupLayouts;
+        CachedObjectRetention<ComputePipelineBase> computePipelines;
+        CachedObjectRetention<RenderPipelineBase> renderPipelines;
+        CachedObjectRetention<SamplerBase> samplers;
+    };
+
     struct DeviceBase::DeprecationWarnings {
         std::unordered_set<std::string> emitted;
         size_t count = 0;
@@ -91,6 +175,10 @@ namespace dawn_native {
             ApplyExtensions(descriptor);
         }
 
+        const DeviceDescriptor defaultDescriptor = {};
+        mCachedObjectRetentions = std::make_unique<CachedObjectRetentions>(
+            descriptor != nullptr ? *descriptor : defaultDescriptor);
+
         mFormatTable = BuildFormatTable(this);
         SetDefaultToggles();
     }
@@ -100,6 +188,10 @@ namespace dawn_native {
     MaybeError DeviceBase::Initialize(QueueBase* defaultQueue) {
         mQueue = AcquireRef(defaultQueue);
 
+        if (IsToggleEnabled(Toggle::RecordErrorBacktraces)) {
+            mErrorBacktraces = std::make_unique<ScopedErrorBacktraces>();
+        }
+
 #if defined(DAWN_ENABLE_ASSERTS)
         mUncapturedErrorCallback = [](WGPUErrorType, char const*, void*) {
             static bool calledOnce = false;
@@ -195,6 +287,12 @@ namespace dawn_native {
 
         mInternalPipelineStore = nullptr;
 
+        // Pipelines reference bind group layouts so they are released first.
+        mCachedObjectRetentions->renderPipelines.Clear();
+        mCachedObjectRetentions->computePipelines.Clear();
+        mCachedObjectRetentions->samplers.Clear();
+        mCachedObjectRetentions->bindGroupLayouts.Clear();
+
         AssumeCommandsComplete();
         // Tell the backend that it can free all the objects now that the GPU timeline is empty.
         ShutDownImpl();
@@ -272,6 +370,11 @@ namespace dawn_native {
 
     void DeviceBase::ConsumeError(std::unique_ptr<ErrorData> error) {
         ASSERT(error != nullptr);
+        if (error->GetBacktrace().empty()) {
+            HandleError(error->GetType(), error->GetMessage());
+            return;
+        }
+
         std::ostringstream ss;
         ss << error->GetMessage();
         for (const auto& callsite : error->GetBacktrace()) {
@@ -359,6 +462,19 @@ namespace dawn_native {
         return GetAdapter()->GetInstance()->GetPlatform();
     }
 
+    dawn_platform::WorkerTaskPool* DeviceBase::GetWorkerTaskPool() {
+        if (mWorkerTaskPool == nullptr) {
+            dawn_platform::Platform* platform = GetPlatform();
+            if (platform != nullptr) {
+                mWorkerTaskPool = platform->CreateWorkerTaskPool();
+            } else {
+                dawn_platform::Platform defaultPlatform;
+                mWorkerTaskPool = defaultPlatform.CreateWorkerTaskPool();
+            }
+        }
+        return mWorkerTaskPool.get();
+    }
+
     ExecutionSerial DeviceBase::GetCompletedCommandSerial() const {
         return mCompletedSerial;
     }
@@ -375,6 +491,21 @@ namespace dawn_native {
         return mInternalPipelineStore.get();
     }
 
+    MaybeError DeviceBase::WarmInternalPipelines() {
+        DAWN_TRY(CreateCopyTextureForBrowserPipelines(this));
+        if (IsExtensionEnabled(Extension::TimestampQuery)) {
+            DAWN_TRY(CreateTimestampComputePipeline(this));
+        }
+        if (IsExtensionEnabled(Extension::TextureDataConversion)) {
+            DAWN_TRY(CreateTextureDataConversionPipeline(this));
+        }
+        return PersistPipelineCacheImpl();
+    }
+
+    MaybeError DeviceBase::PersistPipelineCacheImpl() {
+        return {};
+    }
+
     void DeviceBase::IncrementLastSubmittedCommandSerial() {
         mLastSubmittedSerial++;
     }
@@ -449,14 +580,16 @@ namespace dawn_native {
         blueprint.SetContentHash(blueprintHash);
 
         Ref<BindGroupLayoutBase> result;
-        auto iter = mCaches->bindGroupLayouts.find(&blueprint);
-        if (iter != mCaches->bindGroupLayouts.end()) {
-            result = *iter;
+        BindGroupLayoutBase* cached = mCaches->bindGroupLayouts.Find(&blueprint);
+        if (cached != nullptr) {
+            mCachedObjectRetentions->bindGroupLayouts.Touch(cached, true);
+            result = cached;
         } else {
             DAWN_TRY_ASSIGN(result, CreateBindGroupLayoutImpl(descriptor));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
-            mCaches->bindGroupLayouts.insert(result.Get());
+            mCaches->bindGroupLayouts.Insert(result.Get());
+            mCachedObjectRetentions->bindGroupLayouts.Touch(result.Get(), false);
         }
 
         return std::move(result);
@@ -464,7 +597,7 @@ namespace dawn_native {
 
     void DeviceBase::UncacheBindGroupLayout(BindGroupLayoutBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->bindGroupLayouts.erase(obj);
+        size_t removedCount = mCaches->bindGroupLayouts.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
@@ -484,15 +617,18 @@ namespace dawn_native {
 
     std::pair<Ref<ComputePipelineBase>, size_t> DeviceBase::GetCachedComputePipeline(
         const ComputePipelineDescriptor* descriptor) {
-        ComputePipelineBase blueprint(this, descriptor);
-
-        const size_t blueprintHash = blueprint.ComputeContentHash();
-        blueprint.SetContentHash(blueprintHash);
+        // Compute pipelines are looked up directly with the descriptor to avoid reflecting the
+        // entry point and computing the minimum buffer sizes of a blueprint.
+        const size_t blueprintHash = ComputePipelineBase::ComputeDescriptorContentHash(descriptor);
 
         Ref<ComputePipelineBase> result;
-        auto iter = mCaches->computePipelines.find(&blueprint);
-        if (iter != mCaches->computePipelines.end()) {
-            result = *iter;
+        ComputePipelineBase* cached = mCaches->computePipelines.Find(
+            blueprintHash, [&](const ComputePipelineBase* pipeline) {
+                return pipeline->MatchesDescriptor(descriptor);
+            });
+        if (cached != nullptr) {
+            mCachedObjectRetentions->computePipelines.Touch(cached, true);
+            result = cached;
         }
 
         return std::make_pair(result, blueprintHash);
@@ -502,18 +638,20 @@ namespace dawn_native {
         Ref<ComputePipelineBase> computePipeline,
         size_t blueprintHash) {
         computePipeline->SetContentHash(blueprintHash);
-        auto insertion = mCaches->computePipelines.insert(computePipeline.Get());
+        auto insertion = mCaches->computePipelines.Insert(computePipeline.Get());
         if (insertion.second) {
             computePipeline->SetIsCachedReference();
+            mCachedObjectRetentions->computePipelines.Touch(computePipeline.Get(), false);
             return computePipeline;
         } else {
-            return *(insertion.first);
+            mCachedObjectRetentions->computePipelines.Touch(insertion.first, true);
+            return insertion.first;
         }
     }
 
     void DeviceBase::UncacheComputePipeline(ComputePipelineBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->computePipelines.erase(obj);
+        size_t removedCount = mCaches->computePipelines.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
@@ -525,14 +663,14 @@ namespace dawn_native {
         blueprint.SetContentHash(blueprintHash);
 
         Ref<PipelineLayoutBase> result;
-        auto iter = mCaches->pipelineLayouts.find(&blueprint);
-        if (iter != mCaches->pipelineLayouts.end()) {
-            result = *iter;
+        PipelineLayoutBase* cached = mCaches->pipelineLayouts.Find(&blueprint);
+        if (cached != nullptr) {
+            result = cached;
         } else {
             DAWN_TRY_ASSIGN(result, CreatePipelineLayoutImpl(descriptor));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
-            mCaches->pipelineLayouts.insert(result.Get());
+            mCaches->pipelineLayouts.Insert(result.Get());
         }
 
         return std::move(result);
@@ -540,7 +678,7 @@ namespace dawn_native {
 
     void DeviceBase::UncachePipelineLayout(PipelineLayoutBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->pipelineLayouts.erase(obj);
+        size_t removedCount = mCaches->pipelineLayouts.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
@@ -552,14 +690,16 @@ namespace dawn_native {
         blueprint.SetContentHash(blueprintHash);
 
         Ref<RenderPipelineBase> result;
-        auto iter = mCaches->renderPipelines.find(&blueprint);
-        if (iter != mCaches->renderPipelines.end()) {
-            result = *iter;
+        RenderPipelineBase* cached = mCaches->renderPipelines.Find(&blueprint);
+        if (cached != nullptr) {
+            mCachedObjectRetentions->renderPipelines.Touch(cached, true);
+            result = cached;
         } else {
             DAWN_TRY_ASSIGN(result, CreateRenderPipelineImpl(descriptor));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
-            mCaches->renderPipelines.insert(result.Get());
+            mCaches->renderPipelines.Insert(result.Get());
+            mCachedObjectRetentions->renderPipelines.Touch(result.Get(), false);
         }
 
         return std::move(result);
@@ -567,26 +707,28 @@ namespace dawn_native {
 
     void DeviceBase::UncacheRenderPipeline(RenderPipelineBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->renderPipelines.erase(obj);
+        size_t removedCount = mCaches->renderPipelines.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
     ResultOrError<Ref<SamplerBase>> DeviceBase::GetOrCreateSampler(
         const SamplerDescriptor* descriptor) {
-        SamplerBase blueprint(this, descriptor);
-
-        const size_t blueprintHash = blueprint.ComputeContentHash();
-        blueprint.SetContentHash(blueprintHash);
+        const size_t blueprintHash = SamplerBase::ComputeDescriptorContentHash(descriptor);
 
         Ref<SamplerBase> result;
-        auto iter = mCaches->samplers.find(&blueprint);
-        if (iter != mCaches->samplers.end()) {
-            result = *iter;
+        SamplerBase* cached =
+            mCaches->samplers.Find(blueprintHash, [&](const SamplerBase* sampler) {
+                return sampler->MatchesDescriptor(descriptor);
+            });
+        if (cached != nullptr) {
+            mCachedObjectRetentions->samplers.Touch(cached, true);
+            result = cached;
         } else {
             DAWN_TRY_ASSIGN(result, CreateSamplerImpl(descriptor));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
-            mCaches->samplers.insert(result.Get());
+            mCaches->samplers.Insert(result.Get());
+            mCachedObjectRetentions->samplers.Touch(result.Get(), false);
         }
 
         return std::move(result);
@@ -594,7 +736,7 @@ namespace dawn_native {
 
     void DeviceBase::UncacheSampler(SamplerBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->samplers.erase(obj);
+        size_t removedCount = mCaches->samplers.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
@@ -603,16 +745,14 @@ namespace dawn_native {
         ShaderModuleParseResult* parseResult) {
         ASSERT(parseResult != nullptr);
 
-        ShaderModuleBase blueprint(this, descriptor);
-
-        const size_t blueprintHash = blueprint.ComputeContentHash();
-        blueprint.SetContentHash(blueprintHash);
+        // Shader modules are looked up directly with the descriptor to avoid copying the shader
+        // source into a blueprint.
+        const size_t blueprintHash = ShaderModuleBase::ComputeDescriptorContentHash(descriptor);
 
-        Ref<ShaderModuleBase> result;
-        auto iter = mCaches->shaderModules.find(&blueprint);
-        if (iter != mCaches->shaderModules.end()) {
-            result = *iter;
-        } else {
+        Ref<ShaderModuleBase> result = mCaches->shaderModules.Find(
+            blueprintHash,
+            [&](const ShaderModuleBase* module) { return module->MatchesDescriptor(descriptor); });
+        if (result == nullptr) {
             if (!parseResult->HasParsedShader()) {
                 // We skip the parse on creation if validation isn't enabled which let's us quickly
                 // lookup in the cache without validating and parsing. We need the parsed module
@@ -624,7 +764,7 @@ namespace dawn_native {
             DAWN_TRY_ASSIGN(result, CreateShaderModuleImpl(descriptor, parseResult));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
-            mCaches->shaderModules.insert(result.Get());
+            mCaches->shaderModules.Insert(result.Get());
         }
 
         return std::move(result);
@@ -632,21 +772,21 @@ namespace dawn_native {
 
     void DeviceBase::UncacheShaderModule(ShaderModuleBase* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->shaderModules.erase(obj);
+        size_t removedCount = mCaches->shaderModules.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
     Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(
         AttachmentStateBlueprint* blueprint) {
-        auto iter = mCaches->attachmentStates.find(blueprint);
-        if (iter != mCaches->attachmentStates.end()) {
-            return static_cast<AttachmentState*>(*iter);
+        AttachmentStateBlueprint* cached = mCaches->attachmentStates.Find(blueprint);
+        if (cached != nullptr) {
+            return static_cast<AttachmentState*>(cached);
         }
 
         Ref<AttachmentState> attachmentState = AcquireRef(new AttachmentState(this, *blueprint));
         attachmentState->SetIsCachedReference();
         attachmentState->SetContentHash(attachmentState->ComputeContentHash());
-        mCaches->attachmentStates.insert(attachmentState.Get());
+        mCaches->attachmentStates.Insert(attachmentState.Get());
         return attachmentState;
     }
 
@@ -676,10 +816,47 @@ namespace dawn_native {
 
     void DeviceBase::UncacheAttachmentState(AttachmentState* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->attachmentStates.erase(obj);
+        size_t removedCount = mCaches->attachmentStates.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
+    CachedObjectsRetentionStats DeviceBase::GetCachedObjectsRetentionStats() const {
+        CachedObjectsRetentionStats stats;
+        stats.bindGroupLayouts = mCachedObjectRetentions->bindGroupLayouts.GetStats();
+        stats.computePipelines = mCachedObjectRetentions->computePipelines.GetStats();
+        stats.renderPipelines = mCachedObjectRetentions->renderPipelines.GetStats();
+        stats.samplers = mCachedObjectRetentions->samplers.GetStats();
+        return stats;
+    }
+
+    ObjectCacheStats DeviceBase::GetTextureViewCacheStats() const {
+        return mTextureViewCacheStats;
+    }
+
+    ElidedCommandStats DeviceBase::GetElidedCommandStats() const {
+        return mElidedCommandStats;
+    }
+
+    void DeviceBase::CountElidedCommand(uint64_t ElidedCommandStats::*counter) {
+        mElidedCommandStats.*counter += 1;
+    }
+
+    void DeviceBase::ReleaseRetainedCachedObjects() {
+        // Pipelines are released first so that the bind group layouts they referenced can be
+        // released in the same pass.
+        mCachedObjectRetentions->renderPipelines.ReleaseRetained();
+        mCachedObjectRetentions->computePipelines.ReleaseRetained();
+        mCachedObjectRetentions->samplers.ReleaseRetained();
+        mCachedObjectRetentions->bindGroupLayouts.ReleaseRetained();
+    }
+
+    void DeviceBase::TrimRetainedCachedObjects() {
+        mCachedObjectRetentions->renderPipelines.Trim();
+        mCachedObjectRetentions->computePipelines.Trim();
+        mCachedObjectRetentions->samplers.Trim();
+        mCachedObjectRetentions->bindGroupLayouts.Trim();
+    }
+
     // Object creation API methods
 
     BindGroupBase* DeviceBase::APICreateBindGroup(const BindGroupDescriptor* descriptor) {
@@ -727,8 +904,7 @@ namespace dawn_native {
         // callback.
         if (maybeResult.IsError()) {
             std::unique_ptr<ErrorData> error = maybeResult.AcquireError();
-            callback(WGPUCreatePipelineAsyncStatus_Error, nullptr, error->GetMessage().c_str(),
-                     userdata);
+            callback(WGPUCreatePipelineAsyncStatus_Error, nullptr, error->GetMessage(), userdata);
         }
     }
     PipelineLayoutBase* DeviceBase::APICreatePipelineLayout(
@@ -760,8 +936,7 @@ namespace dawn_native {
             CreateRenderPipeline(descriptor);
         if (maybeResult.IsError()) {
             std::unique_ptr<ErrorData> error = maybeResult.AcquireError();
-            callback(WGPUCreatePipelineAsyncStatus_Error, nullptr, error->GetMessage().c_str(),
-                     userdata);
+            callback(WGPUCreatePipelineAsyncStatus_Error, nullptr, error->GetMessage(), userdata);
             return;
         }
 
@@ -911,6 +1086,105 @@ namespace dawn_native {
         return result.Detach();
     }
 
+    // Bulk object creation
+
+    void DeviceBase::CreateBuffers(uint32_t count,
+                                   const BufferDescriptor* descriptors,
+                                   BufferBase** buffers) {
+        CreateObjectsInBulk(
+            this, count, descriptors, buffers,
+            [&](uint32_t i) -> MaybeError {
+                DAWN_TRY(ValidateIsAlive());
+                if (IsValidationEnabled()) {
+                    DAWN_TRY(ValidateBufferDescriptor(this, &descriptors[i]));
+                }
+                return {};
+            },
+            [&](uint32_t validCount, const BufferDescriptor* const* validDescriptors,
+                Ref<BufferBase>* results) {
+                return CreateBuffersImpl(validCount, validDescriptors, results);
+            },
+            [&](const BufferDescriptor* descriptor) { return CreateBufferImpl(descriptor); },
+            [&](BufferBase* buffer, uint32_t i) -> MaybeError {
+                if (descriptors[i].mappedAtCreation) {
+                    DAWN_TRY(buffer->MapAtCreation());
+                }
+                return {};
+            },
+            [&](uint32_t i) { return BufferBase::MakeError(this, &descriptors[i]); });
+    }
+
+    void DeviceBase::CreateTextures(uint32_t count,
+                                    const TextureDescriptor* descriptors,
+                                    TextureBase** textures) {
+        std::vector<TextureDescriptor> fixedDescriptors(descriptors, descriptors + count);
+        CreateObjectsInBulk(
+            this, count, fixedDescriptors.data(), textures,
+            [&](uint32_t i) -> MaybeError {
+                DAWN_TRY(ValidateIsAlive());
+                DAWN_TRY(FixUpDeprecatedGPUExtent3DDepth(this, &fixedDescriptors[i].size));
+                if (IsValidationEnabled()) {
+                    DAWN_TRY(ValidateTextureDescriptor(this, &fixedDescriptors[i]));
+                }
+                return {};
+            },
+            [&](uint32_t validCount, const TextureDescriptor* const* validDescriptors,
+                Ref<TextureBase>* results) {
+                return CreateTexturesImpl(validCount, validDescriptors, results);
+            },
+            [&](const TextureDescriptor* descriptor) { return CreateTextureImpl(descriptor); },
+            [](TextureBase*, uint32_t) -> MaybeError { return {}; },
+            [&](uint32_t) { return TextureBase::MakeError(this); });
+    }
+
+    void DeviceBase::CreateBindGroups(uint32_t count,
+                                      const BindGroupDescriptor* descriptors,
+                                      BindGroupBase** bindGroups) {
+        CreateObjectsInBulk(
+            this, count, descriptors, bindGroups,
+            [&](uint32_t i) -> MaybeError {
+                DAWN_TRY(ValidateIsAlive());
+                if (IsValidationEnabled()) {
+                    DAWN_TRY(ValidateBindGroupDescriptor(this, &descriptors[i]));
+                }
+                return {};
+            },
+            [&](uint32_t validCount, const BindGroupDescriptor* const* validDescriptors,
+                Ref<BindGroupBase>* results) {
+                return CreateBindGroupsImpl(validCount, validDescriptors, results);
+            },
+            [&](const BindGroupDescriptor* descriptor) { return CreateBindGroupImpl(descriptor); },
+            [](BindGroupBase*, uint32_t) -> MaybeError { return {}; },
+            [&](uint32_t) { return BindGroupBase::MakeError(this); });
+    }
+
+    MaybeError DeviceBase::CreateBindGroupsImpl(uint32_t count,
+                                                const BindGroupDescriptor* const* descriptors,
+                                                Ref<BindGroupBase>* bindGroups) {
+        for (uint32_t i = 0; i < count; ++i) {
+            DAWN_TRY_ASSIGN(bindGroups[i], CreateBindGroupImpl(descriptors[i]));
+        }
+        return {};
+    }
+
+    MaybeError DeviceBase::CreateBuffersImpl(uint32_t count,
+                                             const BufferDescriptor* const* descriptors,
+                                             Ref<BufferBase>* buffers) {
+        for (uint32_t i = 0; i < count; ++i) {
+            DAWN_TRY_ASSIGN(buffers[i], CreateBufferImpl(descriptors[i]));
+        }
+        return {};
+    }
+
+    MaybeError DeviceBase::CreateTexturesImpl(uint32_t count,
+                                              const TextureDescriptor* const* descriptors,
+                                              Ref<TextureBase>* textures) {
+        for (uint32_t i = 0; i < count; ++i) {
+            DAWN_TRY_ASSIGN(textures[i], CreateTextureImpl(descriptors[i]));
+        }
+        return {};
+    }
+
     // For Dawn Wire
 
     BufferBase* DeviceBase::APICreateErrorBuffer() {
@@ -931,6 +1205,9 @@ namespace dawn_native {
     MaybeError DeviceBase::Tick() {
         DAWN_TRY(ValidateIsAlive());
 
+        // Released cached objects are evicted even when there is no GPU work in flight.
+        TrimRetainedCachedObjects();
+
         // to avoid overly ticking, we only want to tick when:
         // 1. the last submitted serial has moved beyond the completed serial
         // 2. or the completed serial has not reached the future serial set by the trackers
@@ -958,6 +1235,40 @@ namespace dawn_native {
         return {};
     }
 
+    ResultOrError<bool> DeviceBase::WaitForSerial(ExecutionSerial serial, uint64_t timeoutNs) {
+        // Serials past the last submitted one complete when all the submitted work does.
+        ASSERT(serial <= std::max(mLastSubmittedSerial, mFutureSerial));
+
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point start = Clock::now();
+
+        while (true) {
+            // Ticking submits the pending commands so that they can be waited on, updates the
+            // completed serial and fires the callbacks of the completed work.
+            DAWN_TRY(Tick());
+            if (mCompletedSerial >= serial) {
+                return true;
+            }
+
+            uint64_t elapsedNs = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start)
+                    .count());
+            if (elapsedNs >= timeoutNs) {
+                return false;
+            }
+
+            DAWN_TRY(WaitForSerialImpl(std::min(serial, mLastSubmittedSerial),
+                                       timeoutNs - elapsedNs));
+        }
+    }
+
+    MaybeError DeviceBase::WaitForSerialImpl(ExecutionSerial serial, uint64_t timeoutNs) {
+        constexpr uint64_t kPollingIntervalNs = 100 * 1000;
+        std::this_thread::sleep_for(
+            std::chrono::nanoseconds(std::min(timeoutNs, kPollingIntervalNs)));
+        return {};
+    }
+
     QueueBase* DeviceBase::APIGetQueue() {
         // Backends gave the primary queue during initialization.
         ASSERT(mQueue != nullptr);
@@ -1071,6 +1382,9 @@ namespace dawn_native {
         DAWN_TRY(ValidateIsAlive());
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateComputePipelineDescriptor(this, descriptor));
+        } else {
+            DAWN_TRY(descriptor->computeStage.module->ReflectEntryPoint(
+                descriptor->computeStage.entryPoint));
         }
 
         // Ref will keep the pipeline layout alive until the end of the function where
@@ -1098,6 +1412,9 @@ namespace dawn_native {
         DAWN_TRY(ValidateIsAlive());
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateComputePipelineDescriptor(this, descriptor));
+        } else {
+            DAWN_TRY(descriptor->computeStage.module->ReflectEntryPoint(
+                descriptor->computeStage.entryPoint));
         }
 
         // Ref will keep the pipeline layout alive until the end of the function where
@@ -1205,6 +1522,10 @@ namespace dawn_native {
         DAWN_TRY(ValidateIsAlive());
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateRenderPipelineDescriptor(this, descriptor));
+        } else {
+            for (const StageAndDescriptor& stage : GetStages(descriptor)) {
+                DAWN_TRY(stage.module->ReflectEntryPoint(stage.entryPoint));
+            }
         }
 
         if (descriptor->layout == nullptr) {
@@ -1304,7 +1625,18 @@ namespace dawn_native {
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateTextureViewDescriptor(this, texture, &desc));
         }
-        return CreateTextureViewImpl(texture, &desc);
+
+        // Views are immutable so a live view with the same descriptor can be returned instead.
+        if (TextureViewBase* cachedView = texture->GetCachedView(desc)) {
+            mTextureViewCacheStats.hits++;
+            return Ref<TextureViewBase>(cachedView);
+        }
+        mTextureViewCacheStats.misses++;
+
+        Ref<TextureViewBase> view;
+        DAWN_TRY_ASSIGN(view, CreateTextureViewImpl(texture, &desc));
+        texture->AddCachedView(desc, view.Get());
+        return std::move(view);
     }
 
     // Other implementation details
@@ -29,6 +29,10 @@
 #include <memory>
 #include <utility>
 
+namespace dawn_platform {
+    class WorkerTaskPool;
+}  // namespace dawn_platform
+
 namespace dawn_native {
     class AdapterBase;
     class AttachmentState;
@@ -74,6 +78,10 @@ namespace dawn_native {
         AdapterBase* GetAdapter() const;
         dawn_platform::Platform* GetPlatform() const;
 
+        // Returns the worker task pool of the platform, or of the default platform when none is
+        // set. It is created on first use.
+        dawn_platform::WorkerTaskPool* GetWorkerTaskPool();
+
         // Returns the Format corresponding to the wgpu::TextureFormat or an error if the format
         // isn't a valid wgpu::TextureFormat or isn't supported by this device.
         // The pointer returned has the same lifetime as the device.
@@ -140,6 +148,19 @@ namespace dawn_native {
         Ref<AttachmentState> GetOrCreateAttachmentState(const RenderPassDescriptor* descriptor);
         void UncacheAttachmentState(AttachmentState* obj);
 
+        // Released bind group layouts, pipelines and samplers can be kept alive for a while, with
+        // a budget given in the DeviceDescriptor, so that recreating them is a cache hit.
+        CachedObjectsRetentionStats GetCachedObjectsRetentionStats() const;
+        void ReleaseRetainedCachedObjects();
+
+        // Creating a view equal to a live view of the same texture returns the existing view.
+        ObjectCacheStats GetTextureViewCacheStats() const;
+
+        // Pass encoders skip the commands setting state that is already set, and count them with
+        // CountElidedCommand(&ElidedCommandStats::setBindGroup) for example.
+        ElidedCommandStats GetElidedCommandStats() const;
+        void CountElidedCommand(uint64_t ElidedCommandStats::*counter);
+
         // Object creation methods that be used in a reentrant manner.
         ResultOrError<Ref<BindGroupBase>> CreateBindGroup(const BindGroupDescriptor* descriptor);
         ResultOrError<Ref<BindGroupLayoutBase>> CreateBindGroupLayout(
@@ -195,7 +216,23 @@ namespace dawn_native {
         SwapChainBase* APICreateSwapChain(Surface* surface, const SwapChainDescriptor* descriptor);
         TextureBase* APICreateTexture(const TextureDescriptor* descriptor);
 
+        // Create |count| objects at once, for example when loading a scene. Each descriptor is
+        // validated and its errors are reported like for the single object creation, producing
+        // an error object, but all the valid objects are created by the backend in one batch.
+        void CreateBuffers(uint32_t count,
+                           const BufferDescriptor* descriptors,
+                           BufferBase** buffers);
+        void CreateTextures(uint32_t count,
+                            const TextureDescriptor* descriptors,
+                            TextureBase** textures);
+        void CreateBindGroups(uint32_t count,
+                              const BindGroupDescriptor* descriptors,
+                              BindGroupBase** bindGroups);
+
         InternalPipelineStore* GetInternalPipelineStore();
+        // Creates the internal pipelines ahead of their first use, and lets the backend persist
+        // the result of their compilation.
+        MaybeError WarmInternalPipelines();
 
         // For Dawn Wire
         BufferBase* APICreateErrorBuffer();
@@ -277,6 +314,11 @@ namespace dawn_native {
 
         MaybeError Tick();
 
+        // Blocks until |serial| is completed or |timeoutNs| nanoseconds have passed, ticking the
+        // device to submit the pending commands and to fire the callbacks of the completed work.
+        // Returns whether |serial| is completed.
+        ResultOrError<bool> WaitForSerial(ExecutionSerial serial, uint64_t timeoutNs);
+
         virtual uint32_t GetOptimalBytesPerRowAlignment() const = 0;
         virtual uint64_t GetOptimalBufferToTextureCopyOffsetAlignment() const = 0;
 
@@ -325,8 +367,31 @@ namespace dawn_native {
             TextureBase* texture,
             const TextureViewDescriptor* descriptor) = 0;
 
+        // Create the objects of already validated descriptors in a batch. The default
+        // implementations create them one by one. When they return an error, the objects are
+        // created again one by one so that the error is reported for the object that caused it.
+        virtual MaybeError CreateBindGroupsImpl(uint32_t count,
+                                                const BindGroupDescriptor* const* descriptors,
+                                                Ref<BindGroupBase>* bindGroups);
+        virtual MaybeError CreateBuffersImpl(uint32_t count,
+                                             const BufferDescriptor* const* descriptors,
+                                             Ref<BufferBase>* buffers);
+        virtual MaybeError CreateTexturesImpl(uint32_t count,
+                                              const TextureDescriptor* const* descriptors,
+                                              Ref<TextureBase>* textures);
+
         virtual MaybeError TickImpl() = 0;
 
+        // Blocks until the GPU completed |serial| or |timeoutNs| nanoseconds have passed, without
+        // updating the completed serial. The default implementation only sleeps for a short time
+        // and is used by backends that have nothing to block on.
+        virtual MaybeError WaitForSerialImpl(ExecutionSerial serial, uint64_t timeoutNs);
+
+        // Lets the backend store its pipeline cache in the PersistentCache. Backends without a
+        // pipeline cache either persist their shaders as they compile them, or don't persist
+        // anything.
+        virtual MaybeError PersistPipelineCacheImpl();
+
         ResultOrError<Ref<BindGroupLayoutBase>> CreateEmptyBindGroupLayout();
 
         ResultOrError<Ref<PipelineLayoutBase>> ValidateAndGetComputePipelineDescriptorWithDefaults(
@@ -386,6 +451,7 @@ namespace dawn_native {
         void* mDeviceLostUserdata = nullptr;
 
         std::unique_ptr<ErrorScopeStack> mErrorScopeStack;
+        std::unique_ptr<ScopedErrorBacktraces> mErrorBacktraces;
 
         // The Device keeps a ref to the Instance so that any live Device keeps the Instance alive.
         // The Instance shouldn't need to ref child objects so this shouldn't introduce ref cycles.
@@ -399,6 +465,13 @@ namespace dawn_native {
         struct Caches;
         std::unique_ptr<Caches> mCaches;
 
+        struct CachedObjectRetentions;
+        std::unique_ptr<CachedObjectRetentions> mCachedObjectRetentions;
+        void TrimRetainedCachedObjects();
+
+        ObjectCacheStats mTextureViewCacheStats;
+        ElidedCommandStats mElidedCommandStats;
+
         Ref<BindGroupLayoutBase> mEmptyBindGroupLayout;
 
         std::unique_ptr<DynamicUploader> mDynamicUploader;
@@ -421,6 +494,8 @@ namespace dawn_native {
         std::unique_ptr<InternalPipelineStore> mInternalPipelineStore;
 
         std::unique_ptr<PersistentCache> mPersistentCache;
+
+        std::unique_ptr<dawn_platform::WorkerTaskPool> mWorkerTaskPool;
     };
 
 }  // namespace dawn_native
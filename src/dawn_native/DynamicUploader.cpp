@@ -16,6 +16,8 @@
 #include "common/Math.h"
 #include "dawn_native/Device.h"
 
+#include <algorithm>
+
 namespace dawn_native {
 
     DynamicUploader::DynamicUploader(DeviceBase* device) : mDevice(device) {
@@ -110,6 +112,76 @@ namespace dawn_native {
         mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
     }
 
+    ResultOrError<DynamicUploader::MapAtCreationChunk*> DynamicUploader::CreateMapAtCreationChunk(
+        uint64_t size) {
+        std::unique_ptr<MapAtCreationChunk> chunk = std::make_unique<MapAtCreationChunk>();
+        DAWN_TRY_ASSIGN(chunk->stagingBuffer, mDevice->CreateStagingBuffer(size));
+        mMapAtCreationChunks.push_back(std::move(chunk));
+        return mMapAtCreationChunks.back().get();
+    }
+
+    void DynamicUploader::ReleaseMapAtCreationChunkIfUnused(MapAtCreationChunk* chunk) {
+        // The current chunk is kept even when it is unused so that creating and unmapping buffers
+        // one at a time doesn't create a staging buffer for each of them.
+        if (chunk->allocationCount != 0 || chunk == mCurrentMapAtCreationChunk) {
+            return;
+        }
+
+        // The copies from the chunk were recorded at serials up to the pending one.
+        ReleaseStagingBuffer(std::move(chunk->stagingBuffer));
+
+        auto it = std::find_if(
+            mMapAtCreationChunks.begin(), mMapAtCreationChunks.end(),
+            [chunk](const std::unique_ptr<MapAtCreationChunk>& c) { return c.get() == chunk; });
+        ASSERT(it != mMapAtCreationChunks.end());
+        mMapAtCreationChunks.erase(it);
+    }
+
+    ResultOrError<UploadHandle> DynamicUploader::AllocateForMapAtCreation(
+        uint64_t allocationSize) {
+        MapAtCreationChunk* chunk = nullptr;
+        uint64_t alignedSize = Align(allocationSize, kMapAtCreationAlignment);
+
+        if (allocationSize > kMaxMapAtCreationSubAllocationSize) {
+            // Large allocations get a staging buffer of their own.
+            DAWN_TRY_ASSIGN(chunk, CreateMapAtCreationChunk(allocationSize));
+        } else {
+            if (mCurrentMapAtCreationChunk == nullptr ||
+                mCurrentMapAtCreationChunk->usedSize + alignedSize > kMapAtCreationChunkSize) {
+                MapAtCreationChunk* previousChunk = mCurrentMapAtCreationChunk;
+                DAWN_TRY_ASSIGN(mCurrentMapAtCreationChunk,
+                                CreateMapAtCreationChunk(kMapAtCreationChunkSize));
+                if (previousChunk != nullptr) {
+                    ReleaseMapAtCreationChunkIfUnused(previousChunk);
+                }
+            }
+            chunk = mCurrentMapAtCreationChunk;
+        }
+
+        UploadHandle uploadHandle;
+        uploadHandle.stagingBuffer = chunk->stagingBuffer.get();
+        uploadHandle.startOffset = chunk->usedSize;
+        uploadHandle.mappedBuffer =
+            static_cast<uint8_t*>(uploadHandle.stagingBuffer->GetMappedPointer()) +
+            uploadHandle.startOffset;
+
+        chunk->usedSize += alignedSize;
+        chunk->allocationCount++;
+        return uploadHandle;
+    }
+
+    void DynamicUploader::ReleaseForMapAtCreation(const UploadHandle& uploadHandle) {
+        for (const std::unique_ptr<MapAtCreationChunk>& chunk : mMapAtCreationChunks) {
+            if (chunk->stagingBuffer.get() == uploadHandle.stagingBuffer) {
+                ASSERT(chunk->allocationCount > 0);
+                chunk->allocationCount--;
+                ReleaseMapAtCreationChunkIfUnused(chunk.get());
+                return;
+            }
+        }
+        UNREACHABLE();
+    }
+
     // TODO(dawn:512): Optimize this function so that it doesn't allocate additional memory
     // when it's not necessary.
     ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize,
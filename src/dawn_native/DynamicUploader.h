@@ -46,19 +46,44 @@ namespace dawn_native {
                                              uint64_t offsetAlignment);
         void Deallocate(ExecutionSerial lastCompletedSerial);
 
+        // Allocate the staging memory of a buffer mapped at creation that isn't CPU writable.
+        // Small allocations share staging buffers so that creating many small buffers doesn't
+        // create as many staging buffers. The copy from the staging memory is recorded when the
+        // buffer is unmapped, at a serial that isn't known yet, so the allocation must be released
+        // explicitly after the copy is recorded, or when the buffer is destroyed without a copy.
+        ResultOrError<UploadHandle> AllocateForMapAtCreation(uint64_t allocationSize);
+        void ReleaseForMapAtCreation(const UploadHandle& uploadHandle);
+
       private:
         static constexpr uint64_t kRingBufferSize = 4 * 1024 * 1024;
 
+        // Staging buffers for buffers mapped at creation are bump-allocated in chunks, and
+        // released once all their allocations are released and they aren't the current chunk.
+        static constexpr uint64_t kMapAtCreationChunkSize = 4 * 1024 * 1024;
+        static constexpr uint64_t kMaxMapAtCreationSubAllocationSize = 256 * 1024;
+        static constexpr uint64_t kMapAtCreationAlignment = 16;
+
         struct RingBuffer {
             std::unique_ptr<StagingBufferBase> mStagingBuffer;
             RingBufferAllocator mAllocator;
         };
 
+        struct MapAtCreationChunk {
+            std::unique_ptr<StagingBufferBase> stagingBuffer;
+            uint64_t usedSize = 0;
+            uint32_t allocationCount = 0;
+        };
+
+        ResultOrError<MapAtCreationChunk*> CreateMapAtCreationChunk(uint64_t size);
+        void ReleaseMapAtCreationChunkIfUnused(MapAtCreationChunk* chunk);
+
         ResultOrError<UploadHandle> AllocateInternal(uint64_t allocationSize,
                                                      ExecutionSerial serial);
 
         std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
         SerialQueue<ExecutionSerial, std::unique_ptr<StagingBufferBase>> mReleasedStagingBuffers;
+        std::vector<std::unique_ptr<MapAtCreationChunk>> mMapAtCreationChunks;
+        MapAtCreationChunk* mCurrentMapAtCreationChunk = nullptr;
         DeviceBase* mDevice;
     };
 }  // namespace dawn_native
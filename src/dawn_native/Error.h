@@ -46,6 +46,10 @@ namespace dawn_native {
     // but shorthand version for specific error types are preferred:
     //   return DAWN_VALIDATION_ERROR("My error message");
     //
+    // String literal messages are kept by pointer while other messages are copied in the error, so
+    // literals should be preferred on paths that applications can hit often. Other const char
+    // arrays are also kept by pointer and must outlive the error.
+    //
     // There are different types of errors that should be used for different purpose:
     //
     //   - Validation: these are errors that show the user did something bad, which causes the
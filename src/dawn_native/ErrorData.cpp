@@ -14,26 +14,106 @@
 
 #include "dawn_native/ErrorData.h"
 
+#include "common/Assert.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/dawn_platform.h"
 
+#include <array>
+#include <atomic>
+
 namespace dawn_native {
 
+    namespace {
+
+        std::atomic<uint32_t> gBacktraceScopeCount{0};
+
+        // Keeps the memory of a few deleted ErrorData per thread so that creating errors in a
+        // loop doesn't go through the heap each time.
+        class ErrorDataCache {
+          public:
+            ~ErrorDataCache() {
+                for (size_t i = 0; i < mCount; ++i) {
+                    ::operator delete(mBlocks[i]);
+                }
+                // Errors destroyed later during thread exit bypass the cache.
+                mCount = 0;
+                mDestroyed = true;
+            }
+
+            void* Allocate() {
+                if (mCount == 0) {
+                    return ::operator new(sizeof(ErrorData));
+                }
+                return mBlocks[--mCount];
+            }
+
+            void Deallocate(void* ptr) {
+                if (mDestroyed || mCount == mBlocks.size()) {
+                    ::operator delete(ptr);
+                    return;
+                }
+                mBlocks[mCount++] = ptr;
+            }
+
+          private:
+            std::array<void*, 8> mBlocks;
+            size_t mCount = 0;
+            bool mDestroyed = false;
+        };
+
+        thread_local ErrorDataCache tErrorDataCache;
+
+    }  // anonymous namespace
+
+    // static
     std::unique_ptr<ErrorData> ErrorData::Create(InternalErrorType type,
                                                  std::string message,
                                                  const char* file,
                                                  const char* function,
                                                  int line) {
-        std::unique_ptr<ErrorData> error = std::make_unique<ErrorData>(type, message);
+        std::unique_ptr<ErrorData> error = std::make_unique<ErrorData>(type, std::move(message));
+        error->AppendBacktrace(file, function, line);
+        return error;
+    }
+
+    // static
+    std::unique_ptr<ErrorData> ErrorData::CreateWithStaticMessage(InternalErrorType type,
+                                                                  const char* message,
+                                                                  const char* file,
+                                                                  const char* function,
+                                                                  int line) {
+        std::unique_ptr<ErrorData> error(new ErrorData(type, message));
         error->AppendBacktrace(file, function, line);
         return error;
     }
 
     ErrorData::ErrorData(InternalErrorType type, std::string message)
-        : mType(type), mMessage(std::move(message)) {
+        : mType(type), mOwnedMessage(std::move(message)) {
+        mMessage = mOwnedMessage.c_str();
+    }
+
+    ErrorData::ErrorData(InternalErrorType type, const char* staticMessage)
+        : mType(type), mMessage(staticMessage) {
+    }
+
+    // static
+    void* ErrorData::operator new(size_t size) {
+        ASSERT(size == sizeof(ErrorData));
+        return tErrorDataCache.Allocate();
+    }
+
+    // static
+    void ErrorData::operator delete(void* ptr) {
+        if (ptr != nullptr) {
+            tErrorDataCache.Deallocate(ptr);
+        }
     }
 
     void ErrorData::AppendBacktrace(const char* file, const char* function, int line) {
+        if (!AreBacktracesEnabled()) {
+            return;
+        }
+
         BacktraceRecord record;
         record.file = file;
         record.function = function;
@@ -46,7 +126,7 @@ namespace dawn_native {
         return mType;
     }
 
-    const std::string& ErrorData::GetMessage() const {
+    const char* ErrorData::GetMessage() const {
         return mMessage;
     }
 
@@ -54,4 +134,18 @@ namespace dawn_native {
         return mBacktrace;
     }
 
+    // static
+    bool ErrorData::AreBacktracesEnabled() {
+        return gBacktraceScopeCount.load(std::memory_order_relaxed) != 0;
+    }
+
+    ScopedErrorBacktraces::ScopedErrorBacktraces() {
+        gBacktraceScopeCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ScopedErrorBacktraces::~ScopedErrorBacktraces() {
+        ASSERT(gBacktraceScopeCount.load(std::memory_order_relaxed) > 0);
+        gBacktraceScopeCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
 }  // namespace dawn_native
@@ -17,6 +17,7 @@
 
 #include "common/Compiler.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -33,6 +34,10 @@ namespace dawn {
 namespace dawn_native {
     enum class InternalErrorType : uint32_t;
 
+    // Errors are created often by code probing for failures, so creating one shouldn't allocate:
+    // string literal messages are kept by pointer instead of being copied, ErrorData are recycled
+    // through a small per-thread cache, and backtraces are only recorded when enabled (see
+    // ScopedErrorBacktraces).
     class DAWN_NO_DISCARD ErrorData {
       public:
         static DAWN_NO_DISCARD std::unique_ptr<ErrorData> Create(InternalErrorType type,
@@ -40,7 +45,32 @@ namespace dawn_native {
                                                                  const char* file,
                                                                  const char* function,
                                                                  int line);
+        // String literals can't be told apart from other const char arrays, so const char array
+        // messages are kept by pointer and must have static storage duration.
+        template <size_t N>
+        static DAWN_NO_DISCARD std::unique_ptr<ErrorData> Create(InternalErrorType type,
+                                                                 const char (&message)[N],
+                                                                 const char* file,
+                                                                 const char* function,
+                                                                 int line) {
+            return CreateWithStaticMessage(type, message, file, function, line);
+        }
+        // Non-const char arrays, like buffers formatted on the stack, are copied.
+        template <size_t N>
+        static DAWN_NO_DISCARD std::unique_ptr<ErrorData> Create(InternalErrorType type,
+                                                                 char (&message)[N],
+                                                                 const char* file,
+                                                                 const char* function,
+                                                                 int line) {
+            return Create(type, std::string(message), file, function, line);
+        }
+
         ErrorData(InternalErrorType type, std::string message);
+        ErrorData(const ErrorData&) = delete;
+        ErrorData& operator=(const ErrorData&) = delete;
+
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr);
 
         struct BacktraceRecord {
             const char* file;
@@ -50,15 +80,41 @@ namespace dawn_native {
         void AppendBacktrace(const char* file, const char* function, int line);
 
         InternalErrorType GetType() const;
-        const std::string& GetMessage() const;
+        const char* GetMessage() const;
         const std::vector<BacktraceRecord>& GetBacktrace() const;
 
+        static bool AreBacktracesEnabled();
+
       private:
+        friend class ScopedErrorBacktraces;
+
+        ErrorData(InternalErrorType type, const char* staticMessage);
+
+        static std::unique_ptr<ErrorData> CreateWithStaticMessage(InternalErrorType type,
+                                                                  const char* message,
+                                                                  const char* file,
+                                                                  const char* function,
+                                                                  int line);
+
         InternalErrorType mType;
-        std::string mMessage;
+        // Either points to a string literal, or to the contents of mOwnedMessage.
+        const char* mMessage;
+        std::string mOwnedMessage;
         std::vector<BacktraceRecord> mBacktrace;
     };
 
+    // Backtraces are recorded for all errors while at least one ScopedErrorBacktraces is alive.
+    // Devices with the record_error_backtraces toggle keep one for their lifetime, which enables
+    // backtraces for the errors of every device in the process, not only their own.
+    class ScopedErrorBacktraces {
+      public:
+        ScopedErrorBacktraces();
+        ~ScopedErrorBacktraces();
+
+        ScopedErrorBacktraces(const ScopedErrorBacktraces&) = delete;
+        ScopedErrorBacktraces& operator=(const ScopedErrorBacktraces&) = delete;
+    };
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_ERRORDATA_H_
@@ -56,7 +56,29 @@ namespace dawn_native {
              {Extension::DepthClamping,
               {"depth_clamping", "Clamp depth to [0, 1] in NDC space instead of clipping",
                "https://bugs.chromium.org/p/dawn/issues/detail?id=716"},
-              &WGPUDeviceProperties::depthClamping}}};
+              &WGPUDeviceProperties::depthClamping},
+             {Extension::TextureDataConversion,
+              {"texture_data_conversion",
+               "Write RGB8, RGBA8 or BGRA8 data to RGBA8 and BGRA8 textures with "
+               "Queue::WriteTexture, converting it on the GPU",
+               ""},
+              &WGPUDeviceProperties::textureDataConversion},
+             {Extension::MultiDrawIndirect,
+              {"multi_draw_indirect",
+               "Issue several indexed indirect draws from consecutive arguments in a buffer with "
+               "a single MultiDrawIndexedIndirect command",
+               ""},
+              &WGPUDeviceProperties::multiDrawIndirect},
+             {Extension::DrawIndirectCount,
+              {"draw_indirect_count",
+               "Read the number of draws of MultiDrawIndexedIndirect from a GPU buffer", ""},
+              &WGPUDeviceProperties::drawIndirectCount},
+             {Extension::ImmediateData,
+              {"immediate_data",
+               "Set a small range of data read by the shaders with SetImmediateData instead of "
+               "updating uniform buffers",
+               ""},
+              &WGPUDeviceProperties::immediateData}}};
 
     }  // anonymous namespace
 
@@ -30,6 +30,10 @@ namespace dawn_native {
         TimestampQuery,
         MultiPlanarFormats,
         DepthClamping,
+        TextureDataConversion,
+        MultiDrawIndirect,
+        DrawIndirectCount,
+        ImmediateData,
 
         EnumCount,
         InvalidEnum = EnumCount,
@@ -0,0 +1,79 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_IMMEDIATEDATATRACKER_H_
+#define DAWNNATIVE_IMMEDIATEDATATRACKER_H_
+
+#include "common/Assert.h"
+#include "common/Constants.h"
+#include "dawn_native/Commands.h"
+#include "dawn_native/Pipeline.h"
+#include "dawn_native/PipelineLayout.h"
+
+#include <array>
+#include <cstring>
+
+namespace dawn_native {
+
+    // Keeps a copy of the immediate data so that it can be lazily applied before draws and
+    // dispatches, when the pipeline layout is known. Backends set it again whenever the pipeline
+    // layout changes, since their immediate data is tied to the layout.
+    class ImmediateDataTracker {
+      public:
+        void OnSetImmediateData(const SetImmediateDataCmd* cmd, const uint8_t* data) {
+            ASSERT(cmd->offset + cmd->size <= kMaxImmediateDataSize);
+            memcpy(mData.data() + cmd->offset, data, cmd->size);
+            mDirty = true;
+        }
+
+        void OnSetPipeline(PipelineBase* pipeline) {
+            mPipelineLayout = pipeline->GetLayout();
+            if (mPipelineLayout != mLastAppliedPipelineLayout) {
+                mDirty = true;
+            }
+        }
+
+        // Returns the size of the data to apply for the current pipeline layout, or 0 if it
+        // doesn't need to be applied again.
+        uint32_t GetDirtySize() const {
+            if (!mDirty || mPipelineLayout == nullptr) {
+                return 0;
+            }
+            return mPipelineLayout->GetImmediateDataSize();
+        }
+
+        const uint8_t* GetData() const {
+            return mData.data();
+        }
+
+        PipelineLayoutBase* GetPipelineLayout() const {
+            return mPipelineLayout;
+        }
+
+        // The backend should call this after applying GetDirtySize() bytes of the data.
+        void DidApply() {
+            mDirty = false;
+            mLastAppliedPipelineLayout = mPipelineLayout;
+        }
+
+      private:
+        std::array<uint8_t, kMaxImmediateDataSize> mData = {};
+        bool mDirty = false;
+        PipelineLayoutBase* mPipelineLayout = nullptr;
+        PipelineLayoutBase* mLastAppliedPipelineLayout = nullptr;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_IMMEDIATEDATATRACKER_H_
@@ -19,6 +19,8 @@
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/Surface.h"
 
+#include <future>
+
 #if defined(DAWN_USE_X11)
 #    include "dawn_native/XlibXcbFunctions.h"
 #endif  // defined(DAWN_USE_X11)
@@ -53,6 +55,91 @@ namespace dawn_native {
     }
 #endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
 
+    namespace {
+
+        // The backend types that have been compiled, in the order in which their adapters are
+        // listed.
+        std::vector<wgpu::BackendType> GetCompiledBackendTypes() {
+            std::vector<wgpu::BackendType> backendTypes;
+#if defined(DAWN_ENABLE_BACKEND_D3D12)
+            backendTypes.push_back(wgpu::BackendType::D3D12);
+#endif  // defined(DAWN_ENABLE_BACKEND_D3D12)
+#if defined(DAWN_ENABLE_BACKEND_METAL)
+            backendTypes.push_back(wgpu::BackendType::Metal);
+#endif  // defined(DAWN_ENABLE_BACKEND_METAL)
+#if defined(DAWN_ENABLE_BACKEND_VULKAN)
+            backendTypes.push_back(wgpu::BackendType::Vulkan);
+#endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
+#if defined(DAWN_ENABLE_BACKEND_OPENGL)
+            backendTypes.push_back(wgpu::BackendType::OpenGL);
+            backendTypes.push_back(wgpu::BackendType::OpenGLES);
+#endif  // defined(DAWN_ENABLE_BACKEND_OPENGL)
+#if defined(DAWN_ENABLE_BACKEND_NULL)
+            backendTypes.push_back(wgpu::BackendType::Null);
+#endif  // defined(DAWN_ENABLE_BACKEND_NULL)
+            return backendTypes;
+        }
+
+        // Creates the connections to the backends of the given type. This doesn't modify the
+        // instance so it can run concurrently for different backend types.
+        std::vector<std::unique_ptr<BackendConnection>> ConnectBackend(
+            InstanceBase* instance,
+            wgpu::BackendType backendType) {
+            std::vector<std::unique_ptr<BackendConnection>> connections;
+            auto Register = [&](BackendConnection* connection) {
+                if (connection != nullptr) {
+                    ASSERT(connection->GetType() == backendType);
+                    ASSERT(connection->GetInstance() == instance);
+                    connections.push_back(std::unique_ptr<BackendConnection>(connection));
+                }
+            };
+
+            switch (backendType) {
+#if defined(DAWN_ENABLE_BACKEND_D3D12)
+                case wgpu::BackendType::D3D12:
+                    Register(d3d12::Connect(instance));
+                    break;
+#endif  // defined(DAWN_ENABLE_BACKEND_D3D12)
+#if defined(DAWN_ENABLE_BACKEND_METAL)
+                case wgpu::BackendType::Metal:
+                    Register(metal::Connect(instance));
+                    break;
+#endif  // defined(DAWN_ENABLE_BACKEND_METAL)
+#if defined(DAWN_ENABLE_BACKEND_VULKAN)
+                case wgpu::BackendType::Vulkan:
+                    // TODO(https://github.com/KhronosGroup/Vulkan-Loader/issues/287):
+                    // When we can load SwiftShader in parallel with the system driver, we should
+                    // create the backend only once and expose SwiftShader as an additional
+                    // adapter. For now, we create two VkInstances, one from SwiftShader, and one
+                    // from the system. Note: If the Vulkan driver *is* SwiftShader, then this
+                    // would load SwiftShader twice. Both connections are made one after the other
+                    // because they set process-wide environment variables.
+                    Register(vulkan::Connect(instance, false));
+#    if defined(DAWN_ENABLE_SWIFTSHADER)
+                    Register(vulkan::Connect(instance, true));
+#    endif  // defined(DAWN_ENABLE_SWIFTSHADER)
+                    break;
+#endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
+#if defined(DAWN_ENABLE_BACKEND_OPENGL)
+                case wgpu::BackendType::OpenGL:
+                case wgpu::BackendType::OpenGLES:
+                    Register(opengl::Connect(instance, backendType));
+                    break;
+#endif  // defined(DAWN_ENABLE_BACKEND_OPENGL)
+#if defined(DAWN_ENABLE_BACKEND_NULL)
+                case wgpu::BackendType::Null:
+                    Register(null::Connect(instance));
+                    break;
+#endif  // defined(DAWN_ENABLE_BACKEND_NULL)
+                default:
+                    break;
+            }
+
+            return connections;
+        }
+
+    }  // anonymous namespace
+
     // InstanceBase
 
     // static
@@ -69,25 +156,84 @@ namespace dawn_native {
     }
 
     void InstanceBase::DiscoverDefaultAdapters() {
-        EnsureBackendConnections();
+        DiscoverDefaultAdaptersInternal(GetCompiledBackendTypes());
+    }
 
-        if (mDiscoveredDefaultAdapters) {
-            return;
+    void InstanceBase::DiscoverDefaultAdapters(wgpu::BackendType backendType) {
+        DiscoverDefaultAdaptersInternal({backendType});
+    }
+
+    void InstanceBase::DiscoverDefaultAdaptersInternal(
+        const std::vector<wgpu::BackendType>& backendTypes) {
+        struct BackendDiscovery {
+            wgpu::BackendType type;
+            bool needsConnection;
+            std::vector<std::unique_ptr<BackendConnection>> newBackends;
+            std::vector<std::unique_ptr<AdapterBase>> adapters;
+        };
+
+        std::vector<BackendDiscovery> discoveries;
+        for (wgpu::BackendType type : backendTypes) {
+            if (mDiscoveredDefaultAdapterTypes.count(type) == 0) {
+                discoveries.push_back({type, mConnectedBackendTypes.count(type) == 0, {}, {}});
+            }
         }
 
-        // Query and merge all default adapters for all backends
-        for (std::unique_ptr<BackendConnection>& backend : mBackends) {
-            std::vector<std::unique_ptr<AdapterBase>> backendAdapters =
-                backend->DiscoverDefaultAdapters();
+        // The Vulkan backend sets process-wide environment variables while it connects, which
+        // would race with the other backends, so it is connected before any of them starts.
+        for (BackendDiscovery& discovery : discoveries) {
+            if (discovery.type == wgpu::BackendType::Vulkan && discovery.needsConnection) {
+                discovery.newBackends = ConnectBackend(this, discovery.type);
+                discovery.needsConnection = false;
+            }
+        }
 
-            for (std::unique_ptr<AdapterBase>& adapter : backendAdapters) {
-                ASSERT(adapter->GetBackendType() == backend->GetType());
-                ASSERT(adapter->GetInstance() == this);
-                mAdapters.push_back(std::move(adapter));
+        // Otherwise connecting to a backend and querying its adapters only reads the instance, so
+        // it can run concurrently for all the backend types. The results are merged afterwards.
+        auto Discover = [this](BackendDiscovery* discovery) {
+            if (discovery->needsConnection) {
+                discovery->newBackends = ConnectBackend(this, discovery->type);
+            }
+
+            auto DiscoverBackend = [&](BackendConnection* backend) {
+                for (std::unique_ptr<AdapterBase>& adapter : backend->DiscoverDefaultAdapters()) {
+                    ASSERT(adapter->GetBackendType() == backend->GetType());
+                    ASSERT(adapter->GetInstance() == this);
+                    discovery->adapters.push_back(std::move(adapter));
+                }
+            };
+            for (const std::unique_ptr<BackendConnection>& backend : mBackends) {
+                if (backend->GetType() == discovery->type) {
+                    DiscoverBackend(backend.get());
+                }
+            }
+            for (const std::unique_ptr<BackendConnection>& backend : discovery->newBackends) {
+                DiscoverBackend(backend.get());
             }
+        };
+
+        std::vector<std::future<void>> pendingDiscoveries;
+        for (size_t i = 1; i < discoveries.size(); ++i) {
+            pendingDiscoveries.push_back(
+                std::async(std::launch::async, Discover, &discoveries[i]));
+        }
+        if (!discoveries.empty()) {
+            Discover(&discoveries[0]);
+        }
+        for (std::future<void>& pendingDiscovery : pendingDiscoveries) {
+            pendingDiscovery.wait();
         }
 
-        mDiscoveredDefaultAdapters = true;
+        for (BackendDiscovery& discovery : discoveries) {
+            for (std::unique_ptr<BackendConnection>& backend : discovery.newBackends) {
+                mBackends.push_back(std::move(backend));
+            }
+            for (std::unique_ptr<AdapterBase>& adapter : discovery.adapters) {
+                mAdapters.push_back(std::move(adapter));
+            }
+            mConnectedBackendTypes.insert(discovery.type);
+            mDiscoveredDefaultAdapterTypes.insert(discovery.type);
+        }
     }
 
     // This is just a wrapper around the real logic that uses Error.h error handling.
@@ -120,49 +266,19 @@ namespace dawn_native {
         return mAdapters;
     }
 
-    void InstanceBase::EnsureBackendConnections() {
-        if (mBackendsConnected) {
+    void InstanceBase::EnsureBackendConnection(wgpu::BackendType backendType) {
+        if (mConnectedBackendTypes.count(backendType) != 0) {
             return;
         }
 
-        auto Register = [this](BackendConnection* connection, wgpu::BackendType expectedType) {
-            if (connection != nullptr) {
-                ASSERT(connection->GetType() == expectedType);
-                ASSERT(connection->GetInstance() == this);
-                mBackends.push_back(std::unique_ptr<BackendConnection>(connection));
-            }
-        };
-
-#if defined(DAWN_ENABLE_BACKEND_D3D12)
-        Register(d3d12::Connect(this), wgpu::BackendType::D3D12);
-#endif  // defined(DAWN_ENABLE_BACKEND_D3D12)
-#if defined(DAWN_ENABLE_BACKEND_METAL)
-        Register(metal::Connect(this), wgpu::BackendType::Metal);
-#endif  // defined(DAWN_ENABLE_BACKEND_METAL)
-#if defined(DAWN_ENABLE_BACKEND_VULKAN)
-        // TODO(https://github.com/KhronosGroup/Vulkan-Loader/issues/287):
-        // When we can load SwiftShader in parallel with the system driver, we should create the
-        // backend only once and expose SwiftShader as an additional adapter. For now, we create two
-        // VkInstances, one from SwiftShader, and one from the system. Note: If the Vulkan driver
-        // *is* SwiftShader, then this would load SwiftShader twice.
-        Register(vulkan::Connect(this, false), wgpu::BackendType::Vulkan);
-#    if defined(DAWN_ENABLE_SWIFTSHADER)
-        Register(vulkan::Connect(this, true), wgpu::BackendType::Vulkan);
-#    endif  // defined(DAWN_ENABLE_SWIFTSHADER)
-#endif      // defined(DAWN_ENABLE_BACKEND_VULKAN)
-#if defined(DAWN_ENABLE_BACKEND_OPENGL)
-        Register(opengl::Connect(this, wgpu::BackendType::OpenGL), wgpu::BackendType::OpenGL);
-        Register(opengl::Connect(this, wgpu::BackendType::OpenGLES), wgpu::BackendType::OpenGLES);
-#endif  // defined(DAWN_ENABLE_BACKEND_OPENGL)
-#if defined(DAWN_ENABLE_BACKEND_NULL)
-        Register(null::Connect(this), wgpu::BackendType::Null);
-#endif  // defined(DAWN_ENABLE_BACKEND_NULL)
-
-        mBackendsConnected = true;
+        for (std::unique_ptr<BackendConnection>& backend : ConnectBackend(this, backendType)) {
+            mBackends.push_back(std::move(backend));
+        }
+        mConnectedBackendTypes.insert(backendType);
     }
 
     MaybeError InstanceBase::DiscoverAdaptersInternal(const AdapterDiscoveryOptionsBase* options) {
-        EnsureBackendConnections();
+        EnsureBackendConnection(static_cast<wgpu::BackendType>(options->backendType));
 
         bool foundBackend = false;
         for (std::unique_ptr<BackendConnection>& backend : mBackends) {
@@ -25,6 +25,7 @@
 #include <array>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace dawn_native {
@@ -39,6 +40,7 @@ namespace dawn_native {
         static InstanceBase* Create(const InstanceDescriptor* descriptor = nullptr);
 
         void DiscoverDefaultAdapters();
+        void DiscoverDefaultAdapters(wgpu::BackendType backendType);
         bool DiscoverAdapters(const AdapterDiscoveryOptionsBase* options);
 
         const std::vector<std::unique_ptr<AdapterBase>>& GetAdapters() const;
@@ -83,13 +85,17 @@ namespace dawn_native {
 
         bool Initialize(const InstanceDescriptor* descriptor);
 
-        // Lazily creates connections to all backends that have been compiled.
-        void EnsureBackendConnections();
+        // Lazily creates the connections to the backends of the given type, if it was compiled.
+        void EnsureBackendConnection(wgpu::BackendType backendType);
+
+        // Connects to the backends of the given types and discovers their default adapters.
+        // Backends are connected concurrently when there are several of them.
+        void DiscoverDefaultAdaptersInternal(const std::vector<wgpu::BackendType>& backendTypes);
 
         MaybeError DiscoverAdaptersInternal(const AdapterDiscoveryOptionsBase* options);
 
-        bool mBackendsConnected = false;
-        bool mDiscoveredDefaultAdapters = false;
+        std::unordered_set<wgpu::BackendType> mConnectedBackendTypes;
+        std::unordered_set<wgpu::BackendType> mDiscoveredDefaultAdapterTypes;
 
         bool mBeginCaptureOnStartup = false;
         BackendValidationLevel mBackendValidationLevel = BackendValidationLevel::Disabled;
@@ -33,6 +33,9 @@ namespace dawn_native {
 
         Ref<ComputePipelineBase> timestampComputePipeline;
         Ref<ShaderModuleBase> timestampCS;
+
+        Ref<ComputePipelineBase> textureDataConversionPipeline;
+        Ref<ShaderModuleBase> textureDataConversionCS;
     };
 }  // namespace dawn_native
 
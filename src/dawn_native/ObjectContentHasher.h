@@ -18,6 +18,7 @@
 #include "common/HashUtils.h"
 
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace dawn_native {
@@ -55,11 +56,25 @@ namespace dawn_native {
 
         template <typename T>
         struct RecordImpl<std::vector<T>> {
-            static constexpr void Call(ObjectContentHasher* recorder, const std::vector<T>& vec) {
-                recorder->RecordIterable<std::vector<T>>(vec);
+            static void Call(ObjectContentHasher* recorder, const std::vector<T>& vec) {
+                recorder->RecordVector(vec, std::is_arithmetic<T>());
             }
         };
 
+        // Vectors of numbers (like SPIR-V code) are hashed as a single range of bytes.
+        template <typename T>
+        void RecordVector(const std::vector<T>& vec, std::true_type) {
+            RecordBytes(vec.data(), vec.size() * sizeof(T));
+        }
+        template <typename T>
+        void RecordVector(const std::vector<T>& vec, std::false_type) {
+            RecordIterable<std::vector<T>>(vec);
+        }
+
+        void RecordBytes(const void* data, size_t size) {
+            HashCombine(&mContentHash, HashBytes(data, size));
+        }
+
         template <typename IteratorT>
         constexpr void RecordIterable(const IteratorT& iterable) {
             for (auto it = iterable.begin(); it != iterable.end(); ++it) {
@@ -72,8 +87,8 @@ namespace dawn_native {
 
     template <>
     struct ObjectContentHasher::RecordImpl<std::string> {
-        static constexpr void Call(ObjectContentHasher* recorder, const std::string& str) {
-            recorder->RecordIterable<std::string>(str);
+        static void Call(ObjectContentHasher* recorder, const std::string& str) {
+            recorder->RecordBytes(str.data(), str.size());
         }
     };
 
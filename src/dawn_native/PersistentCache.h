@@ -34,7 +34,7 @@ namespace dawn_native {
 
     class DeviceBase;
 
-    enum class PersistentKeyType { Shader };
+    enum class PersistentKeyType { Shader, PipelineCache, SpirvValidation };
 
     class PersistentCache {
       public:
@@ -70,11 +70,12 @@ namespace dawn_native {
             return std::move(blob);
         }
 
-      private:
-        // PersistentCache impl
+        // Direct load/store operations for blobs that are updated after their creation, like
+        // backend pipeline caches.
         ScopedCachedBlob LoadData(const PersistentCacheKey& key);
         void StoreData(const PersistentCacheKey& key, const void* value, size_t size);
 
+      private:
         dawn_platform::CachingInterface* GetPlatformCache();
 
         DeviceBase* mDevice = nullptr;
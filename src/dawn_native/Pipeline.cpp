@@ -23,7 +23,7 @@
 namespace dawn_native {
 
     MaybeError ValidateProgrammableStage(DeviceBase* device,
-                                         const ShaderModuleBase* module,
+                                         ShaderModuleBase* module,
                                          const std::string& entryPoint,
                                          const PipelineLayoutBase* layout,
                                          SingleShaderStage stage) {
@@ -33,6 +33,7 @@ namespace dawn_native {
             return DAWN_VALIDATION_ERROR("Entry point doesn't exist in the module");
         }
 
+        DAWN_TRY(module->ReflectEntryPoint(entryPoint));
         const EntryPointMetadata& metadata = module->GetEntryPoint(entryPoint);
 
         if (metadata.stage != stage) {
@@ -68,6 +69,9 @@ namespace dawn_native {
             mStageMask |= StageBit(shaderStage);
             mStages[shaderStage] = {module, entryPointName, &metadata};
 
+            // The pipeline keeps the module alive, and its compiled code scales with the source.
+            mEstimatedShaderSize += module->GetSourceSize();
+
             // Compute the max() of all minBufferSizes across all stages.
             RequiredBufferSizes stageMinBufferSizes =
                 ComputeRequiredBufferSizesForLayout(metadata, layout);
@@ -145,6 +149,14 @@ namespace dawn_native {
         return result.Detach();
     }
 
+    uint64_t PipelineBase::GetEstimatedRetainedSize() const {
+        return CachedObject::GetEstimatedRetainedSize() + mEstimatedShaderSize;
+    }
+
+    void PipelineBase::AddEstimatedShaderSize(uint64_t size) {
+        mEstimatedShaderSize += size;
+    }
+
     size_t PipelineBase::ComputeContentHash() {
         ObjectContentHasher recorder;
         recorder.Record(mLayout->GetContentHash());
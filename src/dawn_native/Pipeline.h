@@ -29,7 +29,7 @@
 namespace dawn_native {
 
     MaybeError ValidateProgrammableStage(DeviceBase* device,
-                                         const ShaderModuleBase* module,
+                                         ShaderModuleBase* module,
                                          const std::string& entryPoint,
                                          const PipelineLayoutBase* layout,
                                          SingleShaderStage stage);
@@ -56,6 +56,8 @@ namespace dawn_native {
         size_t ComputeContentHash() override;
         static bool EqualForCache(const PipelineBase* a, const PipelineBase* b);
 
+        uint64_t GetEstimatedRetainedSize() const override;
+
         // Implementation of the API entrypoint. Do not use in a reentrant manner.
         BindGroupLayoutBase* APIGetBindGroupLayout(uint32_t groupIndex);
 
@@ -65,6 +67,10 @@ namespace dawn_native {
                      std::vector<StageAndDescriptor> stages);
         PipelineBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
+        // Backends add the size of the compiled shaders they know of, which the driver keeps in
+        // the pipeline.
+        void AddEstimatedShaderSize(uint64_t size);
+
       private:
         MaybeError ValidateGetBindGroupLayout(uint32_t group);
 
@@ -73,6 +79,8 @@ namespace dawn_native {
 
         Ref<PipelineLayoutBase> mLayout;
         RequiredBufferSizes mMinBufferSizes;
+
+        uint64_t mEstimatedShaderSize = 0;
     };
 
 }  // namespace dawn_native
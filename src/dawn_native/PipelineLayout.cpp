@@ -16,6 +16,7 @@
 
 #include "common/Assert.h"
 #include "common/BitSetIterator.h"
+#include "common/Math.h"
 #include "common/ityp_stack_vec.h"
 #include "dawn_native/BindGroupLayout.h"
 #include "dawn_native/Device.h"
@@ -42,6 +43,19 @@ namespace dawn_native {
         }
 
         DAWN_TRY(ValidateBindingCounts(bindingCounts));
+
+        if (descriptor->immediateDataSize != 0) {
+            if (!device->IsExtensionEnabled(Extension::ImmediateData)) {
+                return DAWN_VALIDATION_ERROR("The immediate_data extension is not enabled");
+            }
+            if (descriptor->immediateDataSize > kMaxImmediateDataSize) {
+                return DAWN_VALIDATION_ERROR("Immediate data size over limits");
+            }
+            if (descriptor->immediateDataSize % 4 != 0) {
+                return DAWN_VALIDATION_ERROR("Immediate data size must be a multiple of 4");
+            }
+        }
+
         return {};
     }
 
@@ -49,7 +63,7 @@ namespace dawn_native {
 
     PipelineLayoutBase::PipelineLayoutBase(DeviceBase* device,
                                            const PipelineLayoutDescriptor* descriptor)
-        : CachedObject(device) {
+        : CachedObject(device), mImmediateDataSize(descriptor->immediateDataSize) {
         ASSERT(descriptor->bindGroupLayoutCount <= kMaxBindGroups);
         for (BindGroupIndex group(0); group < BindGroupIndex(descriptor->bindGroupLayoutCount);
              ++group) {
@@ -175,7 +189,11 @@ namespace dawn_native {
             entryData = {};
 
         // Loops over all the reflected BindGroupLayoutEntries from shaders.
+        uint32_t immediateDataSize = 0;
         for (const StageAndDescriptor& stage : stages) {
+            immediateDataSize = std::max(
+                immediateDataSize, stage.module->GetEntryPoint(stage.entryPoint).immediateDataSize);
+
             const EntryPointMetadata::BindingInfoArray& info =
                 stage.module->GetEntryPoint(stage.entryPoint).bindings;
 
@@ -221,6 +239,7 @@ namespace dawn_native {
         PipelineLayoutDescriptor desc = {};
         desc.bindGroupLayouts = bgls.data();
         desc.bindGroupLayoutCount = static_cast<uint32_t>(pipelineBGLCount);
+        desc.immediateDataSize = Align(immediateDataSize, 4);
 
         DAWN_TRY(ValidatePipelineLayoutDescriptor(device, &desc));
 
@@ -262,6 +281,11 @@ namespace dawn_native {
         return mMask;
     }
 
+    uint32_t PipelineLayoutBase::GetImmediateDataSize() const {
+        ASSERT(!IsError());
+        return mImmediateDataSize;
+    }
+
     BindGroupLayoutMask PipelineLayoutBase::InheritedGroupsMask(
         const PipelineLayoutBase* other) const {
         ASSERT(!IsError());
@@ -281,7 +305,7 @@ namespace dawn_native {
 
     size_t PipelineLayoutBase::ComputeContentHash() {
         ObjectContentHasher recorder;
-        recorder.Record(mMask);
+        recorder.Record(mMask, mImmediateDataSize);
 
         for (BindGroupIndex group : IterateBitSet(mMask)) {
             recorder.Record(GetBindGroupLayout(group)->GetContentHash());
@@ -292,7 +316,7 @@ namespace dawn_native {
 
     bool PipelineLayoutBase::EqualityFunc::operator()(const PipelineLayoutBase* a,
                                                       const PipelineLayoutBase* b) const {
-        if (a->mMask != b->mMask) {
+        if (a->mMask != b->mMask || a->mImmediateDataSize != b->mImmediateDataSize) {
             return false;
         }
 
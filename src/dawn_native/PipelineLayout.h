@@ -57,6 +57,10 @@ namespace dawn_native {
         BindGroupLayoutBase* GetBindGroupLayout(BindGroupIndex group);
         const BindGroupLayoutMask& GetBindGroupLayoutsMask() const;
 
+        // The size in bytes of the immediate data that the shaders can read, which is 0 unless
+        // the ImmediateData extension is enabled.
+        uint32_t GetImmediateDataSize() const;
+
         // Utility functions to compute inherited bind groups.
         // Returns the inherited bind groups as a mask.
         BindGroupLayoutMask InheritedGroupsMask(const PipelineLayoutBase* other) const;
@@ -77,6 +81,7 @@ namespace dawn_native {
 
         BindGroupLayoutArray mBindGroupLayouts;
         BindGroupLayoutMask mMask;
+        uint32_t mImmediateDataSize = 0;
     };
 
 }  // namespace dawn_native
@@ -54,7 +54,11 @@ namespace dawn_native {
         mPool.push_front(std::move(allocation));
     }
 
-    uint64_t PooledResourceMemoryAllocator::GetPoolSizeForTesting() const {
+    uint64_t PooledResourceMemoryAllocator::GetPoolSize() const {
         return mPool.size();
     }
+
+    uint64_t PooledResourceMemoryAllocator::GetPoolSizeForTesting() const {
+        return GetPoolSize();
+    }
 }  // namespace dawn_native
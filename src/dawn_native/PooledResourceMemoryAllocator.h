@@ -39,6 +39,8 @@ namespace dawn_native {
 
         void DestroyPool();
 
+        uint64_t GetPoolSize() const;
+
         // For testing purposes.
         uint64_t GetPoolSizeForTesting() const;
 
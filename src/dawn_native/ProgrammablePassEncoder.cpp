@@ -160,6 +160,20 @@ namespace dawn_native {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
             BindGroupIndex groupIndex(groupIndexIn);
 
+            // Setting the same bind group with the same dynamic offsets again is a no-op that
+            // doesn't need to be validated again. The bind group can't be invalid as it was
+            // already set successfully.
+            if (group != nullptr && groupIndex < kMaxBindGroupsTyped) {
+                const BoundBindGroup& bound = mBoundBindGroups[groupIndex];
+                if (bound.group == group && bound.dynamicOffsetCount == dynamicOffsetCountIn &&
+                    (dynamicOffsetCountIn == 0 ||
+                     memcmp(bound.dynamicOffsets.data(), dynamicOffsetsIn,
+                            dynamicOffsetCountIn * sizeof(uint32_t)) == 0)) {
+                    GetDevice()->CountElidedCommand(&ElidedCommandStats::setBindGroup);
+                    return {};
+                }
+            }
+
             if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(group));
 
@@ -224,6 +238,50 @@ namespace dawn_native {
 
             TrackBindGroupResourceUsage(&mUsageTracker, group);
 
+            // Validation guarantees this but it may be skipped.
+            if (groupIndex < kMaxBindGroupsTyped &&
+                dynamicOffsetCountIn <= kMaxDynamicBuffersPerPipelineLayout) {
+                BoundBindGroup& bound = mBoundBindGroups[groupIndex];
+                bound.group = group;
+                bound.dynamicOffsetCount = dynamicOffsetCountIn;
+                if (dynamicOffsetCountIn > 0) {
+                    memcpy(bound.dynamicOffsets.data(), dynamicOffsetsIn,
+                           dynamicOffsetCountIn * sizeof(uint32_t));
+                }
+            }
+
+            return {};
+        });
+    }
+
+    void ProgrammablePassEncoder::APISetImmediateData(uint32_t offset,
+                                                      const void* data,
+                                                      uint32_t size) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (IsValidationEnabled()) {
+                if (!GetDevice()->IsExtensionEnabled(Extension::ImmediateData)) {
+                    return DAWN_VALIDATION_ERROR("The immediate_data extension is not enabled");
+                }
+                if (offset % 4 != 0 || size % 4 != 0) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Immediate data offset and size must be multiples of 4");
+                }
+                if (offset > kMaxImmediateDataSize || size > kMaxImmediateDataSize - offset) {
+                    return DAWN_VALIDATION_ERROR("Immediate data range over limits");
+                }
+            }
+
+            if (size == 0) {
+                return {};
+            }
+
+            SetImmediateDataCmd* cmd =
+                allocator->Allocate<SetImmediateDataCmd>(Command::SetImmediateData);
+            cmd->offset = offset;
+            cmd->size = size;
+            uint8_t* immediateData = allocator->AllocateData<uint8_t>(size);
+            memcpy(immediateData, data, size);
+
             return {};
         });
     }
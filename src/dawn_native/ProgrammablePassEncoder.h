@@ -15,6 +15,8 @@
 #ifndef DAWNNATIVE_PROGRAMMABLEPASSENCODER_H_
 #define DAWNNATIVE_PROGRAMMABLEPASSENCODER_H_
 
+#include "common/ityp_array.h"
+#include "dawn_native/BindingInfo.h"
 #include "dawn_native/CommandBufferStateTracker.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/Error.h"
@@ -43,6 +45,8 @@ namespace dawn_native {
                              uint32_t dynamicOffsetCount = 0,
                              const uint32_t* dynamicOffsets = nullptr);
 
+        void APISetImmediateData(uint32_t offset, const void* data, uint32_t size);
+
       protected:
         bool IsValidationEnabled() const;
         MaybeError ValidateProgrammableEncoderEnd() const;
@@ -59,6 +63,17 @@ namespace dawn_native {
         uint64_t mDebugGroupStackSize = 0;
         CommandBufferStateTracker mCommandBufferState;
 
+        // The arguments of the last successful SetPipeline and SetBindGroup calls, used to skip
+        // the calls that would set the same state again. The objects are kept alive by the
+        // commands that set them.
+        struct BoundBindGroup {
+            BindGroupBase* group = nullptr;
+            uint32_t dynamicOffsetCount = 0;
+            std::array<uint32_t, kMaxDynamicBuffersPerPipelineLayout> dynamicOffsets;
+        };
+        PipelineBase* mBoundPipeline = nullptr;
+        ityp::array<BindGroupIndex, BoundBindGroup, kMaxBindGroups> mBoundBindGroups;
+
       private:
         const bool mValidationEnabled;
     };
@@ -135,6 +135,11 @@ namespace dawn_native {
 
     }  // anonymous namespace
 
+    MaybeError CreateTimestampComputePipeline(DeviceBase* device) {
+        DAWN_TRY(GetOrCreateTimestampComputePipeline(device));
+        return {};
+    }
+
     MaybeError EncodeConvertTimestampsToNanoseconds(CommandEncoder* encoder,
                                                     BufferBase* timestamps,
                                                     BufferBase* availability,
@@ -22,6 +22,7 @@ namespace dawn_native {
 
     class BufferBase;
     class CommandEncoder;
+    class DeviceBase;
 
     struct TimestampParams {
         uint32_t count;
@@ -29,6 +30,9 @@ namespace dawn_native {
         float period;
     };
 
+    // Creates the internal pipeline used to convert timestamps ahead of the first resolve.
+    MaybeError CreateTimestampComputePipeline(DeviceBase* device);
+
     MaybeError EncodeConvertTimestampsToNanoseconds(CommandEncoder* encoder,
                                                     BufferBase* timestamps,
                                                     BufferBase* availability,
@@ -16,6 +16,7 @@
 
 #include "common/Constants.h"
 #include "dawn_native/Buffer.h"
+#include "dawn_native/ChainUtils_autogen.h"
 #include "dawn_native/CommandBuffer.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/CommandValidation.h"
@@ -28,6 +29,8 @@
 #include "dawn_native/RenderPassEncoder.h"
 #include "dawn_native/RenderPipeline.h"
 #include "dawn_native/Texture.h"
+#include "dawn_native/TextureDataConversionHelper.h"
+#include "dawn_native/TextureDataCopy.h"
 #include "dawn_platform/DawnPlatform.h"
 #include "dawn_platform/tracing/TraceEvent.h"
 
@@ -37,41 +40,6 @@ namespace dawn_native {
 
     namespace {
 
-        void CopyTextureData(uint8_t* dstPointer,
-                             const uint8_t* srcPointer,
-                             uint32_t depth,
-                             uint32_t rowsPerImage,
-                             uint64_t imageAdditionalStride,
-                             uint32_t actualBytesPerRow,
-                             uint32_t dstBytesPerRow,
-                             uint32_t srcBytesPerRow) {
-            bool copyWholeLayer =
-                actualBytesPerRow == dstBytesPerRow && dstBytesPerRow == srcBytesPerRow;
-            bool copyWholeData = copyWholeLayer && imageAdditionalStride == 0;
-
-            if (!copyWholeLayer) {  // copy row by row
-                for (uint32_t d = 0; d < depth; ++d) {
-                    for (uint32_t h = 0; h < rowsPerImage; ++h) {
-                        memcpy(dstPointer, srcPointer, actualBytesPerRow);
-                        dstPointer += dstBytesPerRow;
-                        srcPointer += srcBytesPerRow;
-                    }
-                    srcPointer += imageAdditionalStride;
-                }
-            } else {
-                uint64_t layerSize = uint64_t(rowsPerImage) * actualBytesPerRow;
-                if (!copyWholeData) {  // copy layer by layer
-                    for (uint32_t d = 0; d < depth; ++d) {
-                        memcpy(dstPointer, srcPointer, layerSize);
-                        dstPointer += layerSize;
-                        srcPointer += layerSize + imageAdditionalStride;
-                    }
-                } else {  // do a single copy
-                    memcpy(dstPointer, srcPointer, layerSize * depth);
-                }
-            }
-        }
-
         ResultOrError<UploadHandle> UploadTextureDataAligningBytesPerRowAndOffset(
             DeviceBase* device,
             const void* data,
@@ -115,9 +83,19 @@ namespace dawn_native {
             uint64_t imageAdditionalStride =
                 dataLayout.bytesPerRow * (dataRowsPerImage - alignedRowsPerImage);
 
-            CopyTextureData(dstPointer, srcPointer, writeSizePixel.depthOrArrayLayers,
-                            alignedRowsPerImage, imageAdditionalStride, alignedBytesPerRow,
-                            optimallyAlignedBytesPerRow, dataLayout.bytesPerRow);
+            TextureDataCopyLayout copyLayout;
+            copyLayout.depth = writeSizePixel.depthOrArrayLayers;
+            copyLayout.rowsPerImage = alignedRowsPerImage;
+            copyLayout.bytesPerRow = alignedBytesPerRow;
+            copyLayout.srcBytesPerRow = dataLayout.bytesPerRow;
+            copyLayout.dstBytesPerRow = optimallyAlignedBytesPerRow;
+            copyLayout.srcImageAdditionalStride = imageAdditionalStride;
+
+            dawn_platform::WorkerTaskPool* workerTaskPool = nullptr;
+            if (device->IsToggleEnabled(Toggle::UseWorkerThreadsForLargeTextureUploads)) {
+                workerTaskPool = device->GetWorkerTaskPool();
+            }
+            CopyTextureData(dstPointer, srcPointer, copyLayout, workerTaskPool);
 
             return uploadHandle;
         }
@@ -325,10 +303,20 @@ namespace dawn_native {
             return {};
         }
 
-        const TexelBlockInfo& blockInfo =
-            destination->texture->GetFormat().GetAspectInfo(destination->aspect).block;
+        const TextureDataConversion* conversion = nullptr;
+        FindInChain(dataLayout->nextInChain, &conversion);
+
+        const TexelBlockInfo blockInfo =
+            conversion != nullptr
+                ? GetTextureDataConversionSourceBlockInfo(conversion)
+                : destination->texture->GetFormat().GetAspectInfo(destination->aspect).block;
         TextureDataLayout layout = *dataLayout;
         ApplyDefaultTextureDataLayoutOptions(&layout, blockInfo, fixedWriteSize);
+
+        if (conversion != nullptr && !IsTextureDataConversionNoop(conversion, *destination)) {
+            return DoWriteTextureWithConversion(GetDevice(), *destination, data, layout,
+                                                fixedWriteSize, conversion);
+        }
         return WriteTextureImpl(*destination, data, layout, fixedWriteSize);
     }
 
@@ -523,6 +511,13 @@ namespace dawn_native {
             return DAWN_VALIDATION_ERROR("The sample count of textures must be 1");
         }
 
+        DAWN_TRY(ValidateSingleSType(dataLayout->nextInChain, wgpu::SType::TextureDataConversion));
+        const TextureDataConversion* conversion = nullptr;
+        FindInChain(dataLayout->nextInChain, &conversion);
+        if (conversion != nullptr) {
+            DAWN_TRY(ValidateTextureDataConversion(GetDevice(), conversion, destination));
+        }
+
         DAWN_TRY(ValidateLinearToDepthStencilCopyRestrictions(*destination));
         // We validate texture copy range before validating linear texture data,
         // because in the latter we divide copyExtent.width by blockWidth and
@@ -530,8 +525,10 @@ namespace dawn_native {
         // checked in validating texture copy range.
         DAWN_TRY(ValidateTextureCopyRange(GetDevice(), *destination, *writeSize));
 
-        const TexelBlockInfo& blockInfo =
-            destination->texture->GetFormat().GetAspectInfo(destination->aspect).block;
+        const TexelBlockInfo blockInfo =
+            conversion != nullptr
+                ? GetTextureDataConversionSourceBlockInfo(conversion)
+                : destination->texture->GetFormat().GetAspectInfo(destination->aspect).block;
 
         TextureDataLayout layout = FixUpDeprecatedTextureDataLayoutOptions(GetDevice(), *dataLayout,
                                                                            blockInfo, *writeSize);
@@ -16,6 +16,7 @@
 
 #include "common/Constants.h"
 #include "common/Log.h"
+#include "dawn_native/Adapter.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/CommandValidation.h"
@@ -56,6 +57,13 @@ namespace dawn_native {
         return std::move(mAttachmentState);
     }
 
+    void RenderEncoderBase::ResetBoundState() {
+        mBoundPipeline = nullptr;
+        mBoundBindGroups.fill({});
+        mBoundVertexBuffers.fill({});
+        mBoundIndexBuffer = {};
+    }
+
     void RenderEncoderBase::APIDraw(uint32_t vertexCount,
                                     uint32_t instanceCount,
                                     uint32_t firstVertex,
@@ -181,8 +189,87 @@ namespace dawn_native {
         });
     }
 
+    void RenderEncoderBase::APIMultiDrawIndexedIndirect(BufferBase* indirectBuffer,
+                                                        uint64_t indirectOffset,
+                                                        uint32_t maxDrawCount,
+                                                        BufferBase* drawCountBuffer,
+                                                        uint64_t drawCountBufferOffset) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (IsValidationEnabled()) {
+                if (!GetDevice()->IsExtensionEnabled(Extension::MultiDrawIndirect)) {
+                    return DAWN_VALIDATION_ERROR("Multi draw indirect is not enabled");
+                }
+
+                DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
+                DAWN_TRY(ValidateCanUseAs(indirectBuffer, wgpu::BufferUsage::Indirect));
+                DAWN_TRY(mCommandBufferState.ValidateCanDrawIndexed());
+
+                // Same as DrawIndexedIndirect, the range of indices of each draw isn't validated.
+                if (GetDevice()->IsToggleEnabled(Toggle::DisallowUnsafeAPIs)) {
+                    return DAWN_VALIDATION_ERROR(
+                        "MultiDrawIndexedIndirect is disallowed because it doesn't validate that "
+                        "the index range is valid yet.");
+                }
+
+                if (indirectOffset % 4 != 0) {
+                    return DAWN_VALIDATION_ERROR("Indirect offset must be a multiple of 4");
+                }
+
+                // Check the offset first so that the size of the draws can't overflow.
+                if (indirectOffset > indirectBuffer->GetSize() ||
+                    uint64_t(maxDrawCount) * kDrawIndexedIndirectSize >
+                        indirectBuffer->GetSize() - indirectOffset) {
+                    return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                }
+
+                if (maxDrawCount > GetDevice()->GetAdapter()->GetMaxDrawIndirectCount()) {
+                    return DAWN_VALIDATION_ERROR("Max draw count exceeds maxDrawIndirectCount");
+                }
+
+                if (drawCountBuffer != nullptr) {
+                    if (!GetDevice()->IsExtensionEnabled(Extension::DrawIndirectCount)) {
+                        return DAWN_VALIDATION_ERROR("Draw indirect count is not enabled");
+                    }
+
+                    DAWN_TRY(GetDevice()->ValidateObject(drawCountBuffer));
+                    DAWN_TRY(ValidateCanUseAs(drawCountBuffer, wgpu::BufferUsage::Indirect));
+
+                    if (drawCountBufferOffset % 4 != 0) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Draw count buffer offset must be a multiple of 4");
+                    }
+
+                    if (drawCountBufferOffset >= drawCountBuffer->GetSize() ||
+                        drawCountBufferOffset + sizeof(uint32_t) > drawCountBuffer->GetSize()) {
+                        return DAWN_VALIDATION_ERROR("Draw count buffer offset out of bounds");
+                    }
+                }
+            }
+
+            MultiDrawIndexedIndirectCmd* cmd = allocator->Allocate<MultiDrawIndexedIndirectCmd>(
+                Command::MultiDrawIndexedIndirect);
+            cmd->indirectBuffer = indirectBuffer;
+            cmd->indirectOffset = indirectOffset;
+            cmd->maxDrawCount = maxDrawCount;
+            cmd->drawCountBuffer = drawCountBuffer;
+            cmd->drawCountBufferOffset = drawCountBufferOffset;
+
+            mUsageTracker.BufferUsedAs(indirectBuffer, wgpu::BufferUsage::Indirect);
+            if (drawCountBuffer != nullptr) {
+                mUsageTracker.BufferUsedAs(drawCountBuffer, wgpu::BufferUsage::Indirect);
+            }
+
+            return {};
+        });
+    }
+
     void RenderEncoderBase::APISetPipeline(RenderPipelineBase* pipeline) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (pipeline != nullptr && pipeline == mBoundPipeline) {
+                GetDevice()->CountElidedCommand(&ElidedCommandStats::setPipeline);
+                return {};
+            }
+
             if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(pipeline));
 
@@ -199,6 +286,8 @@ namespace dawn_native {
                 allocator->Allocate<SetRenderPipelineCmd>(Command::SetRenderPipeline);
             cmd->pipeline = pipeline;
 
+            mBoundPipeline = pipeline;
+
             return {};
         });
     }
@@ -218,6 +307,16 @@ namespace dawn_native {
                                               uint64_t offset,
                                               uint64_t size) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            // The arguments are compared before the size is defaulted, which is fine since the
+            // size of buffers can't change.
+            if (buffer != nullptr && buffer == mBoundIndexBuffer.buffer &&
+                format == mBoundIndexBuffer.format && offset == mBoundIndexBuffer.offset &&
+                size == mBoundIndexBuffer.size) {
+                GetDevice()->CountElidedCommand(&ElidedCommandStats::setIndexBuffer);
+                return {};
+            }
+            const uint64_t sizeIn = size;
+
             if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(buffer));
                 DAWN_TRY(ValidateCanUseAs(buffer, wgpu::BufferUsage::Index));
@@ -257,6 +356,8 @@ namespace dawn_native {
 
             mUsageTracker.BufferUsedAs(buffer, wgpu::BufferUsage::Index);
 
+            mBoundIndexBuffer = {buffer, format, offset, sizeIn};
+
             return {};
         });
     }
@@ -266,6 +367,16 @@ namespace dawn_native {
                                                uint64_t offset,
                                                uint64_t size) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (buffer != nullptr && slot < kMaxVertexBuffers) {
+                const BoundVertexBuffer& bound =
+                    mBoundVertexBuffers[VertexBufferSlot(static_cast<uint8_t>(slot))];
+                if (buffer == bound.buffer && offset == bound.offset && size == bound.size) {
+                    GetDevice()->CountElidedCommand(&ElidedCommandStats::setVertexBuffer);
+                    return {};
+                }
+            }
+            const uint64_t sizeIn = size;
+
             if (IsValidationEnabled()) {
                 DAWN_TRY(GetDevice()->ValidateObject(buffer));
                 DAWN_TRY(ValidateCanUseAs(buffer, wgpu::BufferUsage::Vertex));
@@ -304,6 +415,11 @@ namespace dawn_native {
 
             mUsageTracker.BufferUsedAs(buffer, wgpu::BufferUsage::Vertex);
 
+            // Validation guarantees this but it may be skipped.
+            if (slot < kMaxVertexBuffers) {
+                mBoundVertexBuffers[cmd->slot] = {buffer, offset, sizeIn};
+            }
+
             return {};
         });
     }
@@ -39,6 +39,11 @@ namespace dawn_native {
 
         void APIDrawIndirect(BufferBase* indirectBuffer, uint64_t indirectOffset);
         void APIDrawIndexedIndirect(BufferBase* indirectBuffer, uint64_t indirectOffset);
+        void APIMultiDrawIndexedIndirect(BufferBase* indirectBuffer,
+                                         uint64_t indirectOffset,
+                                         uint32_t maxDrawCount,
+                                         BufferBase* drawCountBuffer,
+                                         uint64_t drawCountBufferOffset);
 
         void APISetPipeline(RenderPipelineBase* pipeline);
 
@@ -59,10 +64,30 @@ namespace dawn_native {
         // Construct an "error" render encoder base.
         RenderEncoderBase(DeviceBase* device, EncodingContext* encodingContext, ErrorTag errorTag);
 
+        // Forgets the state set by the encoder, for example after executing render bundles that
+        // change it.
+        void ResetBoundState();
+
       private:
         Ref<AttachmentState> mAttachmentState;
         const bool mDisableBaseVertex;
         const bool mDisableBaseInstance;
+
+        // The arguments of the last successful SetVertexBuffer and SetIndexBuffer calls, before
+        // the size is defaulted.
+        struct BoundVertexBuffer {
+            BufferBase* buffer = nullptr;
+            uint64_t offset = 0;
+            uint64_t size = 0;
+        };
+        struct BoundIndexBuffer {
+            BufferBase* buffer = nullptr;
+            wgpu::IndexFormat format = wgpu::IndexFormat::Undefined;
+            uint64_t offset = 0;
+            uint64_t size = 0;
+        };
+        ityp::array<VertexBufferSlot, BoundVertexBuffer, kMaxVertexBuffers> mBoundVertexBuffers;
+        BoundIndexBuffer mBoundIndexBuffer;
     };
 
 }  // namespace dawn_native
@@ -212,6 +212,7 @@ namespace dawn_native {
             }
 
             mCommandBufferState = CommandBufferStateTracker{};
+            ResetBoundState();
 
             ExecuteBundlesCmd* cmd =
                 allocator->Allocate<ExecuteBundlesCmd>(Command::ExecuteBundles);
@@ -129,4 +129,28 @@ namespace dawn_native {
                a->mCompareFunction == b->mCompareFunction && a->mMaxAnisotropy == b->mMaxAnisotropy;
     }
 
+    // static
+    size_t SamplerBase::ComputeDescriptorContentHash(const SamplerDescriptor* descriptor) {
+        ObjectContentHasher recorder;
+        recorder.Record(descriptor->addressModeU, descriptor->addressModeV,
+                        descriptor->addressModeW, descriptor->magFilter, descriptor->minFilter,
+                        descriptor->mipmapFilter, descriptor->lodMinClamp, descriptor->lodMaxClamp,
+                        descriptor->compare, descriptor->maxAnisotropy);
+        return recorder.GetContentHash();
+    }
+
+    bool SamplerBase::MatchesDescriptor(const SamplerDescriptor* descriptor) const {
+        ASSERT(!std::isnan(descriptor->lodMinClamp));
+        ASSERT(!std::isnan(descriptor->lodMaxClamp));
+
+        return mAddressModeU == descriptor->addressModeU &&
+               mAddressModeV == descriptor->addressModeV &&
+               mAddressModeW == descriptor->addressModeW && mMagFilter == descriptor->magFilter &&
+               mMinFilter == descriptor->minFilter && mMipmapFilter == descriptor->mipmapFilter &&
+               mLodMinClamp == descriptor->lodMinClamp &&
+               mLodMaxClamp == descriptor->lodMaxClamp &&
+               mCompareFunction == descriptor->compare &&
+               mMaxAnisotropy == descriptor->maxAnisotropy;
+    }
+
 }  // namespace dawn_native
@@ -42,6 +42,11 @@ namespace dawn_native {
             bool operator()(const SamplerBase* a, const SamplerBase* b) const;
         };
 
+        // Computes the same hash as ComputeContentHash, and compares with the state of a sampler,
+        // directly from the descriptor. This lets the device cache be probed without a blueprint.
+        static size_t ComputeDescriptorContentHash(const SamplerDescriptor* descriptor);
+        bool MatchesDescriptor(const SamplerDescriptor* descriptor) const;
+
         uint16_t GetMaxAnisotropy() const {
             return mMaxAnisotropy;
         }
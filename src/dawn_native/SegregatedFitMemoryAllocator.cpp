@@ -0,0 +1,288 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/SegregatedFitMemoryAllocator.h"
+
+#include "common/Assert.h"
+#include "common/Math.h"
+#include "dawn_native/ResourceHeapAllocator.h"
+
+namespace dawn_native {
+
+    SegregatedFitMemoryAllocator::SegregatedFitMemoryAllocator(
+        uint64_t heapSize,
+        ResourceHeapAllocator* heapAllocator)
+        : mHeapSize(heapSize), mHeapAllocator(heapAllocator) {
+        ASSERT(heapSize > 0);
+    }
+
+    SegregatedFitMemoryAllocator::~SegregatedFitMemoryAllocator() {
+        ASSERT(mHeapCount == 0);
+    }
+
+    // static
+    size_t SegregatedFitMemoryAllocator::GetBinIndex(uint64_t size) {
+        ASSERT(size > 0);
+        return Log2(size);
+    }
+
+    uint64_t SegregatedFitMemoryAllocator::AlignInHeap(uint64_t offset, uint64_t alignment) const {
+        const uint64_t heapStart = offset - offset % mHeapSize;
+        return heapStart + Align(offset - heapStart, alignment);
+    }
+
+    ResultOrError<ResourceMemoryAllocation> SegregatedFitMemoryAllocator::Allocate(
+        uint64_t allocationSize,
+        uint64_t alignment) {
+        ResourceMemoryAllocation invalidAllocation = ResourceMemoryAllocation{};
+
+        if (allocationSize == 0 || allocationSize > mHeapSize) {
+            return std::move(invalidAllocation);
+        }
+        ASSERT(IsPowerOfTwo(alignment));
+
+        uint64_t blockOffset = FindFreeBlock(allocationSize, alignment);
+        if (blockOffset == kInvalidOffset) {
+            DAWN_TRY(AddHeap());
+            blockOffset = FindFreeBlock(allocationSize, alignment);
+            ASSERT(blockOffset != kInvalidOffset);
+        }
+
+        return AllocateInFreeBlock(blockOffset, allocationSize, alignment);
+    }
+
+    ResourceMemoryAllocation SegregatedFitMemoryAllocator::AllocateOutsideHeap(
+        uint64_t allocationSize,
+        uint64_t alignment,
+        const ResourceHeapBase* excludedHeap) {
+        if (allocationSize == 0 || allocationSize > mHeapSize) {
+            return ResourceMemoryAllocation{};
+        }
+        ASSERT(IsPowerOfTwo(alignment));
+
+        uint64_t excludedHeapIndex = kInvalidOffset;
+        for (uint64_t i = 0; i < mHeaps.size(); ++i) {
+            if (mHeaps[i].heap.get() == excludedHeap) {
+                excludedHeapIndex = i;
+                break;
+            }
+        }
+
+        uint64_t blockOffset = FindFreeBlock(allocationSize, alignment, excludedHeapIndex);
+        if (blockOffset == kInvalidOffset) {
+            return ResourceMemoryAllocation{};
+        }
+        return AllocateInFreeBlock(blockOffset, allocationSize, alignment);
+    }
+
+    ResourceMemoryAllocation SegregatedFitMemoryAllocator::AllocateInFreeBlock(
+        uint64_t blockOffset,
+        uint64_t allocationSize,
+        uint64_t alignment) {
+        // Split the free block in up to three blocks: the padding required by the alignment, the
+        // allocation and the remaining space.
+        const uint64_t freeBlockSize = mBlocks[blockOffset].size;
+        RemoveFreeBlock(blockOffset, freeBlockSize);
+
+        const uint64_t allocationOffset = AlignInHeap(blockOffset, alignment);
+        const uint64_t paddingSize = allocationOffset - blockOffset;
+        const uint64_t remainingSize = freeBlockSize - paddingSize - allocationSize;
+
+        if (paddingSize > 0) {
+            InsertFreeBlock(blockOffset, paddingSize);
+        }
+        mBlocks[allocationOffset] = {allocationSize, false};
+        if (remainingSize > 0) {
+            InsertFreeBlock(allocationOffset + allocationSize, remainingSize);
+        }
+
+        const uint64_t heapIndex = allocationOffset / mHeapSize;
+        mHeaps[heapIndex].allocationCount++;
+        mHeaps[heapIndex].usedSize += allocationSize;
+        mUsedSize += allocationSize;
+
+        AllocationInfo info;
+        info.mBlockOffset = allocationOffset;
+        info.mMethod = AllocationMethod::kSubAllocated;
+
+        return ResourceMemoryAllocation{info, allocationOffset % mHeapSize,
+                                        mHeaps[heapIndex].heap.get()};
+    }
+
+    void SegregatedFitMemoryAllocator::Deallocate(const ResourceMemoryAllocation& allocation) {
+        const AllocationInfo info = allocation.GetInfo();
+        ASSERT(info.mMethod == AllocationMethod::kSubAllocated);
+
+        auto it = mBlocks.find(info.mBlockOffset);
+        ASSERT(it != mBlocks.end() && !it->second.isFree);
+
+        uint64_t offset = it->first;
+        uint64_t size = it->second.size;
+        const uint64_t heapIndex = offset / mHeapSize;
+        mHeaps[heapIndex].usedSize -= size;
+        mUsedSize -= size;
+        mBlocks.erase(it);
+
+        // Merge with the free neighbors in the same heap.
+        auto next = mBlocks.lower_bound(offset + size);
+        if (next != mBlocks.end() && next->first == offset + size && next->second.isFree &&
+            next->first / mHeapSize == heapIndex) {
+            uint64_t nextSize = next->second.size;
+            RemoveFreeBlock(next->first, nextSize);
+            size += nextSize;
+        }
+
+        auto previous = mBlocks.lower_bound(offset);
+        if (previous != mBlocks.begin()) {
+            --previous;
+            if (previous->first + previous->second.size == offset && previous->second.isFree &&
+                previous->first / mHeapSize == heapIndex) {
+                uint64_t previousOffset = previous->first;
+                uint64_t previousSize = previous->second.size;
+                RemoveFreeBlock(previousOffset, previousSize);
+                offset = previousOffset;
+                size += previousSize;
+            }
+        }
+
+        InsertFreeBlock(offset, size);
+
+        ASSERT(mHeaps[heapIndex].allocationCount > 0);
+        mHeaps[heapIndex].allocationCount--;
+        if (mHeaps[heapIndex].allocationCount == 0) {
+            ReleaseHeap(heapIndex);
+        }
+    }
+
+    uint64_t SegregatedFitMemoryAllocator::FindFreeBlock(uint64_t allocationSize,
+                                                         uint64_t alignment,
+                                                         uint64_t excludedHeapIndex) const {
+        for (size_t binIndex = GetBinIndex(allocationSize); binIndex < kBinCount; ++binIndex) {
+            const Bin& bin = mFreeBins[binIndex];
+            for (auto it = bin.lower_bound({allocationSize, 0}); it != bin.end(); ++it) {
+                const uint64_t size = it->first;
+                const uint64_t offset = it->second;
+                if (offset / mHeapSize == excludedHeapIndex) {
+                    continue;
+                }
+                const uint64_t paddingSize = AlignInHeap(offset, alignment) - offset;
+                if (paddingSize + allocationSize <= size) {
+                    return offset;
+                }
+            }
+        }
+        return kInvalidOffset;
+    }
+
+    MaybeError SegregatedFitMemoryAllocator::AddHeap() {
+        std::unique_ptr<ResourceHeapBase> heap;
+        DAWN_TRY_ASSIGN(heap, mHeapAllocator->AllocateResourceHeap(mHeapSize));
+
+        // Reuse the range of a released heap if there is one.
+        uint64_t heapIndex = 0;
+        while (heapIndex < mHeaps.size() && mHeaps[heapIndex].heap != nullptr) {
+            heapIndex++;
+        }
+        if (heapIndex == mHeaps.size()) {
+            mHeaps.emplace_back();
+        }
+
+        mHeaps[heapIndex].heap = std::move(heap);
+        mHeaps[heapIndex].allocationCount = 0;
+        mHeaps[heapIndex].usedSize = 0;
+        mHeapCount++;
+
+        InsertFreeBlock(heapIndex * mHeapSize, mHeapSize);
+        return {};
+    }
+
+    void SegregatedFitMemoryAllocator::ReleaseHeap(uint64_t heapIndex) {
+        // The heap is empty so it is a single free block.
+        RemoveFreeBlock(heapIndex * mHeapSize, mHeapSize);
+        mBlocks.erase(heapIndex * mHeapSize);
+
+        mHeapAllocator->DeallocateResourceHeap(std::move(mHeaps[heapIndex].heap));
+        mHeapCount--;
+    }
+
+    void SegregatedFitMemoryAllocator::InsertFreeBlock(uint64_t offset, uint64_t size) {
+        mBlocks[offset] = {size, true};
+        mFreeBins[GetBinIndex(size)].insert({size, offset});
+    }
+
+    void SegregatedFitMemoryAllocator::RemoveFreeBlock(uint64_t offset, uint64_t size) {
+        ASSERT(mBlocks.at(offset).isFree);
+        mFreeBins[GetBinIndex(size)].erase({size, offset});
+        mBlocks.erase(offset);
+    }
+
+    bool SegregatedFitMemoryAllocator::OwnsHeap(const ResourceHeapBase* heap) const {
+        for (const TrackedHeap& trackedHeap : mHeaps) {
+            if (trackedHeap.heap.get() == heap) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const ResourceHeapBase* SegregatedFitMemoryAllocator::FindHeapToEvacuate() const {
+        if (mHeapCount < 2) {
+            return nullptr;
+        }
+
+        const TrackedHeap* leastUsedHeap = nullptr;
+        for (const TrackedHeap& trackedHeap : mHeaps) {
+            if (trackedHeap.heap != nullptr &&
+                (leastUsedHeap == nullptr || trackedHeap.usedSize < leastUsedHeap->usedSize)) {
+                leastUsedHeap = &trackedHeap;
+            }
+        }
+        ASSERT(leastUsedHeap != nullptr);
+
+        const uint64_t freeSizeInOtherHeaps =
+            GetFreeSize() - (mHeapSize - leastUsedHeap->usedSize);
+        if (leastUsedHeap->usedSize * 2 > mHeapSize ||
+            leastUsedHeap->usedSize > freeSizeInOtherHeaps) {
+            return nullptr;
+        }
+        return leastUsedHeap->heap.get();
+    }
+
+    uint64_t SegregatedFitMemoryAllocator::GetHeapSize() const {
+        return mHeapSize;
+    }
+
+    uint64_t SegregatedFitMemoryAllocator::GetHeapCount() const {
+        return mHeapCount;
+    }
+
+    uint64_t SegregatedFitMemoryAllocator::GetUsedSize() const {
+        return mUsedSize;
+    }
+
+    uint64_t SegregatedFitMemoryAllocator::GetFreeSize() const {
+        return mHeapCount * mHeapSize - mUsedSize;
+    }
+
+    uint64_t SegregatedFitMemoryAllocator::GetLargestFreeBlockSize() const {
+        for (size_t binIndex = kBinCount; binIndex > 0; --binIndex) {
+            const Bin& bin = mFreeBins[binIndex - 1];
+            if (!bin.empty()) {
+                return bin.rbegin()->first;
+            }
+        }
+        return 0;
+    }
+
+}  // namespace dawn_native
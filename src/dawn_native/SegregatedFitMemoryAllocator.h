@@ -0,0 +1,125 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAWNNATIVE_SEGREGATEDFITMEMORYALLOCATOR_H_
+#define DAWNNATIVE_SEGREGATEDFITMEMORYALLOCATOR_H_
+
+#include "dawn_native/Error.h"
+#include "dawn_native/ResourceMemoryAllocation.h"
+
+#include <array>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace dawn_native {
+
+    class ResourceHeapAllocator;
+
+    // SegregatedFitMemoryAllocator sub-allocates blocks of arbitrary sizes in fixed-size heaps
+    // created by a ResourceHeapAllocator. It is meant for resources that are too large for the
+    // BuddyMemoryAllocator, which rounds sizes up to a power of two, but are small compared to a
+    // heap.
+    //
+    // Free blocks are kept in bins of power-of-two size classes and allocations take the smallest
+    // free block that fits in the first bin that can contain one. Freed blocks are merged with
+    // their free neighbors and heaps without allocations are released immediately.
+    //
+    // Like in the BuddyMemoryAllocator, the block offset of an allocation is in a single range
+    // covering all heaps, so the heap of a block is its offset divided by the heap size. The heap
+    // size doesn't need to be a power of two, so alignments are relative to the start of a heap.
+    class SegregatedFitMemoryAllocator {
+      public:
+        SegregatedFitMemoryAllocator(uint64_t heapSize, ResourceHeapAllocator* heapAllocator);
+        ~SegregatedFitMemoryAllocator();
+
+        ResultOrError<ResourceMemoryAllocation> Allocate(uint64_t allocationSize,
+                                                         uint64_t alignment);
+        void Deallocate(const ResourceMemoryAllocation& allocation);
+
+        bool OwnsHeap(const ResourceHeapBase* heap) const;
+
+        // Compaction moves the allocations of a sparse heap to the other heaps so that it gets
+        // released. FindHeapToEvacuate returns the least used heap, if it is at most half full
+        // and the other heaps have enough free space for its allocations, or nullptr.
+        // AllocateOutsideHeap allocates outside of |excludedHeap| without creating heaps, and
+        // returns an invalid allocation when there is no room.
+        const ResourceHeapBase* FindHeapToEvacuate() const;
+        ResourceMemoryAllocation AllocateOutsideHeap(uint64_t allocationSize,
+                                                     uint64_t alignment,
+                                                     const ResourceHeapBase* excludedHeap);
+
+        uint64_t GetHeapSize() const;
+        uint64_t GetHeapCount() const;
+        uint64_t GetUsedSize() const;
+        // The free size of all the heaps is fragmented if it is much larger than the largest free
+        // block.
+        uint64_t GetFreeSize() const;
+        uint64_t GetLargestFreeBlockSize() const;
+
+      private:
+        static constexpr size_t kBinCount = 64;
+        static constexpr uint64_t kInvalidOffset = std::numeric_limits<uint64_t>::max();
+
+        struct Block {
+            uint64_t size;
+            bool isFree;
+        };
+
+        // Free blocks of a bin sorted by size, then offset.
+        using Bin = std::set<std::pair<uint64_t, uint64_t>>;
+
+        struct TrackedHeap {
+            std::unique_ptr<ResourceHeapBase> heap;
+            uint64_t allocationCount = 0;
+            uint64_t usedSize = 0;
+        };
+
+        static size_t GetBinIndex(uint64_t size);
+
+        // Aligns |offset| relative to the start of its heap.
+        uint64_t AlignInHeap(uint64_t offset, uint64_t alignment) const;
+
+        // Returns the offset of a free block that can hold the allocation and isn't in the heap
+        // |excludedHeapIndex|, or kInvalidOffset.
+        uint64_t FindFreeBlock(uint64_t allocationSize,
+                               uint64_t alignment,
+                               uint64_t excludedHeapIndex = kInvalidOffset) const;
+        ResourceMemoryAllocation AllocateInFreeBlock(uint64_t blockOffset,
+                                                     uint64_t allocationSize,
+                                                     uint64_t alignment);
+        MaybeError AddHeap();
+        void ReleaseHeap(uint64_t heapIndex);
+
+        void InsertFreeBlock(uint64_t offset, uint64_t size);
+        void RemoveFreeBlock(uint64_t offset, uint64_t size);
+
+        uint64_t mHeapSize;
+        ResourceHeapAllocator* mHeapAllocator;
+
+        // All the blocks of all the heaps, indexed by their offset.
+        std::map<uint64_t, Block> mBlocks;
+        std::array<Bin, kBinCount> mFreeBins;
+
+        std::vector<TrackedHeap> mHeaps;
+        uint64_t mHeapCount = 0;
+        uint64_t mUsedSize = 0;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_SEGREGATEDFITMEMORYALLOCATOR_H_
@@ -21,6 +21,7 @@
 #include "dawn_native/CompilationMessages.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/ObjectContentHasher.h"
+#include "dawn_native/PersistentCache.h"
 #include "dawn_native/Pipeline.h"
 #include "dawn_native/PipelineLayout.h"
 #include "dawn_native/RenderPipeline.h"
@@ -37,6 +38,10 @@
 #undef SPV_REVISION
 #include <tint/tint.h>
 
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <mutex>
 #include <sstream>
 
 namespace dawn_native {
@@ -634,6 +639,26 @@ namespace dawn_native {
             return {};
         }
 
+        // The immediate data is read from a uniform buffer declared at a group index past the
+        // bind groups, that the backends replace with their own mechanism to set small data.
+        bool IsImmediateDataBinding(const DeviceBase* device, BindGroupIndex group) {
+            return group == BindGroupIndex(kImmediateDataBindGroup) &&
+                   device->IsExtensionEnabled(Extension::ImmediateData);
+        }
+
+        MaybeError ValidateImmediateDataBinding(BindingNumber binding,
+                                                bool isUniformBuffer,
+                                                uint64_t size) {
+            if (binding != BindingNumber(0) || !isUniformBuffer) {
+                return DAWN_VALIDATION_ERROR(
+                    "The immediate data must be a uniform buffer at binding 0");
+            }
+            if (size > kMaxImmediateDataSize) {
+                return DAWN_VALIDATION_ERROR("The immediate data is larger than the maximum size");
+            }
+            return {};
+        }
+
         ResultOrError<std::unique_ptr<EntryPointMetadata>> ExtractSpirvInfo(
             const DeviceBase* device,
             const spirv_cross::Compiler& compiler,
@@ -656,11 +681,11 @@ namespace dawn_native {
 
             // Fill in bindingInfo with the SPIRV bindings
             auto ExtractResourcesBinding =
-                [](const DeviceBase* device,
-                   const spirv_cross::SmallVector<spirv_cross::Resource>& resources,
-                   const spirv_cross::Compiler& compiler, BindingInfoType bindingType,
-                   EntryPointMetadata::BindingInfoArray* metadataBindings,
-                   bool isStorageBuffer = false) -> MaybeError {
+                [&metadata](const DeviceBase* device,
+                            const spirv_cross::SmallVector<spirv_cross::Resource>& resources,
+                            const spirv_cross::Compiler& compiler, BindingInfoType bindingType,
+                            EntryPointMetadata::BindingInfoArray* metadataBindings,
+                            bool isStorageBuffer = false) -> MaybeError {
                 for (const auto& resource : resources) {
                     if (!compiler.get_decoration_bitset(resource.id).get(spv::DecorationBinding)) {
                         return DAWN_VALIDATION_ERROR("No Binding decoration set for resource");
@@ -676,6 +701,17 @@ namespace dawn_native {
                     BindGroupIndex bindGroupIndex(
                         compiler.get_decoration(resource.id, spv::DecorationDescriptorSet));
 
+                    if (IsImmediateDataBinding(device, bindGroupIndex)) {
+                        uint64_t size = compiler.get_declared_struct_size(
+                            compiler.get_type(resource.base_type_id));
+                        bool isUniformBuffer =
+                            bindingType == BindingInfoType::Buffer && !isStorageBuffer;
+                        DAWN_TRY(
+                            ValidateImmediateDataBinding(bindingNumber, isUniformBuffer, size));
+                        metadata->immediateDataSize = static_cast<uint32_t>(size);
+                        continue;
+                    }
+
                     if (bindGroupIndex >= kMaxBindGroupsTyped) {
                         return DAWN_VALIDATION_ERROR("Bind group index over limits in the SPIRV");
                     }
@@ -871,12 +907,90 @@ namespace dawn_native {
             return {std::move(metadata)};
         }
 
-        ResultOrError<EntryPointMetadataTable> ReflectShaderUsingTint(
-            DeviceBase*,
+        // Lists the entry points of the program without reflecting them, which is much cheaper
+        // than the inspector.
+        ResultOrError<std::unique_ptr<EntryPointMetadata>> ReflectEntryPointUsingSPIRVCross(
+            const DeviceBase* device,
+            spirv_cross::Compiler* compiler,
+            const std::string& entryPointName,
+            SingleShaderStage stage) {
+            compiler->set_entry_point(entryPointName, ShaderStageToExecutionModel(stage));
+            return ExtractSpirvInfo(device, *compiler, entryPointName, stage);
+        }
+
+        // Lists the entry points of the SPIR-V from its OpEntryPoint instructions, without
+        // parsing the rest of the module.
+        ResultOrError<EntryPointStageTable> ListSpirvEntryPoints(
+            const std::vector<uint32_t>& spirv) {
+            constexpr size_t kHeaderSize = 5;
+            constexpr size_t kEntryPointNameOffset = 3;
+
+            EntryPointStageTable result;
+            size_t i = kHeaderSize;
+            while (i < spirv.size()) {
+                uint32_t wordCount = spirv[i] >> spv::WordCountShift;
+                if (wordCount == 0 || wordCount > spirv.size() - i) {
+                    return DAWN_VALIDATION_ERROR("Invalid SPIR-V instruction");
+                }
+
+                spv::Op opcode = static_cast<spv::Op>(spirv[i] & spv::OpCodeMask);
+                // Entry points are declared before all the functions.
+                if (opcode == spv::OpFunction) {
+                    break;
+                }
+
+                if (opcode == spv::OpEntryPoint) {
+                    if (wordCount <= kEntryPointNameOffset) {
+                        return DAWN_VALIDATION_ERROR("Invalid SPIR-V OpEntryPoint");
+                    }
+
+                    spv::ExecutionModel model = static_cast<spv::ExecutionModel>(spirv[i + 1]);
+                    if (model != spv::ExecutionModelVertex &&
+                        model != spv::ExecutionModelFragment &&
+                        model != spv::ExecutionModelGLCompute) {
+                        return DAWN_VALIDATION_ERROR("Unsupported SPIR-V execution model");
+                    }
+
+                    // The name is a nul-terminated string packed in the remaining words.
+                    const char* name =
+                        reinterpret_cast<const char*>(&spirv[i + kEntryPointNameOffset]);
+                    size_t maxLength = (wordCount - kEntryPointNameOffset) * sizeof(uint32_t);
+                    std::string entryPointName(name, strnlen(name, maxLength));
+                    if (result.count(entryPointName) != 0) {
+                        return DAWN_VALIDATION_ERROR("Duplicate SPIR-V entry point name");
+                    }
+                    result[entryPointName] = ExecutionModelToShaderStage(model);
+                }
+
+                i += wordCount;
+            }
+            return std::move(result);
+        }
+
+        ResultOrError<EntryPointStageTable> ListEntryPointsUsingTint(
             const tint::Program* program) {
             ASSERT(program->IsValid());
 
-            EntryPointMetadataTable result;
+            EntryPointStageTable result;
+            for (const tint::ast::Function* function : program->AST().Functions()) {
+                if (!function->IsEntryPoint()) {
+                    continue;
+                }
+
+                std::string name = program->Symbols().NameFor(function->symbol());
+                ASSERT(result.count(name) == 0);
+                DAWN_TRY_ASSIGN(result[name],
+                                TintPipelineStageToShaderStage(function->pipeline_stage()));
+            }
+            return std::move(result);
+        }
+
+        ResultOrError<std::unique_ptr<EntryPointMetadata>> ReflectEntryPointUsingTint(
+            DeviceBase* device,
+            const tint::Program* program,
+            const std::string& entryPointName) {
+            ASSERT(program->IsValid());
+
             std::ostringstream errorStream;
             errorStream << "Tint Reflection failure:" << std::endl;
 
@@ -887,151 +1001,156 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR(errorStream.str().c_str());
             }
 
-            for (auto& entryPoint : entryPoints) {
-                ASSERT(result.count(entryPoint.name) == 0);
+            auto entryPointIt = std::find_if(entryPoints.begin(), entryPoints.end(),
+                                             [&](const tint::inspector::EntryPoint& entryPoint) {
+                                                 return entryPoint.name == entryPointName;
+                                             });
+            ASSERT(entryPointIt != entryPoints.end());
+            const tint::inspector::EntryPoint& entryPoint = *entryPointIt;
 
-                auto metadata = std::make_unique<EntryPointMetadata>();
+            auto metadata = std::make_unique<EntryPointMetadata>();
 
-                DAWN_TRY_ASSIGN(metadata->stage, TintPipelineStageToShaderStage(entryPoint.stage));
-                if (metadata->stage == SingleShaderStage::Vertex) {
-                    for (auto& stage_input : entryPoint.input_variables) {
-                        if (!stage_input.has_location_decoration) {
-                            return DAWN_VALIDATION_ERROR(
-                                "Need Location decoration on Vertex input");
-                        }
-                        uint32_t location = stage_input.location_decoration;
-                        if (location >= kMaxVertexAttributes) {
-                            return DAWN_VALIDATION_ERROR("Attribute location over limits");
-                        }
-                        metadata->usedVertexAttributes.set(location);
+            DAWN_TRY_ASSIGN(metadata->stage, TintPipelineStageToShaderStage(entryPoint.stage));
+            if (metadata->stage == SingleShaderStage::Vertex) {
+                for (auto& stage_input : entryPoint.input_variables) {
+                    if (!stage_input.has_location_decoration) {
+                        return DAWN_VALIDATION_ERROR("Need Location decoration on Vertex input");
                     }
-
-                    for (auto& stage_output : entryPoint.output_variables) {
-                        if (!stage_output.has_location_decoration) {
-                            return DAWN_VALIDATION_ERROR(
-                                "Need Location decoration on Vertex output");
-                        }
+                    uint32_t location = stage_input.location_decoration;
+                    if (location >= kMaxVertexAttributes) {
+                        return DAWN_VALIDATION_ERROR("Attribute location over limits");
                     }
+                    metadata->usedVertexAttributes.set(location);
                 }
 
-                if (metadata->stage == SingleShaderStage::Compute) {
-                    metadata->localWorkgroupSize.x = entryPoint.workgroup_size_x;
-                    metadata->localWorkgroupSize.y = entryPoint.workgroup_size_y;
-                    metadata->localWorkgroupSize.z = entryPoint.workgroup_size_z;
+                for (auto& stage_output : entryPoint.output_variables) {
+                    if (!stage_output.has_location_decoration) {
+                        return DAWN_VALIDATION_ERROR("Need Location decoration on Vertex output");
+                    }
                 }
+            }
 
-                if (metadata->stage == SingleShaderStage::Vertex) {
-                    for (const auto& input_var : entryPoint.input_variables) {
-                        uint32_t location = 0;
-                        if (input_var.has_location_decoration) {
-                            location = input_var.location_decoration;
-                        }
+            if (metadata->stage == SingleShaderStage::Compute) {
+                metadata->localWorkgroupSize.x = entryPoint.workgroup_size_x;
+                metadata->localWorkgroupSize.y = entryPoint.workgroup_size_y;
+                metadata->localWorkgroupSize.z = entryPoint.workgroup_size_z;
+            }
 
-                        if (DAWN_UNLIKELY(location >= kMaxVertexAttributes)) {
-                            std::stringstream ss;
-                            ss << "Attribute location (" << location << ") over limits";
-                            return DAWN_VALIDATION_ERROR(ss.str());
-                        }
-                        metadata->usedVertexAttributes.set(location);
+            if (metadata->stage == SingleShaderStage::Vertex) {
+                for (const auto& input_var : entryPoint.input_variables) {
+                    uint32_t location = 0;
+                    if (input_var.has_location_decoration) {
+                        location = input_var.location_decoration;
                     }
 
-                    for (const auto& output_var : entryPoint.output_variables) {
-                        if (DAWN_UNLIKELY(!output_var.has_location_decoration)) {
-                            std::stringstream ss;
-                            ss << "Missing location qualifier on vertex output, "
-                               << output_var.name;
-                            return DAWN_VALIDATION_ERROR(ss.str());
-                        }
+                    if (DAWN_UNLIKELY(location >= kMaxVertexAttributes)) {
+                        std::stringstream ss;
+                        ss << "Attribute location (" << location << ") over limits";
+                        return DAWN_VALIDATION_ERROR(ss.str());
                     }
+                    metadata->usedVertexAttributes.set(location);
                 }
 
-                if (metadata->stage == SingleShaderStage::Fragment) {
-                    for (const auto& input_var : entryPoint.input_variables) {
-                        if (!input_var.has_location_decoration) {
-                            return DAWN_VALIDATION_ERROR(
-                                "Need location decoration on fragment input");
-                        }
+                for (const auto& output_var : entryPoint.output_variables) {
+                    if (DAWN_UNLIKELY(!output_var.has_location_decoration)) {
+                        std::stringstream ss;
+                        ss << "Missing location qualifier on vertex output, " << output_var.name;
+                        return DAWN_VALIDATION_ERROR(ss.str());
                     }
+                }
+            }
 
-                    for (const auto& output_var : entryPoint.output_variables) {
-                        if (!output_var.has_location_decoration) {
-                            return DAWN_VALIDATION_ERROR(
-                                "Need location decoration on fragment output");
-                        }
-
-                        uint32_t unsanitizedAttachment = output_var.location_decoration;
-                        if (unsanitizedAttachment >= kMaxColorAttachments) {
-                            return DAWN_VALIDATION_ERROR(
-                                "Fragment output index must be less than max number of color "
-                                "attachments");
-                        }
-                        ColorAttachmentIndex attachment(
-                            static_cast<uint8_t>(unsanitizedAttachment));
-                        DAWN_TRY_ASSIGN(
-                            metadata->fragmentOutputFormatBaseTypes[attachment],
-                            TintComponentTypeToTextureComponentType(output_var.component_type));
-                        metadata->fragmentOutputsWritten.set(attachment);
+            if (metadata->stage == SingleShaderStage::Fragment) {
+                for (const auto& input_var : entryPoint.input_variables) {
+                    if (!input_var.has_location_decoration) {
+                        return DAWN_VALIDATION_ERROR("Need location decoration on fragment input");
                     }
                 }
 
-                for (auto& resource : inspector.GetResourceBindings(entryPoint.name)) {
-                    BindingNumber bindingNumber(resource.binding);
-                    BindGroupIndex bindGroupIndex(resource.bind_group);
-                    if (bindGroupIndex >= kMaxBindGroupsTyped) {
-                        return DAWN_VALIDATION_ERROR("Shader has bind group index over limits");
+                for (const auto& output_var : entryPoint.output_variables) {
+                    if (!output_var.has_location_decoration) {
+                        return DAWN_VALIDATION_ERROR("Need location decoration on fragment output");
                     }
 
-                    const auto& it = metadata->bindings[bindGroupIndex].emplace(
-                        bindingNumber, EntryPointMetadata::ShaderBindingInfo{});
-                    if (!it.second) {
-                        return DAWN_VALIDATION_ERROR("Shader has duplicate bindings");
+                    uint32_t unsanitizedAttachment = output_var.location_decoration;
+                    if (unsanitizedAttachment >= kMaxColorAttachments) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Fragment output index must be less than max number of color "
+                            "attachments");
                     }
+                    ColorAttachmentIndex attachment(static_cast<uint8_t>(unsanitizedAttachment));
+                    DAWN_TRY_ASSIGN(
+                        metadata->fragmentOutputFormatBaseTypes[attachment],
+                        TintComponentTypeToTextureComponentType(output_var.component_type));
+                    metadata->fragmentOutputsWritten.set(attachment);
+                }
+            }
 
-                    EntryPointMetadata::ShaderBindingInfo* info = &it.first->second;
-                    info->bindingType = TintResourceTypeToBindingInfoType(resource.resource_type);
+            for (auto& resource : inspector.GetResourceBindings(entryPoint.name)) {
+                BindingNumber bindingNumber(resource.binding);
+                BindGroupIndex bindGroupIndex(resource.bind_group);
+                if (IsImmediateDataBinding(device, bindGroupIndex)) {
+                    DAWN_TRY(ValidateImmediateDataBinding(
+                        bindingNumber,
+                        resource.resource_type ==
+                            tint::inspector::ResourceBinding::ResourceType::kUniformBuffer,
+                        resource.size_no_padding));
+                    metadata->immediateDataSize = static_cast<uint32_t>(resource.size_no_padding);
+                    continue;
+                }
+                if (bindGroupIndex >= kMaxBindGroupsTyped) {
+                    return DAWN_VALIDATION_ERROR("Shader has bind group index over limits");
+                }
 
-                    switch (info->bindingType) {
-                        case BindingInfoType::Buffer:
-                            info->buffer.minBindingSize = resource.size_no_padding;
-                            DAWN_TRY_ASSIGN(info->buffer.type, TintResourceTypeToBufferBindingType(
-                                                                   resource.resource_type));
-                            break;
-                        case BindingInfoType::Sampler:
-                            info->sampler.type = wgpu::SamplerBindingType::Filtering;
-                            break;
-                        case BindingInfoType::Texture:
-                            info->texture.viewDimension =
-                                TintTextureDimensionToTextureViewDimension(resource.dim);
-                            if (resource.resource_type ==
-                                tint::inspector::ResourceBinding::ResourceType::kDepthTexture) {
-                                info->texture.sampleType = wgpu::TextureSampleType::Depth;
-                            } else {
-                                info->texture.sampleType =
-                                    TintSampledKindToTextureSampleType(resource.sampled_kind);
-                            }
-                            info->texture.multisampled = resource.resource_type ==
-                                                         tint::inspector::ResourceBinding::
-                                                             ResourceType::kMultisampledTexture;
+                const auto& it = metadata->bindings[bindGroupIndex].emplace(
+                    bindingNumber, EntryPointMetadata::ShaderBindingInfo{});
+                if (!it.second) {
+                    return DAWN_VALIDATION_ERROR("Shader has duplicate bindings");
+                }
 
-                            break;
-                        case BindingInfoType::StorageTexture:
-                            DAWN_TRY_ASSIGN(
-                                info->storageTexture.access,
-                                TintResourceTypeToStorageTextureAccess(resource.resource_type));
-                            info->storageTexture.format =
-                                TintImageFormatToTextureFormat(resource.image_format);
-                            info->storageTexture.viewDimension =
-                                TintTextureDimensionToTextureViewDimension(resource.dim);
+                EntryPointMetadata::ShaderBindingInfo* info = &it.first->second;
+                info->bindingType = TintResourceTypeToBindingInfoType(resource.resource_type);
 
-                            break;
-                        default:
-                            return DAWN_VALIDATION_ERROR("Unknown binding type in Shader");
-                    }
-                }
+                switch (info->bindingType) {
+                    case BindingInfoType::Buffer:
+                        info->buffer.minBindingSize = resource.size_no_padding;
+                        DAWN_TRY_ASSIGN(info->buffer.type, TintResourceTypeToBufferBindingType(
+                                                               resource.resource_type));
+                        break;
+                    case BindingInfoType::Sampler:
+                        info->sampler.type = wgpu::SamplerBindingType::Filtering;
+                        break;
+                    case BindingInfoType::Texture:
+                        info->texture.viewDimension =
+                            TintTextureDimensionToTextureViewDimension(resource.dim);
+                        if (resource.resource_type ==
+                            tint::inspector::ResourceBinding::ResourceType::kDepthTexture) {
+                            info->texture.sampleType = wgpu::TextureSampleType::Depth;
+                        } else {
+                            info->texture.sampleType =
+                                TintSampledKindToTextureSampleType(resource.sampled_kind);
+                        }
+                        info->texture.multisampled = resource.resource_type ==
+                                                     tint::inspector::ResourceBinding::
+                                                         ResourceType::kMultisampledTexture;
 
-                result[entryPoint.name] = std::move(metadata);
+                        break;
+                    case BindingInfoType::StorageTexture:
+                        DAWN_TRY_ASSIGN(
+                            info->storageTexture.access,
+                            TintResourceTypeToStorageTextureAccess(resource.resource_type));
+                        info->storageTexture.format =
+                            TintImageFormatToTextureFormat(resource.image_format);
+                        info->storageTexture.viewDimension =
+                            TintTextureDimensionToTextureViewDimension(resource.dim);
+
+                        break;
+                    default:
+                        return DAWN_VALIDATION_ERROR("Unknown binding type in Shader");
+                }
             }
-            return std::move(result);
+
+            return std::move(metadata);
         }
     }  // anonymous namespace
 
@@ -1060,6 +1179,194 @@ namespace dawn_native {
         tint::Source::File file;
     };
 
+    namespace {
+
+        // A program parsed again from the WGSL source of a module, that keeps its source alive for
+        // the diagnostics of the transforms.
+        struct ReparsedWgslProgram {
+            explicit ReparsedWgslProgram(const std::string& wgsl) : source("", wgsl) {
+            }
+
+            TintSource source;
+            tint::Program program;
+        };
+
+        // The key of the process-wide cache of shader parse results. It contains the whole source
+        // so that a lookup can never return the result of another source with the same hash.
+        // With persistSpirvValidation, the SPIR-V validation can come from the persistent cache
+        // of the device, so the result must not be shared with devices that really validate it.
+        struct ShaderParseCacheKey {
+            enum class SourceType : uint8_t { Spirv, Wgsl };
+
+            SourceType sourceType;
+            bool useTintGenerator;
+            bool persistSpirvValidation;
+            std::string source;
+            size_t hash;
+
+            ShaderParseCacheKey(SourceType sourceType,
+                                bool useTintGenerator,
+                                bool persistSpirvValidation,
+                                const void* data,
+                                size_t size)
+                : sourceType(sourceType),
+                  useTintGenerator(useTintGenerator),
+                  persistSpirvValidation(persistSpirvValidation),
+                  source(static_cast<const char*>(data), size) {
+                hash = HashBytes(data, size);
+                HashCombine(&hash, sourceType, useTintGenerator, persistSpirvValidation);
+            }
+
+            bool operator==(const ShaderParseCacheKey& other) const {
+                return hash == other.hash && sourceType == other.sourceType &&
+                       useTintGenerator == other.useTintGenerator &&
+                       persistSpirvValidation == other.persistSpirvValidation &&
+                       source == other.source;
+            }
+
+            struct HashFunc {
+                size_t operator()(const ShaderParseCacheKey& key) const {
+                    return key.hash;
+                }
+            };
+        };
+
+        // The immutable result of the successful parse and validation of a source, shared by all
+        // the shader modules created from that source on any device.
+        struct ShaderParseCacheEntry {
+            std::shared_ptr<const tint::Program> tintProgram;
+            std::shared_ptr<TintSource> tintSource;
+            // Only set for SPIR-V generated from WGSL. SPIR-V sources are used as they are.
+            std::vector<uint32_t> spirv;
+            OwnedCompilationMessages compilationMessages;
+        };
+
+        // Applications often create the same shader modules on several devices, or again after
+        // recreating their device or loading a level. The per-device cache of shader modules
+        // doesn't help in these cases, so the parse results are also cached for the whole
+        // process, and evicted in least recently used order.
+        class ShaderParseCache {
+          public:
+            static constexpr size_t kMaxEntries = 4096;
+
+            std::shared_ptr<const ShaderParseCacheEntry> Find(const ShaderParseCacheKey& key) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto it = mEntries.find(key);
+                if (it == mEntries.end()) {
+                    return nullptr;
+                }
+                mRecentlyUsed.splice(mRecentlyUsed.begin(), mRecentlyUsed, it->second.recentlyUsed);
+                return it->second.entry;
+            }
+
+            void Insert(ShaderParseCacheKey key,
+                        std::shared_ptr<const ShaderParseCacheEntry> entry) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                auto inserted = mEntries.emplace(std::move(key), Value{std::move(entry), {}});
+                if (!inserted.second) {
+                    // Another thread parsed the same source at the same time.
+                    return;
+                }
+                mRecentlyUsed.push_front(&inserted.first->first);
+                inserted.first->second.recentlyUsed = mRecentlyUsed.begin();
+
+                if (mEntries.size() > kMaxEntries) {
+                    mEntries.erase(mEntries.find(*mRecentlyUsed.back()));
+                    mRecentlyUsed.pop_back();
+                }
+            }
+
+          private:
+            struct Value {
+                std::shared_ptr<const ShaderParseCacheEntry> entry;
+                std::list<const ShaderParseCacheKey*>::iterator recentlyUsed;
+            };
+
+            std::mutex mMutex;
+            std::unordered_map<ShaderParseCacheKey, Value, ShaderParseCacheKey::HashFunc> mEntries;
+            // Points at the keys in mEntries, the most recently used first.
+            std::list<const ShaderParseCacheKey*> mRecentlyUsed;
+        };
+
+        // Leaked on purpose to avoid static constructors and exit-time destructors.
+        ShaderParseCache* GetShaderParseCache() {
+            static ShaderParseCache* cache = new ShaderParseCache();
+            return cache;
+        }
+
+        MaybeError ValidateSpirvWithPersistentCache(DeviceBase* device,
+                                                    const std::vector<uint32_t>& spirv) {
+            if (!device->IsToggleEnabled(Toggle::PersistSpirvValidation)) {
+                return ValidateSpirv(spirv.data(), spirv.size());
+            }
+
+            uint32_t keyType = static_cast<uint32_t>(PersistentKeyType::SpirvValidation);
+            PersistentCacheKey key(sizeof(keyType) + spirv.size() * sizeof(uint32_t));
+            memcpy(key.data(), &keyType, sizeof(keyType));
+            memcpy(key.data() + sizeof(keyType), spirv.data(), spirv.size() * sizeof(uint32_t));
+
+            PersistentCache* persistentCache = device->GetPersistentCache();
+            if (persistentCache->LoadData(key).bufferSize > 0) {
+                return {};
+            }
+
+            DAWN_TRY(ValidateSpirv(spirv.data(), spirv.size()));
+
+            constexpr uint8_t kValidated = 1;
+            persistentCache->StoreData(key, &kValidated, sizeof(kValidated));
+            return {};
+        }
+
+        MaybeError ParseShaderModule(DeviceBase* device,
+                                     const ShaderModuleSPIRVDescriptor* spirvDesc,
+                                     const ShaderModuleWGSLDescriptor* wgslDesc,
+                                     ShaderModuleParseResult* parseResult) {
+            OwnedCompilationMessages* outMessages = parseResult->compilationMessages.get();
+
+            if (spirvDesc) {
+                std::vector<uint32_t> spirv(spirvDesc->code, spirvDesc->code + spirvDesc->codeSize);
+                if (device->IsToggleEnabled(Toggle::UseTintGenerator)) {
+                    tint::Program program;
+                    DAWN_TRY_ASSIGN(program, ParseSPIRV(spirv, outMessages));
+                    parseResult->tintProgram = std::make_shared<tint::Program>(std::move(program));
+                } else {
+                    if (device->IsValidationEnabled()) {
+                        DAWN_TRY(ValidateSpirvWithPersistentCache(device, spirv));
+                    }
+                    parseResult->spirv = std::move(spirv);
+                }
+            } else if (wgslDesc) {
+                auto tintSource = std::make_shared<TintSource>("", wgslDesc->source);
+
+                tint::Program program;
+                DAWN_TRY_ASSIGN(program, ParseWGSL(&tintSource->file, outMessages));
+
+                if (device->IsToggleEnabled(Toggle::UseTintGenerator)) {
+                    parseResult->tintProgram = std::make_shared<tint::Program>(std::move(program));
+                    parseResult->tintSource = std::move(tintSource);
+                } else {
+                    tint::transform::Manager transformManager;
+                    transformManager.Add<tint::transform::EmitVertexPointSize>();
+                    transformManager.Add<tint::transform::Spirv>();
+
+                    tint::transform::DataMap transformInputs;
+
+                    DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, &program,
+                                                           transformInputs, nullptr, outMessages));
+
+                    std::vector<uint32_t> spirv;
+                    DAWN_TRY_ASSIGN(spirv, ModuleToSPIRV(&program));
+                    DAWN_TRY(ValidateSpirvWithPersistentCache(device, spirv));
+
+                    parseResult->spirv = std::move(spirv);
+                }
+            }
+
+            return {};
+        }
+
+    }  // anonymous namespace
+
     MaybeError ValidateShaderModuleDescriptor(DeviceBase* device,
                                               const ShaderModuleDescriptor* descriptor,
                                               ShaderModuleParseResult* parseResult) {
@@ -1074,53 +1381,65 @@ namespace dawn_native {
             wgpu::SType::ShaderModuleSPIRVDescriptor,
             wgpu::SType::ShaderModuleWGSLDescriptor));
 
-        OwnedCompilationMessages* outMessages = parseResult->compilationMessages.get();
-
         ScopedTintICEHandler scopedICEHandler(device);
 
         const ShaderModuleSPIRVDescriptor* spirvDesc = nullptr;
         FindInChain(chainedDescriptor, &spirvDesc);
         const ShaderModuleWGSLDescriptor* wgslDesc = nullptr;
         FindInChain(chainedDescriptor, &wgslDesc);
+        if (spirvDesc == nullptr && wgslDesc == nullptr) {
+            return {};
+        }
 
-        if (spirvDesc) {
-            std::vector<uint32_t> spirv(spirvDesc->code, spirvDesc->code + spirvDesc->codeSize);
-            if (device->IsToggleEnabled(Toggle::UseTintGenerator)) {
-                tint::Program program;
-                DAWN_TRY_ASSIGN(program, ParseSPIRV(spirv, outMessages));
-                parseResult->tintProgram = std::make_unique<tint::Program>(std::move(program));
-            } else {
-                if (device->IsValidationEnabled()) {
-                    DAWN_TRY(ValidateSpirv(spirv.data(), spirv.size()));
-                }
-                parseResult->spirv = std::move(spirv);
-            }
-        } else if (wgslDesc) {
-            auto tintSource = std::make_unique<TintSource>("", wgslDesc->source);
-
-            tint::Program program;
-            DAWN_TRY_ASSIGN(program, ParseWGSL(&tintSource->file, outMessages));
+        if (device->IsToggleEnabled(Toggle::DisableShaderParseCache)) {
+            return ParseShaderModule(device, spirvDesc, wgslDesc, parseResult);
+        }
 
-            if (device->IsToggleEnabled(Toggle::UseTintGenerator)) {
-                parseResult->tintProgram = std::make_unique<tint::Program>(std::move(program));
-                parseResult->tintSource = std::move(tintSource);
+        bool useTintGenerator = device->IsToggleEnabled(Toggle::UseTintGenerator);
+        bool persistSpirvValidation = device->IsToggleEnabled(Toggle::PersistSpirvValidation);
+        ShaderParseCacheKey key =
+            spirvDesc != nullptr
+                ? ShaderParseCacheKey(ShaderParseCacheKey::SourceType::Spirv, useTintGenerator,
+                                      persistSpirvValidation, spirvDesc->code,
+                                      spirvDesc->codeSize * sizeof(uint32_t))
+                : ShaderParseCacheKey(ShaderParseCacheKey::SourceType::Wgsl, useTintGenerator,
+                                      persistSpirvValidation, wgslDesc->source,
+                                      strlen(wgslDesc->source));
+
+        ShaderParseCache* cache = GetShaderParseCache();
+        if (std::shared_ptr<const ShaderParseCacheEntry> cached = cache->Find(key)) {
+            parseResult->tintProgram = cached->tintProgram;
+            parseResult->tintSource = cached->tintSource;
+            if (spirvDesc != nullptr && !useTintGenerator) {
+                parseResult->spirv.assign(spirvDesc->code, spirvDesc->code + spirvDesc->codeSize);
             } else {
-                tint::transform::Manager transformManager;
-                transformManager.Add<tint::transform::EmitVertexPointSize>();
-                transformManager.Add<tint::transform::Spirv>();
+                parseResult->spirv = cached->spirv;
+            }
+            parseResult->compilationMessages->AddMessages(cached->compilationMessages);
+            return {};
+        }
 
-                tint::transform::DataMap transformInputs;
+        DAWN_TRY(ParseShaderModule(device, spirvDesc, wgslDesc, parseResult));
 
-                DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, &program,
-                                                       transformInputs, nullptr, outMessages));
+        // SPIR-V that wasn't validated can't be cached since it would skip the validation of
+        // other devices.
+        if (spirvDesc != nullptr && !useTintGenerator && !device->IsValidationEnabled()) {
+            return {};
+        }
 
-                std::vector<uint32_t> spirv;
-                DAWN_TRY_ASSIGN(spirv, ModuleToSPIRV(&program));
-                DAWN_TRY(ValidateSpirv(spirv.data(), spirv.size()));
+        // The cache would keep alive the programs the device wants to release.
+        if (useTintGenerator && device->IsToggleEnabled(Toggle::ReleaseShaderModulePrograms)) {
+            return {};
+        }
 
-                parseResult->spirv = std::move(spirv);
-            }
+        auto entry = std::make_shared<ShaderParseCacheEntry>();
+        entry->tintProgram = parseResult->tintProgram;
+        entry->tintSource = parseResult->tintSource;
+        if (wgslDesc != nullptr) {
+            entry->spirv = parseResult->spirv;
         }
+        entry->compilationMessages.AddMessages(*parseResult->compilationMessages);
+        cache->Insert(std::move(key), std::move(entry));
 
         return {};
     }
@@ -1200,6 +1519,11 @@ namespace dawn_native {
             }
         }
 
+        if (entryPoint.immediateDataSize > layout->GetImmediateDataSize()) {
+            return DAWN_VALIDATION_ERROR(
+                "The immediate data of the shader is larger than the pipeline layout's");
+        }
+
         return {};
     }
 
@@ -1246,11 +1570,51 @@ namespace dawn_native {
     }
 
     bool ShaderModuleBase::HasEntryPoint(const std::string& entryPoint) const {
-        return mEntryPoints.count(entryPoint) > 0;
+        return mEntryPointStages.count(entryPoint) > 0;
     }
 
-    const EntryPointMetadata& ShaderModuleBase::GetEntryPoint(const std::string& entryPoint) const {
+    MaybeError ShaderModuleBase::ReflectEntryPoint(const std::string& entryPoint) {
         ASSERT(HasEntryPoint(entryPoint));
+        if (mEntryPoints.count(entryPoint) > 0) {
+            return {};
+        }
+
+        std::unique_ptr<EntryPointMetadata> metadata;
+        if (GetDevice()->IsToggleEnabled(Toggle::UseTintGenerator)) {
+            ScopedTintICEHandler scopedICEHandler(GetDevice());
+
+            // The program isn't released here since the pipeline is compiled next.
+            std::shared_ptr<const tint::Program> program = mTintProgram;
+            if (program == nullptr) {
+                program = mReleasedTintProgram.lock();
+            }
+            if (program == nullptr) {
+                DAWN_TRY_ASSIGN(program, ReparseTintProgram());
+                mReleasedTintProgram = program;
+            }
+            DAWN_TRY_ASSIGN(metadata,
+                            ReflectEntryPointUsingTint(GetDevice(), program.get(), entryPoint));
+        } else {
+            if (mSpirvCrossCompiler == nullptr) {
+                mSpirvCrossCompiler = std::make_unique<spirv_cross::Compiler>(mSpirv);
+            }
+            DAWN_TRY_ASSIGN(metadata, ReflectEntryPointUsingSPIRVCross(
+                                          GetDevice(), mSpirvCrossCompiler.get(), entryPoint,
+                                          mEntryPointStages.at(entryPoint)));
+        }
+
+        ASSERT(metadata->stage == mEntryPointStages.at(entryPoint));
+        mEntryPoints[entryPoint] = std::move(metadata);
+
+        // The parsed SPIR-V isn't needed anymore once all the entry points are reflected.
+        if (mEntryPoints.size() == mEntryPointStages.size()) {
+            mSpirvCrossCompiler = nullptr;
+        }
+        return {};
+    }
+
+    const EntryPointMetadata& ShaderModuleBase::GetEntryPoint(const std::string& entryPoint) const {
+        ASSERT(mEntryPoints.count(entryPoint) > 0);
         return *mEntryPoints.at(entryPoint);
     }
 
@@ -1268,6 +1632,48 @@ namespace dawn_native {
                a->mWgsl == b->mWgsl;
     }
 
+    // static
+    size_t ShaderModuleBase::ComputeDescriptorContentHash(
+        const ShaderModuleDescriptor* descriptor) {
+        const ShaderModuleSPIRVDescriptor* spirvDesc = nullptr;
+        FindInChain(descriptor->nextInChain, &spirvDesc);
+        const ShaderModuleWGSLDescriptor* wgslDesc = nullptr;
+        FindInChain(descriptor->nextInChain, &wgslDesc);
+        ASSERT(spirvDesc || wgslDesc);
+
+        // This must match ComputeContentHash, where vectors and strings are recorded as ranges
+        // of bytes, and the unused source is empty.
+        size_t hash = 0;
+        if (spirvDesc) {
+            HashCombine(&hash, Type::Spirv);
+            HashCombine(&hash, HashBytes(spirvDesc->code, spirvDesc->codeSize * sizeof(uint32_t)));
+            HashCombine(&hash, HashBytes(nullptr, 0));
+        } else {
+            HashCombine(&hash, Type::Wgsl);
+            HashCombine(&hash, HashBytes(nullptr, 0));
+            HashCombine(&hash, HashBytes(wgslDesc->source, strlen(wgslDesc->source)));
+        }
+        return hash;
+    }
+
+    bool ShaderModuleBase::MatchesDescriptor(const ShaderModuleDescriptor* descriptor) const {
+        const ShaderModuleSPIRVDescriptor* spirvDesc = nullptr;
+        FindInChain(descriptor->nextInChain, &spirvDesc);
+        const ShaderModuleWGSLDescriptor* wgslDesc = nullptr;
+        FindInChain(descriptor->nextInChain, &wgslDesc);
+
+        if (spirvDesc) {
+            return mType == Type::Spirv && mOriginalSpirv.size() == spirvDesc->codeSize &&
+                   std::equal(mOriginalSpirv.begin(), mOriginalSpirv.end(), spirvDesc->code);
+        }
+        ASSERT(wgslDesc);
+        return mType == Type::Wgsl && mWgsl == wgslDesc->source;
+    }
+
+    uint64_t ShaderModuleBase::GetSourceSize() const {
+        return mOriginalSpirv.size() * sizeof(uint32_t) + mWgsl.size();
+    }
+
     const std::vector<uint32_t>& ShaderModuleBase::GetSpirv() const {
         ASSERT(!GetDevice()->IsToggleEnabled(Toggle::UseTintGenerator));
         return mSpirv;
@@ -1275,9 +1681,67 @@ namespace dawn_native {
 
     const tint::Program* ShaderModuleBase::GetTintProgram() const {
         ASSERT(GetDevice()->IsToggleEnabled(Toggle::UseTintGenerator));
+        ASSERT(mTintProgram != nullptr);
         return mTintProgram.get();
     }
 
+    ResultOrError<std::shared_ptr<const tint::Program>> ShaderModuleBase::AcquireTintProgram() {
+        ASSERT(GetDevice()->IsToggleEnabled(Toggle::UseTintGenerator));
+
+        std::shared_ptr<const tint::Program> program;
+        if (!GetDevice()->IsToggleEnabled(Toggle::ReleaseShaderModulePrograms)) {
+            program = mTintProgram;
+            return std::move(program);
+        }
+
+        program = std::move(mTintProgram);
+        if (program == nullptr) {
+            program = mReleasedTintProgram.lock();
+        }
+        if (program == nullptr) {
+            DAWN_TRY_ASSIGN(program, ReparseTintProgram());
+        }
+        mReleasedTintProgram = program;
+        return std::move(program);
+    }
+
+    ResultOrError<std::shared_ptr<const tint::Program>> ShaderModuleBase::ReparseTintProgram() {
+        // The source was already validated when the module was created, and its compilation
+        // messages already recorded.
+        std::shared_ptr<const tint::Program> program;
+        if (mType == Type::Spirv) {
+            tint::Program parsed;
+            DAWN_TRY_ASSIGN(parsed, ParseSPIRV(mOriginalSpirv, nullptr));
+            program = std::make_shared<tint::Program>(std::move(parsed));
+        } else {
+            ASSERT(mType == Type::Wgsl);
+            auto reparsed = std::make_shared<ReparsedWgslProgram>(mWgsl);
+            DAWN_TRY_ASSIGN(reparsed->program, ParseWGSL(&reparsed->source.file, nullptr));
+            program = std::shared_ptr<const tint::Program>(reparsed, &reparsed->program);
+        }
+        return std::move(program);
+    }
+
+    uint64_t ShaderModuleBase::ComputeRetainedBytes() const {
+        uint64_t bytes = GetSourceSize() + mSpirv.size() * sizeof(uint32_t);
+        for (const auto& it : mEntryPointStages) {
+            bytes += it.first.size() + sizeof(it.second);
+        }
+        for (const auto& it : mEntryPoints) {
+            bytes += it.first.size() + sizeof(EntryPointMetadata);
+            for (const EntryPointMetadata::BindingGroupInfoMap& groupBindings :
+                 it.second->bindings) {
+                bytes += groupBindings.size() *
+                         sizeof(EntryPointMetadata::BindingGroupInfoMap::value_type);
+            }
+        }
+        return bytes;
+    }
+
+    bool ShaderModuleBase::RetainsTintProgram() const {
+        return mTintProgram != nullptr;
+    }
+
     void ShaderModuleBase::APIGetCompilationInfo(wgpu::CompilationInfoCallback callback,
                                                  void* userdata) {
         if (callback == nullptr) {
@@ -1342,8 +1806,9 @@ namespace dawn_native {
         mSpirv = std::move(parseResult->spirv);
         mCompilationMessages = std::move(parseResult->compilationMessages);
 
+        // The entry points are only reflected when pipelines use them.
         if (GetDevice()->IsToggleEnabled(Toggle::UseTintGenerator)) {
-            DAWN_TRY_ASSIGN(mEntryPoints, ReflectShaderUsingTint(GetDevice(), mTintProgram.get()));
+            DAWN_TRY_ASSIGN(mEntryPointStages, ListEntryPointsUsingTint(mTintProgram.get()));
         } else {
             // If not using Tint to generate backend code, run the robust buffer access pass now
             // since all backends will use this SPIR-V. If Tint is used, the robustness pass should
@@ -1351,7 +1816,7 @@ namespace dawn_native {
             if (GetDevice()->IsRobustnessEnabled()) {
                 DAWN_TRY_ASSIGN(mSpirv, RunRobustBufferAccessPass(mSpirv));
             }
-            DAWN_TRY_ASSIGN(mEntryPoints, ReflectShaderUsingSPIRVCross(GetDevice(), mSpirv));
+            DAWN_TRY_ASSIGN(mEntryPointStages, ListSpirvEntryPoints(mSpirv));
         }
 
         return {};
@@ -29,6 +29,7 @@
 
 #include <bitset>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -60,6 +61,8 @@ namespace dawn_native {
     // A map from name to EntryPointMetadata.
     using EntryPointMetadataTable =
         std::unordered_map<std::string, std::unique_ptr<EntryPointMetadata>>;
+    // A map from name to the stage of an entry point.
+    using EntryPointStageTable = std::unordered_map<std::string, SingleShaderStage>;
 
     // Source for a tint program
     class TintSource;
@@ -72,8 +75,10 @@ namespace dawn_native {
 
         bool HasParsedShader() const;
 
-        std::unique_ptr<tint::Program> tintProgram;
-        std::unique_ptr<TintSource> tintSource;
+        // The program and its source are immutable and can be shared with the process-wide cache
+        // of parse results.
+        std::shared_ptr<const tint::Program> tintProgram;
+        std::shared_ptr<TintSource> tintSource;
         std::vector<uint32_t> spirv;
         std::unique_ptr<OwnedCompilationMessages> compilationMessages;
     };
@@ -130,6 +135,10 @@ namespace dawn_native {
             fragmentOutputFormatBaseTypes;
         ityp::bitset<ColorAttachmentIndex, kMaxColorAttachments> fragmentOutputsWritten;
 
+        // The size of the uniform buffer declared at [[group(kImmediateDataBindGroup),
+        // binding(0)]] to read the immediate data, or 0 if the entry point doesn't use it.
+        uint32_t immediateDataSize = 0;
+
         // The local workgroup size declared for a compute entry point (or 0s otehrwise).
         Origin3D localWorkgroupSize;
 
@@ -149,8 +158,14 @@ namespace dawn_native {
         // Return true iff the program has an entrypoint called `entryPoint`.
         bool HasEntryPoint(const std::string& entryPoint) const;
 
-        // Returns the metadata for the given `entryPoint`. HasEntryPoint with the same argument
-        // must be true.
+        // Computes the metadata for the given `entryPoint` if it wasn't already. Entry points are
+        // only reflected when a pipeline first uses them, so that the cost of modules with many
+        // entry points scales with the entry points that are used. HasEntryPoint with the same
+        // argument must be true.
+        MaybeError ReflectEntryPoint(const std::string& entryPoint);
+
+        // Returns the metadata for the given `entryPoint`. ReflectEntryPoint with the same
+        // argument must have succeeded.
         const EntryPointMetadata& GetEntryPoint(const std::string& entryPoint) const;
 
         // Functions necessary for the unordered_set<ShaderModuleBase*>-based cache.
@@ -160,9 +175,32 @@ namespace dawn_native {
             bool operator()(const ShaderModuleBase* a, const ShaderModuleBase* b) const;
         };
 
+        // Computes the same hash as ComputeContentHash, and compares with the content of a
+        // module, directly from the descriptor. This lets the device cache be probed without
+        // copying the shader source into a blueprint.
+        static size_t ComputeDescriptorContentHash(const ShaderModuleDescriptor* descriptor);
+        bool MatchesDescriptor(const ShaderModuleDescriptor* descriptor) const;
+
+        // The size of the source of the module, which the code compiled from it scales with.
+        uint64_t GetSourceSize() const;
+
         const std::vector<uint32_t>& GetSpirv() const;
+        // Only valid during the initialization of the module. Pipelines must use
+        // AcquireTintProgram instead since the program might have been released.
         const tint::Program* GetTintProgram() const;
 
+        // Returns the Tint program to compile a pipeline with. With the
+        // ReleaseShaderModulePrograms toggle, the module stops keeping the program alive once it
+        // is acquired, and parses it again if it was freed when another pipeline needs it, so the
+        // caller should only keep the reference while it compiles the pipeline.
+        ResultOrError<std::shared_ptr<const tint::Program>> AcquireTintProgram();
+
+        // Returns the number of bytes kept alive by the module for the creation of pipelines: the
+        // source, the SPIR-V and the reflection data. This doesn't include the Tint program, whose
+        // size isn't known, or the objects owned by the driver.
+        virtual uint64_t ComputeRetainedBytes() const;
+        bool RetainsTintProgram() const;
+
         void APIGetCompilationInfo(wgpu::CompilationInfoCallback callback, void* userdata);
 
         ResultOrError<std::vector<uint32_t>> GeneratePullingSpirv(
@@ -192,6 +230,9 @@ namespace dawn_native {
                          ObjectBase::ErrorTag tag,
                          std::unique_ptr<OwnedCompilationMessages> compilationMessages);
 
+        // Recreates the Tint program released by AcquireTintProgram from the source of the module.
+        ResultOrError<std::shared_ptr<const tint::Program>> ReparseTintProgram();
+
         // The original data in the descriptor for caching.
         enum class Type { Undefined, Spirv, Wgsl };
         Type mType;
@@ -199,10 +240,18 @@ namespace dawn_native {
         std::string mWgsl;
 
         // Data computed from what is in the descriptor. mSpirv is set iff !UseTintGenerator while
-        // mTintProgram is set iff UseTintGenerator.
+        // mTintProgram is set iff UseTintGenerator, until it is released by AcquireTintProgram.
+        // The program can then still be alive in mReleasedTintProgram if a pipeline or another
+        // module holds it. All the entry points are listed in mEntryPointStages when the module is
+        // created, while mEntryPoints only contains the ones reflected since.
+        EntryPointStageTable mEntryPointStages;
         EntryPointMetadataTable mEntryPoints;
         std::vector<uint32_t> mSpirv;
-        std::unique_ptr<tint::Program> mTintProgram;
+        // Without UseTintGenerator, the SPIRV-Cross parse of mSpirv shared by the reflection of
+        // the entry points, until they are all reflected.
+        std::unique_ptr<spirv_cross::Compiler> mSpirvCrossCompiler;
+        std::shared_ptr<const tint::Program> mTintProgram;
+        std::weak_ptr<const tint::Program> mReleasedTintProgram;
 
         std::unique_ptr<OwnedCompilationMessages> mCompilationMessages;
     };
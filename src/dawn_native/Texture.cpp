@@ -625,6 +625,42 @@ namespace dawn_native {
         return {clampedCopyExtentWidth, clampedCopyExtentHeight, extent.depthOrArrayLayers};
     }
 
+    TextureViewBase* TextureBase::GetCachedView(const TextureViewDescriptor& descriptor) const {
+        const char* label = descriptor.label != nullptr ? descriptor.label : "";
+        for (const CachedView& cached : mCachedViews) {
+            const TextureViewDescriptor& other = cached.descriptor;
+            if (other.format == descriptor.format && other.dimension == descriptor.dimension &&
+                other.baseMipLevel == descriptor.baseMipLevel &&
+                other.mipLevelCount == descriptor.mipLevelCount &&
+                other.baseArrayLayer == descriptor.baseArrayLayer &&
+                other.arrayLayerCount == descriptor.arrayLayerCount &&
+                other.aspect == descriptor.aspect && cached.label == label) {
+                return cached.view;
+            }
+        }
+        return nullptr;
+    }
+
+    void TextureBase::AddCachedView(const TextureViewDescriptor& descriptor,
+                                    TextureViewBase* view) {
+        ASSERT(GetCachedView(descriptor) == nullptr);
+
+        // The chained structs and the label aren't owned by the texture, so the label is copied.
+        CachedView cached = {descriptor, descriptor.label != nullptr ? descriptor.label : "", view};
+        cached.descriptor.nextInChain = nullptr;
+        cached.descriptor.label = nullptr;
+        mCachedViews.push_back(cached);
+    }
+
+    void TextureBase::RemoveCachedView(const TextureViewBase* view) {
+        for (auto it = mCachedViews.begin(); it != mCachedViews.end(); ++it) {
+            if (it->view == view) {
+                mCachedViews.erase(it);
+                return;
+            }
+        }
+    }
+
     TextureViewBase* TextureBase::APICreateView(const TextureViewDescriptor* descriptor) {
         DeviceBase* device = GetDevice();
 
@@ -649,6 +685,9 @@ namespace dawn_native {
     void TextureBase::DestroyInternal() {
         DestroyImpl();
         mState = TextureState::Destroyed;
+
+        // Views of a destroyed texture can't be created anymore, no need to look them up.
+        mCachedViews.clear();
     }
 
     MaybeError TextureBase::ValidateDestroy() const {
@@ -672,6 +711,13 @@ namespace dawn_native {
         : ObjectBase(device, tag), mFormat(kUnusedFormat) {
     }
 
+    TextureViewBase::~TextureViewBase() {
+        // Error views don't have a texture.
+        if (mTexture != nullptr) {
+            mTexture->RemoveCachedView(this);
+        }
+    }
+
     // static
     TextureViewBase* TextureViewBase::MakeError(DeviceBase* device) {
         return new TextureViewBase(device, ObjectBase::kError);
@@ -24,6 +24,7 @@
 
 #include "dawn_native/dawn_platform.h"
 
+#include <string>
 #include <vector>
 
 namespace dawn_native {
@@ -88,6 +89,12 @@ namespace dawn_native {
                                             const Origin3D& origin,
                                             const Extent3D& extent) const;
 
+        // Returns a live view of the texture that was created with the same descriptor and label,
+        // or nullptr. |descriptor| must have its defaults applied.
+        TextureViewBase* GetCachedView(const TextureViewDescriptor& descriptor) const;
+        void AddCachedView(const TextureViewDescriptor& descriptor, TextureViewBase* view);
+        void RemoveCachedView(const TextureViewBase* view);
+
         // Dawn API
         TextureViewBase* APICreateView(const TextureViewDescriptor* descriptor = nullptr);
         void APIDestroy();
@@ -111,6 +118,17 @@ namespace dawn_native {
 
         // TODO(natlee@microsoft.com): Use a more optimized data structure to save space
         std::vector<bool> mIsSubresourceContentInitializedAtIndex;
+
+        // The views of the texture, so that creating the same view again returns the existing
+        // one. The views don't stay alive because of the cache: they remove themselves from it
+        // when they are destroyed. Textures only have a few distinct views so a vector is enough.
+        struct CachedView {
+            TextureViewDescriptor descriptor;
+            // The label is given to the backend object, so views with different labels differ.
+            std::string label;
+            TextureViewBase* view;
+        };
+        std::vector<CachedView> mCachedViews;
     };
 
     class TextureViewBase : public ObjectBase {
@@ -131,6 +149,9 @@ namespace dawn_native {
         uint32_t GetLayerCount() const;
         const SubresourceRange& GetSubresourceRange() const;
 
+      protected:
+        ~TextureViewBase() override;
+
       private:
         TextureViewBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
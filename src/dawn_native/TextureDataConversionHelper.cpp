@@ -0,0 +1,370 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/TextureDataConversionHelper.h"
+
+#include "common/Constants.h"
+#include "common/Math.h"
+#include "dawn_native/BindGroup.h"
+#include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/Buffer.h"
+#include "dawn_native/CommandBuffer.h"
+#include "dawn_native/CommandEncoder.h"
+#include "dawn_native/ComputePassEncoder.h"
+#include "dawn_native/ComputePipeline.h"
+#include "dawn_native/Device.h"
+#include "dawn_native/DynamicUploader.h"
+#include "dawn_native/InternalPipelineStore.h"
+#include "dawn_native/Queue.h"
+#include "dawn_native/Texture.h"
+#include "dawn_native/TextureDataCopy.h"
+#include "dawn_native/ValidationUtils_autogen.h"
+
+#include <algorithm>
+
+namespace dawn_native {
+
+    namespace {
+
+        // Each texel is converted by an invocation. The source data is read and the converted
+        // data is written as arrays of u32 because storage buffers can't hold smaller types.
+        static const char sTextureDataConversionShader[] = R"(
+            [[block]] struct Params {
+                width : u32;
+                rowCount : u32;
+                isSourceRGB8 : u32;
+                swapRedAndBlue : u32;
+                dstRowLength : u32;
+            };
+
+            [[block]] struct Words {
+                data : array<u32>;
+            };
+
+            [[group(0), binding(0)]] var<uniform> params : Params;
+            [[group(0), binding(1)]] var<storage> src : [[access(read)]] Words;
+            [[group(0), binding(2)]] var<storage> dst : [[access(read_write)]] Words;
+
+            fn LoadSourceByte(index : u32) -> u32 {
+                return (src.data[index / 4u] >> ((index % 4u) * 8u)) & 0xFFu;
+            }
+
+            [[stage(compute), workgroup_size(8, 8, 1)]]
+            fn main([[builtin(global_invocation_id)]] GlobalInvocationID : vec3<u32>) {
+                var x : u32 = GlobalInvocationID.x;
+                var y : u32 = GlobalInvocationID.y;
+                if (x >= params.width || y >= params.rowCount) { return; }
+
+                var texel : u32 = y * params.width + x;
+                var rgba : u32;
+                if (params.isSourceRGB8 != 0u) {
+                    var byteIndex : u32 = texel * 3u;
+                    rgba = LoadSourceByte(byteIndex) | (LoadSourceByte(byteIndex + 1u) << 8u) |
+                           (LoadSourceByte(byteIndex + 2u) << 16u) | 0xFF000000u;
+                } else {
+                    rgba = src.data[texel];
+                }
+
+                if (params.swapRedAndBlue != 0u) {
+                    rgba = (rgba & 0xFF00FF00u) | ((rgba & 0xFFu) << 16u) |
+                           ((rgba >> 16u) & 0xFFu);
+                }
+
+                dst.data[y * params.dstRowLength + x] = rgba;
+            }
+        )";
+
+        struct ConversionParams {
+            uint32_t width;
+            uint32_t rowCount;
+            uint32_t isSourceRGB8;
+            uint32_t swapRedAndBlue;
+            uint32_t dstRowLength;
+        };
+
+        // The temporary buffers of a conversion are capped to this size. Larger writes are
+        // converted in several batches of images, or of rows when a single image is too large.
+        constexpr uint64_t kMaxConversionBatchSize = 32 * 1024 * 1024;
+
+        constexpr uint32_t kWorkgroupSize = 8;
+
+        bool IsBGRAFormat(wgpu::TextureFormat format) {
+            return format == wgpu::TextureFormat::BGRA8Unorm ||
+                   format == wgpu::TextureFormat::BGRA8UnormSrgb;
+        }
+
+        ResultOrError<ComputePipelineBase*> GetOrCreateTextureDataConversionPipeline(
+            DeviceBase* device) {
+            InternalPipelineStore* store = device->GetInternalPipelineStore();
+
+            if (store->textureDataConversionPipeline == nullptr) {
+                // Create compute shader module if not cached before.
+                if (store->textureDataConversionCS == nullptr) {
+                    ShaderModuleDescriptor descriptor;
+                    ShaderModuleWGSLDescriptor wgslDesc;
+                    wgslDesc.source = sTextureDataConversionShader;
+                    descriptor.nextInChain = reinterpret_cast<ChainedStruct*>(&wgslDesc);
+
+                    DAWN_TRY_ASSIGN(store->textureDataConversionCS,
+                                    device->CreateShaderModule(&descriptor));
+                }
+
+                ComputePipelineDescriptor computePipelineDesc = {};
+                // Generate the layout based on shader module.
+                computePipelineDesc.layout = nullptr;
+                computePipelineDesc.computeStage.module = store->textureDataConversionCS.Get();
+                computePipelineDesc.computeStage.entryPoint = "main";
+
+                DAWN_TRY_ASSIGN(store->textureDataConversionPipeline,
+                                device->CreateComputePipeline(&computePipelineDesc));
+            }
+
+            return store->textureDataConversionPipeline.Get();
+        }
+
+        // Converts |imageCount| images of |rowCount| rows starting at the row |firstRow| of the
+        // image |firstImage| of the write.
+        MaybeError EncodeConversionBatch(DeviceBase* device,
+                                         CommandEncoder* encoder,
+                                         ComputePipelineBase* pipeline,
+                                         const ImageCopyTexture& destination,
+                                         const uint8_t* data,
+                                         const TextureDataLayout& dataLayout,
+                                         const Extent3D& writeSize,
+                                         const TextureDataConversion* conversion,
+                                         uint32_t firstImage,
+                                         uint32_t imageCount,
+                                         uint32_t firstRow,
+                                         uint32_t rowCount) {
+            const uint32_t srcTexelSize =
+                GetTextureDataConversionSourceBlockInfo(conversion).byteSize;
+            const uint32_t srcBytesPerRow = writeSize.width * srcTexelSize;
+            const uint32_t dstBytesPerRow =
+                Align(writeSize.width * 4u, kTextureBytesPerRowAlignment);
+            const uint32_t totalRowCount = imageCount * rowCount;
+
+            // Upload the source rows tightly packed to a storage buffer.
+            BufferDescriptor srcDesc = {};
+            srcDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Storage;
+            srcDesc.size = Align(uint64_t(totalRowCount) * srcBytesPerRow, 4);
+            Ref<BufferBase> srcBuffer;
+            DAWN_TRY_ASSIGN(srcBuffer, device->CreateBuffer(&srcDesc));
+
+            UploadHandle uploadHandle;
+            DAWN_TRY_ASSIGN(uploadHandle, device->GetDynamicUploader()->Allocate(
+                                              srcDesc.size, device->GetPendingCommandSerial(),
+                                              kCopyBufferToBufferOffsetAlignment));
+            ASSERT(uploadHandle.mappedBuffer != nullptr);
+
+            const uint64_t srcImageStride = uint64_t(dataLayout.bytesPerRow) *
+                                            dataLayout.rowsPerImage;
+            TextureDataCopyLayout copyLayout;
+            copyLayout.depth = imageCount;
+            copyLayout.rowsPerImage = rowCount;
+            copyLayout.bytesPerRow = srcBytesPerRow;
+            copyLayout.srcBytesPerRow = dataLayout.bytesPerRow;
+            copyLayout.dstBytesPerRow = srcBytesPerRow;
+            copyLayout.srcImageAdditionalStride =
+                srcImageStride - uint64_t(rowCount) * dataLayout.bytesPerRow;
+            CopyTextureData(uploadHandle.mappedBuffer,
+                            data + dataLayout.offset + firstImage * srcImageStride +
+                                uint64_t(firstRow) * dataLayout.bytesPerRow,
+                            copyLayout);
+
+            device->AddFutureSerial(device->GetPendingCommandSerial());
+            DAWN_TRY(device->CopyFromStagingToBuffer(uploadHandle.stagingBuffer,
+                                                     uploadHandle.startOffset, srcBuffer.Get(), 0,
+                                                     srcDesc.size));
+
+            // The converted rows are laid out for a buffer to texture copy. The padding at the end
+            // of the rows is never read so the buffer doesn't need to be cleared.
+            BufferDescriptor dstDesc = {};
+            dstDesc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc;
+            dstDesc.size = uint64_t(totalRowCount) * dstBytesPerRow;
+            Ref<BufferBase> dstBuffer;
+            DAWN_TRY_ASSIGN(dstBuffer, device->CreateBuffer(&dstDesc));
+            dstBuffer->SetIsDataInitialized();
+
+            ConversionParams params;
+            params.width = writeSize.width;
+            params.rowCount = totalRowCount;
+            params.isSourceRGB8 =
+                conversion->sourceFormat == wgpu::TextureDataSourceFormat::RGB8Unorm;
+            params.swapRedAndBlue =
+                (conversion->sourceFormat == wgpu::TextureDataSourceFormat::BGRA8Unorm) !=
+                IsBGRAFormat(destination.texture->GetFormat().format);
+            params.dstRowLength = dstBytesPerRow / 4;
+
+            BufferDescriptor paramsDesc = {};
+            paramsDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform;
+            paramsDesc.size = sizeof(params);
+            Ref<BufferBase> paramsBuffer;
+            DAWN_TRY_ASSIGN(paramsBuffer, device->CreateBuffer(&paramsDesc));
+            DAWN_TRY(
+                device->GetQueue()->WriteBuffer(paramsBuffer.Get(), 0, &params, sizeof(params)));
+
+            Ref<BindGroupLayoutBase> layout;
+            DAWN_TRY_ASSIGN(layout, pipeline->GetBindGroupLayout(0));
+
+            BindGroupEntry bindGroupEntries[3] = {};
+            bindGroupEntries[0].binding = 0;
+            bindGroupEntries[0].buffer = paramsBuffer.Get();
+            bindGroupEntries[0].size = sizeof(params);
+            bindGroupEntries[1].binding = 1;
+            bindGroupEntries[1].buffer = srcBuffer.Get();
+            bindGroupEntries[1].size = srcDesc.size;
+            bindGroupEntries[2].binding = 2;
+            bindGroupEntries[2].buffer = dstBuffer.Get();
+            bindGroupEntries[2].size = dstDesc.size;
+
+            BindGroupDescriptor bgDesc = {};
+            bgDesc.layout = layout.Get();
+            bgDesc.entryCount = 3;
+            bgDesc.entries = bindGroupEntries;
+            Ref<BindGroupBase> bindGroup;
+            DAWN_TRY_ASSIGN(bindGroup, device->CreateBindGroup(&bgDesc));
+
+            ComputePassDescriptor passDesc = {};
+            // TODO(dawn:723): change to not use AcquireRef for reentrant object creation.
+            Ref<ComputePassEncoder> pass = AcquireRef(encoder->APIBeginComputePass(&passDesc));
+            pass->APISetPipeline(pipeline);
+            pass->APISetBindGroup(0, bindGroup.Get());
+            pass->APIDispatch((writeSize.width + kWorkgroupSize - 1) / kWorkgroupSize,
+                              (totalRowCount + kWorkgroupSize - 1) / kWorkgroupSize);
+            pass->APIEndPass();
+
+            ImageCopyBuffer imageCopyBuffer = {};
+            imageCopyBuffer.buffer = dstBuffer.Get();
+            imageCopyBuffer.layout.offset = 0;
+            imageCopyBuffer.layout.bytesPerRow = dstBytesPerRow;
+            imageCopyBuffer.layout.rowsPerImage = rowCount;
+
+            ImageCopyTexture imageCopyTexture = destination;
+            imageCopyTexture.origin.y += firstRow;
+            imageCopyTexture.origin.z += firstImage;
+
+            Extent3D copySize = {writeSize.width, rowCount, imageCount};
+            encoder->APICopyBufferToTexture(&imageCopyBuffer, &imageCopyTexture, &copySize);
+
+            return {};
+        }
+
+    }  // anonymous namespace
+
+    MaybeError ValidateTextureDataConversion(const DeviceBase* device,
+                                             const TextureDataConversion* conversion,
+                                             const ImageCopyTexture* destination) {
+        if (!device->IsExtensionEnabled(Extension::TextureDataConversion)) {
+            return DAWN_VALIDATION_ERROR("The texture_data_conversion extension is not enabled");
+        }
+
+        DAWN_TRY(ValidateTextureDataSourceFormat(conversion->sourceFormat));
+
+        switch (destination->texture->GetFormat().format) {
+            case wgpu::TextureFormat::RGBA8Unorm:
+            case wgpu::TextureFormat::RGBA8UnormSrgb:
+            case wgpu::TextureFormat::BGRA8Unorm:
+            case wgpu::TextureFormat::BGRA8UnormSrgb:
+                break;
+            default:
+                return DAWN_VALIDATION_ERROR(
+                    "Texture data can only be converted to RGBA8 and BGRA8 formats");
+        }
+
+        return {};
+    }
+
+    TexelBlockInfo GetTextureDataConversionSourceBlockInfo(
+        const TextureDataConversion* conversion) {
+        switch (conversion->sourceFormat) {
+            case wgpu::TextureDataSourceFormat::RGB8Unorm:
+                return {3, 1, 1};
+            case wgpu::TextureDataSourceFormat::RGBA8Unorm:
+            case wgpu::TextureDataSourceFormat::BGRA8Unorm:
+                return {4, 1, 1};
+            case wgpu::TextureDataSourceFormat::Undefined:
+                break;
+        }
+        UNREACHABLE();
+    }
+
+    bool IsTextureDataConversionNoop(const TextureDataConversion* conversion,
+                                     const ImageCopyTexture& destination) {
+        bool isDestinationBGRA = IsBGRAFormat(destination.texture->GetFormat().format);
+        switch (conversion->sourceFormat) {
+            case wgpu::TextureDataSourceFormat::RGBA8Unorm:
+                return !isDestinationBGRA;
+            case wgpu::TextureDataSourceFormat::BGRA8Unorm:
+                return isDestinationBGRA;
+            default:
+                return false;
+        }
+    }
+
+    MaybeError CreateTextureDataConversionPipeline(DeviceBase* device) {
+        DAWN_TRY(GetOrCreateTextureDataConversionPipeline(device));
+        return {};
+    }
+
+    MaybeError DoWriteTextureWithConversion(DeviceBase* device,
+                                           const ImageCopyTexture& destination,
+                                           const void* data,
+                                           const TextureDataLayout& dataLayout,
+                                           const Extent3D& writeSize,
+                                           const TextureDataConversion* conversion) {
+        ComputePipelineBase* pipeline;
+        DAWN_TRY_ASSIGN(pipeline, GetOrCreateTextureDataConversionPipeline(device));
+
+        // The converted data is larger than the source data.
+        const uint64_t dstBytesPerRow = Align(writeSize.width * 4u, kTextureBytesPerRowAlignment);
+        const uint32_t maxRowsPerBatch =
+            static_cast<uint32_t>(std::max(kMaxConversionBatchSize / dstBytesPerRow, uint64_t(1)));
+
+        CommandEncoderDescriptor encoderDesc = {};
+        // TODO(dawn:723): change to not use AcquireRef for reentrant object creation.
+        Ref<CommandEncoder> encoder = AcquireRef(device->APICreateCommandEncoder(&encoderDesc));
+
+        const uint8_t* src = static_cast<const uint8_t*>(data);
+        if (writeSize.height <= maxRowsPerBatch) {
+            // Convert whole images at once.
+            const uint32_t imagesPerBatch = maxRowsPerBatch / writeSize.height;
+            for (uint32_t image = 0; image < writeSize.depthOrArrayLayers;
+                 image += imagesPerBatch) {
+                uint32_t imageCount =
+                    std::min(imagesPerBatch, writeSize.depthOrArrayLayers - image);
+                DAWN_TRY(EncodeConversionBatch(device, encoder.Get(), pipeline, destination, src,
+                                               dataLayout, writeSize, conversion, image,
+                                               imageCount, 0, writeSize.height));
+            }
+        } else {
+            // Convert each image in batches of rows.
+            for (uint32_t image = 0; image < writeSize.depthOrArrayLayers; ++image) {
+                for (uint32_t row = 0; row < writeSize.height; row += maxRowsPerBatch) {
+                    uint32_t rowCount = std::min(maxRowsPerBatch, writeSize.height - row);
+                    DAWN_TRY(EncodeConversionBatch(device, encoder.Get(), pipeline, destination,
+                                                   src, dataLayout, writeSize, conversion, image,
+                                                   1, row, rowCount));
+                }
+            }
+        }
+
+        // TODO(dawn:723): change to not use AcquireRef for reentrant object creation.
+        Ref<CommandBufferBase> commandBuffer = AcquireRef(encoder->APIFinish());
+        CommandBufferBase* submitCommandBuffer = commandBuffer.Get();
+        device->GetQueue()->APISubmit(1, &submitCommandBuffer);
+
+        return {};
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,58 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_TEXTUREDATACONVERSIONHELPER_H_
+#define DAWNNATIVE_TEXTUREDATACONVERSIONHELPER_H_
+
+#include "dawn_native/Error.h"
+#include "dawn_native/Format.h"
+#include "dawn_native/dawn_platform.h"
+
+namespace dawn_native {
+    class DeviceBase;
+    struct Extent3D;
+    struct ImageCopyTexture;
+    struct TextureDataConversion;
+    struct TextureDataLayout;
+
+    MaybeError ValidateTextureDataConversion(const DeviceBase* device,
+                                             const TextureDataConversion* conversion,
+                                             const ImageCopyTexture* destination);
+
+    // The texel block of the source data of a WriteTexture with |conversion|.
+    TexelBlockInfo GetTextureDataConversionSourceBlockInfo(const TextureDataConversion* conversion);
+
+    // Returns whether the source data has the same texel size and channel order as |destination|
+    // so that it can be written without conversion.
+    bool IsTextureDataConversionNoop(const TextureDataConversion* conversion,
+                                     const ImageCopyTexture& destination);
+
+    // Creates the internal pipeline so that the first WriteTexture with conversion doesn't have to
+    // compile it.
+    MaybeError CreateTextureDataConversionPipeline(DeviceBase* device);
+
+    // Writes |data| to |destination| after converting it to the format of the texture in compute
+    // shaders. The source rows are tightly packed in staging memory and uploaded to a storage
+    // buffer, that the compute shaders expand to the layout of a buffer to texture copy.
+    // |dataLayout| must have its defaults applied for the source texel block.
+    MaybeError DoWriteTextureWithConversion(DeviceBase* device,
+                                           const ImageCopyTexture& destination,
+                                           const void* data,
+                                           const TextureDataLayout& dataLayout,
+                                           const Extent3D& writeSize,
+                                           const TextureDataConversion* conversion);
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_TEXTUREDATACONVERSIONHELPER_H_
@@ -0,0 +1,187 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/TextureDataCopy.h"
+
+#include "common/Assert.h"
+#include "dawn_platform/DawnPlatform.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DAWN_TEXTURE_DATA_COPY_USE_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+namespace dawn_native {
+
+    namespace {
+
+        struct CopyTask {
+            uint8_t* dst;
+            const uint8_t* src;
+            const TextureDataCopyLayout* layout;
+            uint64_t firstRow;
+            uint64_t rowCount;
+            bool nonTemporal;
+        };
+
+#if defined(DAWN_TEXTURE_DATA_COPY_USE_SSE2)
+        void CopyBytesNonTemporal(uint8_t* dst, const uint8_t* src, uint64_t size) {
+            // Streaming stores must be aligned: copy the first bytes with regular stores.
+            uint64_t headSize = std::min(
+                size, uint64_t((16 - (reinterpret_cast<uintptr_t>(dst) & 15)) & 15));
+            memcpy(dst, src, headSize);
+            dst += headSize;
+            src += headSize;
+            size -= headSize;
+
+            // Write full cache lines at once so that the write-combining buffers are flushed
+            // without partial writes.
+            while (size >= 64) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+                __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+                __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst), a);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16), b);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32), c);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48), d);
+                dst += 64;
+                src += 64;
+                size -= 64;
+            }
+            while (size >= 16) {
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+                dst += 16;
+                src += 16;
+                size -= 16;
+            }
+            memcpy(dst, src, size);
+        }
+#endif  // defined(DAWN_TEXTURE_DATA_COPY_USE_SSE2)
+
+        void CopyBytes(uint8_t* dst, const uint8_t* src, uint64_t size, bool nonTemporal) {
+#if defined(DAWN_TEXTURE_DATA_COPY_USE_SSE2)
+            if (nonTemporal) {
+                CopyBytesNonTemporal(dst, src, size);
+                return;
+            }
+#endif
+            memcpy(dst, src, size);
+        }
+
+        // Copy the rows [firstRow, firstRow + rowCount) where rows are numbered across images.
+        void CopyRows(const CopyTask& task) {
+            const TextureDataCopyLayout& layout = *task.layout;
+            const bool rowsAreContiguous = layout.bytesPerRow == layout.srcBytesPerRow &&
+                                           layout.bytesPerRow == layout.dstBytesPerRow;
+
+            if (rowsAreContiguous && layout.srcImageAdditionalStride == 0) {
+                // The images are contiguous too: do a single copy.
+                uint64_t offset = task.firstRow * layout.bytesPerRow;
+                CopyBytes(task.dst + offset, task.src + offset, task.rowCount * layout.bytesPerRow,
+                          task.nonTemporal);
+            } else {
+                const uint64_t srcImageStride =
+                    uint64_t(layout.rowsPerImage) * layout.srcBytesPerRow +
+                    layout.srcImageAdditionalStride;
+
+                uint64_t row = task.firstRow;
+                const uint64_t endRow = task.firstRow + task.rowCount;
+                while (row < endRow) {
+                    uint64_t image = row / layout.rowsPerImage;
+                    uint32_t rowInImage = static_cast<uint32_t>(row % layout.rowsPerImage);
+                    uint64_t rowsToCopy =
+                        std::min(uint64_t(layout.rowsPerImage - rowInImage), endRow - row);
+
+                    const uint8_t* src = task.src + image * srcImageStride +
+                                         uint64_t(rowInImage) * layout.srcBytesPerRow;
+                    uint8_t* dst = task.dst + row * layout.dstBytesPerRow;
+
+                    if (rowsAreContiguous) {  // copy layer by layer
+                        CopyBytes(dst, src, rowsToCopy * layout.bytesPerRow, task.nonTemporal);
+                    } else {  // copy row by row
+                        for (uint64_t r = 0; r < rowsToCopy; ++r) {
+                            CopyBytes(dst, src, layout.bytesPerRow, task.nonTemporal);
+                            dst += layout.dstBytesPerRow;
+                            src += layout.srcBytesPerRow;
+                        }
+                    }
+                    row += rowsToCopy;
+                }
+            }
+
+#if defined(DAWN_TEXTURE_DATA_COPY_USE_SSE2)
+            // Streaming stores are weakly ordered: make them visible before the copy is reported
+            // complete, possibly to another thread.
+            if (task.nonTemporal) {
+                _mm_sfence();
+            }
+#endif
+        }
+
+        void DoCopyTask(void* userdata) {
+            CopyRows(*static_cast<const CopyTask*>(userdata));
+        }
+
+    }  // anonymous namespace
+
+    void CopyTextureData(uint8_t* dst,
+                         const uint8_t* src,
+                         const TextureDataCopyLayout& layout,
+                         dawn_platform::WorkerTaskPool* workerTaskPool) {
+        const uint64_t rowCount = uint64_t(layout.depth) * layout.rowsPerImage;
+        const uint64_t copySize = rowCount * layout.bytesPerRow;
+        if (copySize == 0) {
+            return;
+        }
+
+        uint64_t taskCount = 1;
+        if (workerTaskPool != nullptr) {
+            taskCount = std::min(
+                {copySize / kMinTextureDataCopyTaskSize, uint64_t(kMaxTextureDataCopyTasks),
+                 rowCount});
+            taskCount = std::max(taskCount, uint64_t(1));
+        }
+
+        std::array<CopyTask, kMaxTextureDataCopyTasks> tasks;
+        for (uint64_t i = 0; i < taskCount; ++i) {
+            CopyTask& task = tasks[i];
+            task.dst = dst;
+            task.src = src;
+            task.layout = &layout;
+            task.firstRow = i * rowCount / taskCount;
+            task.rowCount = (i + 1) * rowCount / taskCount - task.firstRow;
+            task.nonTemporal = copySize >= kNonTemporalTextureDataCopyThreshold;
+        }
+
+        // The calling thread copies the first part while the workers copy the others.
+        std::array<std::unique_ptr<dawn_platform::WaitableEvent>, kMaxTextureDataCopyTasks>
+            events;
+        for (uint64_t i = 1; i < taskCount; ++i) {
+            ASSERT(workerTaskPool != nullptr);
+            events[i] = workerTaskPool->PostWorkerTask(DoCopyTask, &tasks[i]);
+        }
+        CopyRows(tasks[0]);
+        for (uint64_t i = 1; i < taskCount; ++i) {
+            events[i]->Wait();
+        }
+    }
+
+}  // namespace dawn_native
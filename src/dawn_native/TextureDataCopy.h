@@ -0,0 +1,60 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_TEXTUREDATACOPY_H_
+#define DAWNNATIVE_TEXTUREDATACOPY_H_
+
+#include <cstdint>
+
+namespace dawn_platform {
+    class WorkerTaskPool;
+}  // namespace dawn_platform
+
+namespace dawn_native {
+
+    // The layout of texture data copied from the user's memory to staging memory. The copy is
+    // |depth| images of |rowsPerImage| rows of |bytesPerRow| bytes. Consecutive rows are
+    // |srcBytesPerRow| apart in the source and |dstBytesPerRow| apart in the destination. Images
+    // are tightly packed in the destination, and |srcImageAdditionalStride| bytes apart in the
+    // source.
+    struct TextureDataCopyLayout {
+        uint32_t depth;
+        uint32_t rowsPerImage;
+        uint32_t bytesPerRow;
+        uint32_t srcBytesPerRow;
+        uint32_t dstBytesPerRow;
+        uint64_t srcImageAdditionalStride;
+    };
+
+    // Copies above this size bypass the CPU caches with non-temporal stores when the CPU supports
+    // them. Staging memory is only read by the GPU and is often write-combined, so caching the
+    // data only evicts more useful cache lines.
+    static constexpr uint64_t kNonTemporalTextureDataCopyThreshold = 256 * 1024;
+
+    // Copies are split in tasks of at least this size, and at most kMaxTextureDataCopyTasks, run
+    // on |workerTaskPool| and the calling thread when a pool is given. Smaller tasks would spend
+    // more time being posted and waited on than copying.
+    static constexpr uint64_t kMinTextureDataCopyTaskSize = 2 * 1024 * 1024;
+    static constexpr uint32_t kMaxTextureDataCopyTasks = 4;
+
+    // Copies texture data from |src| to |dst| with the row pitches of |layout|. Contiguous rows
+    // are copied at once.
+    void CopyTextureData(uint8_t* dst,
+                         const uint8_t* src,
+                         const TextureDataCopyLayout& layout,
+                         dawn_platform::WorkerTaskPool* workerTaskPool = nullptr);
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_TEXTUREDATACOPY_H_
@@ -176,7 +176,53 @@ namespace dawn_native {
               "GPUs which have a driver bug in the execution of CopyTextureRegion() when we copy "
               "with the formats whose texel block sizes are less than 4 bytes from a greater mip "
               "level to a smaller mip level on D3D12 backends.",
-              "https://crbug.com/1161355"}}
+              "https://crbug.com/1161355"}},
+            {Toggle::UseWorkerThreadsForLargeTextureUploads,
+             {"use_worker_threads_for_large_texture_uploads",
+              "Split the copy of large Queue::WriteTexture data to staging memory between the "
+              "calling thread and the platform's worker threads. This toggle is disabled by "
+              "default because the cost of posting tasks depends on the platform's worker pool.",
+              ""}},
+            {Toggle::DisableShaderParseCache,
+             {"disable_shader_parse_cache",
+              "Disables the process-wide cache of parsed and validated shader sources, so that "
+              "every shader module creation parses and validates its source again.",
+              ""}},
+            {Toggle::PersistSpirvValidation,
+             {"persist_spirv_validation",
+              "Records in the platform's persistent cache which SPIR-V modules passed validation, "
+              "and skips the validation of the SPIR-V modules recorded there. This toggle is "
+              "disabled by default because it trusts the content of the persistent cache.",
+              ""}},
+            {Toggle::ReleaseShaderModulePrograms,
+             {"release_shader_module_programs",
+              "Doesn't keep the Tint programs of shader modules alive after they are used to "
+              "create a pipeline, and parses them again from the source when another pipeline "
+              "needs them. This saves memory for applications with many shader modules at the "
+              "cost of slower pipeline creation.",
+              ""}},
+            {Toggle::RecordErrorBacktraces,
+             {"record_error_backtraces",
+              "Records the call stack of DAWN_TRY's that errors go through and appends it to the "
+              "error messages. This helps finding where errors come from, but makes every error "
+              "allocate memory, even for applications that probe for errors in a loop. Recording "
+              "is process-wide: while a device with this toggle is alive, the errors of all "
+              "devices record their call stack.",
+              ""}},
+            {Toggle::SubAllocateSmallBuffers,
+             {"suballocate_small_buffers",
+              "Places small buffers that can't be mapped in ranges of large buffers shared with "
+              "other buffers of the same usage, to reduce the number of backend buffer objects "
+              "when an application creates a lot of small buffers. Only implemented on Vulkan.",
+              ""}},
+            {Toggle::DefragmentBufferMemoryWhenIdle,
+             {"defragment_buffer_memory_when_idle",
+              "Moves buffers out of the sparsest heaps of large resources with GPU copies when the "
+              "GPU is idle, so that the heaps can be released. This makes buffers copyable and "
+              "rewrites the descriptor sets of their bind groups when they move. Only implemented "
+              "on Vulkan, when MemoryAllocatorOptions enable the sub-allocation of large "
+              "resources.",
+              ""}}
             // Dummy comment to separate the }} so it is clearer what to copy-paste to add a toggle.
         }};
 
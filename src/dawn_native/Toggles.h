@@ -51,6 +51,13 @@ namespace dawn_native {
         UseTintGenerator,
         FlushBeforeClientWaitSync,
         UseTempBufferInSmallFormatTextureToTextureCopyFromGreaterToLessMipLevel,
+        UseWorkerThreadsForLargeTextureUploads,
+        DisableShaderParseCache,
+        PersistSpirvValidation,
+        ReleaseShaderModulePrograms,
+        RecordErrorBacktraces,
+        SubAllocateSmallBuffers,
+        DefragmentBufferMemoryWhenIdle,
 
         EnumCount,
         InvalidEnum = EnumCount,
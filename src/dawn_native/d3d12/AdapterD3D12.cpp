@@ -108,6 +108,10 @@ namespace dawn_native { namespace d3d12 {
             mSupportedExtensions.EnableExtension(Extension::ShaderFloat16);
         }
         mSupportedExtensions.EnableExtension(Extension::MultiPlanarFormats);
+        mSupportedExtensions.EnableExtension(Extension::TextureDataConversion);
+        mSupportedExtensions.EnableExtension(Extension::MultiDrawIndirect);
+        mSupportedExtensions.EnableExtension(Extension::DrawIndirectCount);
+        mSupportedExtensions.EnableExtension(Extension::ImmediateData);
     }
 
     MaybeError Adapter::InitializeDebugLayerFilters() {
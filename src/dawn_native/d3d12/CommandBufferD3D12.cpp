@@ -16,6 +16,7 @@
 
 #include "dawn_native/BindGroupTracker.h"
 #include "dawn_native/CommandValidation.h"
+#include "dawn_native/ImmediateDataTracker.h"
 #include "dawn_native/RenderBundle.h"
 #include "dawn_native/d3d12/BindGroupD3D12.h"
 #include "dawn_native/d3d12/BindGroupLayoutD3D12.h"
@@ -116,6 +117,25 @@ namespace dawn_native { namespace d3d12 {
                                                        count, offsets.data(), 0);
         }
 
+        void ApplyImmediateData(ID3D12GraphicsCommandList* commandList,
+                                ImmediateDataTracker* immediateData,
+                                bool inCompute) {
+            uint32_t size = immediateData->GetDirtySize();
+            if (size > 0) {
+                PipelineLayout* layout = ToBackend(immediateData->GetPipelineLayout());
+                if (inCompute) {
+                    commandList->SetComputeRoot32BitConstants(
+                        layout->GetImmediateDataParameterIndex(), size / sizeof(uint32_t),
+                        immediateData->GetData(), 0);
+                } else {
+                    commandList->SetGraphicsRoot32BitConstants(
+                        layout->GetImmediateDataParameterIndex(), size / sizeof(uint32_t),
+                        immediateData->GetData(), 0);
+                }
+            }
+            immediateData->DidApply();
+        }
+
         bool ShouldCopyUsingTemporaryBuffer(DeviceBase* device,
                                             const TextureCopy& srcCopy,
                                             const TextureCopy& dstCopy) {
@@ -948,6 +968,7 @@ namespace dawn_native { namespace d3d12 {
                                                 BindGroupStateTracker* bindingTracker) {
         PipelineLayout* lastLayout = nullptr;
         ID3D12GraphicsCommandList* commandList = commandContext->GetCommandList();
+        ImmediateDataTracker immediateData = {};
 
         Command type;
         while (mCommands.NextCommandId(&type)) {
@@ -956,6 +977,7 @@ namespace dawn_native { namespace d3d12 {
                     DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
+                    ApplyImmediateData(commandList, &immediateData, true);
                     commandList->Dispatch(dispatch->x, dispatch->y, dispatch->z);
                     break;
                 }
@@ -964,6 +986,7 @@ namespace dawn_native { namespace d3d12 {
                     DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
+                    ApplyImmediateData(commandList, &immediateData, true);
                     Buffer* buffer = ToBackend(dispatch->indirectBuffer.Get());
                     buffer->TrackUsageAndTransitionNow(commandContext, wgpu::BufferUsage::Indirect);
                     ComPtr<ID3D12CommandSignature> signature =
@@ -987,6 +1010,7 @@ namespace dawn_native { namespace d3d12 {
                     commandList->SetPipelineState(pipeline->GetPipelineState());
 
                     bindingTracker->OnSetPipeline(pipeline);
+                    immediateData.OnSetPipeline(pipeline);
 
                     lastLayout = layout;
                     break;
@@ -1006,6 +1030,12 @@ namespace dawn_native { namespace d3d12 {
                     break;
                 }
 
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = mCommands.NextCommand<SetImmediateDataCmd>();
+                    immediateData.OnSetImmediateData(cmd, mCommands.NextData<uint8_t>(cmd->size));
+                    break;
+                }
+
                 case Command::InsertDebugMarker: {
                     InsertDebugMarkerCmd* cmd = mCommands.NextCommand<InsertDebugMarkerCmd>();
                     const char* label = mCommands.NextData<char>(cmd->length + 1);
@@ -1238,6 +1268,7 @@ namespace dawn_native { namespace d3d12 {
         }
 
         ID3D12GraphicsCommandList* commandList = commandContext->GetCommandList();
+        ImmediateDataTracker immediateData = {};
 
         // Set up default dynamic state
         {
@@ -1263,6 +1294,7 @@ namespace dawn_native { namespace d3d12 {
                     DrawCmd* draw = iter->NextCommand<DrawCmd>();
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
+                    ApplyImmediateData(commandList, &immediateData, false);
                     vertexBufferTracker.Apply(commandList, lastPipeline);
                     RecordFirstIndexOffset(commandList, lastPipeline, draw->firstVertex,
                                            draw->firstInstance);
@@ -1275,6 +1307,7 @@ namespace dawn_native { namespace d3d12 {
                     DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
+                    ApplyImmediateData(commandList, &immediateData, false);
                     vertexBufferTracker.Apply(commandList, lastPipeline);
                     RecordFirstIndexOffset(commandList, lastPipeline, draw->baseVertex,
                                            draw->firstInstance);
@@ -1288,6 +1321,7 @@ namespace dawn_native { namespace d3d12 {
                     DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
+                    ApplyImmediateData(commandList, &immediateData, false);
                     vertexBufferTracker.Apply(commandList, lastPipeline);
                     Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
                     ComPtr<ID3D12CommandSignature> signature =
@@ -1301,6 +1335,7 @@ namespace dawn_native { namespace d3d12 {
                     DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
+                    ApplyImmediateData(commandList, &immediateData, false);
                     vertexBufferTracker.Apply(commandList, lastPipeline);
                     Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
                     ComPtr<ID3D12CommandSignature> signature =
@@ -1310,6 +1345,26 @@ namespace dawn_native { namespace d3d12 {
                     break;
                 }
 
+                case Command::MultiDrawIndexedIndirect: {
+                    MultiDrawIndexedIndirectCmd* draw =
+                        iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+
+                    DAWN_TRY(bindingTracker->Apply(commandContext));
+                    ApplyImmediateData(commandList, &immediateData, false);
+                    vertexBufferTracker.Apply(commandList, lastPipeline);
+                    Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                    ID3D12Resource* countBuffer =
+                        draw->drawCountBuffer != nullptr
+                            ? ToBackend(draw->drawCountBuffer)->GetD3D12Resource()
+                            : nullptr;
+                    ComPtr<ID3D12CommandSignature> signature =
+                        ToBackend(GetDevice())->GetDrawIndexedIndirectSignature();
+                    commandList->ExecuteIndirect(signature.Get(), draw->maxDrawCount,
+                                                 buffer->GetD3D12Resource(), draw->indirectOffset,
+                                                 countBuffer, draw->drawCountBufferOffset);
+                    break;
+                }
+
                 case Command::InsertDebugMarker: {
                     InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
                     const char* label = iter->NextData<char>(cmd->length + 1);
@@ -1359,6 +1414,7 @@ namespace dawn_native { namespace d3d12 {
                     commandList->IASetPrimitiveTopology(pipeline->GetD3D12PrimitiveTopology());
 
                     bindingTracker->OnSetPipeline(pipeline);
+                    immediateData.OnSetPipeline(pipeline);
 
                     lastPipeline = pipeline;
                     lastLayout = layout;
@@ -1379,6 +1435,12 @@ namespace dawn_native { namespace d3d12 {
                     break;
                 }
 
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = iter->NextCommand<SetImmediateDataCmd>();
+                    immediateData.OnSetImmediateData(cmd, iter->NextData<uint8_t>(cmd->size));
+                    break;
+                }
+
                 case Command::SetIndexBuffer: {
                     SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
 
@@ -52,6 +52,7 @@ namespace dawn_native { namespace d3d12 {
                                                         SingleShaderStage::Compute,
                                                         ToBackend(GetLayout()), compileFlags));
         d3dDesc.CS = compiledShader.GetD3D12ShaderBytecode();
+        AddEstimatedShaderSize(d3dDesc.CS.BytecodeLength);
         auto* d3d12Device = device->GetD3D12Device();
         DAWN_TRY(CheckHRESULT(
             d3d12Device->CreateComputePipelineState(&d3dDesc, IID_PPV_ARGS(&mPipelineState)),
@@ -287,6 +287,30 @@ namespace dawn_native { namespace d3d12 {
         return {};
     }
 
+    MaybeError Device::WaitForSerialImpl(ExecutionSerial serial, uint64_t timeoutNs) {
+        if (mFence->GetCompletedValue() >= uint64_t(serial)) {
+            return {};
+        }
+
+        // Round the timeout up to milliseconds, values too large for a DWORD wait forever.
+        constexpr uint64_t kNsPerMs = 1000 * 1000;
+        uint64_t timeoutMs = timeoutNs / kNsPerMs + (timeoutNs % kNsPerMs != 0 ? 1 : 0);
+        DWORD waitMs = timeoutMs >= INFINITE ? INFINITE : static_cast<DWORD>(timeoutMs);
+
+        // Use a new event since mFenceEvent must not stay signaled after a timeout.
+        HANDLE waitEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        if (waitEvent == nullptr) {
+            return DAWN_INTERNAL_ERROR("Failed to create an event");
+        }
+        DAWN_TRY_WITH_CLEANUP(
+            CheckHRESULT(mFence->SetEventOnCompletion(uint64_t(serial), waitEvent),
+                         "D3D12 set event on completion"),
+            { CloseHandle(waitEvent); });
+        WaitForSingleObject(waitEvent, waitMs);
+        CloseHandle(waitEvent);
+        return {};
+    }
+
     ResultOrError<ExecutionSerial> Device::CheckAndUpdateCompletedSerials() {
         ExecutionSerial completeSerial = ExecutionSerial(mFence->GetCompletedValue());
 
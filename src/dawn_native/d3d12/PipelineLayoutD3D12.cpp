@@ -52,6 +52,21 @@ namespace dawn_native { namespace d3d12 {
                     UNREACHABLE();
             }
         }
+
+        // The cost of a root parameter in the 64 DWORDs of the root signature.
+        uint32_t RootParameterDWordCount(const D3D12_ROOT_PARAMETER& parameter) {
+            switch (parameter.ParameterType) {
+                case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+                    return 1;
+                case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+                    return parameter.Constants.Num32BitValues;
+                case D3D12_ROOT_PARAMETER_TYPE_CBV:
+                case D3D12_ROOT_PARAMETER_TYPE_SRV:
+                case D3D12_ROOT_PARAMETER_TYPE_UAV:
+                    return 2;
+            }
+            UNREACHABLE();
+        }
     }  // anonymous namespace
 
     ResultOrError<Ref<PipelineLayout>> PipelineLayout::Create(
@@ -184,6 +199,28 @@ namespace dawn_native { namespace d3d12 {
         // would need to be updated often
         rootParameters.emplace_back(indexOffsetConstants);
 
+        // The immediate data is declared by shaders as a constant buffer at register 0 of the
+        // space of kImmediateDataBindGroup, which root constants can back directly.
+        if (GetImmediateDataSize() > 0) {
+            D3D12_ROOT_PARAMETER immediateDataConstants{};
+            immediateDataConstants.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+            immediateDataConstants.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+            immediateDataConstants.Constants.Num32BitValues =
+                GetImmediateDataSize() / sizeof(uint32_t);
+            immediateDataConstants.Constants.RegisterSpace = kImmediateDataBindGroup;
+            immediateDataConstants.Constants.ShaderRegister = 0;
+            mImmediateDataParameterIndex = rootParameters.size();
+            rootParameters.emplace_back(immediateDataConstants);
+        }
+
+        // kMaxImmediateDataSize is chosen so that the root signature fits even at the maximum
+        // limits.
+        uint32_t rootSignatureDWordCount = 0;
+        for (const D3D12_ROOT_PARAMETER& parameter : rootParameters) {
+            rootSignatureDWordCount += RootParameterDWordCount(parameter);
+        }
+        ASSERT(rootSignatureDWordCount <= kMaxRootSignatureDWords);
+
         D3D12_ROOT_SIGNATURE_DESC rootSignatureDescriptor;
         rootSignatureDescriptor.NumParameters = rootParameters.size();
         rootSignatureDescriptor.pParameters = rootParameters.data();
@@ -240,4 +277,9 @@ namespace dawn_native { namespace d3d12 {
     uint32_t PipelineLayout::GetFirstIndexOffsetParameterIndex() const {
         return mFirstIndexOffsetParameterIndex;
     }
+
+    uint32_t PipelineLayout::GetImmediateDataParameterIndex() const {
+        ASSERT(GetImmediateDataSize() > 0);
+        return mImmediateDataParameterIndex;
+    }
 }}  // namespace dawn_native::d3d12
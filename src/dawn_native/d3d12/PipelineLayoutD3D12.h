@@ -41,6 +41,10 @@ namespace dawn_native { namespace d3d12 {
         uint32_t GetFirstIndexOffsetShaderRegister() const;
         uint32_t GetFirstIndexOffsetParameterIndex() const;
 
+        // Returns the index of the root constants holding the immediate data. Only valid when
+        // GetImmediateDataSize() is not 0.
+        uint32_t GetImmediateDataParameterIndex() const;
+
         ID3D12RootSignature* GetRootSignature() const;
 
       private:
@@ -56,6 +60,7 @@ namespace dawn_native { namespace d3d12 {
         uint32_t mFirstIndexOffsetRegisterSpace;
         uint32_t mFirstIndexOffsetShaderRegister;
         uint32_t mFirstIndexOffsetParameterIndex;
+        uint32_t mImmediateDataParameterIndex;
         ComPtr<ID3D12RootSignature> mRootSignature;
     };
 
@@ -363,6 +363,7 @@ namespace dawn_native { namespace d3d12 {
                             modules[stage]->Compile(entryPoints[stage], stage,
                                                     ToBackend(GetLayout()), compileFlags));
             *shaders[stage] = compiledShader[stage].GetD3D12ShaderBytecode();
+            AddEstimatedShaderSize(shaders[stage]->BytecodeLength);
         }
 
         mFirstOffsetInfo = compiledShader[SingleShaderStage::Vertex].firstOffsetInfo;
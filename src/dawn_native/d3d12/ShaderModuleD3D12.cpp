@@ -192,7 +192,7 @@ namespace dawn_native { namespace d3d12 {
         SingleShaderStage stage,
         PipelineLayout* layout,
         std::string* remappedEntryPointName,
-        FirstOffsetInfo* firstOffsetInfo) const {
+        FirstOffsetInfo* firstOffsetInfo) {
         ASSERT(!IsError());
 
         ScopedTintICEHandler scopedICEHandler(GetDevice());
@@ -259,10 +259,13 @@ namespace dawn_native { namespace d3d12 {
         transformInputs.Add<BindingRemapper::Remappings>(std::move(bindingPoints),
                                                          std::move(accessControls));
 
+        std::shared_ptr<const tint::Program> tintProgram;
+        DAWN_TRY_ASSIGN(tintProgram, AcquireTintProgram());
+
         tint::Program program;
         tint::transform::DataMap transformOutputs;
-        DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, GetTintProgram(), transformInputs,
-                                               &transformOutputs, nullptr));
+        DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, tintProgram.get(),
+                                               transformInputs, &transformOutputs, nullptr));
 
         if (auto* data = transformOutputs.Get<tint::transform::FirstIndexOffset::Data>()) {
             firstOffsetInfo->usesVertexIndex = data->has_vertex_index;
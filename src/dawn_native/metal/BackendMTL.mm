@@ -232,6 +232,11 @@ namespace dawn_native { namespace metal {
             }
 
             mSupportedExtensions.EnableExtension(Extension::ShaderFloat16);
+            mSupportedExtensions.EnableExtension(Extension::TextureDataConversion);
+
+            // MultiDrawIndirect is a loop of indirect draws. DrawIndirectCount would need indirect
+            // command buffers and isn't supported.
+            mSupportedExtensions.EnableExtension(Extension::MultiDrawIndirect);
         }
 
         NSPRef<id<MTLDevice>> mDevice;
@@ -1155,6 +1155,29 @@ namespace dawn_native { namespace metal {
                     break;
                 }
 
+                case Command::MultiDrawIndexedIndirect: {
+                    MultiDrawIndexedIndirectCmd* draw =
+                        iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+                    ASSERT(draw->drawCountBuffer == nullptr);
+
+                    vertexBuffers.Apply(encoder, lastPipeline, enableVertexPulling);
+                    bindGroups.Apply(encoder);
+                    storageBufferLengths.Apply(encoder, lastPipeline, enableVertexPulling);
+
+                    Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                    id<MTLBuffer> indirectBuffer = buffer->GetMTLBuffer();
+                    for (uint32_t i = 0; i < draw->maxDrawCount; ++i) {
+                        [encoder drawIndexedPrimitives:lastPipeline->GetMTLPrimitiveTopology()
+                                             indexType:indexBufferType
+                                           indexBuffer:indexBuffer
+                                     indexBufferOffset:indexBufferBaseOffset
+                                        indirectBuffer:indirectBuffer
+                                  indirectBufferOffset:draw->indirectOffset +
+                                                       i * kDrawIndexedIndirectSize];
+                    }
+                    break;
+                }
+
                 case Command::InsertDebugMarker: {
                     InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
                     char* label = iter->NextData<char>(cmd->length + 1);
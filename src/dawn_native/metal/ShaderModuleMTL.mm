@@ -89,10 +89,13 @@ namespace dawn_native { namespace metal {
         transformManager.Add<tint::transform::Renamer>();
         transformManager.Add<tint::transform::Msl>();
 
+        std::shared_ptr<const tint::Program> tintProgram;
+        DAWN_TRY_ASSIGN(tintProgram, AcquireTintProgram());
+
         tint::Program program;
         tint::transform::DataMap transformOutputs;
-        DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, GetTintProgram(), transformInputs,
-                                               &transformOutputs, nullptr));
+        DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, tintProgram.get(),
+                                               transformInputs, &transformOutputs, nullptr));
 
         if (auto* data = transformOutputs.Get<tint::transform::Renamer::Data>()) {
             auto it = data->remappings.find(entryPointName);
@@ -130,9 +133,11 @@ namespace dawn_native { namespace metal {
         if (GetDevice()->IsToggleEnabled(Toggle::MetalEnableVertexPulling) &&
             stage == SingleShaderStage::Vertex) {
             if (GetDevice()->IsToggleEnabled(Toggle::UseTintGenerator)) {
+                std::shared_ptr<const tint::Program> tintProgram;
+                DAWN_TRY_ASSIGN(tintProgram, AcquireTintProgram());
                 DAWN_TRY_ASSIGN(pullingSpirv,
-                                GeneratePullingSpirv(GetTintProgram(), *vertexState, entryPointName,
-                                                     kPullingBufferBindingSet));
+                                GeneratePullingSpirv(tintProgram.get(), *vertexState,
+                                                     entryPointName, kPullingBufferBindingSet));
             } else {
                 DAWN_TRY_ASSIGN(pullingSpirv,
                                 GeneratePullingSpirv(GetSpirv(), *vertexState, entryPointName,
@@ -32,6 +32,10 @@ namespace dawn_native { namespace null {
 
         // Enable all extensions by default for the convenience of tests.
         mSupportedExtensions.extensionsBitSet.flip();
+
+        // Use the smallest maxDrawIndirectCount of Vulkan devices with the multiDrawIndirect
+        // feature so that its validation can be tested.
+        mMaxDrawIndirectCount = 65535;
     }
 
     Adapter::~Adapter() = default;
@@ -225,6 +229,11 @@ namespace dawn_native { namespace null {
         return GetLastSubmittedCommandSerial();
     }
 
+    MaybeError Device::WaitForSerialImpl(ExecutionSerial serial, uint64_t timeoutNs) {
+        // All the submitted work is completed immediately.
+        return {};
+    }
+
     void Device::AddPendingOperation(std::unique_ptr<PendingOperation> operation) {
         mPendingOperations.emplace_back(std::move(operation));
     }
@@ -154,6 +154,7 @@ namespace dawn_native { namespace null {
             const TextureViewDescriptor* descriptor) override;
 
         ResultOrError<ExecutionSerial> CheckAndUpdateCompletedSerials() override;
+        MaybeError WaitForSerialImpl(ExecutionSerial serial, uint64_t timeoutNs) override;
 
         void ShutDownImpl() override;
         MaybeError WaitForIdleForDestruction() override;
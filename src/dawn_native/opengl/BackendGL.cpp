@@ -247,6 +247,21 @@ namespace dawn_native { namespace opengl {
                         dawn_native::Extension::TextureCompressionBC);
                 }
             }
+
+            // TextureDataConversion is implemented with compute shaders in the frontend.
+            mSupportedExtensions.EnableExtension(dawn_native::Extension::TextureDataConversion);
+
+            // MultiDrawIndirect uses glMultiDrawElementsIndirect from GL 4.3 and falls back to a
+            // loop of glDrawElementsIndirect otherwise.
+            mSupportedExtensions.EnableExtension(dawn_native::Extension::MultiDrawIndirect);
+
+            // DrawIndirectCount
+            if (mFunctions.IsAtLeastGL(4, 6)) {
+                mSupportedExtensions.EnableExtension(dawn_native::Extension::DrawIndirectCount);
+            }
+
+            // ImmediateData is stored in a uniform buffer owned by the device.
+            mSupportedExtensions.EnableExtension(dawn_native::Extension::ImmediateData);
         }
     };
 
@@ -19,6 +19,7 @@
 #include "dawn_native/BindGroupTracker.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/Commands.h"
+#include "dawn_native/ImmediateDataTracker.h"
 #include "dawn_native/RenderBundle.h"
 #include "dawn_native/opengl/BufferGL.h"
 #include "dawn_native/opengl/ComputePipelineGL.h"
@@ -369,6 +370,22 @@ namespace dawn_native { namespace opengl {
             PipelineGL* mPipeline = nullptr;
         };
 
+        void ApplyImmediateData(Device* device, ImmediateDataTracker* immediateData) {
+            uint32_t size = immediateData->GetDirtySize();
+            if (size > 0) {
+                const OpenGLFunctions& gl = device->gl;
+                GLuint buffer = device->GetImmediateDataBuffer();
+                gl.BindBuffer(GL_UNIFORM_BUFFER, buffer);
+                gl.BufferSubData(GL_UNIFORM_BUFFER, 0, size, immediateData->GetData());
+                gl.BindBufferBase(
+                    GL_UNIFORM_BUFFER,
+                    ToBackend(immediateData->GetPipelineLayout())
+                        ->GetImmediateDataUniformBufferIndex(),
+                    buffer);
+            }
+            immediateData->DidApply();
+        }
+
         void ResolveMultisampledRenderTargets(const OpenGLFunctions& gl,
                                               const BeginRenderPassCmd* renderPass) {
             ASSERT(renderPass != nullptr);
@@ -795,9 +812,11 @@ namespace dawn_native { namespace opengl {
     }
 
     MaybeError CommandBuffer::ExecuteComputePass() {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+        Device* device = ToBackend(GetDevice());
+        const OpenGLFunctions& gl = device->gl;
         ComputePipeline* lastPipeline = nullptr;
         BindGroupTracker bindGroupTracker = {};
+        ImmediateDataTracker immediateData = {};
 
         Command type;
         while (mCommands.NextCommandId(&type)) {
@@ -810,6 +829,7 @@ namespace dawn_native { namespace opengl {
                 case Command::Dispatch: {
                     DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
                     bindGroupTracker.Apply(gl);
+                    ApplyImmediateData(device, &immediateData);
 
                     gl.DispatchCompute(dispatch->x, dispatch->y, dispatch->z);
                     // TODO(cwallez@chromium.org): add barriers to the API
@@ -820,6 +840,7 @@ namespace dawn_native { namespace opengl {
                 case Command::DispatchIndirect: {
                     DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
                     bindGroupTracker.Apply(gl);
+                    ApplyImmediateData(device, &immediateData);
 
                     uint64_t indirectBufferOffset = dispatch->indirectOffset;
                     Buffer* indirectBuffer = ToBackend(dispatch->indirectBuffer.Get());
@@ -837,6 +858,7 @@ namespace dawn_native { namespace opengl {
                     lastPipeline->ApplyNow();
 
                     bindGroupTracker.OnSetPipeline(lastPipeline);
+                    immediateData.OnSetPipeline(lastPipeline);
                     break;
                 }
 
@@ -851,6 +873,12 @@ namespace dawn_native { namespace opengl {
                     break;
                 }
 
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = mCommands.NextCommand<SetImmediateDataCmd>();
+                    immediateData.OnSetImmediateData(cmd, mCommands.NextData<uint8_t>(cmd->size));
+                    break;
+                }
+
                 case Command::InsertDebugMarker:
                 case Command::PopDebugGroup:
                 case Command::PushDebugGroup: {
@@ -874,7 +902,8 @@ namespace dawn_native { namespace opengl {
     }
 
     MaybeError CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+        Device* device = ToBackend(GetDevice());
+        const OpenGLFunctions& gl = device->gl;
         GLuint fbo = 0;
 
         // Create the framebuffer used for this render pass and calls the correct glDrawBuffers
@@ -1040,6 +1069,7 @@ namespace dawn_native { namespace opengl {
 
         VertexStateBufferBindingTracker vertexStateBufferBindingTracker;
         BindGroupTracker bindGroupTracker = {};
+        ImmediateDataTracker immediateData = {};
 
         auto DoRenderBundleCommand = [&](CommandIterator* iter, Command type) {
             switch (type) {
@@ -1047,6 +1077,7 @@ namespace dawn_native { namespace opengl {
                     DrawCmd* draw = iter->NextCommand<DrawCmd>();
                     vertexStateBufferBindingTracker.Apply(gl);
                     bindGroupTracker.Apply(gl);
+                    ApplyImmediateData(device, &immediateData);
 
                     if (draw->firstInstance > 0) {
                         gl.DrawArraysInstancedBaseInstance(
@@ -1065,6 +1096,7 @@ namespace dawn_native { namespace opengl {
                     DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
                     vertexStateBufferBindingTracker.Apply(gl);
                     bindGroupTracker.Apply(gl);
+                    ApplyImmediateData(device, &immediateData);
 
                     if (draw->firstInstance > 0) {
                         gl.DrawElementsInstancedBaseVertexBaseInstance(
@@ -1099,6 +1131,7 @@ namespace dawn_native { namespace opengl {
                     DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
                     vertexStateBufferBindingTracker.Apply(gl);
                     bindGroupTracker.Apply(gl);
+                    ApplyImmediateData(device, &immediateData);
 
                     uint64_t indirectBufferOffset = draw->indirectOffset;
                     Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
@@ -1114,6 +1147,7 @@ namespace dawn_native { namespace opengl {
                     DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
                     vertexStateBufferBindingTracker.Apply(gl);
                     bindGroupTracker.Apply(gl);
+                    ApplyImmediateData(device, &immediateData);
 
                     uint64_t indirectBufferOffset = draw->indirectOffset;
                     Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
@@ -1125,6 +1159,44 @@ namespace dawn_native { namespace opengl {
                     break;
                 }
 
+                case Command::MultiDrawIndexedIndirect: {
+                    MultiDrawIndexedIndirectCmd* draw =
+                        iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+                    vertexStateBufferBindingTracker.Apply(gl);
+                    bindGroupTracker.Apply(gl);
+                    ApplyImmediateData(device, &immediateData);
+
+                    uint64_t indirectBufferOffset = draw->indirectOffset;
+                    Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
+                    GLenum topology = lastPipeline->GetGLPrimitiveTopology();
+                    constexpr GLsizei kStride = static_cast<GLsizei>(kDrawIndexedIndirectSize);
+
+                    gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer->GetHandle());
+                    if (draw->drawCountBuffer != nullptr) {
+                        ASSERT(gl.IsAtLeastGL(4, 6));
+                        gl.BindBuffer(GL_PARAMETER_BUFFER,
+                                      ToBackend(draw->drawCountBuffer)->GetHandle());
+                        gl.MultiDrawElementsIndirectCount(
+                            topology, indexBufferFormat,
+                            reinterpret_cast<void*>(static_cast<intptr_t>(indirectBufferOffset)),
+                            static_cast<GLintptr>(draw->drawCountBufferOffset),
+                            static_cast<GLsizei>(draw->maxDrawCount), kStride);
+                    } else if (gl.IsAtLeastGL(4, 3)) {
+                        gl.MultiDrawElementsIndirect(
+                            topology, indexBufferFormat,
+                            reinterpret_cast<void*>(static_cast<intptr_t>(indirectBufferOffset)),
+                            static_cast<GLsizei>(draw->maxDrawCount), kStride);
+                    } else {
+                        for (uint32_t i = 0; i < draw->maxDrawCount; ++i) {
+                            gl.DrawElementsIndirect(
+                                topology, indexBufferFormat,
+                                reinterpret_cast<void*>(static_cast<intptr_t>(
+                                    indirectBufferOffset + uint64_t(i) * kStride)));
+                        }
+                    }
+                    break;
+                }
+
                 case Command::InsertDebugMarker:
                 case Command::PopDebugGroup:
                 case Command::PushDebugGroup: {
@@ -1141,6 +1213,7 @@ namespace dawn_native { namespace opengl {
 
                     vertexStateBufferBindingTracker.OnSetPipeline(lastPipeline);
                     bindGroupTracker.OnSetPipeline(lastPipeline);
+                    immediateData.OnSetPipeline(lastPipeline);
                     break;
                 }
 
@@ -1155,6 +1228,12 @@ namespace dawn_native { namespace opengl {
                     break;
                 }
 
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = iter->NextCommand<SetImmediateDataCmd>();
+                    immediateData.OnSetImmediateData(cmd, iter->NextData<uint8_t>(cmd->size));
+                    break;
+                }
+
                 case Command::SetIndexBuffer: {
                     SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
 
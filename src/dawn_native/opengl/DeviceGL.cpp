@@ -14,6 +14,7 @@
 
 #include "dawn_native/opengl/DeviceGL.h"
 
+#include "common/Constants.h"
 #include "dawn_native/BackendConnection.h"
 #include "dawn_native/BindGroupLayout.h"
 #include "dawn_native/ErrorData.h"
@@ -173,7 +174,7 @@ namespace dawn_native { namespace opengl {
     void Device::SubmitFenceSync() {
         GLsync sync = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
         IncrementLastSubmittedCommandSerial();
-        mFencesInFlight.emplace(sync, GetLastSubmittedCommandSerial());
+        mFencesInFlight.emplace_back(sync, GetLastSubmittedCommandSerial());
     }
 
     MaybeError Device::TickImpl() {
@@ -202,13 +203,34 @@ namespace dawn_native { namespace opengl {
 
             gl.DeleteSync(sync);
 
-            mFencesInFlight.pop();
+            mFencesInFlight.pop_front();
 
             ASSERT(fenceSerial > GetCompletedCommandSerial());
         }
         return fenceSerial;
     }
 
+    MaybeError Device::WaitForSerialImpl(ExecutionSerial serial, uint64_t timeoutNs) {
+        // Fences are added in order, wait on the first one that covers |serial|.
+        for (const auto& syncAndSerial : mFencesInFlight) {
+            if (syncAndSerial.second < serial) {
+                continue;
+            }
+
+            // TODO(crbug.com/dawn/633): Remove this workaround after the deadlock issue is fixed.
+            if (IsToggleEnabled(Toggle::FlushBeforeClientWaitSync)) {
+                gl.Flush();
+            }
+            GLenum result =
+                gl.ClientWaitSync(syncAndSerial.first, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNs);
+            if (result == GL_WAIT_FAILED) {
+                return DAWN_INTERNAL_ERROR("glClientWaitSync failed");
+            }
+            return {};
+        }
+        return {};
+    }
+
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
         return DAWN_UNIMPLEMENTED_ERROR("Device unable to create staging buffer.");
     }
@@ -228,8 +250,21 @@ namespace dawn_native { namespace opengl {
         return DAWN_UNIMPLEMENTED_ERROR("Device unable to copy from staging buffer to texture.");
     }
 
+    GLuint Device::GetImmediateDataBuffer() {
+        if (mImmediateDataBuffer == 0) {
+            gl.GenBuffers(1, &mImmediateDataBuffer);
+            gl.BindBuffer(GL_UNIFORM_BUFFER, mImmediateDataBuffer);
+            gl.BufferData(GL_UNIFORM_BUFFER, kMaxImmediateDataSize, nullptr, GL_DYNAMIC_DRAW);
+        }
+        return mImmediateDataBuffer;
+    }
+
     void Device::ShutDownImpl() {
         ASSERT(GetState() == State::Disconnected);
+        if (mImmediateDataBuffer != 0) {
+            gl.DeleteBuffers(1, &mImmediateDataBuffer);
+            mImmediateDataBuffer = 0;
+        }
     }
 
     MaybeError Device::WaitForIdleForDestruction() {
@@ -24,7 +24,7 @@
 #include "dawn_native/opengl/GLFormat.h"
 #include "dawn_native/opengl/OpenGLFunctions.h"
 
-#include <queue>
+#include <deque>
 
 // Remove windows.h macros after glad's include of windows.h
 #if defined(DAWN_PLATFORM_WINDOWS)
@@ -49,6 +49,9 @@ namespace dawn_native { namespace opengl {
 
         void SubmitFenceSync();
 
+        // The uniform buffer that the immediate data is written to before draws and dispatches.
+        GLuint GetImmediateDataBuffer();
+
         ResultOrError<Ref<CommandBufferBase>> CreateCommandBuffer(
             CommandEncoder* encoder,
             const CommandBufferDescriptor* descriptor) override;
@@ -110,12 +113,15 @@ namespace dawn_native { namespace opengl {
 
         void InitTogglesFromDriver();
         ResultOrError<ExecutionSerial> CheckAndUpdateCompletedSerials() override;
+        MaybeError WaitForSerialImpl(ExecutionSerial serial, uint64_t timeoutNs) override;
         void ShutDownImpl() override;
         MaybeError WaitForIdleForDestruction() override;
 
-        std::queue<std::pair<GLsync, ExecutionSerial>> mFencesInFlight;
+        std::deque<std::pair<GLsync, ExecutionSerial>> mFencesInFlight;
 
         GLFormatTable mFormatTable;
+
+        GLuint mImmediateDataBuffer = 0;
     };
 
 }}  // namespace dawn_native::opengl
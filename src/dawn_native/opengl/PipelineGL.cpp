@@ -124,6 +124,12 @@ namespace dawn_native { namespace opengl {
         gl.UseProgram(mProgram);
         const auto& indices = layout->GetBindingIndexInfo();
 
+        GLuint immediateDataBlock = gl.GetUniformBlockIndex(mProgram, kImmediateDataBlockName);
+        if (immediateDataBlock != GL_INVALID_INDEX) {
+            gl.UniformBlockBinding(mProgram, immediateDataBlock,
+                                   layout->GetImmediateDataUniformBufferIndex());
+        }
+
         for (BindGroupIndex group : IterateBitSet(layout->GetBindGroupLayoutsMask())) {
             const BindGroupLayoutBase* bgl = layout->GetBindGroupLayout(group);
 
@@ -72,6 +72,7 @@ namespace dawn_native { namespace opengl {
 
         mNumSamplers = samplerIndex;
         mNumSampledTextures = sampledTextureIndex;
+        mImmediateDataUniformBufferIndex = uboIndex;
     }
 
     const PipelineLayout::BindingIndexInfo& PipelineLayout::GetBindingIndexInfo() const {
@@ -90,4 +91,8 @@ namespace dawn_native { namespace opengl {
         return mNumSampledTextures;
     }
 
+    GLuint PipelineLayout::GetImmediateDataUniformBufferIndex() const {
+        return mImmediateDataUniformBufferIndex;
+    }
+
 }}  // namespace dawn_native::opengl
@@ -38,11 +38,15 @@ namespace dawn_native { namespace opengl {
         size_t GetNumSamplers() const;
         size_t GetNumSampledTextures() const;
 
+        // The immediate data is a uniform buffer bound after the ones of the bind groups.
+        GLuint GetImmediateDataUniformBufferIndex() const;
+
       private:
         ~PipelineLayout() override = default;
         BindingIndexInfo mIndexInfo;
         size_t mNumSamplers;
         size_t mNumSampledTextures;
+        GLuint mImmediateDataUniformBufferIndex;
     };
 
 }}  // namespace dawn_native::opengl
@@ -89,9 +89,14 @@ namespace dawn_native { namespace opengl {
 
             tint::transform::DataMap transformInputs;
 
+            // The program isn't needed after the SPIR-V is generated, so it is acquired to let
+            // the ReleaseShaderModulePrograms toggle free it.
+            std::shared_ptr<const tint::Program> tintProgram;
+            DAWN_TRY_ASSIGN(tintProgram, AcquireTintProgram());
+
             tint::Program program;
             DAWN_TRY_ASSIGN(program,
-                            RunTransforms(&transformManager, GetTintProgram(), transformInputs,
+                            RunTransforms(&transformManager, tintProgram.get(), transformInputs,
                                           nullptr, GetCompilationMessages()));
 
             tint::writer::spirv::Generator generator(&program);
@@ -108,6 +113,15 @@ namespace dawn_native { namespace opengl {
         return {};
     }
 
+    uint64_t ShaderModule::ComputeRetainedBytes() const {
+        uint64_t bytes = ShaderModuleBase::ComputeRetainedBytes();
+        bytes += mGLSpirv.size() * sizeof(uint32_t);
+        for (const auto& it : mGLEntryPoints) {
+            bytes += it.first.size() + sizeof(EntryPointMetadata);
+        }
+        return bytes;
+    }
+
     std::string ShaderModule::TranslateToGLSL(const char* entryPointName,
                                               SingleShaderStage stage,
                                               CombinedSamplerInfo* combinedSamplers,
@@ -214,6 +228,20 @@ namespace dawn_native { namespace opengl {
             }
         }
 
+        // The immediate data isn't in the bindings of the entry point. Its uniform block is bound
+        // by name like the other ones.
+        if (GetDevice()->IsExtensionEnabled(Extension::ImmediateData)) {
+            for (const auto& resource : compiler.get_shader_resources().uniform_buffers) {
+                if (compiler.get_decoration(resource.id, spv::DecorationDescriptorSet) ==
+                        kImmediateDataBindGroup &&
+                    compiler.get_decoration(resource.id, spv::DecorationBinding) == 0) {
+                    compiler.set_name(resource.base_type_id, kImmediateDataBlockName);
+                    compiler.unset_decoration(resource.id, spv::DecorationDescriptorSet);
+                    compiler.unset_decoration(resource.id, spv::DecorationBinding);
+                }
+            }
+        }
+
         return compiler.compile();
     }
 
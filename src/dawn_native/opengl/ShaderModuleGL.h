@@ -26,6 +26,9 @@ namespace dawn_native { namespace opengl {
 
     std::string GetBindingName(BindGroupIndex group, BindingNumber bindingNumber);
 
+    // The name of the uniform block of the immediate data in the GLSL.
+    static constexpr char kImmediateDataBlockName[] = "dawn_immediate_data";
+
     struct BindingLocation {
         BindGroupIndex group;
         BindingNumber binding;
@@ -56,6 +59,8 @@ namespace dawn_native { namespace opengl {
                                     const PipelineLayout* layout,
                                     bool* needsDummySampler) const;
 
+        uint64_t ComputeRetainedBytes() const override;
+
       private:
         ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
         ~ShaderModule() override = default;
@@ -99,6 +99,21 @@ namespace dawn_native { namespace vulkan {
         if (mDeviceInfo.properties.limits.timestampComputeAndGraphics == VK_TRUE) {
             mSupportedExtensions.EnableExtension(Extension::TimestampQuery);
         }
+
+        mSupportedExtensions.EnableExtension(Extension::TextureDataConversion);
+
+        // Multi draw indirect falls back to a loop of indirect draws without the feature.
+        mSupportedExtensions.EnableExtension(Extension::MultiDrawIndirect);
+        if (mDeviceInfo.features.multiDrawIndirect == VK_TRUE) {
+            mMaxDrawIndirectCount = mDeviceInfo.properties.limits.maxDrawIndirectCount;
+            if (mDeviceInfo.HasExt(DeviceExt::DrawIndirectCount)) {
+                mSupportedExtensions.EnableExtension(Extension::DrawIndirectCount);
+            }
+        }
+
+        // Immediate data uses push constants, of which Vulkan guarantees at least
+        // kMaxImmediateDataSize bytes.
+        mSupportedExtensions.EnableExtension(Extension::ImmediateData);
     }
 
     ResultOrError<DeviceBase*> Adapter::CreateDeviceImpl(const DeviceDescriptor* descriptor) {
@@ -164,19 +164,43 @@ namespace dawn_native { namespace vulkan {
     ResultOrError<Ref<BindGroup>> BindGroupLayout::AllocateBindGroup(
         Device* device,
         const BindGroupDescriptor* descriptor) {
-        DescriptorSetAllocation descriptorSetAllocation;
-        DAWN_TRY_ASSIGN(descriptorSetAllocation, mDescriptorSetAllocator->Allocate());
+        Ref<BindGroup> bindGroup = AllocateBindGroupWithoutDescriptorSet(device, descriptor);
+        DAWN_TRY(bindGroup->InitializeDescriptorSet());
+        return std::move(bindGroup);
+    }
 
-        return AcquireRef(
-            mBindGroupAllocator.Allocate(device, descriptor, descriptorSetAllocation));
+    Ref<BindGroup> BindGroupLayout::AllocateBindGroupWithoutDescriptorSet(
+        Device* device,
+        const BindGroupDescriptor* descriptor) {
+        return AcquireRef(mBindGroupAllocator.Allocate(device, descriptor));
     }
 
     void BindGroupLayout::DeallocateBindGroup(BindGroup* bindGroup,
                                               DescriptorSetAllocation* descriptorSetAllocation) {
-        mDescriptorSetAllocator->Deallocate(descriptorSetAllocation);
+        // The allocation is empty if the bind group failed to initialize.
+        if (descriptorSetAllocation->set != VK_NULL_HANDLE) {
+            std::vector<ObjectBase*> resources;
+            DescriptorSetKey key = bindGroup->ComputeDescriptorSetKey(&resources);
+            mDescriptorSetAllocator->Recycle(descriptorSetAllocation, std::move(key),
+                                             std::move(resources));
+        }
         mBindGroupAllocator.Deallocate(bindGroup);
     }
 
+    ResultOrError<DescriptorSetAllocation> BindGroupLayout::AllocateDescriptorSet() {
+        return mDescriptorSetAllocator->Allocate();
+    }
+
+    void BindGroupLayout::ReserveDescriptorSets(uint32_t setCount) {
+        mDescriptorSetAllocator->Reserve(setCount);
+    }
+
+    bool BindGroupLayout::AllocateRecycledDescriptorSet(
+        const DescriptorSetKey& key,
+        DescriptorSetAllocation* descriptorSetAllocation) {
+        return mDescriptorSetAllocator->AllocateRecycled(key, descriptorSetAllocation);
+    }
+
     void BindGroupLayout::FinishDeallocation(ExecutionSerial completedSerial) {
         mDescriptorSetAllocator->FinishDeallocation(completedSerial);
     }
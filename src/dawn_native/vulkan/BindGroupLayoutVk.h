@@ -27,6 +27,7 @@ namespace dawn_native { namespace vulkan {
     class BindGroup;
     struct DescriptorSetAllocation;
     class DescriptorSetAllocator;
+    struct DescriptorSetKey;
     class Device;
 
     VkDescriptorType VulkanDescriptorType(const BindingInfo& bindingInfo);
@@ -59,10 +60,19 @@ namespace dawn_native { namespace vulkan {
 
         ResultOrError<Ref<BindGroup>> AllocateBindGroup(Device* device,
                                                         const BindGroupDescriptor* descriptor);
+        // Allocates a bind group whose descriptor set must still be initialized.
+        Ref<BindGroup> AllocateBindGroupWithoutDescriptorSet(
+            Device* device,
+            const BindGroupDescriptor* descriptor);
         void DeallocateBindGroup(BindGroup* bindGroup,
                                  DescriptorSetAllocation* descriptorSetAllocation);
         void FinishDeallocation(ExecutionSerial completedSerial);
 
+        ResultOrError<DescriptorSetAllocation> AllocateDescriptorSet();
+        void ReserveDescriptorSets(uint32_t setCount);
+        bool AllocateRecycledDescriptorSet(const DescriptorSetKey& key,
+                                           DescriptorSetAllocation* descriptorSetAllocation);
+
       private:
         ~BindGroupLayout() override;
         MaybeError Initialize();
@@ -15,6 +15,7 @@
 #include "dawn_native/vulkan/BindGroupVk.h"
 
 #include "common/BitSetIterator.h"
+#include "common/HashUtils.h"
 #include "common/ityp_stack_vec.h"
 #include "dawn_native/vulkan/BindGroupLayoutVk.h"
 #include "dawn_native/vulkan/BufferVk.h"
@@ -24,19 +25,168 @@
 #include "dawn_native/vulkan/TextureVk.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
 namespace dawn_native { namespace vulkan {
 
+    namespace {
+
+        // The bits of |handle| as a word of DescriptorSetKey, 0 for VK_NULL_HANDLE.
+        uint64_t GetHandleKeyWord(VkBuffer handle) {
+            uint64_t word = 0;
+            static_assert(sizeof(handle) <= sizeof(word), "");
+            memcpy(&word, &handle, sizeof(handle));
+            return word;
+        }
+
+    }  // anonymous namespace
+
     // static
     ResultOrError<Ref<BindGroup>> BindGroup::Create(Device* device,
                                                     const BindGroupDescriptor* descriptor) {
         return ToBackend(descriptor->layout)->AllocateBindGroup(device, descriptor);
     }
 
-    BindGroup::BindGroup(Device* device,
-                         const BindGroupDescriptor* descriptor,
-                         DescriptorSetAllocation descriptorSetAllocation)
-        : BindGroupBase(this, device, descriptor),
-          mDescriptorSetAllocation(descriptorSetAllocation) {
+    template <typename F>
+    void BindGroup::ForEachBuffer(F&& f) {
+        for (BindingIndex bindingIndex{0}; bindingIndex < GetLayout()->GetBufferCount();
+             ++bindingIndex) {
+            f(ToBackend(GetBindingAsBufferBinding(bindingIndex).buffer));
+        }
+    }
+
+    BindGroup::BindGroup(Device* device, const BindGroupDescriptor* descriptor)
+        : BindGroupBase(this, device, descriptor) {
+        if (device->GetBufferDefragmenter() != nullptr) {
+            ForEachBuffer([this](Buffer* buffer) { buffer->AddBindGroup(this); });
+        }
+    }
+
+    // static
+    MaybeError BindGroup::CreateMany(Device* device,
+                                     uint32_t count,
+                                     const BindGroupDescriptor* const* descriptors,
+                                     Ref<BindGroupBase>* bindGroups) {
+        // Let each layout allocate the descriptor sets it needs with few pools.
+        std::unordered_map<BindGroupLayout*, uint32_t> setCountPerLayout;
+        uint32_t totalBindingCount = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            BindGroupLayout* layout = ToBackend(descriptors[i]->layout);
+            setCountPerLayout[layout]++;
+            totalBindingCount += static_cast<uint32_t>(layout->GetBindingCount());
+        }
+        for (const auto& it : setCountPerLayout) {
+            it.first->ReserveDescriptorSets(it.second);
+        }
+
+        // The descriptor writes of all the bind groups are gathered to update all the descriptor
+        // sets at once. The arrays are allocated upfront so that the writes can point in them.
+        std::vector<VkWriteDescriptorSet> writes(totalBindingCount);
+        std::vector<VkDescriptorBufferInfo> writeBufferInfo(totalBindingCount);
+        std::vector<VkDescriptorImageInfo> writeImageInfo(totalBindingCount);
+        uint32_t numWrites = 0;
+        uint32_t infoOffset = 0;
+
+        // The descriptor sets must be written even if a later allocation fails because the
+        // sets of the bind groups already created get recycled with the key of their content.
+        auto UpdateDescriptorSets = [&]() {
+            if (numWrites > 0) {
+                device->fn.UpdateDescriptorSets(device->GetVkDevice(), numWrites, writes.data(),
+                                                0, nullptr);
+            }
+        };
+
+        for (uint32_t i = 0; i < count; ++i) {
+            BindGroupLayout* layout = ToBackend(descriptors[i]->layout);
+            Ref<BindGroup> bindGroup =
+                layout->AllocateBindGroupWithoutDescriptorSet(device, descriptors[i]);
+
+            bool needsWrite = false;
+            DAWN_TRY_WITH_CLEANUP(bindGroup->AllocateDescriptorSet(&needsWrite),
+                                  { UpdateDescriptorSets(); });
+            if (needsWrite) {
+                numWrites += bindGroup->FillDescriptorSetWrites(&writes[numWrites],
+                                                                &writeBufferInfo[infoOffset],
+                                                                &writeImageInfo[infoOffset]);
+                infoOffset += static_cast<uint32_t>(layout->GetBindingCount());
+            }
+            bindGroups[i] = std::move(bindGroup);
+        }
+
+        UpdateDescriptorSets();
+        return {};
+    }
+
+    MaybeError BindGroup::InitializeDescriptorSet() {
+        bool needsWrite = false;
+        DAWN_TRY(AllocateDescriptorSet(&needsWrite));
+        if (needsWrite) {
+            WriteDescriptorSet();
+        }
+        return {};
+    }
+
+    MaybeError BindGroup::AllocateDescriptorSet(bool* needsWrite) {
+        BindGroupLayout* layout = ToBackend(GetLayout());
+        if (layout->AllocateRecycledDescriptorSet(ComputeDescriptorSetKey(nullptr),
+                                                  &mDescriptorSetAllocation)) {
+            *needsWrite = false;
+            return {};
+        }
+
+        DAWN_TRY_ASSIGN(mDescriptorSetAllocation, layout->AllocateDescriptorSet());
+        *needsWrite = true;
+        return {};
+    }
+
+    DescriptorSetKey BindGroup::ComputeDescriptorSetKey(std::vector<ObjectBase*>* resources) {
+        const BindingIndex bindingCount = GetLayout()->GetBindingCount();
+
+        DescriptorSetKey key;
+        key.words.reserve(static_cast<uint32_t>(bindingCount) * 4);
+        for (BindingIndex bindingIndex{0}; bindingIndex < bindingCount; ++bindingIndex) {
+            ObjectBase* object = nullptr;
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            uint64_t handle = 0;
+
+            switch (GetLayout()->GetBindingInfo(bindingIndex).bindingType) {
+                case BindingInfoType::Buffer: {
+                    BufferBinding binding = GetBindingAsBufferBinding(bindingIndex);
+                    object = binding.buffer;
+                    offset = binding.offset;
+                    size = binding.size;
+                    handle = GetHandleKeyWord(ToBackend(binding.buffer)->GetHandle());
+                    break;
+                }
+                case BindingInfoType::Sampler:
+                    object = GetBindingAsSampler(bindingIndex);
+                    break;
+                case BindingInfoType::Texture:
+                case BindingInfoType::StorageTexture:
+                    object = GetBindingAsTextureView(bindingIndex);
+                    break;
+            }
+
+            key.words.push_back(reinterpret_cast<uint64_t>(object));
+            key.words.push_back(offset);
+            key.words.push_back(size);
+            key.words.push_back(handle);
+
+            if (resources != nullptr) {
+                resources->push_back(object);
+            }
+        }
+
+        key.hash = HashBytes(key.words.data(), key.words.size() * sizeof(uint64_t));
+        return key;
+    }
+
+    void BindGroup::WriteDescriptorSet() {
+        Device* device = ToBackend(GetDevice());
+
         // Now do a write of a single descriptor set with all possible chained data allocated on the
         // stack.
         const uint32_t bindingCount = static_cast<uint32_t>((GetLayout()->GetBindingCount()));
@@ -47,6 +197,16 @@ namespace dawn_native { namespace vulkan {
         ityp::stack_vec<uint32_t, VkDescriptorImageInfo, kMaxOptimalBindingsPerGroup>
             writeImageInfo(bindingCount);
 
+        uint32_t numWrites =
+            FillDescriptorSetWrites(writes.data(), writeBufferInfo.data(), writeImageInfo.data());
+        device->fn.UpdateDescriptorSets(device->GetVkDevice(), numWrites, writes.data(), 0,
+                                        nullptr);
+    }
+
+    uint32_t BindGroup::FillDescriptorSetWrites(VkWriteDescriptorSet* writes,
+                                                VkDescriptorBufferInfo* writeBufferInfo,
+                                                VkDescriptorImageInfo* writeImageInfo) {
+        Device* device = ToBackend(GetDevice());
         bool useBindingIndex = device->IsToggleEnabled(Toggle::UseTintGenerator);
 
         uint32_t numWrites = 0;
@@ -78,7 +238,8 @@ namespace dawn_native { namespace vulkan {
                         continue;
                     }
                     writeBufferInfo[numWrites].buffer = handle;
-                    writeBufferInfo[numWrites].offset = binding.offset;
+                    writeBufferInfo[numWrites].offset =
+                        ToBackend(binding.buffer)->GetHandleOffset() + binding.offset;
                     writeBufferInfo[numWrites].range = binding.size;
                     write.pBufferInfo = &writeBufferInfo[numWrites];
                     break;
@@ -118,12 +279,13 @@ namespace dawn_native { namespace vulkan {
             numWrites++;
         }
 
-        // TODO(cwallez@chromium.org): Batch these updates
-        device->fn.UpdateDescriptorSets(device->GetVkDevice(), numWrites, writes.data(), 0,
-                                        nullptr);
+        return numWrites;
     }
 
     BindGroup::~BindGroup() {
+        if (ToBackend(GetDevice())->GetBufferDefragmenter() != nullptr) {
+            ForEachBuffer([this](Buffer* buffer) { buffer->RemoveBindGroup(this); });
+        }
         ToBackend(GetLayout())->DeallocateBindGroup(this, &mDescriptorSetAllocation);
     }
 
@@ -21,6 +21,7 @@
 #include "common/vulkan_platform.h"
 #include "dawn_native/vulkan/BindGroupLayoutVk.h"
 #include "dawn_native/vulkan/DescriptorSetAllocation.h"
+#include "dawn_native/vulkan/DescriptorSetAllocator.h"
 
 namespace dawn_native { namespace vulkan {
 
@@ -33,16 +34,43 @@ namespace dawn_native { namespace vulkan {
       public:
         static ResultOrError<Ref<BindGroup>> Create(Device* device,
                                                     const BindGroupDescriptor* descriptor);
+        // Creates the bind groups of |count| validated descriptors, updating all their new
+        // descriptor sets with a single vkUpdateDescriptorSets.
+        static MaybeError CreateMany(Device* device,
+                                     uint32_t count,
+                                     const BindGroupDescriptor* const* descriptors,
+                                     Ref<BindGroupBase>* bindGroups);
 
-        BindGroup(Device* device,
-                  const BindGroupDescriptor* descriptor,
-                  DescriptorSetAllocation descriptorSetAllocation);
+        BindGroup(Device* device, const BindGroupDescriptor* descriptor);
+
+        // Takes a recycled descriptor set with the same content, or allocates and writes a new one.
+        MaybeError InitializeDescriptorSet();
 
         VkDescriptorSet GetHandle() const;
 
+        // The key only depends on the objects and buffer ranges of the bind group, and on the
+        // current VkBuffer of the buffers since destroying them skips their descriptor writes and
+        // relocating them changes it. The objects referenced by the key are appended to
+        // |resources| if it isn't nullptr.
+        DescriptorSetKey ComputeDescriptorSetKey(std::vector<ObjectBase*>* resources);
+
+        // Also used to update the descriptor set when one of its buffers was relocated.
+        void WriteDescriptorSet();
+
       private:
         ~BindGroup() override;
 
+        // Sets |needsWrite| to false if a recycled descriptor set with the same content was
+        // taken.
+        MaybeError AllocateDescriptorSet(bool* needsWrite);
+        template <typename F>
+        void ForEachBuffer(F&& f);
+        // Fills the writes of the descriptor set, which need space for one write, buffer info and
+        // image info per binding. Returns the number of writes.
+        uint32_t FillDescriptorSetWrites(VkWriteDescriptorSet* writes,
+                                         VkDescriptorBufferInfo* writeBufferInfo,
+                                         VkDescriptorImageInfo* writeImageInfo);
+
         // The descriptor set in this allocation outlives the BindGroup because it is owned by
         // the BindGroupLayout which is referenced by the BindGroup.
         DescriptorSetAllocation mDescriptorSetAllocation;
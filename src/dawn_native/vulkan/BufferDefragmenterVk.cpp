@@ -0,0 +1,64 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/BufferDefragmenterVk.h"
+
+#include "dawn_native/vulkan/BufferVk.h"
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/ResourceMemoryAllocatorVk.h"
+
+namespace dawn_native { namespace vulkan {
+
+    namespace {
+
+        // The number of consecutive ticks where the GPU is idle and no memory is allocated or
+        // freed before a heap is evacuated. Relocating buffers counts as memory activity, so
+        // there is at most one evacuation in that many ticks.
+        constexpr uint32_t kIdleTicksBeforeDefragmenting = 30;
+
+    }  // anonymous namespace
+
+    BufferDefragmenter::BufferDefragmenter(Device* device) : mDevice(device) {
+    }
+
+    BufferDefragmenter::~BufferDefragmenter() = default;
+
+    void BufferDefragmenter::AddBuffer(Buffer* buffer) {
+        mBuffers.insert(buffer);
+    }
+
+    void BufferDefragmenter::RemoveBuffer(Buffer* buffer) {
+        mBuffers.erase(buffer);
+    }
+
+    MaybeError BufferDefragmenter::Tick() {
+        ResourceMemoryAllocator* allocator = mDevice->GetResourceMemoryAllocator();
+        if (allocator->GetIdleTicksWithoutMemoryActivity() < kIdleTicksBeforeDefragmenting) {
+            return {};
+        }
+
+        const ResourceHeapBase* heap = allocator->FindHeapToEvacuate();
+        if (heap == nullptr) {
+            return {};
+        }
+
+        for (Buffer* buffer : mBuffers) {
+            if (buffer->GetMemoryHeap() == heap) {
+                DAWN_TRY(buffer->Relocate(heap));
+            }
+        }
+        return {};
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,51 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_BUFFERDEFRAGMENTERVK_H_
+#define DAWNNATIVE_VULKAN_BUFFERDEFRAGMENTERVK_H_
+
+#include "dawn_native/Error.h"
+
+#include <unordered_set>
+
+namespace dawn_native { namespace vulkan {
+
+    class Buffer;
+    class Device;
+
+    // Moves the buffers of a sparse heap for large resources to the other heaps of its memory type
+    // when the device has been idle for a while, so that the heap gets released. The contents are
+    // copied with the pending commands, the buffers get a new VkBuffer and the descriptor sets of
+    // their bind groups are rewritten. Only buffers with their own VkBuffer and non-mappable
+    // memory are relocated.
+    class BufferDefragmenter {
+      public:
+        BufferDefragmenter(Device* device);
+        ~BufferDefragmenter();
+
+        void AddBuffer(Buffer* buffer);
+        void RemoveBuffer(Buffer* buffer);
+
+        // Evacuates at most one heap. Must be called when there are no pending commands since
+        // the descriptor sets can't be updated once they are bound in a command buffer.
+        MaybeError Tick();
+
+      private:
+        Device* mDevice;
+        std::unordered_set<Buffer*> mBuffers;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_BUFFERDEFRAGMENTERVK_H_
@@ -0,0 +1,219 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/BufferSubAllocatorVk.h"
+
+#include "common/Math.h"
+#include "dawn_native/BuddyMemoryAllocator.h"
+#include "dawn_native/PooledResourceMemoryAllocator.h"
+#include "dawn_native/ResourceHeapAllocator.h"
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/ResourceHeapVk.h"
+#include "dawn_native/vulkan/VulkanError.h"
+
+#include <algorithm>
+
+namespace dawn_native { namespace vulkan {
+
+    namespace {
+
+        // Buffers up to this size are sub-allocated. Larger buffers don't benefit as much from
+        // sharing a VkBuffer and would waste more space in the buddy system.
+        constexpr uint64_t kMaxSubAllocatedBufferSize = 64 * 1024;
+
+        // The size of each SharedBuffer. It is small enough for the memory of the SharedBuffers
+        // to be sub-allocated by the ResourceMemoryAllocator.
+        constexpr uint64_t kSharedBufferSize = 1024 * 1024;
+
+        // The maximum total size of the SharedBuffers of a single usage.
+        constexpr uint64_t kMaxSharedBufferSystemSize = 4ull * 1024 * 1024 * 1024;
+
+        // Buffer ranges are used for copies and at arbitrary offsets in descriptors, so their
+        // offset needs the strictest alignment. Vulkan guarantees that these are at most 256.
+        constexpr uint64_t kMinSubAllocationAlignment = 16;
+
+        SharedBuffer* ToSharedBuffer(const ResourceMemoryAllocation& allocation) {
+            return static_cast<SharedBuffer*>(allocation.GetResourceHeap());
+        }
+
+    }  // anonymous namespace
+
+    // SharedBuffer
+
+    SharedBuffer::SharedBuffer(VkBuffer handle,
+                               VkBufferUsageFlags usage,
+                               ResourceMemoryAllocation memoryAllocation)
+        : mHandle(handle), mUsage(usage), mMemoryAllocation(memoryAllocation) {
+    }
+
+    VkBuffer SharedBuffer::GetHandle() const {
+        return mHandle;
+    }
+
+    VkBufferUsageFlags SharedBuffer::GetUsage() const {
+        return mUsage;
+    }
+
+    ResourceMemoryAllocation* SharedBuffer::GetMemoryAllocation() {
+        return &mMemoryAllocation;
+    }
+
+    // SingleUsageAllocator is a BuddyMemoryAllocator and its client that creates SharedBuffers
+    // with a single Vulkan usage. Empty SharedBuffers are kept in a pool for reuse until
+    // DestroyPool is called.
+
+    class BufferSubAllocator::SingleUsageAllocator : public ResourceHeapAllocator {
+      public:
+        SingleUsageAllocator(Device* device, VkBufferUsageFlags usage)
+            : mDevice(device),
+              mUsage(usage),
+              mPooledAllocator(this),
+              mBuddySystem(kMaxSharedBufferSystemSize, kSharedBufferSize, &mPooledAllocator) {
+        }
+        ~SingleUsageAllocator() override = default;
+
+        ResultOrError<ResourceMemoryAllocation> Allocate(uint64_t size, uint64_t alignment) {
+            return mBuddySystem.Allocate(size, alignment);
+        }
+
+        void Deallocate(const ResourceMemoryAllocation& allocation) {
+            mBuddySystem.Deallocate(allocation);
+        }
+
+        void DestroyPool() {
+            mPooledAllocator.DestroyPool();
+        }
+
+        uint64_t GetSharedBufferCount() const {
+            return mBuddySystem.GetHeapCount();
+        }
+
+        // Implementation of the ResourceHeapAllocator interface to be a client of
+        // BuddyMemoryAllocator
+
+        ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(
+            uint64_t size) override {
+            VkBufferCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+            createInfo.size = size;
+            createInfo.usage = mUsage;
+            createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.queueFamilyIndexCount = 0;
+            createInfo.pQueueFamilyIndices = 0;
+
+            VkBuffer handle = VK_NULL_HANDLE;
+            DAWN_TRY(CheckVkOOMThenSuccess(
+                mDevice->fn.CreateBuffer(mDevice->GetVkDevice(), &createInfo, nullptr, &*handle),
+                "vkCreateBuffer"));
+
+            VkMemoryRequirements requirements;
+            mDevice->fn.GetBufferMemoryRequirements(mDevice->GetVkDevice(), handle,
+                                                    &requirements);
+
+            // On errors the VkBuffer can be destroyed immediately because no command uses it.
+            ResultOrError<ResourceMemoryAllocation> memoryOrError =
+                mDevice->AllocateMemory(requirements, false);
+            if (memoryOrError.IsError()) {
+                mDevice->fn.DestroyBuffer(mDevice->GetVkDevice(), handle, nullptr);
+                return memoryOrError.AcquireError();
+            }
+            ResourceMemoryAllocation memory = memoryOrError.AcquireSuccess();
+
+            MaybeError bindResult = CheckVkSuccess(
+                mDevice->fn.BindBufferMemory(mDevice->GetVkDevice(), handle,
+                                             ToBackend(memory.GetResourceHeap())->GetMemory(),
+                                             memory.GetOffset()),
+                "vkBindBufferMemory");
+            if (bindResult.IsError()) {
+                mDevice->fn.DestroyBuffer(mDevice->GetVkDevice(), handle, nullptr);
+                mDevice->DeallocateMemory(&memory);
+                return bindResult.AcquireError();
+            }
+
+            return {std::make_unique<SharedBuffer>(handle, mUsage, memory)};
+        }
+
+        void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
+            SharedBuffer* sharedBuffer = static_cast<SharedBuffer*>(allocation.get());
+            mDevice->GetFencedDeleter()->DeleteWhenUnused(sharedBuffer->GetHandle());
+            mDevice->DeallocateMemory(sharedBuffer->GetMemoryAllocation());
+        }
+
+      private:
+        Device* mDevice;
+        VkBufferUsageFlags mUsage;
+        PooledResourceMemoryAllocator mPooledAllocator;
+        BuddyMemoryAllocator mBuddySystem;
+    };
+
+    // BufferSubAllocator
+
+    BufferSubAllocator::BufferSubAllocator(Device* device) : mDevice(device) {
+        const VkPhysicalDeviceLimits& limits = device->GetDeviceInfo().properties.limits;
+        mAlignment = std::max({kMinSubAllocationAlignment,
+                               uint64_t(limits.minUniformBufferOffsetAlignment),
+                               uint64_t(limits.minStorageBufferOffsetAlignment),
+                               uint64_t(limits.minTexelBufferOffsetAlignment)});
+        ASSERT(IsPowerOfTwo(mAlignment));
+    }
+
+    BufferSubAllocator::~BufferSubAllocator() = default;
+
+    ResultOrError<ResourceMemoryAllocation> BufferSubAllocator::Allocate(
+        uint64_t size,
+        VkBufferUsageFlags usage) {
+        if (size > kMaxSubAllocatedBufferSize) {
+            return ResourceMemoryAllocation{};
+        }
+
+        std::unique_ptr<SingleUsageAllocator>& allocator = mAllocatorsPerUsage[usage];
+        if (allocator == nullptr) {
+            allocator = std::make_unique<SingleUsageAllocator>(mDevice, usage);
+        }
+        return allocator->Allocate(size, mAlignment);
+    }
+
+    void BufferSubAllocator::Deallocate(ResourceMemoryAllocation* allocation) {
+        ASSERT(allocation->GetInfo().mMethod == AllocationMethod::kSubAllocated);
+        mAllocationsToDelete.Enqueue(*allocation, mDevice->GetPendingCommandSerial());
+        allocation->Invalidate();
+    }
+
+    void BufferSubAllocator::Tick(ExecutionSerial completedSerial) {
+        for (const ResourceMemoryAllocation& allocation :
+             mAllocationsToDelete.IterateUpTo(completedSerial)) {
+            VkBufferUsageFlags usage = ToSharedBuffer(allocation)->GetUsage();
+            mAllocatorsPerUsage[usage]->Deallocate(allocation);
+        }
+        mAllocationsToDelete.ClearUpTo(completedSerial);
+    }
+
+    void BufferSubAllocator::DestroyPool() {
+        for (auto& it : mAllocatorsPerUsage) {
+            it.second->DestroyPool();
+        }
+    }
+
+    uint64_t BufferSubAllocator::GetSharedBufferCount() const {
+        uint64_t count = 0;
+        for (const auto& it : mAllocatorsPerUsage) {
+            count += it.second->GetSharedBufferCount();
+        }
+        return count;
+    }
+
+}}  // namespace dawn_native::vulkan
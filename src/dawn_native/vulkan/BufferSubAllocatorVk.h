@@ -0,0 +1,85 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_BUFFERSUBALLOCATORVK_H_
+#define DAWNNATIVE_VULKAN_BUFFERSUBALLOCATORVK_H_
+
+#include "common/SerialQueue.h"
+#include "common/vulkan_platform.h"
+#include "dawn_native/Error.h"
+#include "dawn_native/IntegerTypes.h"
+#include "dawn_native/ResourceHeap.h"
+#include "dawn_native/ResourceMemoryAllocation.h"
+
+#include <map>
+#include <memory>
+
+namespace dawn_native { namespace vulkan {
+
+    class Device;
+
+    // A VkBuffer and its memory, whose ranges are used by several small Buffers.
+    class SharedBuffer : public ResourceHeapBase {
+      public:
+        SharedBuffer(VkBuffer handle,
+                     VkBufferUsageFlags usage,
+                     ResourceMemoryAllocation memoryAllocation);
+        ~SharedBuffer() override = default;
+
+        VkBuffer GetHandle() const;
+        VkBufferUsageFlags GetUsage() const;
+        ResourceMemoryAllocation* GetMemoryAllocation();
+
+      private:
+        VkBuffer mHandle = VK_NULL_HANDLE;
+        VkBufferUsageFlags mUsage = 0;
+        ResourceMemoryAllocation mMemoryAllocation;
+    };
+
+    // Places small buffers in ranges of SharedBuffers instead of giving each of them its own
+    // VkBuffer and memory allocation, which costs driver memory and objects when an application
+    // creates tens of thousands of small buffers. The buffers only share a VkBuffer with buffers
+    // that have exactly the same Vulkan usage flags.
+    class BufferSubAllocator {
+      public:
+        BufferSubAllocator(Device* device);
+        ~BufferSubAllocator();
+
+        // Returns an invalid allocation if the buffer isn't small enough to be sub-allocated.
+        // The offset of the allocation is aligned for all the uses of a buffer range.
+        ResultOrError<ResourceMemoryAllocation> Allocate(uint64_t size, VkBufferUsageFlags usage);
+        void Deallocate(ResourceMemoryAllocation* allocation);
+
+        void Tick(ExecutionSerial completedSerial);
+        void DestroyPool();
+
+        // The number of SharedBuffers that contain at least one buffer.
+        uint64_t GetSharedBufferCount() const;
+
+      private:
+        class SingleUsageAllocator;
+
+        Device* mDevice;
+        uint64_t mAlignment;
+
+        std::map<VkBufferUsageFlags, std::unique_ptr<SingleUsageAllocator>> mAllocatorsPerUsage;
+
+        // Buffer ranges aren't reused immediately, otherwise a new buffer could alias a buffer
+        // still used by the GPU without a barrier between them.
+        SerialQueue<ExecutionSerial, ResourceMemoryAllocation> mAllocationsToDelete;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_BUFFERSUBALLOCATORVK_H_
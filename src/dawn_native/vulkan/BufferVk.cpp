@@ -15,6 +15,9 @@
 #include "dawn_native/vulkan/BufferVk.h"
 
 #include "dawn_native/CommandBuffer.h"
+#include "dawn_native/vulkan/BindGroupVk.h"
+#include "dawn_native/vulkan/BufferDefragmenterVk.h"
+#include "dawn_native/vulkan/BufferSubAllocatorVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/ResourceHeapVk.h"
@@ -22,6 +25,7 @@
 #include "dawn_native/vulkan/VulkanError.h"
 
 #include <cstring>
+#include <vector>
 
 namespace dawn_native { namespace vulkan {
 
@@ -129,6 +133,16 @@ namespace dawn_native { namespace vulkan {
             return flags;
         }
 
+        // The usages of the buffers that can be placed in a SharedBuffer. Mappable buffers keep
+        // their own memory which is mapped for their whole lifetime. Vertex and index buffers
+        // aren't shared because robust buffer access only clamps their fetches to the whole
+        // VkBuffer, and indexed indirect draws aren't range-checked against the index buffer, so
+        // a draw could read other buffers.
+        constexpr wgpu::BufferUsage kSubAllocatableUsages =
+            wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform |
+            wgpu::BufferUsage::Storage | wgpu::BufferUsage::Indirect |
+            wgpu::BufferUsage::QueryResolve;
+
     }  // namespace
 
     // static
@@ -138,17 +152,60 @@ namespace dawn_native { namespace vulkan {
         return std::move(buffer);
     }
 
-    MaybeError Buffer::Initialize(bool mappedAtCreation) {
-        // Avoid passing ludicrously large sizes to drivers because it causes issues: drivers add
-        // some constants to the size passed and align it, but for values close to the maximum
-        // VkDeviceSize this can cause overflows and makes drivers crash or return bad sizes in the
-        // VkmemoryRequirements. See https://gitlab.khronos.org/vulkan/vulkan/issues/1904
-        // Any size with one of two top bits of VkDeviceSize set is a HUGE allocation and we can
-        // safely return an OOM error.
-        if (GetSize() & (uint64_t(3) << uint64_t(62))) {
-            return DAWN_OUT_OF_MEMORY_ERROR("Buffer size is HUGE and could cause overflows");
+    // static
+    MaybeError Buffer::CreateMany(Device* device,
+                                  uint32_t count,
+                                  const BufferDescriptor* const* descriptors,
+                                  Ref<BufferBase>* buffers) {
+        std::vector<Buffer*> created(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            Ref<Buffer> buffer = AcquireRef(new Buffer(device, descriptors[i]));
+            DAWN_TRY(buffer->CreateHandleAndAllocateMemory());
+            created[i] = buffer.Get();
+            buffers[i] = std::move(buffer);
         }
 
+        // Bind the memory of all the buffers with a single call when possible.
+        if (device->fn.BindBufferMemory2 != nullptr) {
+            std::vector<VkBindBufferMemoryInfo> bindInfos(count);
+            uint32_t bindCount = 0;
+            for (Buffer* buffer : created) {
+                if (buffer->IsSubAllocated()) {
+                    continue;
+                }
+                const ResourceMemoryAllocation& allocation = buffer->mMemoryAllocation;
+                VkBindBufferMemoryInfo& bindInfo = bindInfos[bindCount++];
+                bindInfo.sType = VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_INFO;
+                bindInfo.pNext = nullptr;
+                bindInfo.buffer = buffer->mHandle;
+                bindInfo.memory = ToBackend(allocation.GetResourceHeap())->GetMemory();
+                bindInfo.memoryOffset = allocation.GetOffset();
+            }
+            if (bindCount > 0) {
+                DAWN_TRY(CheckVkSuccess(device->fn.BindBufferMemory2(device->GetVkDevice(),
+                                                                     bindCount, bindInfos.data()),
+                                        "vkBindBufferMemory2"));
+            }
+        } else {
+            for (Buffer* buffer : created) {
+                DAWN_TRY(buffer->BindMemory());
+            }
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            created[i]->InitializeContents(descriptors[i]->mappedAtCreation);
+        }
+        return {};
+    }
+
+    MaybeError Buffer::Initialize(bool mappedAtCreation) {
+        DAWN_TRY(CreateHandleAndAllocateMemory());
+        DAWN_TRY(BindMemory());
+        InitializeContents(mappedAtCreation);
+        return {};
+    }
+
+    VkBufferCreateInfo Buffer::GetCreateInfo() const {
         VkBufferCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         createInfo.pNext = nullptr;
@@ -158,12 +215,47 @@ namespace dawn_native { namespace vulkan {
         createInfo.size = std::max(GetSize(), uint64_t(4u));
         // Add CopyDst for non-mappable buffer initialization with mappedAtCreation
         // and robust resource initialization.
-        createInfo.usage = VulkanBufferUsage(GetUsage() | wgpu::BufferUsage::CopyDst);
+        wgpu::BufferUsage usage = GetUsage() | wgpu::BufferUsage::CopyDst;
+        // Add CopySrc to copy the contents of buffers when they are relocated.
+        if (ToBackend(GetDevice())->GetBufferDefragmenter() != nullptr) {
+            usage |= wgpu::BufferUsage::CopySrc;
+        }
+        createInfo.usage = VulkanBufferUsage(usage);
         createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         createInfo.queueFamilyIndexCount = 0;
         createInfo.pQueueFamilyIndices = 0;
+        return createInfo;
+    }
+
+    MaybeError Buffer::CreateHandleAndAllocateMemory() {
+        // Avoid passing ludicrously large sizes to drivers because it causes issues: drivers add
+        // some constants to the size passed and align it, but for values close to the maximum
+        // VkDeviceSize this can cause overflows and makes drivers crash or return bad sizes in the
+        // VkmemoryRequirements. See https://gitlab.khronos.org/vulkan/vulkan/issues/1904
+        // Any size with one of two top bits of VkDeviceSize set is a HUGE allocation and we can
+        // safely return an OOM error.
+        if (GetSize() & (uint64_t(3) << uint64_t(62))) {
+            return DAWN_OUT_OF_MEMORY_ERROR("Buffer size is HUGE and could cause overflows");
+        }
+
+        VkBufferCreateInfo createInfo = GetCreateInfo();
 
         Device* device = ToBackend(GetDevice());
+
+        // Small buffers can use a range of a VkBuffer shared with other buffers instead.
+        BufferSubAllocator* subAllocator = device->GetBufferSubAllocator();
+        if (subAllocator != nullptr && IsSubset(GetUsage(), kSubAllocatableUsages)) {
+            DAWN_TRY_ASSIGN(mSharedBufferAllocation,
+                            subAllocator->Allocate(createInfo.size, createInfo.usage));
+            if (IsSubAllocated()) {
+                SharedBuffer* sharedBuffer =
+                    static_cast<SharedBuffer*>(mSharedBufferAllocation.GetResourceHeap());
+                mHandle = sharedBuffer->GetHandle();
+                mHandleOffset = mSharedBufferAllocation.GetOffset();
+                return {};
+            }
+        }
+
         DAWN_TRY(CheckVkOOMThenSuccess(
             device->fn.CreateBuffer(device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
             "vkCreateBuffer"));
@@ -175,20 +267,39 @@ namespace dawn_native { namespace vulkan {
             (GetUsage() & (wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapWrite)) != 0;
         DAWN_TRY_ASSIGN(mMemoryAllocation, device->AllocateMemory(requirements, requestMappable));
 
+        BufferDefragmenter* defragmenter = device->GetBufferDefragmenter();
+        if (defragmenter != nullptr &&
+            mMemoryAllocation.GetInfo().mMethod == AllocationMethod::kSubAllocated) {
+            defragmenter->AddBuffer(this);
+        }
+
+        return {};
+    }
+
+    MaybeError Buffer::BindMemory() {
+        // The memory of SharedBuffers is bound when they are created.
+        if (IsSubAllocated()) {
+            return {};
+        }
+
+        Device* device = ToBackend(GetDevice());
         DAWN_TRY(CheckVkSuccess(
             device->fn.BindBufferMemory(device->GetVkDevice(), mHandle,
                                         ToBackend(mMemoryAllocation.GetResourceHeap())->GetMemory(),
                                         mMemoryAllocation.GetOffset()),
             "vkBindBufferMemory"));
 
+        return {};
+    }
+
+    void Buffer::InitializeContents(bool mappedAtCreation) {
+        Device* device = ToBackend(GetDevice());
         // The buffers with mappedAtCreation == true will be initialized in
         // BufferBase::MapAtCreation().
         if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting) &&
             !mappedAtCreation) {
             ClearBuffer(device->GetPendingRecordingContext(), 0x01010101);
         }
-
-        return {};
     }
 
     Buffer::~Buffer() {
@@ -199,6 +310,88 @@ namespace dawn_native { namespace vulkan {
         return mHandle;
     }
 
+    VkDeviceSize Buffer::GetHandleOffset() const {
+        return mHandleOffset;
+    }
+
+    ResourceHeapBase* Buffer::GetMemoryHeap() const {
+        return mMemoryAllocation.GetResourceHeap();
+    }
+
+    MaybeError Buffer::Relocate(const ResourceHeapBase* excludedHeap) {
+        ASSERT(!IsSubAllocated() && mHandle != VK_NULL_HANDLE);
+        ASSERT(mMemoryAllocation.GetResourceHeap() == excludedHeap);
+
+        Device* device = ToBackend(GetDevice());
+        VkBufferCreateInfo createInfo = GetCreateInfo();
+        VkBuffer handle = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkOOMThenSuccess(
+            device->fn.CreateBuffer(device->GetVkDevice(), &createInfo, nullptr, &*handle),
+            "vkCreateBuffer"));
+
+        VkMemoryRequirements requirements;
+        device->fn.GetBufferMemoryRequirements(device->GetVkDevice(), handle, &requirements);
+
+        ResourceMemoryAllocation allocation =
+            device->GetResourceMemoryAllocator()->AllocateOutsideHeap(requirements, excludedHeap);
+        if (allocation.GetInfo().mMethod == AllocationMethod::kInvalid) {
+            device->fn.DestroyBuffer(device->GetVkDevice(), handle, nullptr);
+            return {};
+        }
+
+        DAWN_TRY_WITH_CLEANUP(
+            CheckVkSuccess(device->fn.BindBufferMemory(
+                               device->GetVkDevice(), handle,
+                               ToBackend(allocation.GetResourceHeap())->GetMemory(),
+                               allocation.GetOffset()),
+                           "vkBindBufferMemory"),
+            {
+                device->fn.DestroyBuffer(device->GetVkDevice(), handle, nullptr);
+                device->DeallocateMemory(&allocation);
+            });
+
+        // Lazily cleared contents don't need to be copied. The new memory isn't used by the GPU
+        // anymore because freed memory is only reused once the commands using it completed.
+        bool copyContents = GetSize() > 0 &&
+                            (IsDataInitialized() ||
+                             !device->IsToggleEnabled(Toggle::LazyClearResourceOnFirstUse));
+        if (copyContents) {
+            CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
+            TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
+
+            VkBufferCopy region;
+            region.srcOffset = 0;
+            region.dstOffset = 0;
+            region.size = GetSize();
+            device->fn.CmdCopyBuffer(recordingContext->commandBuffer, mHandle, handle, 1, &region);
+        }
+
+        device->GetFencedDeleter()->DeleteWhenUnused(mHandle);
+        device->DeallocateMemory(&mMemoryAllocation);
+        mHandle = handle;
+        mMemoryAllocation = allocation;
+        mLastUsage = copyContents ? wgpu::BufferUsage::CopyDst : wgpu::BufferUsage::None;
+
+        for (BindGroup* bindGroup : mBindGroups) {
+            bindGroup->WriteDescriptorSet();
+        }
+        return {};
+    }
+
+    void Buffer::AddBindGroup(BindGroup* bindGroup) {
+        mBindGroups.insert(bindGroup);
+    }
+
+    void Buffer::RemoveBindGroup(BindGroup* bindGroup) {
+        auto it = mBindGroups.find(bindGroup);
+        ASSERT(it != mBindGroups.end());
+        mBindGroups.erase(it);
+    }
+
+    bool Buffer::IsSubAllocated() const {
+        return mSharedBufferAllocation.GetInfo().mMethod != AllocationMethod::kInvalid;
+    }
+
     void Buffer::TransitionUsageNow(CommandRecordingContext* recordingContext,
                                     wgpu::BufferUsage usage) {
         VkBufferMemoryBarrier barrier;
@@ -241,7 +434,7 @@ namespace dawn_native { namespace vulkan {
         barrier->srcQueueFamilyIndex = 0;
         barrier->dstQueueFamilyIndex = 0;
         barrier->buffer = mHandle;
-        barrier->offset = 0;
+        barrier->offset = mHandleOffset;
         barrier->size = GetSize();
 
         mLastUsage = usage;
@@ -286,10 +479,20 @@ namespace dawn_native { namespace vulkan {
     }
 
     void Buffer::DestroyImpl() {
-        ToBackend(GetDevice())->DeallocateMemory(&mMemoryAllocation);
+        Device* device = ToBackend(GetDevice());
+        if (IsSubAllocated()) {
+            device->GetBufferSubAllocator()->Deallocate(&mSharedBufferAllocation);
+            mHandle = VK_NULL_HANDLE;
+            return;
+        }
+
+        if (device->GetBufferDefragmenter() != nullptr) {
+            device->GetBufferDefragmenter()->RemoveBuffer(this);
+        }
+        device->DeallocateMemory(&mMemoryAllocation);
 
         if (mHandle != VK_NULL_HANDLE) {
-            ToBackend(GetDevice())->GetFencedDeleter()->DeleteWhenUnused(mHandle);
+            device->GetFencedDeleter()->DeleteWhenUnused(mHandle);
             mHandle = VK_NULL_HANDLE;
         }
     }
@@ -354,7 +557,7 @@ namespace dawn_native { namespace vulkan {
         Device* device = ToBackend(GetDevice());
         // TODO(jiawei.shao@intel.com): find out why VK_WHOLE_SIZE doesn't work on old Windows Intel
         // Vulkan drivers.
-        device->fn.CmdFillBuffer(recordingContext->commandBuffer, mHandle, 0, GetSize(),
-                                 clearValue);
+        device->fn.CmdFillBuffer(recordingContext->commandBuffer, mHandle, mHandleOffset,
+                                 GetSize(), clearValue);
     }
 }}  // namespace dawn_native::vulkan
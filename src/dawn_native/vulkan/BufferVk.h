@@ -21,8 +21,11 @@
 #include "common/vulkan_platform.h"
 #include "dawn_native/ResourceMemoryAllocation.h"
 
+#include <unordered_set>
+
 namespace dawn_native { namespace vulkan {
 
+    class BindGroup;
     struct CommandRecordingContext;
     class Device;
 
@@ -30,8 +33,17 @@ namespace dawn_native { namespace vulkan {
       public:
         static ResultOrError<Ref<Buffer>> Create(Device* device,
                                                  const BufferDescriptor* descriptor);
+        // Creates the buffers of |count| validated descriptors, binding their memory in a single
+        // call when VK_KHR_bind_memory2 is available.
+        static MaybeError CreateMany(Device* device,
+                                     uint32_t count,
+                                     const BufferDescriptor* const* descriptors,
+                                     Ref<BufferBase>* buffers);
 
+        // Small buffers can be ranges of a VkBuffer shared with other buffers, starting at
+        // GetHandleOffset(). All the offsets used with GetHandle() must include it.
         VkBuffer GetHandle() const;
+        VkDeviceSize GetHandleOffset() const;
 
         // Transitions the buffer to be used as `usage`, recording any necessary barrier in
         // `commands`.
@@ -42,6 +54,15 @@ namespace dawn_native { namespace vulkan {
                                                   VkPipelineStageFlags* srcStages,
                                                   VkPipelineStageFlags* dstStages);
 
+        // With the DefragmentBufferMemoryWhenIdle toggle, buffers can get a new VkBuffer in a new
+        // memory allocation outside of |excludedHeap|, which is the heap of their memory. The
+        // bind groups using them are tracked to rewrite their descriptor sets when that happens.
+        // Buffers stay where they are when there is no room outside of |excludedHeap|.
+        ResourceHeapBase* GetMemoryHeap() const;
+        MaybeError Relocate(const ResourceHeapBase* excludedHeap);
+        void AddBindGroup(BindGroup* bindGroup);
+        void RemoveBindGroup(BindGroup* bindGroup);
+
         void EnsureDataInitialized(CommandRecordingContext* recordingContext);
         void EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
                                                 uint64_t offset,
@@ -53,6 +74,11 @@ namespace dawn_native { namespace vulkan {
         ~Buffer() override;
         using BufferBase::BufferBase;
         MaybeError Initialize(bool mappedAtCreation);
+        VkBufferCreateInfo GetCreateInfo() const;
+        MaybeError CreateHandleAndAllocateMemory();
+        MaybeError BindMemory();
+        void InitializeContents(bool mappedAtCreation);
+        bool IsSubAllocated() const;
         void InitializeToZero(CommandRecordingContext* recordingContext);
         void ClearBuffer(CommandRecordingContext* recordingContext, uint32_t clearValue);
 
@@ -65,8 +91,13 @@ namespace dawn_native { namespace vulkan {
 
         VkBuffer mHandle = VK_NULL_HANDLE;
         ResourceMemoryAllocation mMemoryAllocation;
+        // Set instead of mMemoryAllocation when mHandle is a SharedBuffer.
+        ResourceMemoryAllocation mSharedBufferAllocation;
+        VkDeviceSize mHandleOffset = 0;
 
         wgpu::BufferUsage mLastUsage = wgpu::BufferUsage::None;
+
+        std::unordered_multiset<BindGroup*> mBindGroups;
     };
 
 }}  // namespace dawn_native::vulkan
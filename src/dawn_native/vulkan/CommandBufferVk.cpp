@@ -19,13 +19,14 @@
 #include "dawn_native/CommandValidation.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/EnumMaskIterator.h"
+#include "dawn_native/ImmediateDataTracker.h"
 #include "dawn_native/RenderBundle.h"
 #include "dawn_native/vulkan/BindGroupVk.h"
 #include "dawn_native/vulkan/BufferVk.h"
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/ComputePipelineVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
-#include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/FramebufferCache.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
 #include "dawn_native/vulkan/QuerySetVk.h"
 #include "dawn_native/vulkan/RenderPassCache.h"
@@ -122,6 +123,18 @@ namespace dawn_native { namespace vulkan {
             }
         }
 
+        void ApplyImmediateData(Device* device,
+                                VkCommandBuffer commands,
+                                ImmediateDataTracker* immediateData) {
+            uint32_t size = immediateData->GetDirtySize();
+            if (size > 0) {
+                device->fn.CmdPushConstants(
+                    commands, ToBackend(immediateData->GetPipelineLayout())->GetHandle(),
+                    kImmediateDataShaderStages, 0, size, immediateData->GetData());
+            }
+            immediateData->DidApply();
+        }
+
         class RenderDescriptorSetTracker : public BindGroupTrackerBase<true, uint32_t> {
           public:
             RenderDescriptorSetTracker() = default;
@@ -257,21 +270,23 @@ namespace dawn_native { namespace vulkan {
                 DAWN_TRY_ASSIGN(renderPassVK, device->GetRenderPassCache()->GetRenderPass(query));
             }
 
-            // Create a framebuffer that will be used once for the render pass and gather the clear
-            // values for the attachments at the same time.
+            // Query a framebuffer for the attachments of the render pass from the cache and gather
+            // the clear values for the attachments at the same time.
             std::array<VkClearValue, kMaxColorAttachments + 1> clearValues;
             VkFramebuffer framebuffer = VK_NULL_HANDLE;
             uint32_t attachmentCount = 0;
             {
-                // Fill in the attachment info that will be chained in the framebuffer create info.
-                std::array<VkImageView, kMaxColorAttachments * 2 + 1> attachments;
+                FramebufferCacheQuery query;
+                query.renderPass = renderPassVK;
+                query.width = renderPass->width;
+                query.height = renderPass->height;
 
                 for (ColorAttachmentIndex i :
                      IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
                     auto& attachmentInfo = renderPass->colorAttachments[i];
                     TextureView* view = ToBackend(attachmentInfo.view.Get());
 
-                    attachments[attachmentCount] = view->GetHandle();
+                    query.AddAttachment(view);
 
                     switch (view->GetFormat().GetAspectInfo(Aspect::Color).baseType) {
                         case wgpu::TextureComponentType::Float: {
@@ -310,7 +325,7 @@ namespace dawn_native { namespace vulkan {
                     auto& attachmentInfo = renderPass->depthStencilAttachment;
                     TextureView* view = ToBackend(attachmentInfo.view.Get());
 
-                    attachments[attachmentCount] = view->GetHandle();
+                    query.AddAttachment(view);
 
                     clearValues[attachmentCount].depthStencil.depth = attachmentInfo.clearDepth;
                     clearValues[attachmentCount].depthStencil.stencil = attachmentInfo.clearStencil;
@@ -324,32 +339,14 @@ namespace dawn_native { namespace vulkan {
                         TextureView* view =
                             ToBackend(renderPass->colorAttachments[i].resolveTarget.Get());
 
-                        attachments[attachmentCount] = view->GetHandle();
+                        query.AddAttachment(view);
 
                         attachmentCount++;
                     }
                 }
 
-                // Chain attachments and create the framebuffer
-                VkFramebufferCreateInfo createInfo;
-                createInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-                createInfo.pNext = nullptr;
-                createInfo.flags = 0;
-                createInfo.renderPass = renderPassVK;
-                createInfo.attachmentCount = attachmentCount;
-                createInfo.pAttachments = AsVkArray(attachments.data());
-                createInfo.width = renderPass->width;
-                createInfo.height = renderPass->height;
-                createInfo.layers = 1;
-
-                DAWN_TRY(
-                    CheckVkSuccess(device->fn.CreateFramebuffer(device->GetVkDevice(), &createInfo,
-                                                                nullptr, &*framebuffer),
-                                   "CreateFramebuffer"));
-
-                // We don't reuse VkFramebuffers so mark the framebuffer for deletion as soon as the
-                // commands currently being recorded are finished.
-                device->GetFencedDeleter()->DeleteWhenUnused(framebuffer);
+                ASSERT(query.attachmentCount == attachmentCount);
+                DAWN_TRY_ASSIGN(framebuffer, device->GetFramebufferCache()->GetFramebuffer(query));
             }
 
             VkRenderPassBeginInfo beginInfo;
@@ -445,7 +442,8 @@ namespace dawn_native { namespace vulkan {
                 // Resolve the queries between firstTrueIt and nextFalseIt (which is at most lastIt)
                 device->fn.CmdCopyQueryPoolResults(
                     commands, querySet->GetHandle(), resolveQueryIndex, resolveQueryCount,
-                    destination->GetHandle(), resolveDestinationOffset, sizeof(uint64_t),
+                    destination->GetHandle(),
+                    destination->GetHandleOffset() + resolveDestinationOffset, sizeof(uint64_t),
                     VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
 
                 // Set current iterator to next false
@@ -505,6 +503,7 @@ namespace dawn_native { namespace vulkan {
         tempBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
         VkBufferImageCopy srcToTempBufferRegion =
             ComputeBufferImageCopyRegion(tempBufferCopy, srcCopy, copySize);
+        srcToTempBufferRegion.bufferOffset += tempBuffer->GetHandleOffset();
 
         // The Dawn CopySrc usage is always mapped to GENERAL
         device->fn.CmdCopyImageToBuffer(commands, srcImage, VK_IMAGE_LAYOUT_GENERAL,
@@ -513,6 +512,7 @@ namespace dawn_native { namespace vulkan {
         tempBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
         VkBufferImageCopy tempBufferToDstRegion =
             ComputeBufferImageCopyRegion(tempBufferCopy, dstCopy, copySize);
+        tempBufferToDstRegion.bufferOffset += tempBuffer->GetHandleOffset();
 
         // Dawn guarantees dstImage be in the TRANSFER_DST_OPTIMAL layout after the
         // copy command.
@@ -616,8 +616,8 @@ namespace dawn_native { namespace vulkan {
                     dstBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
 
                     VkBufferCopy region;
-                    region.srcOffset = copy->sourceOffset;
-                    region.dstOffset = copy->destinationOffset;
+                    region.srcOffset = srcBuffer->GetHandleOffset() + copy->sourceOffset;
+                    region.dstOffset = dstBuffer->GetHandleOffset() + copy->destinationOffset;
                     region.size = copy->size;
 
                     VkBuffer srcHandle = srcBuffer->GetHandle();
@@ -635,6 +635,7 @@ namespace dawn_native { namespace vulkan {
 
                     VkBufferImageCopy region =
                         ComputeBufferImageCopyRegion(src, dst, copy->copySize);
+                    region.bufferOffset += ToBackend(src.buffer)->GetHandleOffset();
                     VkImageSubresourceLayers subresource = region.imageSubresource;
 
                     ASSERT(dst.texture->GetDimension() == wgpu::TextureDimension::e2D);
@@ -674,6 +675,7 @@ namespace dawn_native { namespace vulkan {
 
                     VkBufferImageCopy region =
                         ComputeBufferImageCopyRegion(dst, src, copy->copySize);
+                    region.bufferOffset += ToBackend(dst.buffer)->GetHandleOffset();
 
                     ASSERT(src.texture->GetDimension() == wgpu::TextureDimension::e2D);
                     SubresourceRange range =
@@ -814,9 +816,10 @@ namespace dawn_native { namespace vulkan {
                                                         cmd->queryCount * sizeof(uint64_t)))) {
                         destination->TransitionUsageNow(recordingContext,
                                                         wgpu::BufferUsage::CopyDst);
-                        device->fn.CmdFillBuffer(commands, destination->GetHandle(),
-                                                 cmd->destinationOffset,
-                                                 cmd->queryCount * sizeof(uint64_t), 0u);
+                        device->fn.CmdFillBuffer(
+                            commands, destination->GetHandle(),
+                            destination->GetHandleOffset() + cmd->destinationOffset,
+                            cmd->queryCount * sizeof(uint64_t), 0u);
                     } else {
                         destination->EnsureDataInitializedAsDestination(
                             recordingContext, cmd->destinationOffset,
@@ -906,6 +909,7 @@ namespace dawn_native { namespace vulkan {
         VkCommandBuffer commands = recordingContext->commandBuffer;
 
         ComputeDescriptorSetTracker descriptorSets = {};
+        ImmediateDataTracker immediateData = {};
 
         Command type;
         while (mCommands.NextCommandId(&type)) {
@@ -919,6 +923,7 @@ namespace dawn_native { namespace vulkan {
                     DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+                    ApplyImmediateData(device, commands, &immediateData);
                     device->fn.CmdDispatch(commands, dispatch->x, dispatch->y, dispatch->z);
                     break;
                 }
@@ -927,12 +932,14 @@ namespace dawn_native { namespace vulkan {
                     DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
                     ToBackend(dispatch->indirectBuffer)
                         ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::Indirect);
-                    VkBuffer indirectBuffer = ToBackend(dispatch->indirectBuffer)->GetHandle();
+                    Buffer* indirectBuffer = ToBackend(dispatch->indirectBuffer.Get());
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+                    ApplyImmediateData(device, commands, &immediateData);
                     device->fn.CmdDispatchIndirect(
-                        commands, indirectBuffer,
-                        static_cast<VkDeviceSize>(dispatch->indirectOffset));
+                        commands, indirectBuffer->GetHandle(),
+                        indirectBuffer->GetHandleOffset() +
+                            static_cast<VkDeviceSize>(dispatch->indirectOffset));
                     break;
                 }
 
@@ -950,6 +957,12 @@ namespace dawn_native { namespace vulkan {
                     break;
                 }
 
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = mCommands.NextCommand<SetImmediateDataCmd>();
+                    immediateData.OnSetImmediateData(cmd, mCommands.NextData<uint8_t>(cmd->size));
+                    break;
+                }
+
                 case Command::SetComputePipeline: {
                     SetComputePipelineCmd* cmd = mCommands.NextCommand<SetComputePipelineCmd>();
                     ComputePipeline* pipeline = ToBackend(cmd->pipeline).Get();
@@ -957,6 +970,7 @@ namespace dawn_native { namespace vulkan {
                     device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_COMPUTE,
                                                pipeline->GetHandle());
                     descriptorSets.OnSetPipeline(pipeline);
+                    immediateData.OnSetPipeline(pipeline);
                     break;
                 }
 
@@ -1071,6 +1085,7 @@ namespace dawn_native { namespace vulkan {
         }
 
         RenderDescriptorSetTracker descriptorSets = {};
+        ImmediateDataTracker immediateData = {};
         RenderPipeline* lastPipeline = nullptr;
 
         auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
@@ -1079,6 +1094,7 @@ namespace dawn_native { namespace vulkan {
                     DrawCmd* draw = iter->NextCommand<DrawCmd>();
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    ApplyImmediateData(device, commands, &immediateData);
                     device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
                                        draw->firstVertex, draw->firstInstance);
                     break;
@@ -1088,6 +1104,7 @@ namespace dawn_native { namespace vulkan {
                     DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    ApplyImmediateData(device, commands, &immediateData);
                     device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
                                               draw->firstIndex, draw->baseVertex,
                                               draw->firstInstance);
@@ -1096,23 +1113,59 @@ namespace dawn_native { namespace vulkan {
 
                 case Command::DrawIndirect: {
                     DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                    VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
+                    Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
+                    VkDeviceSize indirectOffset = indirectBuffer->GetHandleOffset() +
+                                                  static_cast<VkDeviceSize>(draw->indirectOffset);
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndirect(commands, indirectBuffer,
-                                               static_cast<VkDeviceSize>(draw->indirectOffset), 1,
-                                               0);
+                    ApplyImmediateData(device, commands, &immediateData);
+                    device->fn.CmdDrawIndirect(commands, indirectBuffer->GetHandle(),
+                                               indirectOffset, 1, 0);
                     break;
                 }
 
                 case Command::DrawIndexedIndirect: {
                     DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                    VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
+                    Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
+                    VkDeviceSize indirectOffset = indirectBuffer->GetHandleOffset() +
+                                                  static_cast<VkDeviceSize>(draw->indirectOffset);
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndexedIndirect(
-                        commands, indirectBuffer, static_cast<VkDeviceSize>(draw->indirectOffset),
-                        1, 0);
+                    ApplyImmediateData(device, commands, &immediateData);
+                    device->fn.CmdDrawIndexedIndirect(commands, indirectBuffer->GetHandle(),
+                                                      indirectOffset, 1, 0);
+                    break;
+                }
+
+                case Command::MultiDrawIndexedIndirect: {
+                    MultiDrawIndexedIndirectCmd* draw =
+                        iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+                    Buffer* indirectBufferObject = ToBackend(draw->indirectBuffer.Get());
+                    VkBuffer indirectBuffer = indirectBufferObject->GetHandle();
+                    VkDeviceSize indirectOffset = indirectBufferObject->GetHandleOffset() +
+                                                  static_cast<VkDeviceSize>(draw->indirectOffset);
+                    constexpr uint32_t kStride = static_cast<uint32_t>(kDrawIndexedIndirectSize);
+
+                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    ApplyImmediateData(device, commands, &immediateData);
+                    if (draw->drawCountBuffer != nullptr) {
+                        device->fn.CmdDrawIndexedIndirectCountKHR(
+                            commands, indirectBuffer, indirectOffset,
+                            ToBackend(draw->drawCountBuffer)->GetHandle(),
+                            ToBackend(draw->drawCountBuffer)->GetHandleOffset() +
+                                static_cast<VkDeviceSize>(draw->drawCountBufferOffset),
+                            draw->maxDrawCount, kStride);
+                    } else if (device->GetDeviceInfo().features.multiDrawIndirect == VK_TRUE) {
+                        device->fn.CmdDrawIndexedIndirect(commands, indirectBuffer, indirectOffset,
+                                                          draw->maxDrawCount, kStride);
+                    } else {
+                        // Without the multiDrawIndirect feature the draw count must be 0 or 1.
+                        for (uint32_t i = 0; i < draw->maxDrawCount; ++i) {
+                            device->fn.CmdDrawIndexedIndirect(
+                                commands, indirectBuffer,
+                                indirectOffset + uint64_t(i) * kStride, 1, 0);
+                        }
+                    }
                     break;
                 }
 
@@ -1179,11 +1232,18 @@ namespace dawn_native { namespace vulkan {
                     break;
                 }
 
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = iter->NextCommand<SetImmediateDataCmd>();
+                    immediateData.OnSetImmediateData(cmd, iter->NextData<uint8_t>(cmd->size));
+                    break;
+                }
+
                 case Command::SetIndexBuffer: {
                     SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                    VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
+                    Buffer* indexBuffer = ToBackend(cmd->buffer.Get());
 
-                    device->fn.CmdBindIndexBuffer(commands, indexBuffer, cmd->offset,
+                    device->fn.CmdBindIndexBuffer(commands, indexBuffer->GetHandle(),
+                                                  indexBuffer->GetHandleOffset() + cmd->offset,
                                                   VulkanIndexType(cmd->format));
                     break;
                 }
@@ -1197,13 +1257,15 @@ namespace dawn_native { namespace vulkan {
                     lastPipeline = pipeline;
 
                     descriptorSets.OnSetPipeline(pipeline);
+                    immediateData.OnSetPipeline(pipeline);
                     break;
                 }
 
                 case Command::SetVertexBuffer: {
                     SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
                     VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
-                    VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+                    VkDeviceSize offset = ToBackend(cmd->buffer)->GetHandleOffset() +
+                                          static_cast<VkDeviceSize>(cmd->offset);
 
                     device->fn.CmdBindVertexBuffers(commands, static_cast<uint8_t>(cmd->slot), 1,
                                                     &*buffer, &offset);
@@ -72,7 +72,7 @@ namespace dawn_native { namespace vulkan {
         }
 
         return CheckVkSuccess(
-            device->fn.CreateComputePipelines(device->GetVkDevice(), ::VK_NULL_HANDLE, 1,
+            device->fn.CreateComputePipelines(device->GetVkDevice(), device->GetPipelineCache(), 1,
                                               &createInfo, nullptr, &*mHandle),
             "CreateComputePipeline");
     }
@@ -19,10 +19,83 @@
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace dawn_native { namespace vulkan {
 
     // TODO(enga): Figure out this value.
-    static constexpr uint32_t kMaxDescriptorsPerPool = 512;
+    static constexpr uint32_t kInitialDescriptorsPerPool = 512;
+    // Each new pool has twice as many sets as the previous one, until it reaches this number of
+    // descriptors, so that layouts used by many bind groups need few pools.
+    static constexpr uint32_t kMaxDescriptorsPerPool = 16384;
+    static_assert(kMaxDescriptorsPerPool <= std::numeric_limits<uint16_t>::max(), "");
+
+    // The maximum number of recycled descriptor sets kept per layout.
+    static constexpr size_t kMaxRecycledDescriptorSets = 64;
+
+    // RecycledDescriptorSetResources
+
+    RecycledDescriptorSetResources::~RecycledDescriptorSetResources() {
+        // The allocators release their recycled sets when they are destroyed, which happens
+        // before the device is destroyed.
+        ASSERT(mResources.empty());
+        ASSERT(mAllocators.empty());
+    }
+
+    void RecycledDescriptorSetResources::Reference(DescriptorSetAllocator* allocator,
+                                                   const std::vector<ObjectBase*>& resources) {
+        mAllocators.insert(allocator);
+        for (ObjectBase* object : resources) {
+            auto it = mResources.find(object);
+            if (it == mResources.end()) {
+                mResources.emplace(object, Resource{object, 1});
+            } else {
+                it->second.recycledSetCount++;
+            }
+        }
+    }
+
+    void RecycledDescriptorSetResources::Release(const std::vector<ObjectBase*>& resources) {
+        for (ObjectBase* object : resources) {
+            auto it = mResources.find(object);
+            ASSERT(it != mResources.end());
+            ASSERT(it->second.recycledSetCount > 0);
+            if (--it->second.recycledSetCount == 0) {
+                mResources.erase(it);
+            }
+        }
+    }
+
+    void RecycledDescriptorSetResources::RemoveAllocator(DescriptorSetAllocator* allocator) {
+        mAllocators.erase(allocator);
+    }
+
+    void RecycledDescriptorSetResources::Tick() {
+        // An object that is only referenced here can never be part of a new bind group, so the
+        // sets referencing it can never be reused.
+        std::unordered_set<ObjectBase*> unreachableResources;
+        for (const auto& it : mResources) {
+            if (it.second.object->HasOneRef()) {
+                unreachableResources.insert(it.first);
+            }
+        }
+        if (unreachableResources.empty()) {
+            return;
+        }
+
+        // Deallocating the sets releases the objects, which only destroys buffers, samplers and
+        // texture views, so no allocator is removed while iterating.
+        for (auto it = mAllocators.begin(); it != mAllocators.end();) {
+            if ((*it)->DeallocateUnreachableRecycledSets(unreachableResources)) {
+                ++it;
+            } else {
+                it = mAllocators.erase(it);
+            }
+        }
+    }
+
+    // DescriptorSetAllocator
 
     DescriptorSetAllocator::DescriptorSetAllocator(
         BindGroupLayout* layout,
@@ -32,39 +105,43 @@ namespace dawn_native { namespace vulkan {
 
         // Compute the total number of descriptors for this layout.
         uint32_t totalDescriptorCount = 0;
-        mPoolSizes.reserve(descriptorCountPerType.size());
+        mPoolSizesPerSet.reserve(descriptorCountPerType.size());
         for (const auto& it : descriptorCountPerType) {
             ASSERT(it.second > 0);
             totalDescriptorCount += it.second;
-            mPoolSizes.push_back(VkDescriptorPoolSize{it.first, it.second});
+            mPoolSizesPerSet.push_back(VkDescriptorPoolSize{it.first, it.second});
         }
 
         if (totalDescriptorCount == 0) {
-            // Vulkan requires that valid usage of vkCreateDescriptorPool must have a non-zero
-            // number of pools, each of which has non-zero descriptor counts.
-            // Since the descriptor set layout is empty, we should be able to allocate
-            // |kMaxDescriptorsPerPool| sets from this 1-sized descriptor pool.
-            // The type of this descriptor pool doesn't matter because it is never used.
-            mPoolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1});
-            mMaxSets = kMaxDescriptorsPerPool;
+            // Since the descriptor set layout is empty, the number of sets is only limited by the
+            // number of descriptors we would allow in a pool.
+            mNextPoolMaxSets = kInitialDescriptorsPerPool;
+            mMaxSetsPerPool = kMaxDescriptorsPerPool;
         } else {
             ASSERT(totalDescriptorCount <= kMaxBindingsPerPipelineLayout);
-            static_assert(kMaxBindingsPerPipelineLayout <= kMaxDescriptorsPerPool, "");
+            static_assert(kMaxBindingsPerPipelineLayout <= kInitialDescriptorsPerPool, "");
 
             // Compute the total number of descriptors sets that fits given the max.
-            mMaxSets = kMaxDescriptorsPerPool / totalDescriptorCount;
-            ASSERT(mMaxSets > 0);
-
-            // Grow the number of desciptors in the pool to fit the computed |mMaxSets|.
-            for (auto& poolSize : mPoolSizes) {
-                poolSize.descriptorCount *= mMaxSets;
-            }
+            mNextPoolMaxSets = kInitialDescriptorsPerPool / totalDescriptorCount;
+            mMaxSetsPerPool = kMaxDescriptorsPerPool / totalDescriptorCount;
+            ASSERT(mNextPoolMaxSets > 0);
         }
     }
 
     DescriptorSetAllocator::~DescriptorSetAllocator() {
+        // The recycled sets can be returned to their pool directly since the pools are only
+        // deleted once they are no longer used by the GPU.
+        RecycledDescriptorSetResources* recycledSetResources = GetRecycledSetResources();
+        for (const RecycledDescriptorSet& recycled : mRecycledSets) {
+            mDescriptorPools[recycled.allocation.poolIndex].freeSetIndices.push_back(
+                recycled.allocation.setIndex);
+            recycledSetResources->Release(recycled.resources);
+        }
+        mRecycledSets.clear();
+        recycledSetResources->RemoveAllocator(this);
+
         for (auto& pool : mDescriptorPools) {
-            ASSERT(pool.freeSetIndices.size() == mMaxSets);
+            ASSERT(pool.freeSetIndices.size() == pool.sets.size());
             if (pool.vkPool != VK_NULL_HANDLE) {
                 Device* device = ToBackend(mLayout->GetDevice());
                 device->GetFencedDeleter()->DeleteWhenUnused(pool.vkPool);
@@ -94,6 +171,20 @@ namespace dawn_native { namespace vulkan {
         return DescriptorSetAllocation{pool->sets[setIndex], poolIndex, setIndex};
     }
 
+    void DescriptorSetAllocator::Reserve(uint32_t setCount) {
+        uint32_t freeSetCount = 0;
+        for (PoolIndex poolIndex : mAvailableDescriptorPoolIndices) {
+            const DescriptorPool& pool = mDescriptorPools[poolIndex];
+            freeSetCount += static_cast<uint32_t>(pool.freeSetIndices.size());
+        }
+        if (setCount <= freeSetCount) {
+            return;
+        }
+
+        uint32_t missingSetCount = std::min(setCount - freeSetCount, uint32_t(mMaxSetsPerPool));
+        mNextPoolMaxSets = std::max(mNextPoolMaxSets, static_cast<SetIndex>(missingSetCount));
+    }
+
     void DescriptorSetAllocator::Deallocate(DescriptorSetAllocation* allocationInfo) {
         ASSERT(allocationInfo != nullptr);
         ASSERT(allocationInfo->set != VK_NULL_HANDLE);
@@ -115,6 +206,73 @@ namespace dawn_native { namespace vulkan {
         *allocationInfo = {};
     }
 
+    bool DescriptorSetAllocator::AllocateRecycled(const DescriptorSetKey& key,
+                                                  DescriptorSetAllocation* allocationInfo) {
+        // Look for the most recently recycled sets first since they are the most likely to be
+        // recreated.
+        for (auto it = mRecycledSets.rbegin(); it != mRecycledSets.rend(); ++it) {
+            if (it->key.hash == key.hash && it->key.words == key.words) {
+                *allocationInfo = it->allocation;
+                // The new bind group references the objects of the set.
+                GetRecycledSetResources()->Release(it->resources);
+                mRecycledSets.erase(std::next(it).base());
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void DescriptorSetAllocator::Recycle(DescriptorSetAllocation* allocationInfo,
+                                         DescriptorSetKey key,
+                                         std::vector<ObjectBase*> resources) {
+        ASSERT(allocationInfo != nullptr);
+        ASSERT(allocationInfo->set != VK_NULL_HANDLE);
+
+        RecycledDescriptorSetResources* recycledSetResources = GetRecycledSetResources();
+        if (mRecycledSets.size() >= kMaxRecycledDescriptorSets) {
+            Deallocate(&mRecycledSets.front().allocation);
+            recycledSetResources->Release(mRecycledSets.front().resources);
+            mRecycledSets.erase(mRecycledSets.begin());
+        }
+
+        recycledSetResources->Reference(this, resources);
+        mRecycledSets.push_back({std::move(key), *allocationInfo, std::move(resources)});
+
+        // Clear the content of allocation so that use after frees are more visible.
+        *allocationInfo = {};
+    }
+
+    bool DescriptorSetAllocator::DeallocateUnreachableRecycledSets(
+        const std::unordered_set<ObjectBase*>& unreachableResources) {
+        // A set referencing an object that nothing else references can never be requested
+        // again, so it is deallocated to stop keeping the object alive.
+        auto isUnreachable = [&](const RecycledDescriptorSet& recycled) {
+            for (ObjectBase* resource : recycled.resources) {
+                if (unreachableResources.count(resource) != 0) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        auto unreachableBegin =
+            std::stable_partition(mRecycledSets.begin(), mRecycledSets.end(),
+                                  [&](const RecycledDescriptorSet& recycled) {
+                                      return !isUnreachable(recycled);
+                                  });
+        RecycledDescriptorSetResources* recycledSetResources = GetRecycledSetResources();
+        for (auto it = unreachableBegin; it != mRecycledSets.end(); ++it) {
+            Deallocate(&it->allocation);
+            recycledSetResources->Release(it->resources);
+        }
+        mRecycledSets.erase(unreachableBegin, mRecycledSets.end());
+        return !mRecycledSets.empty();
+    }
+
+    RecycledDescriptorSetResources* DescriptorSetAllocator::GetRecycledSetResources() const {
+        return ToBackend(mLayout->GetDevice())->GetRecycledDescriptorSetResources();
+    }
+
     void DescriptorSetAllocator::FinishDeallocation(ExecutionSerial completedSerial) {
         for (const Deallocation& dealloc : mPendingDeallocations.IterateUpTo(completedSerial)) {
             ASSERT(dealloc.poolIndex < mDescriptorPools.size());
@@ -129,13 +287,29 @@ namespace dawn_native { namespace vulkan {
     }
 
     MaybeError DescriptorSetAllocator::AllocateDescriptorPool() {
+        const SetIndex maxSets = mNextPoolMaxSets;
+
+        // Grow the number of desciptors in the pool to fit |maxSets|.
+        std::vector<VkDescriptorPoolSize> poolSizes = mPoolSizesPerSet;
+        for (auto& poolSize : poolSizes) {
+            poolSize.descriptorCount *= maxSets;
+        }
+        if (poolSizes.empty()) {
+            // Vulkan requires that valid usage of vkCreateDescriptorPool must have a non-zero
+            // number of pools, each of which has non-zero descriptor counts.
+            // Since the descriptor set layout is empty, we should be able to allocate
+            // |maxSets| sets from this 1-sized descriptor pool.
+            // The type of this descriptor pool doesn't matter because it is never used.
+            poolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1});
+        }
+
         VkDescriptorPoolCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
-        createInfo.maxSets = mMaxSets;
-        createInfo.poolSizeCount = static_cast<PoolIndex>(mPoolSizes.size());
-        createInfo.pPoolSizes = mPoolSizes.data();
+        createInfo.maxSets = maxSets;
+        createInfo.poolSizeCount = static_cast<PoolIndex>(poolSizes.size());
+        createInfo.pPoolSizes = poolSizes.data();
 
         Device* device = ToBackend(mLayout->GetDevice());
 
@@ -144,16 +318,16 @@ namespace dawn_native { namespace vulkan {
                                                                 nullptr, &*descriptorPool),
                                 "CreateDescriptorPool"));
 
-        std::vector<VkDescriptorSetLayout> layouts(mMaxSets, mLayout->GetHandle());
+        std::vector<VkDescriptorSetLayout> layouts(maxSets, mLayout->GetHandle());
 
         VkDescriptorSetAllocateInfo allocateInfo;
         allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
         allocateInfo.pNext = nullptr;
         allocateInfo.descriptorPool = descriptorPool;
-        allocateInfo.descriptorSetCount = mMaxSets;
+        allocateInfo.descriptorSetCount = maxSets;
         allocateInfo.pSetLayouts = AsVkArray(layouts.data());
 
-        std::vector<VkDescriptorSet> sets(mMaxSets);
+        std::vector<VkDescriptorSet> sets(maxSets);
         MaybeError result =
             CheckVkSuccess(device->fn.AllocateDescriptorSets(device->GetVkDevice(), &allocateInfo,
                                                              AsVkArray(sets.data())),
@@ -165,9 +339,9 @@ namespace dawn_native { namespace vulkan {
         }
 
         std::vector<SetIndex> freeSetIndices;
-        freeSetIndices.reserve(mMaxSets);
+        freeSetIndices.reserve(maxSets);
 
-        for (SetIndex i = 0; i < mMaxSets; ++i) {
+        for (SetIndex i = 0; i < maxSets; ++i) {
             freeSetIndices.push_back(i);
         }
 
@@ -175,6 +349,9 @@ namespace dawn_native { namespace vulkan {
         mDescriptorPools.emplace_back(
             DescriptorPool{descriptorPool, std::move(sets), std::move(freeSetIndices)});
 
+        mNextPoolMaxSets = static_cast<SetIndex>(std::min(static_cast<uint32_t>(maxSets) * 2,
+                                                          static_cast<uint32_t>(mMaxSetsPerPool)));
+
         return {};
     }
 
@@ -19,15 +19,54 @@
 #include "common/vulkan_platform.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/IntegerTypes.h"
+#include "dawn_native/ObjectBase.h"
 #include "dawn_native/vulkan/DescriptorSetAllocation.h"
 
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace dawn_native { namespace vulkan {
 
     class BindGroupLayout;
 
+    // Identifies the descriptors written in a descriptor set, see
+    // BindGroup::ComputeDescriptorSetKey.
+    struct DescriptorSetKey {
+        std::vector<uint64_t> words;
+        size_t hash = 0;
+    };
+
+    class DescriptorSetAllocator;
+
+    // Keeps the objects referenced by the recycled descriptor sets of a device alive, so that
+    // other objects can't be created at the same addresses and match their keys. Each object is
+    // referenced once no matter how many recycled sets use it, so that the sets referencing an
+    // object that the application released are found and deallocated on every Tick.
+    class RecycledDescriptorSetResources {
+      public:
+        RecycledDescriptorSetResources() = default;
+        ~RecycledDescriptorSetResources();
+
+        void Reference(DescriptorSetAllocator* allocator,
+                       const std::vector<ObjectBase*>& resources);
+        void Release(const std::vector<ObjectBase*>& resources);
+        void RemoveAllocator(DescriptorSetAllocator* allocator);
+
+        void Tick();
+
+      private:
+        struct Resource {
+            Ref<ObjectBase> object;
+            uint32_t recycledSetCount;
+        };
+        std::unordered_map<ObjectBase*, Resource> mResources;
+        // The allocators that may have recycled sets.
+        std::set<DescriptorSetAllocator*> mAllocators;
+    };
+
     class DescriptorSetAllocator {
         using PoolIndex = uint32_t;
         using SetIndex = uint16_t;
@@ -39,15 +78,37 @@ namespace dawn_native { namespace vulkan {
 
         ResultOrError<DescriptorSetAllocation> Allocate();
         void Deallocate(DescriptorSetAllocation* allocationInfo);
+        // Grows the next pool so that |setCount| sets can be allocated without creating more than
+        // one pool, when they fit in a single pool.
+        void Reserve(uint32_t setCount);
         void FinishDeallocation(ExecutionSerial completedSerial);
 
+        // Descriptor sets of destroyed bind groups are kept with the key of their content so that
+        // an identical bind group can reuse them without writing descriptors again. Reusing a set
+        // doesn't need to wait for its serial because the set isn't updated.
+        // Returns false if no recycled set matches |key|.
+        bool AllocateRecycled(const DescriptorSetKey& key, DescriptorSetAllocation* allocationInfo);
+        // |resources| are the objects referenced in |key|. They are kept alive by the device's
+        // RecycledDescriptorSetResources while the set is recycled.
+        void Recycle(DescriptorSetAllocation* allocationInfo,
+                     DescriptorSetKey key,
+                     std::vector<ObjectBase*> resources);
+        // Deallocates the recycled sets that reference one of |unreachableResources|. Returns
+        // whether some recycled sets remain.
+        bool DeallocateUnreachableRecycledSets(
+            const std::unordered_set<ObjectBase*>& unreachableResources);
+
       private:
         MaybeError AllocateDescriptorPool();
+        RecycledDescriptorSetResources* GetRecycledSetResources() const;
 
         BindGroupLayout* mLayout;
 
-        std::vector<VkDescriptorPoolSize> mPoolSizes;
-        SetIndex mMaxSets;
+        // The number of descriptors of each type in a single set.
+        std::vector<VkDescriptorPoolSize> mPoolSizesPerSet;
+        // Pools grow geometrically from the size of the first one up to mMaxSetsPerPool.
+        SetIndex mNextPoolMaxSets;
+        SetIndex mMaxSetsPerPool;
 
         struct DescriptorPool {
             VkDescriptorPool vkPool;
@@ -64,6 +125,14 @@ namespace dawn_native { namespace vulkan {
         };
         SerialQueue<ExecutionSerial, Deallocation> mPendingDeallocations;
         ExecutionSerial mLastDeallocationSerial = ExecutionSerial(0);
+
+        struct RecycledDescriptorSet {
+            DescriptorSetKey key;
+            DescriptorSetAllocation allocation;
+            std::vector<ObjectBase*> resources;
+        };
+        // Ordered from the least to the most recently recycled.
+        std::vector<RecycledDescriptorSet> mRecycledSets;
     };
 
 }}  // namespace dawn_native::vulkan
@@ -23,13 +23,17 @@
 #include "dawn_native/vulkan/BackendVk.h"
 #include "dawn_native/vulkan/BindGroupLayoutVk.h"
 #include "dawn_native/vulkan/BindGroupVk.h"
+#include "dawn_native/vulkan/BufferDefragmenterVk.h"
+#include "dawn_native/vulkan/BufferSubAllocatorVk.h"
 #include "dawn_native/vulkan/BufferVk.h"
 #include "dawn_native/vulkan/CommandBufferVk.h"
 #include "dawn_native/vulkan/ComputePipelineVk.h"
+#include "dawn_native/vulkan/DescriptorSetAllocator.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
 #include "dawn_native/vulkan/QuerySetVk.h"
 #include "dawn_native/vulkan/QueueVk.h"
+#include "dawn_native/vulkan/FramebufferCache.h"
 #include "dawn_native/vulkan/RenderPassCache.h"
 #include "dawn_native/vulkan/RenderPipelineVk.h"
 #include "dawn_native/vulkan/ResourceMemoryAllocatorVk.h"
@@ -41,6 +45,9 @@
 #include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
+#include <iterator>
+#include <sstream>
+
 namespace dawn_native { namespace vulkan {
 
     // static
@@ -52,6 +59,10 @@ namespace dawn_native { namespace vulkan {
 
     Device::Device(Adapter* adapter, const DeviceDescriptor* descriptor)
         : DeviceBase(adapter, descriptor) {
+        if (descriptor != nullptr) {
+            mMemoryAllocatorOptions = descriptor->memoryAllocatorOptions;
+            mDeferredDeletionOptions = descriptor->deferredDeletionOptions;
+        }
         InitTogglesFromDriver();
     }
 
@@ -80,11 +91,20 @@ namespace dawn_native { namespace vulkan {
             // the device.
             GatherQueueFromDevice();
 
-            mDeleter = std::make_unique<FencedDeleter>(this);
+            mDeleter = std::make_unique<FencedDeleter>(this, mDeferredDeletionOptions);
         }
 
         mRenderPassCache = std::make_unique<RenderPassCache>(this);
-        mResourceMemoryAllocator = std::make_unique<ResourceMemoryAllocator>(this);
+        mRecycledDescriptorSetResources = std::make_unique<RecycledDescriptorSetResources>();
+        mFramebufferCache = std::make_unique<FramebufferCache>(this);
+        mResourceMemoryAllocator =
+            std::make_unique<ResourceMemoryAllocator>(this, mMemoryAllocatorOptions);
+        if (IsToggleEnabled(Toggle::SubAllocateSmallBuffers)) {
+            mBufferSubAllocator = std::make_unique<BufferSubAllocator>(this);
+        }
+        if (IsToggleEnabled(Toggle::DefragmentBufferMemoryWhenIdle)) {
+            mBufferDefragmenter = std::make_unique<BufferDefragmenter>(this);
+        }
 
         mExternalMemoryService = std::make_unique<external_memory::Service>(this);
         mExternalSemaphoreService = std::make_unique<external_semaphore::Service>(this);
@@ -95,7 +115,11 @@ namespace dawn_native { namespace vulkan {
         // the decision if it is not applicable.
         ApplyDepth24PlusS8Toggle();
 
-        return DeviceBase::Initialize(Queue::Create(this));
+        DAWN_TRY(DeviceBase::Initialize(Queue::Create(this)));
+
+        // The pipeline cache is seeded from the PersistentCache which is only available after
+        // DeviceBase::Initialize.
+        return CreatePipelineCache();
     }
 
     Device::~Device() {
@@ -106,6 +130,11 @@ namespace dawn_native { namespace vulkan {
         const BindGroupDescriptor* descriptor) {
         return BindGroup::Create(this, descriptor);
     }
+    MaybeError Device::CreateBindGroupsImpl(uint32_t count,
+                                            const BindGroupDescriptor* const* descriptors,
+                                            Ref<BindGroupBase>* bindGroups) {
+        return BindGroup::CreateMany(this, count, descriptors, bindGroups);
+    }
     ResultOrError<Ref<BindGroupLayoutBase>> Device::CreateBindGroupLayoutImpl(
         const BindGroupLayoutDescriptor* descriptor) {
         return BindGroupLayout::Create(this, descriptor);
@@ -113,6 +142,11 @@ namespace dawn_native { namespace vulkan {
     ResultOrError<Ref<BufferBase>> Device::CreateBufferImpl(const BufferDescriptor* descriptor) {
         return Buffer::Create(this, descriptor);
     }
+    MaybeError Device::CreateBuffersImpl(uint32_t count,
+                                         const BufferDescriptor* const* descriptors,
+                                         Ref<BufferBase>* buffers) {
+        return Buffer::CreateMany(this, count, descriptors, buffers);
+    }
     ResultOrError<Ref<CommandBufferBase>> Device::CreateCommandBuffer(
         CommandEncoder* encoder,
         const CommandBufferDescriptor* descriptor) {
@@ -172,9 +206,21 @@ namespace dawn_native { namespace vulkan {
         }
         mBindGroupLayoutsPendingDeallocation.ClearUpTo(completedSerial);
 
+        // Release the objects that are only kept alive by recycled descriptor sets.
+        mRecycledDescriptorSetResources->Tick();
+
+        // The buffer sub-allocator releases SharedBuffers to the memory allocator and deleter.
+        if (mBufferSubAllocator != nullptr) {
+            mBufferSubAllocator->Tick(completedSerial);
+        }
         mResourceMemoryAllocator->Tick(completedSerial);
         mDeleter->Tick(completedSerial);
 
+        // The copies of the relocated buffers are submitted with the pending commands below.
+        if (mBufferDefragmenter != nullptr && !mRecordingContext.used) {
+            DAWN_TRY(mBufferDefragmenter->Tick());
+        }
+
         if (mRecordingContext.used) {
             DAWN_TRY(SubmitPendingCommands());
         }
@@ -213,6 +259,63 @@ namespace dawn_native { namespace vulkan {
         return mRenderPassCache.get();
     }
 
+    FramebufferCache* Device::GetFramebufferCache() const {
+        return mFramebufferCache.get();
+    }
+
+    VkPipelineCache Device::GetPipelineCache() const {
+        return mPipelineCache;
+    }
+
+    MaybeError Device::CreatePipelineCache() {
+        // The driver checks the header of the initial data and ignores it if it was produced by
+        // an incompatible device or driver.
+        ScopedCachedBlob blob = GetPersistentCache()->LoadData(GetPipelineCacheKey());
+
+        VkPipelineCacheCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.initialDataSize = blob.bufferSize;
+        createInfo.pInitialData = blob.buffer.get();
+
+        return CheckVkSuccess(
+            fn.CreatePipelineCache(mVkDevice, &createInfo, nullptr, &*mPipelineCache),
+            "CreatePipelineCache");
+    }
+
+    PersistentCacheKey Device::GetPipelineCacheKey() const {
+        const VkPhysicalDeviceProperties& properties = mDeviceInfo.properties;
+
+        std::stringstream stream;
+        stream << static_cast<uint32_t>(PersistentKeyType::PipelineCache);
+        stream << properties.vendorID << ";" << properties.deviceID << ";"
+               << properties.driverVersion << ";";
+        stream.write(reinterpret_cast<const char*>(properties.pipelineCacheUUID),
+                     sizeof(properties.pipelineCacheUUID));
+
+        return PersistentCacheKey(std::istreambuf_iterator<char>{stream},
+                                  std::istreambuf_iterator<char>{});
+    }
+
+    MaybeError Device::PersistPipelineCacheImpl() {
+        size_t dataSize = 0;
+        DAWN_TRY(CheckVkSuccess(
+            fn.GetPipelineCacheData(mVkDevice, mPipelineCache, &dataSize, nullptr),
+            "GetPipelineCacheData"));
+        if (dataSize == 0) {
+            return {};
+        }
+
+        std::vector<uint8_t> data(dataSize);
+        DAWN_TRY(CheckVkSuccess(
+            fn.GetPipelineCacheData(mVkDevice, mPipelineCache, &dataSize, data.data()),
+            "GetPipelineCacheData"));
+
+        GetPersistentCache()->StoreData(GetPipelineCacheKey(), data.data(), dataSize);
+        return {};
+    }
+
     void Device::EnqueueDeferredDeallocation(BindGroupLayout* bindGroupLayout) {
         mBindGroupLayoutsPendingDeallocation.Enqueue(bindGroupLayout, GetPendingCommandSerial());
     }
@@ -262,7 +365,7 @@ namespace dawn_native { namespace vulkan {
 
         IncrementLastSubmittedCommandSerial();
         ExecutionSerial lastSubmittedSerial = GetLastSubmittedCommandSerial();
-        mFencesInFlight.emplace(fence, lastSubmittedSerial);
+        mFencesInFlight.emplace_back(fence, lastSubmittedSerial);
 
         CommandPoolAndBuffer submittedCommands = {mRecordingContext.commandPool,
                                                   mRecordingContext.commandBuffer};
@@ -338,6 +441,16 @@ namespace dawn_native { namespace vulkan {
             usedKnobs.features.pipelineStatisticsQuery = VK_TRUE;
         }
 
+        if (IsExtensionEnabled(Extension::MultiDrawIndirect) &&
+            mDeviceInfo.features.multiDrawIndirect == VK_TRUE) {
+            usedKnobs.features.multiDrawIndirect = VK_TRUE;
+        }
+
+        if (IsExtensionEnabled(Extension::DrawIndirectCount)) {
+            ASSERT(usedKnobs.features.multiDrawIndirect == VK_TRUE &&
+                   usedKnobs.HasExt(DeviceExt::DrawIndirectCount));
+        }
+
         if (IsExtensionEnabled(Extension::ShaderFloat16)) {
             const VulkanDeviceInfo& deviceInfo = ToBackend(GetAdapter())->GetDeviceInfo();
             ASSERT(deviceInfo.HasExt(DeviceExt::ShaderFloat16Int8) &&
@@ -535,11 +648,29 @@ namespace dawn_native { namespace vulkan {
             mUnusedFences.push_back(fence);
 
             ASSERT(fenceSerial > GetCompletedCommandSerial());
-            mFencesInFlight.pop();
+            mFencesInFlight.pop_front();
         }
         return fenceSerial;
     }
 
+    MaybeError Device::WaitForSerialImpl(ExecutionSerial serial, uint64_t timeoutNs) {
+        // Fences are added in order, wait on the first one that covers |serial|.
+        for (const auto& fenceAndSerial : mFencesInFlight) {
+            if (fenceAndSerial.second < serial) {
+                continue;
+            }
+
+            VkFence fence = fenceAndSerial.first;
+            VkResult result = VkResult::WrapUnsafe(INJECT_ERROR_OR_RUN(
+                fn.WaitForFences(mVkDevice, 1, &*fence, true, timeoutNs), VK_ERROR_DEVICE_LOST));
+            if (result == VK_TIMEOUT) {
+                return {};
+            }
+            return CheckVkSuccess(::VkResult(result), "vkWaitForFences");
+        }
+        return {};
+    }
+
     MaybeError Device::PrepareRecordingContext() {
         ASSERT(!mRecordingContext.used);
         ASSERT(mRecordingContext.commandBuffer == VK_NULL_HANDLE);
@@ -627,7 +758,7 @@ namespace dawn_native { namespace vulkan {
 
         VkBufferCopy copy;
         copy.srcOffset = sourceOffset;
-        copy.dstOffset = destinationOffset;
+        copy.dstOffset = ToBackend(destination)->GetHandleOffset() + destinationOffset;
         copy.size = size;
 
         this->fn.CmdCopyBuffer(recordingContext->commandBuffer,
@@ -816,6 +947,22 @@ namespace dawn_native { namespace vulkan {
         return mResourceMemoryAllocator.get();
     }
 
+    ResourceMemoryAllocator* Device::GetResourceMemoryAllocator() const {
+        return mResourceMemoryAllocator.get();
+    }
+
+    BufferSubAllocator* Device::GetBufferSubAllocator() const {
+        return mBufferSubAllocator.get();
+    }
+
+    BufferDefragmenter* Device::GetBufferDefragmenter() const {
+        return mBufferDefragmenter.get();
+    }
+
+    RecycledDescriptorSetResources* Device::GetRecycledDescriptorSetResources() const {
+        return mRecycledDescriptorSetResources.get();
+    }
+
     uint32_t Device::GetComputeSubgroupSize() const {
         return mComputeSubgroupSize;
     }
@@ -854,7 +1001,7 @@ namespace dawn_native { namespace vulkan {
             ASSERT(result == VK_SUCCESS);
             fn.DestroyFence(mVkDevice, fence, nullptr);
 
-            mFencesInFlight.pop();
+            mFencesInFlight.pop_front();
         }
         return {};
     }
@@ -921,21 +1068,33 @@ namespace dawn_native { namespace vulkan {
 
         // Releasing the uploader enqueues buffers to be released.
         // Call Tick() again to clear them before releasing the deleter.
+        if (mBufferSubAllocator != nullptr) {
+            mBufferSubAllocator->Tick(GetCompletedCommandSerial());
+            mBufferSubAllocator->DestroyPool();
+        }
         mResourceMemoryAllocator->Tick(GetCompletedCommandSerial());
         mDeleter->Tick(GetCompletedCommandSerial());
 
         // Allow recycled memory to be deleted.
         mResourceMemoryAllocator->DestroyPool();
 
-        // The VkRenderPasses in the cache can be destroyed immediately since all commands referring
-        // to them are guaranteed to be finished executing.
+        // The VkRenderPasses and VkFramebuffers in the caches can be destroyed immediately since
+        // all commands referring to them are guaranteed to be finished executing.
+        mFramebufferCache = nullptr;
         mRenderPassCache = nullptr;
 
+        // The pipeline cache is only used during the creation of pipelines.
+        if (mPipelineCache != VK_NULL_HANDLE) {
+            fn.DestroyPipelineCache(mVkDevice, mPipelineCache, nullptr);
+            mPipelineCache = VK_NULL_HANDLE;
+        }
+
         // We need handle deleting all child objects by calling Tick() again with a large serial to
         // force all operations to look as if they were completed, and delete all objects before
         // destroying the Deleter and vkDevice.
         ASSERT(mDeleter != nullptr);
         mDeleter->Tick(kMaxExecutionSerial);
+        mDeleter->DeleteAllReady();
         mDeleter = nullptr;
 
         // VkQueues are destroyed when the VkDevice is destroyed
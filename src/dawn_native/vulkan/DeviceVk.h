@@ -20,6 +20,7 @@
 #include "common/SerialQueue.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/PersistentCache.h"
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/Forward.h"
 #include "dawn_native/vulkan/VulkanFunctions.h"
@@ -29,14 +30,18 @@
 #include "dawn_native/vulkan/external_semaphore/SemaphoreService.h"
 
 #include <memory>
-#include <queue>
+#include <deque>
 
 namespace dawn_native { namespace vulkan {
 
     class Adapter;
     class BindGroupLayout;
+    class BufferDefragmenter;
+    class BufferSubAllocator;
     class BufferUploader;
     class FencedDeleter;
+    class FramebufferCache;
+    class RecycledDescriptorSetResources;
     class RenderPassCache;
     class ResourceMemoryAllocator;
 
@@ -59,6 +64,8 @@ namespace dawn_native { namespace vulkan {
 
         FencedDeleter* GetFencedDeleter() const;
         RenderPassCache* GetRenderPassCache() const;
+        FramebufferCache* GetFramebufferCache() const;
+        VkPipelineCache GetPipelineCache() const;
 
         CommandRecordingContext* GetPendingRecordingContext();
         MaybeError SubmitPendingCommands();
@@ -100,6 +107,12 @@ namespace dawn_native { namespace vulkan {
         int FindBestMemoryTypeIndex(VkMemoryRequirements requirements, bool mappable);
 
         ResourceMemoryAllocator* GetResourceMemoryAllocatorForTesting() const;
+        ResourceMemoryAllocator* GetResourceMemoryAllocator() const;
+        // Returns nullptr unless the SubAllocateSmallBuffers toggle is enabled.
+        BufferSubAllocator* GetBufferSubAllocator() const;
+        // Returns nullptr unless the DefragmentBufferMemoryWhenIdle toggle is enabled.
+        BufferDefragmenter* GetBufferDefragmenter() const;
+        RecycledDescriptorSetResources* GetRecycledDescriptorSetResources() const;
 
         // Return the fixed subgroup size to use for compute shaders on this device or 0 if none
         // needs to be set.
@@ -115,10 +128,16 @@ namespace dawn_native { namespace vulkan {
 
         ResultOrError<Ref<BindGroupBase>> CreateBindGroupImpl(
             const BindGroupDescriptor* descriptor) override;
+        MaybeError CreateBindGroupsImpl(uint32_t count,
+                                        const BindGroupDescriptor* const* descriptors,
+                                        Ref<BindGroupBase>* bindGroups) override;
         ResultOrError<Ref<BindGroupLayoutBase>> CreateBindGroupLayoutImpl(
             const BindGroupLayoutDescriptor* descriptor) override;
         ResultOrError<Ref<BufferBase>> CreateBufferImpl(
             const BufferDescriptor* descriptor) override;
+        MaybeError CreateBuffersImpl(uint32_t count,
+                                     const BufferDescriptor* const* descriptors,
+                                     Ref<BufferBase>* buffers) override;
         ResultOrError<Ref<ComputePipelineBase>> CreateComputePipelineImpl(
             const ComputePipelineDescriptor* descriptor) override;
         ResultOrError<Ref<PipelineLayoutBase>> CreatePipelineLayoutImpl(
@@ -154,6 +173,10 @@ namespace dawn_native { namespace vulkan {
         void ShutDownImpl() override;
         MaybeError WaitForIdleForDestruction() override;
 
+        MaybeError CreatePipelineCache();
+        PersistentCacheKey GetPipelineCacheKey() const;
+        MaybeError PersistPipelineCacheImpl() override;
+
         // To make it easier to use fn it is a public const member. However
         // the Device is allowed to mutate them through these private methods.
         VulkanFunctions* GetMutableFunctions();
@@ -165,21 +188,29 @@ namespace dawn_native { namespace vulkan {
         uint32_t mComputeSubgroupSize = 0;
 
         SerialQueue<ExecutionSerial, Ref<BindGroupLayout>> mBindGroupLayoutsPendingDeallocation;
+        std::unique_ptr<RecycledDescriptorSetResources> mRecycledDescriptorSetResources;
         std::unique_ptr<FencedDeleter> mDeleter;
         std::unique_ptr<ResourceMemoryAllocator> mResourceMemoryAllocator;
+        std::unique_ptr<BufferSubAllocator> mBufferSubAllocator;
+        std::unique_ptr<BufferDefragmenter> mBufferDefragmenter;
         std::unique_ptr<RenderPassCache> mRenderPassCache;
+        std::unique_ptr<FramebufferCache> mFramebufferCache;
+        VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
+        MemoryAllocatorOptions mMemoryAllocatorOptions;
+        DeferredDeletionOptions mDeferredDeletionOptions;
 
         std::unique_ptr<external_memory::Service> mExternalMemoryService;
         std::unique_ptr<external_semaphore::Service> mExternalSemaphoreService;
 
         ResultOrError<VkFence> GetUnusedFence();
         ResultOrError<ExecutionSerial> CheckAndUpdateCompletedSerials() override;
+        MaybeError WaitForSerialImpl(ExecutionSerial serial, uint64_t timeoutNs) override;
 
         // We track which operations are in flight on the GPU with an increasing serial.
         // This works only because we have a single queue. Each submit to a queue is associated
         // to a serial and a fence, such that when the fence is "ready" we know the operations
         // have finished.
-        std::queue<std::pair<VkFence, ExecutionSerial>> mFencesInFlight;
+        std::deque<std::pair<VkFence, ExecutionSerial>> mFencesInFlight;
         // Fences in the unused list aren't reset yet.
         std::vector<VkFence> mUnusedFences;
 
@@ -16,168 +16,272 @@
 
 #include "dawn_native/vulkan/DeviceVk.h"
 
+#include <chrono>
+#include <cstring>
+
 namespace dawn_native { namespace vulkan {
 
-    FencedDeleter::FencedDeleter(Device* device) : mDevice(device) {
+    namespace {
+
+        // The clock is only read every few destructions because most of them are very cheap.
+        constexpr size_t kDeletionsPerClockRead = 16;
+
+        template <typename T>
+        uint64_t ToUint64(T handle) {
+            static_assert(sizeof(T) == sizeof(uint64_t), "");
+            uint64_t value;
+            memcpy(&value, &handle, sizeof(value));
+            return value;
+        }
+
+        template <typename T>
+        T FromUint64(uint64_t value) {
+            static_assert(sizeof(T) == sizeof(uint64_t), "");
+            T handle;
+            memcpy(&handle, &value, sizeof(value));
+            return handle;
+        }
+
+    }  // anonymous namespace
+
+    FencedDeleter::FencedDeleter(Device* device, const DeferredDeletionOptions& options)
+        : mDevice(device), mMaxTickDurationNs(options.maxTickDurationNs) {
+        if (options.destroyOnBackgroundThread) {
+            mThread = std::thread([this]() { ThreadLoop(); });
+        }
     }
 
     FencedDeleter::~FencedDeleter() {
-        ASSERT(mBuffersToDelete.Empty());
-        ASSERT(mDescriptorPoolsToDelete.Empty());
-        ASSERT(mFramebuffersToDelete.Empty());
-        ASSERT(mImagesToDelete.Empty());
-        ASSERT(mImageViewsToDelete.Empty());
-        ASSERT(mMemoriesToDelete.Empty());
-        ASSERT(mPipelinesToDelete.Empty());
-        ASSERT(mPipelineLayoutsToDelete.Empty());
-        ASSERT(mQueryPoolsToDelete.Empty());
-        ASSERT(mRenderPassesToDelete.Empty());
-        ASSERT(mSamplersToDelete.Empty());
-        ASSERT(mSemaphoresToDelete.Empty());
-        ASSERT(mShaderModulesToDelete.Empty());
-        ASSERT(mSurfacesToDelete.Empty());
-        ASSERT(mSwapChainsToDelete.Empty());
+        ASSERT(mDeletions.Empty());
+        DeleteAllReady();
+
+        if (mThread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStopThread = true;
+            }
+            mCondition.notify_all();
+            mThread.join();
+        }
+    }
+
+    template <typename T>
+    void FencedDeleter::Enqueue(Type type, T handle) {
+        mDeletions.Enqueue(Deletion{type, ToUint64(handle)}, mDevice->GetPendingCommandSerial());
     }
 
     void FencedDeleter::DeleteWhenUnused(VkBuffer buffer) {
-        mBuffersToDelete.Enqueue(buffer, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::Buffer, buffer);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkDescriptorPool pool) {
-        mDescriptorPoolsToDelete.Enqueue(pool, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::DescriptorPool, pool);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkDeviceMemory memory) {
-        mMemoriesToDelete.Enqueue(memory, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::DeviceMemory, memory);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkFramebuffer framebuffer) {
-        mFramebuffersToDelete.Enqueue(framebuffer, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::Framebuffer, framebuffer);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkImage image) {
-        mImagesToDelete.Enqueue(image, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::Image, image);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkImageView view) {
-        mImageViewsToDelete.Enqueue(view, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::ImageView, view);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkPipeline pipeline) {
-        mPipelinesToDelete.Enqueue(pipeline, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::Pipeline, pipeline);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkPipelineLayout layout) {
-        mPipelineLayoutsToDelete.Enqueue(layout, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::PipelineLayout, layout);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkQueryPool querypool) {
-        mQueryPoolsToDelete.Enqueue(querypool, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::QueryPool, querypool);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkRenderPass renderPass) {
-        mRenderPassesToDelete.Enqueue(renderPass, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::RenderPass, renderPass);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkSampler sampler) {
-        mSamplersToDelete.Enqueue(sampler, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::Sampler, sampler);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkSemaphore semaphore) {
-        mSemaphoresToDelete.Enqueue(semaphore, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::Semaphore, semaphore);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkShaderModule module) {
-        mShaderModulesToDelete.Enqueue(module, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::ShaderModule, module);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkSurfaceKHR surface) {
-        mSurfacesToDelete.Enqueue(surface, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::SurfaceKHR, surface);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkSwapchainKHR swapChain) {
-        mSwapChainsToDelete.Enqueue(swapChain, mDevice->GetPendingCommandSerial());
+        Enqueue(Type::SwapchainKHR, swapChain);
     }
 
     void FencedDeleter::Tick(ExecutionSerial completedSerial) {
-        VkDevice vkDevice = mDevice->GetVkDevice();
-        VkInstance instance = mDevice->GetVkInstance();
-
-        // Buffers and images must be deleted before memories because it is invalid to free memory
-        // that still have resources bound to it.
-        for (VkBuffer buffer : mBuffersToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyBuffer(vkDevice, buffer, nullptr);
+        // Queue the completed deletions in the order they must be destroyed. Memories must be
+        // freed after the buffers and images bound to them, and surfaces destroyed after their
+        // swapchains, so they are queued after all the other objects.
+        for (const Deletion& deletion : mDeletions.IterateUpTo(completedSerial)) {
+            if (deletion.type != Type::DeviceMemory && deletion.type != Type::SurfaceKHR) {
+                mReadyDeletions.push_back(deletion);
+            }
         }
-        mBuffersToDelete.ClearUpTo(completedSerial);
-        for (VkImage image : mImagesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyImage(vkDevice, image, nullptr);
+        for (const Deletion& deletion : mDeletions.IterateUpTo(completedSerial)) {
+            if (deletion.type == Type::DeviceMemory || deletion.type == Type::SurfaceKHR) {
+                mReadyDeletions.push_back(deletion);
+            }
         }
-        mImagesToDelete.ClearUpTo(completedSerial);
+        mDeletions.ClearUpTo(completedSerial);
 
-        for (VkDeviceMemory memory : mMemoriesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.FreeMemory(vkDevice, memory, nullptr);
+        if (mReadyDeletions.empty()) {
+            return;
         }
-        mMemoriesToDelete.ClearUpTo(completedSerial);
 
-        for (VkPipelineLayout layout : mPipelineLayoutsToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyPipelineLayout(vkDevice, layout, nullptr);
+        if (mThread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mThreadDeletions.insert(mThreadDeletions.end(), mReadyDeletions.begin(),
+                                        mReadyDeletions.end());
+            }
+            mReadyDeletions.clear();
+            mCondition.notify_all();
+            return;
         }
-        mPipelineLayoutsToDelete.ClearUpTo(completedSerial);
 
-        for (VkRenderPass renderPass : mRenderPassesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyRenderPass(vkDevice, renderPass, nullptr);
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point start = Clock::now();
+        size_t destroyedCount = 0;
+        while (!mReadyDeletions.empty()) {
+            Destroy(mReadyDeletions.front());
+            mReadyDeletions.pop_front();
+
+            if (mMaxTickDurationNs != 0 && ++destroyedCount % kDeletionsPerClockRead == 0) {
+                uint64_t elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         Clock::now() - start)
+                                         .count();
+                if (elapsedNs >= mMaxTickDurationNs) {
+                    break;
+                }
+            }
         }
-        mRenderPassesToDelete.ClearUpTo(completedSerial);
 
-        for (VkFramebuffer framebuffer : mFramebuffersToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyFramebuffer(vkDevice, framebuffer, nullptr);
+        // Make sure the device keeps ticking to destroy the remaining objects even if there is no
+        // GPU work in flight.
+        if (!mReadyDeletions.empty()) {
+            mDevice->AddFutureSerial(mDevice->GetPendingCommandSerial());
         }
-        mFramebuffersToDelete.ClearUpTo(completedSerial);
-
-        for (VkImageView view : mImageViewsToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyImageView(vkDevice, view, nullptr);
-        }
-        mImageViewsToDelete.ClearUpTo(completedSerial);
-
-        for (VkShaderModule module : mShaderModulesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyShaderModule(vkDevice, module, nullptr);
-        }
-        mShaderModulesToDelete.ClearUpTo(completedSerial);
+    }
 
-        for (VkPipeline pipeline : mPipelinesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyPipeline(vkDevice, pipeline, nullptr);
+    void FencedDeleter::DeleteAllReady() {
+        if (mThread.joinable()) {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() { return mThreadDeletions.empty() && !mThreadBusy; });
         }
-        mPipelinesToDelete.ClearUpTo(completedSerial);
 
-        // Vulkan swapchains must be destroyed before their corresponding VkSurface
-        for (VkSwapchainKHR swapChain : mSwapChainsToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroySwapchainKHR(vkDevice, swapChain, nullptr);
-        }
-        mSwapChainsToDelete.ClearUpTo(completedSerial);
-        for (VkSurfaceKHR surface : mSurfacesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroySurfaceKHR(instance, surface, nullptr);
+        while (!mReadyDeletions.empty()) {
+            Destroy(mReadyDeletions.front());
+            mReadyDeletions.pop_front();
         }
-        mSurfacesToDelete.ClearUpTo(completedSerial);
-
-        for (VkSemaphore semaphore : mSemaphoresToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroySemaphore(vkDevice, semaphore, nullptr);
-        }
-        mSemaphoresToDelete.ClearUpTo(completedSerial);
+    }
 
-        for (VkDescriptorPool pool : mDescriptorPoolsToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyDescriptorPool(vkDevice, pool, nullptr);
-        }
-        mDescriptorPoolsToDelete.ClearUpTo(completedSerial);
+    size_t FencedDeleter::GetReadyDeletionCountForTesting() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mReadyDeletions.size() + mThreadDeletions.size();
+    }
 
-        for (VkQueryPool pool : mQueryPoolsToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyQueryPool(vkDevice, pool, nullptr);
+    void FencedDeleter::ThreadLoop() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true) {
+            mCondition.wait(lock, [this]() { return mStopThread || !mThreadDeletions.empty(); });
+            if (mThreadDeletions.empty()) {
+                return;
+            }
+
+            std::deque<Deletion> deletions;
+            deletions.swap(mThreadDeletions);
+            mThreadBusy = true;
+
+            lock.unlock();
+            for (const Deletion& deletion : deletions) {
+                Destroy(deletion);
+            }
+            lock.lock();
+
+            mThreadBusy = false;
+            mCondition.notify_all();
         }
-        mQueryPoolsToDelete.ClearUpTo(completedSerial);
+    }
 
-        for (VkSampler sampler : mSamplersToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroySampler(vkDevice, sampler, nullptr);
+    void FencedDeleter::Destroy(const Deletion& deletion) const {
+        VkDevice vkDevice = mDevice->GetVkDevice();
+        uint64_t handle = deletion.handle;
+
+        switch (deletion.type) {
+            case Type::Buffer:
+                mDevice->fn.DestroyBuffer(vkDevice, FromUint64<VkBuffer>(handle), nullptr);
+                break;
+            case Type::DescriptorPool:
+                mDevice->fn.DestroyDescriptorPool(vkDevice, FromUint64<VkDescriptorPool>(handle),
+                                                  nullptr);
+                break;
+            case Type::DeviceMemory:
+                mDevice->fn.FreeMemory(vkDevice, FromUint64<VkDeviceMemory>(handle), nullptr);
+                break;
+            case Type::Framebuffer:
+                mDevice->fn.DestroyFramebuffer(vkDevice, FromUint64<VkFramebuffer>(handle),
+                                               nullptr);
+                break;
+            case Type::Image:
+                mDevice->fn.DestroyImage(vkDevice, FromUint64<VkImage>(handle), nullptr);
+                break;
+            case Type::ImageView:
+                mDevice->fn.DestroyImageView(vkDevice, FromUint64<VkImageView>(handle), nullptr);
+                break;
+            case Type::Pipeline:
+                mDevice->fn.DestroyPipeline(vkDevice, FromUint64<VkPipeline>(handle), nullptr);
+                break;
+            case Type::PipelineLayout:
+                mDevice->fn.DestroyPipelineLayout(vkDevice, FromUint64<VkPipelineLayout>(handle),
+                                                  nullptr);
+                break;
+            case Type::QueryPool:
+                mDevice->fn.DestroyQueryPool(vkDevice, FromUint64<VkQueryPool>(handle), nullptr);
+                break;
+            case Type::RenderPass:
+                mDevice->fn.DestroyRenderPass(vkDevice, FromUint64<VkRenderPass>(handle), nullptr);
+                break;
+            case Type::Sampler:
+                mDevice->fn.DestroySampler(vkDevice, FromUint64<VkSampler>(handle), nullptr);
+                break;
+            case Type::Semaphore:
+                mDevice->fn.DestroySemaphore(vkDevice, FromUint64<VkSemaphore>(handle), nullptr);
+                break;
+            case Type::ShaderModule:
+                mDevice->fn.DestroyShaderModule(vkDevice, FromUint64<VkShaderModule>(handle),
+                                                nullptr);
+                break;
+            case Type::SurfaceKHR:
+                mDevice->fn.DestroySurfaceKHR(mDevice->GetVkInstance(),
+                                              FromUint64<VkSurfaceKHR>(handle), nullptr);
+                break;
+            case Type::SwapchainKHR:
+                mDevice->fn.DestroySwapchainKHR(vkDevice, FromUint64<VkSwapchainKHR>(handle),
+                                                nullptr);
+                break;
         }
-        mSamplersToDelete.ClearUpTo(completedSerial);
     }
 
 }}  // namespace dawn_native::vulkan
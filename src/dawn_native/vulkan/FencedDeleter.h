@@ -17,15 +17,26 @@
 
 #include "common/SerialQueue.h"
 #include "common/vulkan_platform.h"
+#include "dawn_native/DawnNative.h"
 #include "dawn_native/IntegerTypes.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 namespace dawn_native { namespace vulkan {
 
     class Device;
 
+    // Destroys the Vulkan objects once the GPU has stopped using them. The objects of all types
+    // are kept in a single queue ordered by serial. The objects whose serial has completed are
+    // moved to a FIFO of objects ready to be destroyed, that is processed either in Tick, within
+    // an optional time budget, or on a background thread. Destroying non-dispatchable handles
+    // only requires external synchronization on the handle, which no other code uses anymore.
     class FencedDeleter {
       public:
-        FencedDeleter(Device* device);
+        FencedDeleter(Device* device, const DeferredDeletionOptions& options);
         ~FencedDeleter();
 
         void DeleteWhenUnused(VkBuffer buffer);
@@ -46,23 +57,57 @@ namespace dawn_native { namespace vulkan {
 
         void Tick(ExecutionSerial completedSerial);
 
+        // Destroys all the objects whose serial has completed, ignoring the time budget and
+        // waiting for the background thread to be done. Used before destroying the VkDevice.
+        void DeleteAllReady();
+
+        // The number of objects whose serial has completed and that wait to be destroyed, not
+        // counting the ones the background thread is destroying.
+        size_t GetReadyDeletionCountForTesting();
+
       private:
+        enum class Type : uint8_t {
+            Buffer,
+            DescriptorPool,
+            DeviceMemory,
+            Framebuffer,
+            Image,
+            ImageView,
+            Pipeline,
+            PipelineLayout,
+            QueryPool,
+            RenderPass,
+            Sampler,
+            Semaphore,
+            ShaderModule,
+            SurfaceKHR,
+            SwapchainKHR,
+        };
+
+        struct Deletion {
+            Type type;
+            uint64_t handle;
+        };
+
+        template <typename T>
+        void Enqueue(Type type, T handle);
+        void Destroy(const Deletion& deletion) const;
+        void ThreadLoop();
+
         Device* mDevice = nullptr;
-        SerialQueue<ExecutionSerial, VkBuffer> mBuffersToDelete;
-        SerialQueue<ExecutionSerial, VkDescriptorPool> mDescriptorPoolsToDelete;
-        SerialQueue<ExecutionSerial, VkDeviceMemory> mMemoriesToDelete;
-        SerialQueue<ExecutionSerial, VkFramebuffer> mFramebuffersToDelete;
-        SerialQueue<ExecutionSerial, VkImage> mImagesToDelete;
-        SerialQueue<ExecutionSerial, VkImageView> mImageViewsToDelete;
-        SerialQueue<ExecutionSerial, VkPipeline> mPipelinesToDelete;
-        SerialQueue<ExecutionSerial, VkPipelineLayout> mPipelineLayoutsToDelete;
-        SerialQueue<ExecutionSerial, VkQueryPool> mQueryPoolsToDelete;
-        SerialQueue<ExecutionSerial, VkRenderPass> mRenderPassesToDelete;
-        SerialQueue<ExecutionSerial, VkSampler> mSamplersToDelete;
-        SerialQueue<ExecutionSerial, VkSemaphore> mSemaphoresToDelete;
-        SerialQueue<ExecutionSerial, VkShaderModule> mShaderModulesToDelete;
-        SerialQueue<ExecutionSerial, VkSurfaceKHR> mSurfacesToDelete;
-        SerialQueue<ExecutionSerial, VkSwapchainKHR> mSwapChainsToDelete;
+        uint64_t mMaxTickDurationNs = 0;
+
+        SerialQueue<ExecutionSerial, Deletion> mDeletions;
+        // Deletions whose serial has completed, in the order they must be destroyed.
+        std::deque<Deletion> mReadyDeletions;
+
+        // The background thread takes the batches of mReadyDeletions given by Tick.
+        std::thread mThread;
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<Deletion> mThreadDeletions;
+        bool mThreadBusy = false;
+        bool mStopThread = false;
     };
 
 }}  // namespace dawn_native::vulkan
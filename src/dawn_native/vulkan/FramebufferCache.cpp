@@ -0,0 +1,170 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/FramebufferCache.h"
+
+#include "common/HashUtils.h"
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/TextureVk.h"
+#include "dawn_native/vulkan/VulkanError.h"
+
+#include <algorithm>
+
+namespace dawn_native { namespace vulkan {
+
+    // FramebufferCacheQuery
+
+    void FramebufferCacheQuery::AddAttachment(TextureView* view) {
+        ASSERT(attachmentCount < attachments.size());
+        attachments[attachmentCount] = view;
+        attachmentCount++;
+    }
+
+    // FramebufferCache
+
+    FramebufferCache::FramebufferCache(Device* device) : mDevice(device) {
+    }
+
+    FramebufferCache::~FramebufferCache() {
+        for (auto it : mCache) {
+            mDevice->fn.DestroyFramebuffer(mDevice->GetVkDevice(), it.second, nullptr);
+        }
+        mCache.clear();
+    }
+
+    ResultOrError<VkFramebuffer> FramebufferCache::GetFramebuffer(
+        const FramebufferCacheQuery& query) {
+        auto it = mCache.find(query);
+        if (it != mCache.end()) {
+            mStats.hits++;
+            return VkFramebuffer(it->second);
+        }
+        mStats.misses++;
+
+        VkFramebuffer framebuffer;
+        DAWN_TRY_ASSIGN(framebuffer, CreateFramebufferForQuery(query));
+        it = mCache.emplace(query, framebuffer).first;
+
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            std::vector<const FramebufferCacheQuery*>& queries =
+                mQueriesPerView[query.attachments[i]];
+            // The same view can't be used twice in a render pass, but be robust to it.
+            if (std::find(queries.begin(), queries.end(), &it->first) == queries.end()) {
+                queries.push_back(&it->first);
+            }
+        }
+        return framebuffer;
+    }
+
+    ResultOrError<VkFramebuffer> FramebufferCache::CreateFramebufferForQuery(
+        const FramebufferCacheQuery& query) const {
+        std::array<VkImageView, kMaxColorAttachments * 2 + 1> attachments;
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            attachments[i] = query.attachments[i]->GetHandle();
+        }
+
+        VkFramebufferCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.renderPass = query.renderPass;
+        createInfo.attachmentCount = query.attachmentCount;
+        createInfo.pAttachments = AsVkArray(attachments.data());
+        createInfo.width = query.width;
+        createInfo.height = query.height;
+        createInfo.layers = 1;
+
+        VkFramebuffer framebuffer;
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.CreateFramebuffer(mDevice->GetVkDevice(), &createInfo,
+                                                              nullptr, &*framebuffer),
+                                "CreateFramebuffer"));
+        return framebuffer;
+    }
+
+    void FramebufferCache::DeleteFramebuffer(Cache::iterator it) {
+        const FramebufferCacheQuery* query = &it->first;
+        for (uint32_t i = 0; i < query->attachmentCount; ++i) {
+            auto viewIt = mQueriesPerView.find(query->attachments[i]);
+            if (viewIt == mQueriesPerView.end()) {
+                continue;
+            }
+            std::vector<const FramebufferCacheQuery*>& queries = viewIt->second;
+            queries.erase(std::remove(queries.begin(), queries.end(), query), queries.end());
+            if (queries.empty()) {
+                mQueriesPerView.erase(viewIt);
+            }
+        }
+
+        // The framebuffer might still be used by commands in flight.
+        mDevice->GetFencedDeleter()->DeleteWhenUnused(it->second);
+        mCache.erase(it);
+    }
+
+    void FramebufferCache::OnTextureViewDestroyed(const TextureView* view) {
+        auto viewIt = mQueriesPerView.find(view);
+        if (viewIt == mQueriesPerView.end()) {
+            return;
+        }
+
+        // DeleteFramebuffer modifies the lists of queries, iterate on a copy.
+        std::vector<const FramebufferCacheQuery*> queries = viewIt->second;
+        for (const FramebufferCacheQuery* query : queries) {
+            auto it = mCache.find(*query);
+            ASSERT(it != mCache.end());
+            DeleteFramebuffer(it);
+        }
+        ASSERT(mQueriesPerView.find(view) == mQueriesPerView.end());
+    }
+
+    void FramebufferCache::OnTextureDestroyed(const Texture* texture) {
+        std::vector<const TextureView*> views;
+        for (const auto& it : mQueriesPerView) {
+            if (it.first->GetTexture() == texture) {
+                views.push_back(it.first);
+            }
+        }
+        for (const TextureView* view : views) {
+            OnTextureViewDestroyed(view);
+        }
+    }
+
+    ObjectCacheStats FramebufferCache::GetStats() const {
+        return mStats;
+    }
+
+    // FramebufferCache implementation of the unordered_map functors.
+
+    size_t FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& query) const {
+        // The render pass isn't hashed because framebuffers of the same views almost always use
+        // the same render pass.
+        size_t hash = Hash(query.attachmentCount);
+        HashCombine(&hash, query.width, query.height);
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            HashCombine(&hash, query.attachments[i]);
+        }
+        return hash;
+    }
+
+    bool FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& a,
+                                                  const FramebufferCacheQuery& b) const {
+        if (a.renderPass != b.renderPass || a.width != b.width || a.height != b.height ||
+            a.attachmentCount != b.attachmentCount) {
+            return false;
+        }
+        return std::equal(a.attachments.begin(), a.attachments.begin() + a.attachmentCount,
+                          b.attachments.begin());
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,86 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
+#define DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
+
+#include "common/Constants.h"
+#include "common/vulkan_platform.h"
+#include "dawn_native/DawnNative.h"
+#include "dawn_native/Error.h"
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    class Device;
+    class Texture;
+    class TextureView;
+
+    // The attachments of a framebuffer, in the "color-depthstencil-resolve" order of the
+    // VkRenderPass it is used with.
+    struct FramebufferCacheQuery {
+        void AddAttachment(TextureView* view);
+
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t attachmentCount = 0;
+        std::array<TextureView*, kMaxColorAttachments * 2 + 1> attachments;
+    };
+
+    // Caches VkFramebuffers so that render passes drawing to the same attachments every frame
+    // don't create a new one every time. Framebuffers are keyed by the TextureViews they use,
+    // and are deleted when one of their views, or the texture of one of their views, is
+    // destroyed, so that the handles in the cache never refer to destroyed objects.
+    class FramebufferCache {
+      public:
+        FramebufferCache(Device* device);
+        ~FramebufferCache();
+
+        ResultOrError<VkFramebuffer> GetFramebuffer(const FramebufferCacheQuery& query);
+
+        void OnTextureViewDestroyed(const TextureView* view);
+        void OnTextureDestroyed(const Texture* texture);
+
+        ObjectCacheStats GetStats() const;
+
+      private:
+        struct CacheFuncs {
+            size_t operator()(const FramebufferCacheQuery& query) const;
+            bool operator()(const FramebufferCacheQuery& a, const FramebufferCacheQuery& b) const;
+        };
+        using Cache =
+            std::unordered_map<FramebufferCacheQuery, VkFramebuffer, CacheFuncs, CacheFuncs>;
+
+        ResultOrError<VkFramebuffer> CreateFramebufferForQuery(
+            const FramebufferCacheQuery& query) const;
+        void DeleteFramebuffer(Cache::iterator it);
+
+        Device* mDevice = nullptr;
+        Cache mCache;
+
+        // For each view used by a cached framebuffer, the keys of its framebuffers. Keys in an
+        // unordered_map are never moved so pointers to them stay valid.
+        std::unordered_map<const TextureView*, std::vector<const FramebufferCacheQuery*>>
+            mQueriesPerView;
+
+        ObjectCacheStats mStats;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
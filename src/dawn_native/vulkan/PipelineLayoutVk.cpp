@@ -42,14 +42,24 @@ namespace dawn_native { namespace vulkan {
             numSetLayouts++;
         }
 
+        VkPushConstantRange immediateDataRange;
+        immediateDataRange.stageFlags = kImmediateDataShaderStages;
+        immediateDataRange.offset = 0;
+        immediateDataRange.size = GetImmediateDataSize();
+
         VkPipelineLayoutCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
         createInfo.setLayoutCount = numSetLayouts;
         createInfo.pSetLayouts = AsVkArray(setLayouts.data());
-        createInfo.pushConstantRangeCount = 0;
-        createInfo.pPushConstantRanges = nullptr;
+        if (immediateDataRange.size > 0) {
+            createInfo.pushConstantRangeCount = 1;
+            createInfo.pPushConstantRanges = &immediateDataRange;
+        } else {
+            createInfo.pushConstantRangeCount = 0;
+            createInfo.pPushConstantRanges = nullptr;
+        }
 
         Device* device = ToBackend(GetDevice());
         return CheckVkSuccess(
@@ -24,6 +24,10 @@ namespace dawn_native { namespace vulkan {
 
     class Device;
 
+    // The immediate data is a single push constant range starting at 0, visible in all the stages.
+    static constexpr VkShaderStageFlags kImmediateDataShaderStages =
+        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
     class PipelineLayout final : public PipelineLayoutBase {
       public:
         static ResultOrError<Ref<PipelineLayout>> Create(
@@ -523,7 +523,7 @@ namespace dawn_native { namespace vulkan {
         createInfo.basePipelineIndex = -1;
 
         return CheckVkSuccess(
-            device->fn.CreateGraphicsPipelines(device->GetVkDevice(), VkPipelineCache{}, 1,
+            device->fn.CreateGraphicsPipelines(device->GetVkDevice(), device->GetPipelineCache(), 1,
                                                &createInfo, nullptr, &*mHandle),
             "CreateGraphicsPipeline");
     }
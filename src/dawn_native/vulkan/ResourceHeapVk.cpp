@@ -16,8 +16,8 @@
 
 namespace dawn_native { namespace vulkan {
 
-    ResourceHeap::ResourceHeap(VkDeviceMemory memory, size_t memoryType)
-        : mMemory(memory), mMemoryType(memoryType) {
+    ResourceHeap::ResourceHeap(VkDeviceMemory memory, size_t memoryType, uint64_t size)
+        : mMemory(memory), mMemoryType(memoryType), mSize(size) {
     }
 
     VkDeviceMemory ResourceHeap::GetMemory() const {
@@ -28,4 +28,8 @@ namespace dawn_native { namespace vulkan {
         return mMemoryType;
     }
 
+    uint64_t ResourceHeap::GetSize() const {
+        return mSize;
+    }
+
 }}  // namespace dawn_native::vulkan
@@ -17,9 +17,12 @@
 #include "common/Math.h"
 #include "dawn_native/BuddyMemoryAllocator.h"
 #include "dawn_native/ResourceHeapAllocator.h"
+#include "dawn_native/SegregatedFitMemoryAllocator.h"
+#include "dawn_native/vulkan/AdapterVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/ResourceHeapVk.h"
+#include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
 namespace dawn_native { namespace vulkan {
@@ -29,32 +32,98 @@ namespace dawn_native { namespace vulkan {
         // TODO(cwallez@chromium.org): This is a hardcoded heurstic to choose when to
         // suballocate but it should ideally depend on the size of the memory heaps and other
         // factors.
-        constexpr uint64_t kMaxSizeForSubAllocation = 4ull * 1024ull * 1024ull;  // 4MiB
+        constexpr uint64_t kDefaultMaxSizeForSubAllocation = 4ull * 1024ull * 1024ull;  // 4MiB
+
+        // With releaseUnusedHeapsWhenIdle, the number of consecutive ticks where the GPU is idle
+        // and no memory is allocated or freed before the heaps kept for reuse are released. An
+        // application that creates and destroys resources every frame keeps its heaps.
+        constexpr uint32_t kIdleTicksBeforeReleasingUnusedHeaps = 60;
+
+        // Returns the options of |memoryType|, with the overrides for this memory type applied and
+        // the default maximum size for sub-allocation.
+        MemoryTypeAllocatorOptions GetMemoryTypeOptions(const MemoryAllocatorOptions& options,
+                                                        uint32_t memoryType) {
+            MemoryTypeAllocatorOptions typeOptions;
+            typeOptions.memoryTypeIndex = memoryType;
+            typeOptions.maxSizeForSubAllocation = options.maxSizeForSubAllocation;
+            typeOptions.heapSize = options.heapSize;
+            typeOptions.maxSizeForLargeSubAllocation = options.maxSizeForLargeSubAllocation;
+            typeOptions.largeHeapSize = options.largeHeapSize;
+
+            for (const MemoryTypeAllocatorOptions& override : options.perMemoryType) {
+                if (override.memoryTypeIndex != memoryType) {
+                    continue;
+                }
+                if (override.maxSizeForSubAllocation != 0) {
+                    typeOptions.maxSizeForSubAllocation = override.maxSizeForSubAllocation;
+                }
+                if (override.heapSize != 0) {
+                    typeOptions.heapSize = override.heapSize;
+                }
+                if (override.maxSizeForLargeSubAllocation != 0) {
+                    typeOptions.maxSizeForLargeSubAllocation =
+                        override.maxSizeForLargeSubAllocation;
+                }
+                if (override.largeHeapSize != 0) {
+                    typeOptions.largeHeapSize = override.largeHeapSize;
+                }
+            }
+
+            if (typeOptions.maxSizeForSubAllocation == 0) {
+                typeOptions.maxSizeForSubAllocation = kDefaultMaxSizeForSubAllocation;
+            }
+            return typeOptions;
+        }
 
         // Have each bucket of the buddy system allocate at least some resource of the maximum
         // size
-        constexpr uint64_t kBuddyHeapsSize = 2 * kMaxSizeForSubAllocation;
+        uint64_t ComputeBuddyHeapsSize(const MemoryTypeAllocatorOptions& options) {
+            if (options.heapSize != 0) {
+                return uint64_t(1) << Log2(options.heapSize);
+            }
+            return uint64_t(1) << Log2Ceil(2 * options.maxSizeForSubAllocation);
+        }
+
+        uint64_t ComputeLargeHeapsSize(const MemoryTypeAllocatorOptions& options) {
+            if (options.largeHeapSize != 0) {
+                return options.largeHeapSize;
+            }
+            return 2 * options.maxSizeForLargeSubAllocation;
+        }
 
     }  // anonymous namespace
 
     // SingleTypeAllocator is a combination of a BuddyMemoryAllocator and its client and can
-    // service suballocation requests, but for a single Vulkan memory type.
+    // service suballocation requests, but for a single Vulkan memory type. It optionally
+    // contains a SegregatedFitMemoryAllocator for resources too large for the buddy system. The
+    // sizes of both come from the options of its memory type.
 
     class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocator {
       public:
-        SingleTypeAllocator(Device* device, size_t memoryTypeIndex, VkDeviceSize memoryHeapSize)
+        SingleTypeAllocator(Device* device,
+                            ResourceMemoryAllocator* allocator,
+                            size_t memoryTypeIndex,
+                            VkDeviceSize memoryHeapSize,
+                            const MemoryTypeAllocatorOptions& options)
             : mDevice(device),
+              mAllocator(allocator),
               mMemoryTypeIndex(memoryTypeIndex),
               mMemoryHeapSize(memoryHeapSize),
+              mMaxSizeForSubAllocation(options.maxSizeForSubAllocation),
+              mMaxSizeForLargeSubAllocation(options.maxSizeForLargeSubAllocation),
               mPooledMemoryAllocator(this),
               mBuddySystem(
                   // Round down to a power of 2 that's <= mMemoryHeapSize. This will always
-                  // be a multiple of kBuddyHeapsSize because kBuddyHeapsSize is a power of 2.
+                  // be a multiple of the buddy heaps size because it is a power of 2.
                   uint64_t(1) << Log2(mMemoryHeapSize),
                   // Take the min in the very unlikely case the memory heap is tiny.
-                  std::min(uint64_t(1) << Log2(mMemoryHeapSize), kBuddyHeapsSize),
+                  std::min(uint64_t(1) << Log2(mMemoryHeapSize), ComputeBuddyHeapsSize(options)),
                   &mPooledMemoryAllocator) {
-            ASSERT(IsPowerOfTwo(kBuddyHeapsSize));
+            if (options.maxSizeForLargeSubAllocation != 0) {
+                // Large heaps aren't pooled: they are released as soon as they are empty.
+                mLargeAllocator = std::make_unique<SegregatedFitMemoryAllocator>(
+                    std::min(mMemoryHeapSize, ComputeLargeHeapsSize(options)), this);
+            }
         }
         ~SingleTypeAllocator() override = default;
 
@@ -64,13 +133,61 @@ namespace dawn_native { namespace vulkan {
 
         ResultOrError<ResourceMemoryAllocation> AllocateMemory(
             const VkMemoryRequirements& requirements) {
+            if (requirements.size >= mMaxSizeForSubAllocation) {
+                return ResourceMemoryAllocation{};
+            }
             return mBuddySystem.Allocate(requirements.size, requirements.alignment);
         }
 
+        ResultOrError<ResourceMemoryAllocation> AllocateLargeMemory(
+            const VkMemoryRequirements& requirements) {
+            if (mLargeAllocator == nullptr ||
+                requirements.size >= mMaxSizeForLargeSubAllocation) {
+                return ResourceMemoryAllocation{};
+            }
+            return mLargeAllocator->Allocate(requirements.size, requirements.alignment);
+        }
+
+        const ResourceHeapBase* FindLargeHeapToEvacuate() const {
+            if (mLargeAllocator == nullptr) {
+                return nullptr;
+            }
+            return mLargeAllocator->FindHeapToEvacuate();
+        }
+
+        ResourceMemoryAllocation AllocateLargeMemoryOutsideHeap(
+            const VkMemoryRequirements& requirements,
+            const ResourceHeapBase* excludedHeap) {
+            ASSERT(mLargeAllocator != nullptr && mLargeAllocator->OwnsHeap(excludedHeap));
+            return mLargeAllocator->AllocateOutsideHeap(requirements.size, requirements.alignment,
+                                                        excludedHeap);
+        }
+
         void DeallocateMemory(const ResourceMemoryAllocation& allocation) {
+            if (mLargeAllocator != nullptr &&
+                mLargeAllocator->OwnsHeap(allocation.GetResourceHeap())) {
+                mLargeAllocator->Deallocate(allocation);
+                return;
+            }
             mBuddySystem.Deallocate(allocation);
         }
 
+        void AccumulateStats(MemoryAllocatorStats* stats) const {
+            uint64_t heapCount = mBuddySystem.GetHeapCount() + mPooledMemoryAllocator.GetPoolSize();
+            stats->heapCount += heapCount;
+            stats->heapBytes += heapCount * mBuddySystem.GetMemoryBlockSize();
+            stats->unusedHeapCount += mPooledMemoryAllocator.GetPoolSize();
+
+            if (mLargeAllocator != nullptr) {
+                stats->largeHeapCount += mLargeAllocator->GetHeapCount();
+                stats->largeHeapBytes +=
+                    mLargeAllocator->GetHeapCount() * mLargeAllocator->GetHeapSize();
+                stats->largeHeapUsedBytes += mLargeAllocator->GetUsedSize();
+                stats->largeHeapLargestFreeBlock = std::max(
+                    stats->largeHeapLargestFreeBlock, mLargeAllocator->GetLargestFreeBlockSize());
+            }
+        }
+
         // Implementation of the MemoryAllocator interface to be a client of BuddyMemoryAllocator
 
         ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(
@@ -94,31 +211,45 @@ namespace dawn_native { namespace vulkan {
                 "vkAllocateMemory"));
 
             ASSERT(allocatedMemory != VK_NULL_HANDLE);
-            return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex)};
+            mAllocator->AddHeapUsage(mMemoryTypeIndex, size);
+            return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex, size)};
         }
 
         void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
-            mDevice->GetFencedDeleter()->DeleteWhenUnused(ToBackend(allocation.get())->GetMemory());
+            ResourceHeap* heap = ToBackend(allocation.get());
+            mAllocator->RemoveHeapUsage(mMemoryTypeIndex, heap->GetSize());
+            mDevice->GetFencedDeleter()->DeleteWhenUnused(heap->GetMemory());
         }
 
       private:
         Device* mDevice;
+        ResourceMemoryAllocator* mAllocator;
         size_t mMemoryTypeIndex;
         VkDeviceSize mMemoryHeapSize;
+        uint64_t mMaxSizeForSubAllocation;
+        uint64_t mMaxSizeForLargeSubAllocation;
         PooledResourceMemoryAllocator mPooledMemoryAllocator;
         BuddyMemoryAllocator mBuddySystem;
+        std::unique_ptr<SegregatedFitMemoryAllocator> mLargeAllocator;
     };
 
     // Implementation of ResourceMemoryAllocator
 
-    ResourceMemoryAllocator::ResourceMemoryAllocator(Device* device) : mDevice(device) {
+    ResourceMemoryAllocator::ResourceMemoryAllocator(Device* device,
+                                                     const MemoryAllocatorOptions& options)
+        : mDevice(device),
+          mReleaseUnusedHeapsWhenIdle(options.releaseUnusedHeapsWhenIdle) {
         const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
         mAllocatorsPerType.reserve(info.memoryTypes.size());
 
         for (size_t i = 0; i < info.memoryTypes.size(); i++) {
             mAllocatorsPerType.emplace_back(std::make_unique<SingleTypeAllocator>(
-                mDevice, i, info.memoryHeaps[info.memoryTypes[i].heapIndex].size));
+                mDevice, this, i, info.memoryHeaps[info.memoryTypes[i].heapIndex].size,
+                GetMemoryTypeOptions(options, static_cast<uint32_t>(i))));
         }
+
+        mHeapBudgets.resize(info.memoryHeaps.size());
+        UpdateHeapBudgets();
     }
 
     ResourceMemoryAllocator::~ResourceMemoryAllocator() = default;
@@ -126,22 +257,90 @@ namespace dawn_native { namespace vulkan {
     ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::Allocate(
         const VkMemoryRequirements& requirements,
         bool mappable) {
+        mIdleTicksWithoutMemoryActivity = 0;
+
         // The Vulkan spec guarantees at least on memory type is valid.
         int memoryType = FindBestTypeIndex(requirements, mappable);
         ASSERT(memoryType >= 0);
 
+        // When the allocation doesn't fit in the budget of the heap, first release the unused
+        // heaps kept for reuse, then fall back to a memory type in another heap (for example
+        // host-visible memory instead of device-local memory) that still has budget left. If
+        // there is none, try anyway and let the driver decide.
+        uint32_t heapBit = 1u << GetHeapIndex(memoryType);
+        if ((GetHeapsOverBudget(requirements.size) & heapBit) != 0) {
+            DestroyPool();
+            mPoolReleasesForBudget++;
+        }
+        uint32_t heapsOverBudget = GetHeapsOverBudget(requirements.size);
+        if ((heapsOverBudget & heapBit) != 0) {
+            int fallbackType = FindBestTypeIndexInHeaps(requirements, mappable, heapsOverBudget);
+            if (fallbackType >= 0) {
+                memoryType = fallbackType;
+                mFallbackAllocationsForBudget++;
+            }
+        }
+
+        ResultOrError<ResourceMemoryAllocation> result =
+            AllocateWithType(requirements, mappable, memoryType);
+        if (!result.IsError()) {
+            return result;
+        }
+
+        // The budget is only an estimate, so the driver can still run out of memory. Handle it
+        // the same way, except that all other heaps are candidates for the fallback.
+        std::unique_ptr<ErrorData> error = result.AcquireError();
+        if (error->GetType() != InternalErrorType::OutOfMemory) {
+            return std::move(error);
+        }
+
+        DestroyPool();
+        mPoolReleasesForBudget++;
+        UpdateHeapBudgets();
+        result = AllocateWithType(requirements, mappable, memoryType);
+        if (!result.IsError()) {
+            return result;
+        }
+
+        error = result.AcquireError();
+        if (error->GetType() != InternalErrorType::OutOfMemory) {
+            return std::move(error);
+        }
+
+        int fallbackType =
+            FindBestTypeIndexInHeaps(requirements, mappable, 1u << GetHeapIndex(memoryType));
+        if (fallbackType < 0) {
+            return std::move(error);
+        }
+        mFallbackAllocationsForBudget++;
+        return AllocateWithType(requirements, mappable, fallbackType);
+    }
+
+    ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::AllocateWithType(
+        const VkMemoryRequirements& requirements,
+        bool mappable,
+        int memoryType) {
         VkDeviceSize size = requirements.size;
 
         // Sub-allocate non-mappable resources because at the moment the mapped pointer
         // is part of the resource and not the heap, which doesn't match the Vulkan model.
         // TODO(cwallez@chromium.org): allow sub-allocating mappable resources, maybe.
-        if (requirements.size < kMaxSizeForSubAllocation && !mappable) {
+        if (!mappable) {
             ResourceMemoryAllocation subAllocation;
             DAWN_TRY_ASSIGN(subAllocation,
                             mAllocatorsPerType[memoryType]->AllocateMemory(requirements));
             if (subAllocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
                 return std::move(subAllocation);
             }
+
+            // Resources too large for the buddy system are sub-allocated at their exact size to
+            // avoid wasting up to half of their memory, and to avoid a vkAllocateMemory per
+            // resource.
+            DAWN_TRY_ASSIGN(subAllocation,
+                            mAllocatorsPerType[memoryType]->AllocateLargeMemory(requirements));
+            if (subAllocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
+                return std::move(subAllocation);
+            }
         }
 
         // If sub-allocation failed, allocate memory just for it.
@@ -160,6 +359,9 @@ namespace dawn_native { namespace vulkan {
                 });
         }
 
+        mDirectAllocationCount++;
+        mDirectAllocationBytes += size;
+
         AllocationInfo info;
         info.mMethod = AllocationMethod::kDirect;
         return ResourceMemoryAllocation(info, /*offset*/ 0, resourceHeap.release(),
@@ -167,6 +369,8 @@ namespace dawn_native { namespace vulkan {
     }
 
     void ResourceMemoryAllocator::Deallocate(ResourceMemoryAllocation* allocation) {
+        mIdleTicksWithoutMemoryActivity = 0;
+
         switch (allocation->GetInfo().mMethod) {
             // Some memory allocation can never be initialized, for example when wrapping
             // swapchain VkImages with a Texture.
@@ -177,6 +381,10 @@ namespace dawn_native { namespace vulkan {
             // deleter will make sure the resources are freed before the memory.
             case AllocationMethod::kDirect: {
                 ResourceHeap* heap = ToBackend(allocation->GetResourceHeap());
+                ASSERT(mDirectAllocationCount > 0);
+                mDirectAllocationCount--;
+                mDirectAllocationBytes -= heap->GetSize();
+                RemoveHeapUsage(heap->GetMemoryType(), heap->GetSize());
                 allocation->Invalidate();
                 mDevice->GetFencedDeleter()->DeleteWhenUnused(heap->GetMemory());
                 delete heap;
@@ -211,10 +419,31 @@ namespace dawn_native { namespace vulkan {
         }
 
         mSubAllocationsToDelete.ClearUpTo(completedSerial);
+
+        // The heaps kept for reuse are only useful if resources get created again soon, release
+        // them once the device has been idle for a while if the application asked for it.
+        bool isIdle = mSubAllocationsToDelete.Empty() &&
+                      completedSerial == mDevice->GetLastSubmittedCommandSerial();
+        if (!isIdle) {
+            mIdleTicksWithoutMemoryActivity = 0;
+        } else if (++mIdleTicksWithoutMemoryActivity == kIdleTicksBeforeReleasingUnusedHeaps &&
+                   mReleaseUnusedHeapsWhenIdle) {
+            DestroyPool();
+        }
+
+        // VK_EXT_memory_budget values only change on some events like queue submissions, so
+        // refresh them once per tick.
+        UpdateHeapBudgets();
     }
 
     int ResourceMemoryAllocator::FindBestTypeIndex(VkMemoryRequirements requirements,
                                                    bool mappable) {
+        return FindBestTypeIndexInHeaps(requirements, mappable, 0);
+    }
+
+    int ResourceMemoryAllocator::FindBestTypeIndexInHeaps(VkMemoryRequirements requirements,
+                                                          bool mappable,
+                                                          uint32_t skippedHeaps) {
         const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
 
         // Find a suitable memory type for this allocation
@@ -225,6 +454,10 @@ namespace dawn_native { namespace vulkan {
                 continue;
             }
 
+            if ((skippedHeaps & (1u << info.memoryTypes[i].heapIndex)) != 0) {
+                continue;
+            }
+
             // Mappable resource must be host visible
             if (mappable &&
                 (info.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0) {
@@ -267,10 +500,128 @@ namespace dawn_native { namespace vulkan {
         return bestType;
     }
 
+    const ResourceHeapBase* ResourceMemoryAllocator::FindHeapToEvacuate() const {
+        for (const auto& alloc : mAllocatorsPerType) {
+            const ResourceHeapBase* heap = alloc->FindLargeHeapToEvacuate();
+            if (heap != nullptr) {
+                return heap;
+            }
+        }
+        return nullptr;
+    }
+
+    ResourceMemoryAllocation ResourceMemoryAllocator::AllocateOutsideHeap(
+        const VkMemoryRequirements& requirements,
+        const ResourceHeapBase* excludedHeap) {
+        mIdleTicksWithoutMemoryActivity = 0;
+
+        size_t memoryType = ToBackend(excludedHeap)->GetMemoryType();
+        if ((requirements.memoryTypeBits & (1u << memoryType)) == 0) {
+            return ResourceMemoryAllocation{};
+        }
+
+        ResourceMemoryAllocation allocation =
+            mAllocatorsPerType[memoryType]->AllocateLargeMemoryOutsideHeap(requirements,
+                                                                           excludedHeap);
+        if (allocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
+            mRelocationCount++;
+            mRelocatedBytes += requirements.size;
+        }
+        return allocation;
+    }
+
+    uint32_t ResourceMemoryAllocator::GetIdleTicksWithoutMemoryActivity() const {
+        return mIdleTicksWithoutMemoryActivity;
+    }
+
     void ResourceMemoryAllocator::DestroyPool() {
         for (auto& alloc : mAllocatorsPerType) {
             alloc->DestroyPool();
         }
     }
 
+    MemoryAllocatorStats ResourceMemoryAllocator::GetStats() const {
+        MemoryAllocatorStats stats;
+        for (const auto& alloc : mAllocatorsPerType) {
+            alloc->AccumulateStats(&stats);
+        }
+        stats.directAllocationCount = mDirectAllocationCount;
+        stats.directAllocationBytes = mDirectAllocationBytes;
+        stats.poolReleasesForBudget = mPoolReleasesForBudget;
+        stats.fallbackAllocationsForBudget = mFallbackAllocationsForBudget;
+        stats.relocationCount = mRelocationCount;
+        stats.relocatedBytes = mRelocatedBytes;
+        return stats;
+    }
+
+    std::vector<MemoryHeapBudget> ResourceMemoryAllocator::GetHeapBudgets() const {
+        const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
+
+        std::vector<MemoryHeapBudget> budgets(mHeapBudgets.size());
+        for (size_t i = 0; i < mHeapBudgets.size(); i++) {
+            budgets[i].size = info.memoryHeaps[i].size;
+            budgets[i].budget = mHeapBudgets[i].budget;
+            budgets[i].usage = mHeapBudgets[i].allocatorUsage + mHeapBudgets[i].externalUsage;
+            budgets[i].allocatorUsage = mHeapBudgets[i].allocatorUsage;
+            budgets[i].isDeviceLocal =
+                (info.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+        }
+        return budgets;
+    }
+
+    uint32_t ResourceMemoryAllocator::GetHeapsOverBudget(VkDeviceSize size) const {
+        uint32_t heapsOverBudget = 0;
+        for (size_t i = 0; i < mHeapBudgets.size(); i++) {
+            const HeapBudget& heap = mHeapBudgets[i];
+            if (heap.allocatorUsage + heap.externalUsage + size > heap.budget) {
+                heapsOverBudget |= 1u << i;
+            }
+        }
+        return heapsOverBudget;
+    }
+
+    uint32_t ResourceMemoryAllocator::GetHeapIndex(int memoryType) const {
+        return mDevice->GetDeviceInfo().memoryTypes[memoryType].heapIndex;
+    }
+
+    void ResourceMemoryAllocator::AddHeapUsage(size_t memoryType, uint64_t size) {
+        mHeapBudgets[GetHeapIndex(memoryType)].allocatorUsage += size;
+    }
+
+    void ResourceMemoryAllocator::RemoveHeapUsage(size_t memoryType, uint64_t size) {
+        HeapBudget& heap = mHeapBudgets[GetHeapIndex(memoryType)];
+        ASSERT(heap.allocatorUsage >= size);
+        heap.allocatorUsage -= size;
+    }
+
+    void ResourceMemoryAllocator::UpdateHeapBudgets() {
+        const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
+
+        // Without VK_EXT_memory_budget, assume that this allocator is the only user of the
+        // memory heaps and that all of their memory can be used.
+        if (!info.HasExt(DeviceExt::MemoryBudget)) {
+            for (size_t i = 0; i < mHeapBudgets.size(); i++) {
+                mHeapBudgets[i].budget = info.memoryHeaps[i].size;
+            }
+            return;
+        }
+
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties = {};
+        VkPhysicalDeviceMemoryProperties2 properties2 = {};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        PNextChainBuilder propertiesChain(&properties2);
+        propertiesChain.Add(&budgetProperties,
+                            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT);
+
+        mDevice->fn.GetPhysicalDeviceMemoryProperties2(
+            ToBackend(mDevice->GetAdapter())->GetPhysicalDevice(), &properties2);
+
+        for (size_t i = 0; i < mHeapBudgets.size(); i++) {
+            HeapBudget& heap = mHeapBudgets[i];
+            uint64_t usage = budgetProperties.heapUsage[i];
+            heap.externalUsage = usage > heap.allocatorUsage ? usage - heap.allocatorUsage : 0;
+            heap.budget = budgetProperties.heapBudget[i];
+        }
+    }
+
 }}  // namespace dawn_native::vulkan
@@ -17,10 +17,12 @@
 
 #include "common/SerialQueue.h"
 #include "common/vulkan_platform.h"
+#include "dawn_native/DawnNative.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/IntegerTypes.h"
 #include "dawn_native/PooledResourceMemoryAllocator.h"
 #include "dawn_native/ResourceMemoryAllocation.h"
+#include "dawn_native/VulkanBackend.h"
 
 #include <memory>
 #include <vector>
@@ -31,7 +33,7 @@ namespace dawn_native { namespace vulkan {
 
     class ResourceMemoryAllocator {
       public:
-        ResourceMemoryAllocator(Device* device);
+        ResourceMemoryAllocator(Device* device, const MemoryAllocatorOptions& options);
         ~ResourceMemoryAllocator();
 
         ResultOrError<ResourceMemoryAllocation> Allocate(const VkMemoryRequirements& requirements,
@@ -44,9 +46,65 @@ namespace dawn_native { namespace vulkan {
 
         int FindBestTypeIndex(VkMemoryRequirements requirements, bool mappable);
 
+        // Compaction of the heaps for large resources, see BufferDefragmenter. FindHeapToEvacuate
+        // returns a sparse heap whose allocations fit in the other heaps of its memory type, or
+        // nullptr. AllocateOutsideHeap allocates memory of the type of |excludedHeap| in one of
+        // the other heaps, or returns an invalid allocation when there is no room.
+        const ResourceHeapBase* FindHeapToEvacuate() const;
+        ResourceMemoryAllocation AllocateOutsideHeap(const VkMemoryRequirements& requirements,
+                                                     const ResourceHeapBase* excludedHeap);
+
+        // The number of consecutive ticks where the GPU was idle and no memory was allocated or
+        // freed.
+        uint32_t GetIdleTicksWithoutMemoryActivity() const;
+
+        MemoryAllocatorStats GetStats() const;
+        std::vector<MemoryHeapBudget> GetHeapBudgets() const;
+
       private:
+        ResultOrError<ResourceMemoryAllocation> AllocateWithType(
+            const VkMemoryRequirements& requirements,
+            bool mappable,
+            int memoryType);
+
+        // Returns the best memory type that isn't in one of the heaps of |skippedHeaps|, a
+        // bitmask of heap indices, or -1.
+        int FindBestTypeIndexInHeaps(VkMemoryRequirements requirements,
+                                     bool mappable,
+                                     uint32_t skippedHeaps);
+
+        // Returns a bitmask of the heaps that can't fit |size| more bytes in their budget.
+        uint32_t GetHeapsOverBudget(VkDeviceSize size) const;
+        uint32_t GetHeapIndex(int memoryType) const;
+
+        void AddHeapUsage(size_t memoryType, uint64_t size);
+        void RemoveHeapUsage(size_t memoryType, uint64_t size);
+        void UpdateHeapBudgets();
+
         Device* mDevice;
 
+        bool mReleaseUnusedHeapsWhenIdle;
+        uint32_t mIdleTicksWithoutMemoryActivity = 0;
+
+        uint64_t mDirectAllocationCount = 0;
+        uint64_t mDirectAllocationBytes = 0;
+
+        uint64_t mPoolReleasesForBudget = 0;
+        uint64_t mFallbackAllocationsForBudget = 0;
+
+        uint64_t mRelocationCount = 0;
+        uint64_t mRelocatedBytes = 0;
+
+        // The usage of each memory heap is the memory allocated by this allocator, plus the
+        // memory allocated outside of it as reported by VK_EXT_memory_budget when it was last
+        // queried.
+        struct HeapBudget {
+            uint64_t allocatorUsage = 0;
+            uint64_t externalUsage = 0;
+            uint64_t budget = 0;
+        };
+        std::vector<HeapBudget> mHeapBudgets;
+
         class SingleTypeAllocator;
         std::vector<std::unique_ptr<SingleTypeAllocator>> mAllocatorsPerType;
 
@@ -19,6 +19,7 @@
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
+#include "dawn_native/vulkan/SpirvPushConstants.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
 #include <spirv_cross.hpp>
@@ -45,45 +46,20 @@ namespace dawn_native { namespace vulkan {
     }
 
     MaybeError ShaderModule::Initialize(ShaderModuleParseResult* parseResult) {
-        std::vector<uint32_t> spirv;
-        const std::vector<uint32_t>* spirvPtr;
-
-        ScopedTintICEHandler scopedICEHandler(GetDevice());
+        DAWN_TRY(InitializeBase(parseResult));
 
+        // With the Tint generator, the program is only transformed and converted to SPIR-V in
+        // GetTransformedModuleHandle, for the entry points that pipelines use.
         if (GetDevice()->IsToggleEnabled(Toggle::UseTintGenerator)) {
-            std::ostringstream errorStream;
-            errorStream << "Tint SPIR-V writer failure:" << std::endl;
-
-            tint::transform::Manager transformManager;
-            transformManager.Add<tint::transform::BoundArrayAccessors>();
-            transformManager.Add<tint::transform::EmitVertexPointSize>();
-            transformManager.Add<tint::transform::Spirv>();
-
-            tint::transform::DataMap transformInputs;
-
-            tint::Program program;
-            DAWN_TRY_ASSIGN(program,
-                            RunTransforms(&transformManager, parseResult->tintProgram.get(),
-                                          transformInputs, nullptr, GetCompilationMessages()));
-
-            tint::writer::spirv::Generator generator(&program);
-            if (!generator.Generate()) {
-                errorStream << "Generator: " << generator.error() << std::endl;
-                return DAWN_VALIDATION_ERROR(errorStream.str().c_str());
-            }
+            return {};
+        }
 
-            spirv = generator.result();
+        std::vector<uint32_t> spirv;
+        const std::vector<uint32_t>* spirvPtr = &GetSpirv();
+        if (GetDevice()->IsExtensionEnabled(Extension::ImmediateData)) {
+            spirv = GetSpirv();
+            ConvertImmediateDataToPushConstants(&spirv);
             spirvPtr = &spirv;
-
-            ShaderModuleParseResult transformedParseResult;
-            transformedParseResult.tintProgram =
-                std::make_unique<tint::Program>(std::move(program));
-            transformedParseResult.spirv = spirv;
-
-            DAWN_TRY(InitializeBase(&transformedParseResult));
-        } else {
-            DAWN_TRY(InitializeBase(parseResult));
-            spirvPtr = &GetSpirv();
         }
 
         VkShaderModuleCreateInfo createInfo;
@@ -162,16 +138,18 @@ namespace dawn_native { namespace vulkan {
             }
         }
 
-        tint::transform::Manager transformManager;
-        transformManager.append(std::make_unique<tint::transform::BindingRemapper>());
-
+        // Only the binding remapping depends on the layout.
+        BindingRemapper transform;
         tint::transform::DataMap transformInputs;
         transformInputs.Add<BindingRemapper::Remappings>(std::move(bindingPoints),
                                                          std::move(accessControls));
 
+        std::shared_ptr<const tint::Program> transformedProgram;
+        DAWN_TRY_ASSIGN(transformedProgram, AcquireTransformedProgram());
+
         tint::Program program;
-        DAWN_TRY_ASSIGN(program, RunTransforms(&transformManager, GetTintProgram(), transformInputs,
-                                               nullptr, nullptr));
+        DAWN_TRY_ASSIGN(program, RunTransforms(&transform, transformedProgram.get(),
+                                               transformInputs, nullptr, nullptr));
 
         tint::writer::spirv::Generator generator(&program);
         if (!generator.Generate()) {
@@ -180,6 +158,9 @@ namespace dawn_native { namespace vulkan {
         }
 
         std::vector<uint32_t> spirv = generator.result();
+        if (GetDevice()->IsExtensionEnabled(Extension::ImmediateData)) {
+            ConvertImmediateDataToPushConstants(&spirv);
+        }
 
         // Don't save the transformedParseResult but just create a VkShaderModule
         VkShaderModuleCreateInfo createInfo;
@@ -204,4 +185,34 @@ namespace dawn_native { namespace vulkan {
         return newHandle;
     }
 
+    ResultOrError<std::shared_ptr<const tint::Program>> ShaderModule::AcquireTransformedProgram() {
+        std::shared_ptr<const tint::Program> program = mTransformedProgram;
+        if (program == nullptr) {
+            program = mReleasedTransformedProgram.lock();
+        }
+        if (program != nullptr) {
+            return std::move(program);
+        }
+
+        std::shared_ptr<const tint::Program> tintProgram;
+        DAWN_TRY_ASSIGN(tintProgram, AcquireTintProgram());
+
+        tint::transform::Manager transformManager;
+        transformManager.Add<tint::transform::BoundArrayAccessors>();
+        transformManager.Add<tint::transform::EmitVertexPointSize>();
+        transformManager.Add<tint::transform::Spirv>();
+
+        tint::Program transformed;
+        DAWN_TRY_ASSIGN(transformed, RunTransforms(&transformManager, tintProgram.get(),
+                                                   tint::transform::DataMap(), nullptr, nullptr));
+        program = std::make_shared<const tint::Program>(std::move(transformed));
+
+        if (GetDevice()->IsToggleEnabled(Toggle::ReleaseShaderModulePrograms)) {
+            mReleasedTransformedProgram = program;
+        } else {
+            mTransformedProgram = program;
+        }
+        return std::move(program);
+    }
+
 }}  // namespace dawn_native::vulkan
@@ -20,6 +20,8 @@
 #include "common/vulkan_platform.h"
 #include "dawn_native/Error.h"
 
+#include <memory>
+
 namespace dawn_native { namespace vulkan {
 
     class Device;
@@ -46,8 +48,17 @@ namespace dawn_native { namespace vulkan {
         ~ShaderModule() override;
         MaybeError Initialize(ShaderModuleParseResult* parseResult);
 
+        // Returns the program with the transforms that don't depend on the pipeline layout, which
+        // is computed once and shared by the entry points and layouts of the module. It follows
+        // the lifetime of the Tint program of the module with the ReleaseShaderModulePrograms
+        // toggle.
+        ResultOrError<std::shared_ptr<const tint::Program>> AcquireTransformedProgram();
+
         VkShaderModule mHandle = VK_NULL_HANDLE;
 
+        std::shared_ptr<const tint::Program> mTransformedProgram;
+        std::weak_ptr<const tint::Program> mReleasedTransformedProgram;
+
         // New handles created by GetTransformedModuleHandle at pipeline creation time
         TransformedShaderModuleCache mTransformedShaderModuleCache;
     };
@@ -0,0 +1,160 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/SpirvPushConstants.h"
+
+#include "common/Constants.h"
+
+#include <spirv.hpp>
+
+#include <cstddef>
+#include <map>
+#include <set>
+
+namespace dawn_native { namespace vulkan {
+
+    void ConvertImmediateDataToPushConstants(std::vector<uint32_t>* spirv) {
+        constexpr size_t kHeaderSize = 5;
+        constexpr size_t kBoundIndex = 3;
+        std::vector<uint32_t>& words = *spirv;
+
+        auto WordCount = [&](size_t i) -> uint32_t { return words[i] >> spv::WordCountShift; };
+        auto Opcode = [&](size_t i) -> spv::Op {
+            return static_cast<spv::Op>(words[i] & spv::OpCodeMask);
+        };
+
+        // Find the variable from its decorations.
+        std::map<uint32_t, uint32_t> descriptorSets;
+        std::map<uint32_t, uint32_t> bindings;
+        for (size_t i = kHeaderSize; i < words.size(); i += WordCount(i)) {
+            if (Opcode(i) == spv::OpDecorate && WordCount(i) == 4) {
+                if (words[i + 2] == spv::DecorationDescriptorSet) {
+                    descriptorSets[words[i + 1]] = words[i + 3];
+                } else if (words[i + 2] == spv::DecorationBinding) {
+                    bindings[words[i + 1]] = words[i + 3];
+                }
+            }
+        }
+        uint32_t variable = 0;
+        for (const auto& it : descriptorSets) {
+            auto binding = bindings.find(it.first);
+            if (it.second == kImmediateDataBindGroup && binding != bindings.end() &&
+                binding->second == 0) {
+                variable = it.first;
+                break;
+            }
+        }
+        if (variable == 0) {
+            return;
+        }
+
+        // Find the ids of the pointers derived from the variable. The pointers are only
+        // derived with access chains and copies in the SPIR-V of WGSL shaders.
+        std::set<uint32_t> derivedPointers = {variable};
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (size_t i = kHeaderSize; i < words.size(); i += WordCount(i)) {
+                switch (Opcode(i)) {
+                    case spv::OpAccessChain:
+                    case spv::OpInBoundsAccessChain:
+                    case spv::OpPtrAccessChain:
+                    case spv::OpCopyObject:
+                        if (derivedPointers.count(words[i + 3]) != 0 &&
+                            derivedPointers.insert(words[i + 2]).second) {
+                            changed = true;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        // Record the uniform pointer types, and the push constant ones to reuse them.
+        std::map<uint32_t, uint32_t> uniformPointerPointees;
+        std::map<uint32_t, uint32_t> pushConstantPointerTypes;
+        for (size_t i = kHeaderSize; i < words.size(); i += WordCount(i)) {
+            if (Opcode(i) == spv::OpTypePointer) {
+                if (words[i + 2] == spv::StorageClassUniform) {
+                    uniformPointerPointees[words[i + 1]] = words[i + 3];
+                } else if (words[i + 2] == spv::StorageClassPushConstant) {
+                    pushConstantPointerTypes[words[i + 3]] = words[i + 1];
+                }
+            }
+        }
+
+        // Rewrite the module, retyping the derived pointers and declaring the new pointer
+        // types after the uniform pointer types they replace.
+        std::map<uint32_t, uint32_t> retypedPointers;
+        auto GetPushConstantPointer = [&](uint32_t uniformPointer) -> uint32_t {
+            auto it = retypedPointers.find(uniformPointer);
+            if (it != retypedPointers.end()) {
+                return it->second;
+            }
+            uint32_t pointee = uniformPointerPointees.at(uniformPointer);
+            auto existing = pushConstantPointerTypes.find(pointee);
+            uint32_t pointer = existing != pushConstantPointerTypes.end()
+                                   ? existing->second
+                                   : words[kBoundIndex]++;
+            retypedPointers[uniformPointer] = pointer;
+            return pointer;
+        };
+        for (size_t i = kHeaderSize; i < words.size(); i += WordCount(i)) {
+            switch (Opcode(i)) {
+                case spv::OpAccessChain:
+                case spv::OpInBoundsAccessChain:
+                case spv::OpPtrAccessChain:
+                case spv::OpCopyObject:
+                    if (derivedPointers.count(words[i + 2]) != 0 &&
+                        uniformPointerPointees.count(words[i + 1]) != 0) {
+                        words[i + 1] = GetPushConstantPointer(words[i + 1]);
+                    }
+                    break;
+                case spv::OpVariable:
+                    if (words[i + 2] == variable) {
+                        words[i + 1] = GetPushConstantPointer(words[i + 1]);
+                        words[i + 3] = spv::StorageClassPushConstant;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        std::vector<uint32_t> result(words.begin(), words.begin() + kHeaderSize);
+        result.reserve(words.size() + 4 * retypedPointers.size());
+        for (size_t i = kHeaderSize; i < words.size(); i += WordCount(i)) {
+            if (Opcode(i) == spv::OpDecorate && words[i + 1] == variable &&
+                (words[i + 2] == spv::DecorationDescriptorSet ||
+                 words[i + 2] == spv::DecorationBinding)) {
+                continue;
+            }
+            result.insert(result.end(), words.begin() + i, words.begin() + i + WordCount(i));
+
+            if (Opcode(i) == spv::OpTypePointer) {
+                auto it = retypedPointers.find(words[i + 1]);
+                if (it != retypedPointers.end() &&
+                    pushConstantPointerTypes.count(words[i + 3]) == 0) {
+                    result.push_back((4 << spv::WordCountShift) | spv::OpTypePointer);
+                    result.push_back(it->second);
+                    result.push_back(spv::StorageClassPushConstant);
+                    result.push_back(words[i + 3]);
+                }
+            }
+        }
+        *spirv = std::move(result);
+    }
+
+}}  // namespace dawn_native::vulkan
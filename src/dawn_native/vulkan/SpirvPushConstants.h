@@ -0,0 +1,37 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_SPIRVPUSHCONSTANTS_H_
+#define DAWNNATIVE_VULKAN_SPIRVPUSHCONSTANTS_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    // Turns the uniform buffer that the shaders declare at
+    // [[group(kImmediateDataBindGroup), binding(0)]] into the push constant block of the
+    // immediate data. The variable and the pointers derived from it get the PushConstant storage
+    // class, using new pointer types so that the other uniform buffers are unchanged, and the
+    // variable loses its descriptor set and binding decorations. Modules without immediate data
+    // are left unchanged.
+    //
+    // This is a SPIR-V rewrite rather than a Tint transform because Tint doesn't have a push
+    // constant storage class yet, and because shader modules created without the
+    // use_tint_generator toggle don't go through Tint transforms on Vulkan.
+    void ConvertImmediateDataToPushConstants(std::vector<uint32_t>* spirv);
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_SPIRVPUSHCONSTANTS_H_
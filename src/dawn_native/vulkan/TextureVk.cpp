@@ -25,6 +25,7 @@
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/FramebufferCache.h"
 #include "dawn_native/vulkan/ResourceHeapVk.h"
 #include "dawn_native/vulkan/StagingBufferVk.h"
 #include "dawn_native/vulkan/UtilsVulkan.h"
@@ -721,6 +722,14 @@ namespace dawn_native { namespace vulkan {
     }
 
     void Texture::DestroyImpl() {
+        // Framebuffers must not outlive the VkImage of their attachments.
+        if ((GetUsage() & wgpu::TextureUsage::RenderAttachment) != 0) {
+            FramebufferCache* framebufferCache = ToBackend(GetDevice())->GetFramebufferCache();
+            if (framebufferCache != nullptr) {
+                framebufferCache->OnTextureDestroyed(this);
+            }
+        }
+
         if (GetTextureState() == TextureState::OwnedInternal) {
             Device* device = ToBackend(GetDevice());
 
@@ -1205,6 +1214,11 @@ namespace dawn_native { namespace vulkan {
     TextureView::~TextureView() {
         Device* device = ToBackend(GetTexture()->GetDevice());
 
+        // The cache is destroyed with the VkDevice, after which the framebuffers are gone anyway.
+        if (device->GetFramebufferCache() != nullptr) {
+            device->GetFramebufferCache()->OnTextureViewDestroyed(this);
+        }
+
         if (mHandle != VK_NULL_HANDLE) {
             device->GetFencedDeleter()->DeleteWhenUnused(mHandle);
             mHandle = VK_NULL_HANDLE;
@@ -23,7 +23,9 @@
 
 #include "common/SwapChainUtils.h"
 #include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/FramebufferCache.h"
 #include "dawn_native/vulkan/NativeSwapChainImplVk.h"
+#include "dawn_native/vulkan/ResourceMemoryAllocatorVk.h"
 #include "dawn_native/vulkan/TextureVk.h"
 
 namespace dawn_native { namespace vulkan {
@@ -33,6 +35,21 @@ namespace dawn_native { namespace vulkan {
         return backendDevice->GetVkInstance();
     }
 
+    MemoryAllocatorStats GetMemoryAllocatorStats(WGPUDevice device) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+        return backendDevice->GetResourceMemoryAllocator()->GetStats();
+    }
+
+    std::vector<MemoryHeapBudget> GetMemoryHeapBudgets(WGPUDevice device) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+        return backendDevice->GetResourceMemoryAllocator()->GetHeapBudgets();
+    }
+
+    ObjectCacheStats GetFramebufferCacheStats(WGPUDevice device) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+        return backendDevice->GetFramebufferCache()->GetStats();
+    }
+
     DAWN_NATIVE_EXPORT PFN_vkVoidFunction GetInstanceProcAddr(WGPUDevice device,
                                                               const char* pName) {
         Device* backendDevice = reinterpret_cast<Device*>(device);
@@ -158,6 +158,10 @@ namespace dawn_native { namespace vulkan {
         {DeviceExt::ImageDrmFormatModifier, "VK_EXT_image_drm_format_modifier", NeverPromoted},
         {DeviceExt::Swapchain, "VK_KHR_swapchain", NeverPromoted},
         {DeviceExt::SubgroupSizeControl, "VK_EXT_subgroup_size_control", NeverPromoted},
+        {DeviceExt::MemoryBudget, "VK_EXT_memory_budget", NeverPromoted},
+        // Promoted to 1.2 but only as an optional feature, so it is used only when the extension
+        // is advertised.
+        {DeviceExt::DrawIndirectCount, "VK_KHR_draw_indirect_count", NeverPromoted},
         //
     }};
 
@@ -200,6 +204,7 @@ namespace dawn_native { namespace vulkan {
                 case DeviceExt::Maintenance1:
                 case DeviceExt::ImageFormatList:
                 case DeviceExt::StorageBufferStorageClass:
+                case DeviceExt::DrawIndirectCount:
                     hasDependencies = true;
                     break;
 
@@ -239,6 +244,7 @@ namespace dawn_native { namespace vulkan {
 
                 case DeviceExt::DriverProperties:
                 case DeviceExt::ShaderFloat16Int8:
+                case DeviceExt::MemoryBudget:
                     hasDependencies = HasDep(DeviceExt::GetPhysicalDeviceProperties2);
                     break;
 
@@ -100,6 +100,8 @@ namespace dawn_native { namespace vulkan {
         ImageDrmFormatModifier,
         Swapchain,
         SubgroupSizeControl,
+        MemoryBudget,
+        DrawIndirectCount,
 
         EnumCount,
     };
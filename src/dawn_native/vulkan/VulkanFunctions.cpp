@@ -160,14 +160,17 @@ namespace dawn_native { namespace vulkan {
         return {};
     }
 
-#define GET_DEVICE_PROC(name)                                                           \
-    do {                                                                                \
-        name = reinterpret_cast<decltype(name)>(GetDeviceProcAddr(device, "vk" #name)); \
-        if (name == nullptr) {                                                          \
-            return DAWN_INTERNAL_ERROR(std::string("Couldn't get proc vk") + #name);    \
-        }                                                                               \
+#define GET_DEVICE_PROC_BASE(name, procName)                                                  \
+    do {                                                                                      \
+        name = reinterpret_cast<decltype(name)>(GetDeviceProcAddr(device, "vk" #procName)); \
+        if (name == nullptr) {                                                                \
+            return DAWN_INTERNAL_ERROR(std::string("Couldn't get proc vk") + #procName);      \
+        }                                                                                     \
     } while (0)
 
+#define GET_DEVICE_PROC(name) GET_DEVICE_PROC_BASE(name, name)
+#define GET_DEVICE_PROC_VENDOR(name, vendor) GET_DEVICE_PROC_BASE(name, name##vendor)
+
     MaybeError VulkanFunctions::LoadDeviceProcs(VkDevice device,
                                                 const VulkanDeviceInfo& deviceInfo) {
         GET_DEVICE_PROC(AllocateCommandBuffers);
@@ -290,6 +293,16 @@ namespace dawn_native { namespace vulkan {
         GET_DEVICE_PROC(UpdateDescriptorSets);
         GET_DEVICE_PROC(WaitForFences);
 
+        if (deviceInfo.properties.apiVersion >= VK_MAKE_VERSION(1, 1, 0)) {
+            GET_DEVICE_PROC(BindBufferMemory2);
+        } else if (deviceInfo.HasExt(DeviceExt::BindMemory2)) {
+            GET_DEVICE_PROC_VENDOR(BindBufferMemory2, KHR);
+        }
+
+        if (deviceInfo.HasExt(DeviceExt::DrawIndirectCount)) {
+            GET_DEVICE_PROC(CmdDrawIndexedIndirectCountKHR);
+        }
+
         if (deviceInfo.HasExt(DeviceExt::ExternalMemoryFD)) {
             GET_DEVICE_PROC(GetMemoryFdKHR);
             GET_DEVICE_PROC(GetMemoryFdPropertiesKHR);
@@ -267,6 +267,12 @@ namespace dawn_native { namespace vulkan {
         PFN_vkUpdateDescriptorSets UpdateDescriptorSets = nullptr;
         PFN_vkWaitForFences WaitForFences = nullptr;
 
+        // Core Vulkan 1.1 promoted extensions, set if either the core version or the extension is
+        // present.
+
+        // VK_KHR_bind_memory2
+        PFN_vkBindBufferMemory2 BindBufferMemory2 = nullptr;
+
         // VK_KHR_swapchain
         PFN_vkCreateSwapchainKHR CreateSwapchainKHR = nullptr;
         PFN_vkDestroySwapchainKHR DestroySwapchainKHR = nullptr;
@@ -274,6 +280,9 @@ namespace dawn_native { namespace vulkan {
         PFN_vkAcquireNextImageKHR AcquireNextImageKHR = nullptr;
         PFN_vkQueuePresentKHR QueuePresentKHR = nullptr;
 
+        // VK_KHR_draw_indirect_count
+        PFN_vkCmdDrawIndexedIndirectCountKHR CmdDrawIndexedIndirectCountKHR = nullptr;
+
         // VK_KHR_external_memory_fd
         PFN_vkGetMemoryFdKHR GetMemoryFdKHR = nullptr;
         PFN_vkGetMemoryFdPropertiesKHR GetMemoryFdPropertiesKHR = nullptr;
@@ -19,7 +19,10 @@
 #include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <mutex>
 
 namespace dawn_native { namespace vulkan {
 
@@ -144,7 +147,7 @@ namespace dawn_native { namespace vulkan {
         return std::move(physicalDevices);
     }
 
-    ResultOrError<VulkanDeviceInfo> GatherDeviceInfo(const Adapter& adapter) {
+    ResultOrError<VulkanDeviceInfo> GatherDeviceInfoUncached(const Adapter& adapter) {
         VulkanDeviceInfo info = {};
         VkPhysicalDevice physicalDevice = adapter.GetPhysicalDevice();
         const VulkanGlobalInfo& globalInfo = adapter.GetBackend()->GetGlobalInfo();
@@ -275,6 +278,74 @@ namespace dawn_native { namespace vulkan {
         return std::move(info);
     }
 
+    namespace {
+
+        // Gathering the device info queries all the extensions, features and properties of the
+        // physical device which is a large part of the cost of discovering adapters. The result
+        // only depends on the driver and the instance extensions so it is cached for the whole
+        // process, which helps applications that create several instances.
+        struct DeviceInfoCacheKey {
+            uint32_t vendorID;
+            uint32_t deviceID;
+            uint32_t driverVersion;
+            uint32_t apiVersion;
+            std::array<uint8_t, VK_UUID_SIZE> pipelineCacheUUID;
+            InstanceExtSet instanceExtensions;
+
+            bool operator==(const DeviceInfoCacheKey& other) const {
+                return vendorID == other.vendorID && deviceID == other.deviceID &&
+                       driverVersion == other.driverVersion && apiVersion == other.apiVersion &&
+                       pipelineCacheUUID == other.pipelineCacheUUID &&
+                       instanceExtensions == other.instanceExtensions;
+            }
+        };
+
+        struct DeviceInfoCache {
+            std::mutex mutex;
+            std::vector<std::pair<DeviceInfoCacheKey, VulkanDeviceInfo>> entries;
+        };
+
+        // Leaked on purpose to avoid static constructors and exit-time destructors.
+        DeviceInfoCache* GetDeviceInfoCache() {
+            static DeviceInfoCache* cache = new DeviceInfoCache();
+            return cache;
+        }
+
+    }  // anonymous namespace
+
+    ResultOrError<VulkanDeviceInfo> GatherDeviceInfo(const Adapter& adapter) {
+        const VulkanFunctions& vkFunctions = adapter.GetBackend()->GetFunctions();
+
+        VkPhysicalDeviceProperties properties;
+        vkFunctions.GetPhysicalDeviceProperties(adapter.GetPhysicalDevice(), &properties);
+
+        DeviceInfoCacheKey key;
+        key.vendorID = properties.vendorID;
+        key.deviceID = properties.deviceID;
+        key.driverVersion = properties.driverVersion;
+        key.apiVersion = properties.apiVersion;
+        std::copy(std::begin(properties.pipelineCacheUUID), std::end(properties.pipelineCacheUUID),
+                  key.pipelineCacheUUID.begin());
+        key.instanceExtensions = adapter.GetBackend()->GetGlobalInfo().extensions;
+
+        DeviceInfoCache* cache = GetDeviceInfoCache();
+        {
+            std::lock_guard<std::mutex> lock(cache->mutex);
+            for (const auto& entry : cache->entries) {
+                if (entry.first == key) {
+                    return VulkanDeviceInfo(entry.second);
+                }
+            }
+        }
+
+        VulkanDeviceInfo info;
+        DAWN_TRY_ASSIGN(info, GatherDeviceInfoUncached(adapter));
+
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        cache->entries.emplace_back(key, info);
+        return std::move(info);
+    }
+
     ResultOrError<VulkanSurfaceInfo> GatherSurfaceInfo(const Adapter& adapter,
                                                        VkSurfaceKHR surface) {
         VulkanSurfaceInfo info = {};
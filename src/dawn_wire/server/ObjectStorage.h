@@ -20,12 +20,21 @@
 
 #include <algorithm>
 #include <map>
-#include <unordered_set>
 
 namespace dawn_wire { namespace server {
 
+    // The children of a device are in an intrusive doubly-linked list so that they can be
+    // tracked and untracked without allocations or hashing. The ObjectData of a type move when
+    // its KnownObjects grows, so the links are the packed type and ID of the neighbours instead
+    // of pointers. 0 is used as the end of the list because no object has ID 0.
+    struct DeviceChildLinks {
+        uint64_t previous = 0;
+        uint64_t next = 0;
+    };
+
     struct DeviceInfo {
-        std::unordered_set<uint64_t> childObjectTypesAndIds;
+        // The packed type and ID of the first child in the list, or 0 if there are no children.
+        uint64_t firstChild = 0;
         Server* server;
         ObjectHandle self;
     };
@@ -48,6 +57,7 @@ namespace dawn_wire { namespace server {
 
         // This points to an allocation that is owned by the device.
         DeviceInfo* deviceInfo = nullptr;
+        DeviceChildLinks deviceChildLinks;
     };
 
     // Stores what the backend knows about the type.
@@ -64,9 +74,8 @@ namespace dawn_wire { namespace server {
         BufferMapWriteState mapWriteState = BufferMapWriteState::Unmapped;
     };
 
-    // Pack the ObjectType and ObjectId as a single value for storage in
-    // an std::unordered_set. This lets us avoid providing our own hash and
-    // equality comparison operators.
+    // Pack the ObjectType and ObjectId as a single value for the links of the list of children of
+    // a device.
     inline uint64_t PackObjectTypeAndId(ObjectType type, ObjectId id) {
         static_assert(sizeof(ObjectType) * 8 <= 32, "");
         static_assert(sizeof(ObjectId) * 8 <= 32, "");
@@ -156,10 +165,14 @@ namespace dawn_wire { namespace server {
             return &mKnown[id];
         }
 
-        // Marks an ID as deallocated
+        // Marks an ID as deallocated and releases the data of its slot, like the memory transfer
+        // handles of buffers, instead of waiting for the ID to be reused.
         void Free(uint32_t id) {
             ASSERT(id < mKnown.size());
-            mKnown[id].state = AllocationState::Free;
+            Data data;
+            data.state = AllocationState::Free;
+            data.handle = nullptr;
+            mKnown[id] = std::move(data);
         }
 
         std::vector<T> AcquireAllHandles() {
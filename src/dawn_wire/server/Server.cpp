@@ -15,6 +15,8 @@
 #include "dawn_wire/server/Server.h"
 #include "dawn_wire/WireServer.h"
 
+#include <tuple>
+
 namespace dawn_wire { namespace server {
 
     Server::Server(const DawnProcTable& procs,
@@ -159,23 +161,67 @@ namespace dawn_wire { namespace server {
         mProcs.deviceSetDeviceLostCallback(device, nullptr, nullptr);
     }
 
+    namespace {
+
+        bool IsTrackedDeviceChild(const DeviceInfo* info,
+                                  const DeviceChildLinks* links,
+                                  uint64_t child) {
+            return links->previous != 0 || info->firstChild == child;
+        }
+
+    }  // anonymous namespace
+
     bool TrackDeviceChild(DeviceInfo* info, ObjectType type, ObjectId id) {
-        auto it = info->childObjectTypesAndIds.insert(PackObjectTypeAndId(type, id));
-        if (!it.second) {
+        uint64_t child = PackObjectTypeAndId(type, id);
+        DeviceChildLinks* links = info->server->GetDeviceChildLinks(type, id);
+        if (links == nullptr || IsTrackedDeviceChild(info, links, child)) {
             // An object of this type and id already exists.
             return false;
         }
+
+        // Insert the child at the front of the list.
+        if (info->firstChild != 0) {
+            ObjectType nextType;
+            ObjectId nextId;
+            std::tie(nextType, nextId) = UnpackObjectTypeAndId(info->firstChild);
+            DeviceChildLinks* nextLinks = info->server->GetDeviceChildLinks(nextType, nextId);
+            ASSERT(nextLinks != nullptr);
+            nextLinks->previous = child;
+        }
+        links->previous = 0;
+        links->next = info->firstChild;
+        info->firstChild = child;
         return true;
     }
 
     bool UntrackDeviceChild(DeviceInfo* info, ObjectType type, ObjectId id) {
-        auto& children = info->childObjectTypesAndIds;
-        auto it = children.find(PackObjectTypeAndId(type, id));
-        if (it == children.end()) {
+        uint64_t child = PackObjectTypeAndId(type, id);
+        DeviceChildLinks* links = info->server->GetDeviceChildLinks(type, id);
+        if (links == nullptr || !IsTrackedDeviceChild(info, links, child)) {
             // An object of this type and id was already deleted.
             return false;
         }
-        children.erase(it);
+
+        ObjectType neighborType;
+        ObjectId neighborId;
+        if (links->previous != 0) {
+            std::tie(neighborType, neighborId) = UnpackObjectTypeAndId(links->previous);
+            DeviceChildLinks* previousLinks =
+                info->server->GetDeviceChildLinks(neighborType, neighborId);
+            ASSERT(previousLinks != nullptr);
+            previousLinks->next = links->next;
+        } else {
+            info->firstChild = links->next;
+        }
+        if (links->next != 0) {
+            std::tie(neighborType, neighborId) = UnpackObjectTypeAndId(links->next);
+            DeviceChildLinks* nextLinks =
+                info->server->GetDeviceChildLinks(neighborType, neighborId);
+            ASSERT(nextLinks != nullptr);
+            nextLinks->previous = links->previous;
+        }
+        links->previous = 0;
+        links->next = 0;
         return true;
     }
 
@@ -60,12 +60,123 @@ namespace dawn_native {
     class InstanceBase;
     class AdapterBase;
 
+    // Budget for the recently released cached objects of one type that the device keeps alive so
+    // that recreating them is a cache hit. A maxCount of 0 disables retention and a maxBytes of 0
+    // means there is no byte budget.
+    struct DAWN_NATIVE_EXPORT CachedObjectRetentionBudget {
+        uint32_t maxCount = 0;
+        uint64_t maxBytes = 0;
+    };
+
+    struct DAWN_NATIVE_EXPORT CachedObjectRetentionStats {
+        // Number of creations that found a released object kept alive by the device.
+        uint64_t hits = 0;
+        // Number of creations that had to create a new object.
+        uint64_t misses = 0;
+        // Number of released objects that were dropped because they didn't fit in the budget, or
+        // because ReleaseRetainedCachedObjects was called.
+        uint64_t evictions = 0;
+        // Released objects kept alive by the device, as of the last Tick. Objects still in use
+        // aren't counted.
+        uint32_t retainedCount = 0;
+        uint64_t retainedBytes = 0;
+    };
+
+    struct DAWN_NATIVE_EXPORT CachedObjectsRetentionStats {
+        CachedObjectRetentionStats bindGroupLayouts;
+        CachedObjectRetentionStats computePipelines;
+        CachedObjectRetentionStats renderPipelines;
+        CachedObjectRetentionStats samplers;
+    };
+
+    // Counters of a cache that returns existing objects when an equivalent one is created again.
+    struct DAWN_NATIVE_EXPORT ObjectCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    // Counters of the commands skipped by the pass encoders because they set the same state that
+    // was already set.
+    struct DAWN_NATIVE_EXPORT ElidedCommandStats {
+        uint64_t setPipeline = 0;
+        uint64_t setBindGroup = 0;
+        uint64_t setVertexBuffer = 0;
+        uint64_t setIndexBuffer = 0;
+    };
+
+    // The memory a shader module keeps alive for the creation of pipelines.
+    struct DAWN_NATIVE_EXPORT ShaderModuleMemoryInfo {
+        // Bytes of the source, the SPIR-V and the reflection data of the module.
+        uint64_t retainedBytes = 0;
+        // Whether the module keeps its Tint program alive, whose size isn't known. It is released
+        // after its first use with the release_shader_module_programs toggle.
+        bool retainsTintProgram = false;
+    };
+
+    // Overrides of the sizes of MemoryAllocatorOptions for a single memory type, for example to
+    // use larger heaps for device-local memory than for host-visible memory. Zero keeps the value
+    // of MemoryAllocatorOptions.
+    struct DAWN_NATIVE_EXPORT MemoryTypeAllocatorOptions {
+        // The index of the memory type in the VkPhysicalDeviceMemoryProperties of the adapter.
+        uint32_t memoryTypeIndex = 0;
+        uint64_t maxSizeForSubAllocation = 0;
+        uint64_t heapSize = 0;
+        uint64_t maxSizeForLargeSubAllocation = 0;
+        uint64_t largeHeapSize = 0;
+    };
+
+    // Parameters of the sub-allocation of resource memory, zero keeps the backend defaults. Only
+    // used by the Vulkan backend for now, where they apply to all the memory types that aren't
+    // overridden in |perMemoryType|, clamped to the size of their memory heap.
+    struct DAWN_NATIVE_EXPORT MemoryAllocatorOptions {
+        // Resources smaller than |maxSizeForSubAllocation| are sub-allocated in power-of-two
+        // blocks of heaps of |heapSize| bytes. |heapSize| is rounded down to a power of two.
+        uint64_t maxSizeForSubAllocation = 0;
+        uint64_t heapSize = 0;
+
+        // When non-zero, resources that are too large for the heaps above but smaller than
+        // |maxSizeForLargeSubAllocation| are sub-allocated at their exact size in heaps of
+        // |largeHeapSize| bytes, which defaults to twice |maxSizeForLargeSubAllocation|.
+        uint64_t maxSizeForLargeSubAllocation = 0;
+        uint64_t largeHeapSize = 0;
+
+        // Release the unused heaps kept for reuse once the GPU has been idle, without memory being
+        // allocated or freed, for a number of ticks. They are also released when a memory heap is
+        // over its budget.
+        bool releaseUnusedHeapsWhenIdle = false;
+
+        std::vector<MemoryTypeAllocatorOptions> perMemoryType;
+    };
+
+    // Options for the destruction of the backend objects that are deleted once the GPU has stopped
+    // using them. They are only used by the Vulkan backend for now.
+    struct DAWN_NATIVE_EXPORT DeferredDeletionOptions {
+        // Destroy the objects on a thread owned by the device instead of in Device::Tick.
+        bool destroyOnBackgroundThread = false;
+
+        // When non-zero, each Device::Tick spends at most about |maxTickDurationNs| destroying
+        // objects and leaves the rest for the next ticks. Ignored on the background thread.
+        uint64_t maxTickDurationNs = 0;
+    };
+
     // An optional parameter of Adapter::CreateDevice() to send additional information when creating
     // a Device. For example, we can use it to enable a workaround, optimization or feature.
     struct DAWN_NATIVE_EXPORT DeviceDescriptor {
         std::vector<const char*> requiredExtensions;
         std::vector<const char*> forceEnabledToggles;
         std::vector<const char*> forceDisabledToggles;
+
+        CachedObjectRetentionBudget bindGroupLayoutRetention;
+        CachedObjectRetentionBudget computePipelineRetention;
+        CachedObjectRetentionBudget renderPipelineRetention;
+        CachedObjectRetentionBudget samplerRetention;
+
+        // Create the pipelines Dawn uses internally (for CopyTextureForBrowser and the conversion
+        // of timestamps) during device creation instead of on their first use.
+        bool warmInternalPipelines = false;
+
+        MemoryAllocatorOptions memoryAllocatorOptions;
+        DeferredDeletionOptions deferredDeletionOptions;
     };
 
     // A struct to record the information of a toggle. A toggle is a code path in Dawn device that
@@ -150,6 +261,9 @@ namespace dawn_native {
         // Gather all adapters in the system that can be accessed with no special options. These
         // adapters will later be returned by GetAdapters.
         void DiscoverDefaultAdapters();
+        // Same as DiscoverDefaultAdapters but only connects to the backend of the given type, which
+        // avoids the cost of initializing the other backends.
+        void DiscoverDefaultAdapters(WGPUBackendType backendType);
 
         // Adds adapters that can be discovered with the options provided (like a getProcAddress).
         // The backend is chosen based on the type of the options used. Returns true on success.
@@ -202,6 +316,44 @@ namespace dawn_native {
 
     DAWN_NATIVE_EXPORT bool DeviceTick(WGPUDevice device);
 
+    // Blocks until the work submitted so far and the asynchronous operations pending on it (buffer
+    // mapping, OnSubmittedWorkDone, CreatePipelineAsync) are complete, and fires their callbacks.
+    // This waits on the fences of the backend instead of requiring the application to call
+    // DeviceTick in a loop. Returns false if the work isn't complete after |timeoutNs|
+    // nanoseconds or if an error happened. UINT64_MAX waits forever.
+    DAWN_NATIVE_EXPORT bool DeviceWaitForPendingWork(WGPUDevice device, uint64_t timeoutNs);
+
+    // Query the hit, miss and eviction counters of the cached objects retained after release.
+    DAWN_NATIVE_EXPORT CachedObjectsRetentionStats GetCachedObjectsRetentionStats(WGPUDevice device);
+
+    // Drop all the released cached objects the device keeps alive, for example on memory pressure.
+    DAWN_NATIVE_EXPORT void ReleaseRetainedCachedObjects(WGPUDevice device);
+
+    // Query the counters of the texture views reused when the same view of a texture is created.
+    DAWN_NATIVE_EXPORT ObjectCacheStats GetTextureViewCacheStats(WGPUDevice device);
+
+    // Query the number of redundant state setting commands skipped by the pass encoders.
+    DAWN_NATIVE_EXPORT ElidedCommandStats GetElidedCommandStats(WGPUDevice device);
+
+    // Query the memory kept alive by a shader module.
+    DAWN_NATIVE_EXPORT ShaderModuleMemoryInfo GetShaderModuleMemoryInfo(WGPUShaderModule module);
+
+    // Create |count| objects at once, for example when loading a scene, and write them to the
+    // output array. Each invalid descriptor produces a validation error and an error object like
+    // with the wgpu::Device creation methods, while the valid ones are created in a single batch.
+    DAWN_NATIVE_EXPORT void CreateBuffers(WGPUDevice device,
+                                          uint32_t count,
+                                          const WGPUBufferDescriptor* descriptors,
+                                          WGPUBuffer* buffers);
+    DAWN_NATIVE_EXPORT void CreateTextures(WGPUDevice device,
+                                           uint32_t count,
+                                           const WGPUTextureDescriptor* descriptors,
+                                           WGPUTexture* textures);
+    DAWN_NATIVE_EXPORT void CreateBindGroups(WGPUDevice device,
+                                             uint32_t count,
+                                             const WGPUBindGroupDescriptor* descriptors,
+                                             WGPUBindGroup* bindGroups);
+
     // ErrorInjector functions used for testing only. Defined in dawn_native/ErrorInjector.cpp
     DAWN_NATIVE_EXPORT void EnableErrorInjector();
     DAWN_NATIVE_EXPORT void DisableErrorInjector();
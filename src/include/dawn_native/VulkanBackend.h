@@ -26,6 +26,55 @@ namespace dawn_native { namespace vulkan {
 
     DAWN_NATIVE_EXPORT VkInstance GetInstance(WGPUDevice device);
 
+    // Statistics of the resource memory allocator of the device, summed over all memory types.
+    // The free space of the large heaps is fragmented when it is much larger than their largest
+    // free block.
+    struct DAWN_NATIVE_EXPORT MemoryAllocatorStats {
+        // Heaps of the power-of-two sub-allocator, including the unused ones kept for reuse.
+        uint64_t heapCount = 0;
+        uint64_t heapBytes = 0;
+        uint64_t unusedHeapCount = 0;
+
+        // Heaps of the sub-allocator for large resources, see MemoryAllocatorOptions.
+        uint64_t largeHeapCount = 0;
+        uint64_t largeHeapBytes = 0;
+        uint64_t largeHeapUsedBytes = 0;
+        uint64_t largeHeapLargestFreeBlock = 0;
+
+        // Resources with their own memory allocation.
+        uint64_t directAllocationCount = 0;
+        uint64_t directAllocationBytes = 0;
+
+        // Allocations that didn't fit in the budget of their memory heap and caused the unused
+        // heaps to be released, or were placed in another memory heap.
+        uint64_t poolReleasesForBudget = 0;
+        uint64_t fallbackAllocationsForBudget = 0;
+
+        // Buffers moved out of sparse large heaps while the device was idle, with the
+        // DefragmentBufferMemoryWhenIdle toggle.
+        uint64_t relocationCount = 0;
+        uint64_t relocatedBytes = 0;
+    };
+    DAWN_NATIVE_EXPORT MemoryAllocatorStats GetMemoryAllocatorStats(WGPUDevice device);
+
+    // The memory usage and budget of a Vulkan memory heap. The budget and the usage of other
+    // allocations in the process come from VK_EXT_memory_budget when it is supported. Otherwise
+    // the budget is the size of the heap and the usage only includes the device's allocations.
+    struct DAWN_NATIVE_EXPORT MemoryHeapBudget {
+        uint64_t size = 0;
+        uint64_t budget = 0;
+        uint64_t usage = 0;
+        // The part of |usage| allocated by the device for its resources.
+        uint64_t allocatorUsage = 0;
+        bool isDeviceLocal = false;
+    };
+    // Returns the budget of each memory heap, indexed like VkPhysicalDeviceMemoryProperties.
+    // Applications can use it to adapt the amount of resources they keep resident.
+    DAWN_NATIVE_EXPORT std::vector<MemoryHeapBudget> GetMemoryHeapBudgets(WGPUDevice device);
+
+    // Query the counters of the VkFramebuffers reused by render passes with the same attachments.
+    DAWN_NATIVE_EXPORT ObjectCacheStats GetFramebufferCacheStats(WGPUDevice device);
+
     DAWN_NATIVE_EXPORT PFN_vkVoidFunction GetInstanceProcAddr(WGPUDevice device, const char* pName);
 
     DAWN_NATIVE_EXPORT DawnSwapChainImplementation
@@ -817,6 +817,9 @@ std::vector<const char*> DawnTestBase::GetRequiredExtensions() {
     return {};
 }
 
+void DawnTestBase::SetUpDeviceDescriptor(dawn_native::DeviceDescriptor* descriptor) {
+}
+
 const wgpu::AdapterProperties& DawnTestBase::GetAdapterProperties() const {
     return mParam.adapterProperties;
 }
@@ -890,6 +893,8 @@ void DawnTestBase::SetUp() {
         deviceDescriptor.forceDisabledToggles.push_back(info->name);
     }
 
+    SetUpDeviceDescriptor(&deviceDescriptor);
+
     std::tie(device, backendDevice) =
         mWireHelper->RegisterDevice(mBackendAdapter.CreateDevice(&deviceDescriptor));
     ASSERT_NE(nullptr, backendDevice);
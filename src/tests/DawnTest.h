@@ -371,6 +371,9 @@ class DawnTestBase {
     // code path to handle the situation when not all extensions are supported.
     virtual std::vector<const char*> GetRequiredExtensions();
 
+    // Called in SetUp() to let the tests set the backend-specific options of the device.
+    virtual void SetUpDeviceDescriptor(dawn_native::DeviceDescriptor* descriptor);
+
     const wgpu::AdapterProperties& GetAdapterProperties() const;
 
   private:
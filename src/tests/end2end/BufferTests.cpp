@@ -554,6 +554,44 @@ TEST_P(BufferMappedAtCreationTests, NonMappableUsageLarge) {
     EXPECT_BUFFER_U32_RANGE_EQ(myData.data(), buffer, 0, kDataSize);
 }
 
+// Test many small non-mappable buffers mapped at creation at the same time, that share staging
+// memory, with some destroyed or unmapped out of order and a large one in the middle.
+TEST_P(BufferMappedAtCreationTests, NonMappableUsageManySimultaneous) {
+    constexpr uint32_t kBufferCount = 2000;
+    constexpr uint32_t kDataSize = 1025;
+
+    std::vector<wgpu::Buffer> buffers;
+    for (uint32_t i = 0; i < kBufferCount; ++i) {
+        std::vector<uint32_t> data(kDataSize, i);
+        buffers.push_back(BufferMappedAtCreationWithData(wgpu::BufferUsage::CopySrc, data));
+
+        if (i == kBufferCount / 2) {
+            constexpr uint64_t kLargeDataSize = 1000 * 1000;
+            std::vector<uint32_t> largeData(kLargeDataSize, 42);
+            wgpu::Buffer largeBuffer =
+                BufferMappedAtCreationWithData(wgpu::BufferUsage::CopySrc, largeData);
+            UnmapBuffer(largeBuffer);
+            EXPECT_BUFFER_U32_RANGE_EQ(largeData.data(), largeBuffer, 0, kLargeDataSize);
+        }
+    }
+
+    for (uint32_t i = 0; i < kBufferCount; i += 3) {
+        buffers[i].Destroy();
+    }
+    for (uint32_t i = kBufferCount; i > 0; --i) {
+        if ((i - 1) % 3 != 0) {
+            UnmapBuffer(buffers[i - 1]);
+        }
+    }
+
+    for (uint32_t i = 0; i < kBufferCount; ++i) {
+        if (i % 3 != 0) {
+            std::vector<uint32_t> data(kDataSize, i);
+            EXPECT_BUFFER_U32_RANGE_EQ(data.data(), buffers[i], 0, kDataSize);
+        }
+    }
+}
+
 // Test destroying a non-mappable buffer mapped at creation.
 // This is a regression test for an issue where the D3D12 backend thought the buffer was actually
 // mapped and tried to unlock the heap residency (when actually the buffer was using a staging
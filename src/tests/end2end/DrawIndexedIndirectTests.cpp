@@ -164,3 +164,100 @@ DAWN_INSTANTIATE_TEST(DrawIndexedIndirectTest,
                       OpenGLBackend(),
                       OpenGLESBackend(),
                       VulkanBackend());
+
+class MultiDrawIndexedIndirectTest : public DrawIndexedIndirectTest {
+  protected:
+    std::vector<const char*> GetRequiredExtensions() override {
+        std::vector<const char*> extensions;
+        mIsMultiDrawSupported = SupportsExtensions({"multi_draw_indirect"});
+        if (mIsMultiDrawSupported) {
+            extensions.push_back("multi_draw_indirect");
+        }
+        mIsDrawCountSupported = SupportsExtensions({"draw_indirect_count"});
+        if (mIsDrawCountSupported) {
+            extensions.push_back("draw_indirect_count");
+        }
+        return extensions;
+    }
+
+    // Draw with the draws of |bufferList| starting at |indirectOffset|. If |drawCount| isn't
+    // null, it is put in a draw count buffer.
+    void TestMultiDraw(std::initializer_list<uint32_t> bufferList,
+                       uint64_t indirectOffset,
+                       uint32_t maxDrawCount,
+                       const uint32_t* drawCount,
+                       RGBA8 bottomLeftExpected,
+                       RGBA8 topRightExpected) {
+        wgpu::Buffer indirectBuffer =
+            utils::CreateBufferFromData<uint32_t>(device, wgpu::BufferUsage::Indirect, bufferList);
+        wgpu::Buffer drawCountBuffer;
+        if (drawCount != nullptr) {
+            drawCountBuffer = utils::CreateBufferFromData<uint32_t>(
+                device, wgpu::BufferUsage::Indirect, {0xFFFFFFFF, *drawCount});
+        }
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        {
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+            pass.SetPipeline(pipeline);
+            pass.SetVertexBuffer(0, vertexBuffer);
+            pass.SetIndexBuffer(indexBuffer, wgpu::IndexFormat::Uint32);
+            pass.MultiDrawIndexedIndirect(indirectBuffer, indirectOffset, maxDrawCount,
+                                          drawCountBuffer, sizeof(uint32_t));
+            pass.EndPass();
+        }
+
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+
+        EXPECT_PIXEL_RGBA8_EQ(bottomLeftExpected, renderPass.color, 1, 3);
+        EXPECT_PIXEL_RGBA8_EQ(topRightExpected, renderPass.color, 3, 1);
+    }
+
+    bool mIsMultiDrawSupported = false;
+    bool mIsDrawCountSupported = false;
+};
+
+// Test that each draw of a multi draw uses its own arguments.
+TEST_P(MultiDrawIndexedIndirectTest, DrawCount) {
+    DAWN_SKIP_TEST_IF(!mIsMultiDrawSupported);
+
+    RGBA8 filled(0, 255, 0, 255);
+    RGBA8 notFilled(0, 0, 0, 0);
+
+    // Zero draws
+    TestMultiDraw({3, 1, 0, 0, 0}, 0, 0, nullptr, notFilled, notFilled);
+
+    // One draw for each triangle of the first quad
+    TestMultiDraw({3, 1, 0, 0, 0, 3, 1, 3, 0, 0}, 0, 1, nullptr, filled, notFilled);
+    TestMultiDraw({3, 1, 0, 0, 0, 3, 1, 3, 0, 0}, 0, 2, nullptr, filled, filled);
+
+    // With an offset, only the second draw is done.
+    TestMultiDraw({3, 1, 0, 0, 0, 3, 1, 3, 0, 0}, 5 * sizeof(uint32_t), 1, nullptr, notFilled,
+                  filled);
+}
+
+// Test that the draw count buffer limits the number of draws.
+TEST_P(MultiDrawIndexedIndirectTest, DrawCountBuffer) {
+    DAWN_SKIP_TEST_IF(!mIsDrawCountSupported);
+
+    RGBA8 filled(0, 255, 0, 255);
+    RGBA8 notFilled(0, 0, 0, 0);
+
+    const uint32_t zero = 0;
+    const uint32_t one = 1;
+    const uint32_t two = 2;
+    TestMultiDraw({3, 1, 0, 0, 0, 3, 1, 3, 0, 0}, 0, 2, &zero, notFilled, notFilled);
+    TestMultiDraw({3, 1, 0, 0, 0, 3, 1, 3, 0, 0}, 0, 2, &one, filled, notFilled);
+    TestMultiDraw({3, 1, 0, 0, 0, 3, 1, 3, 0, 0}, 0, 2, &two, filled, filled);
+
+    // The draw count is clamped to maxDrawCount.
+    TestMultiDraw({3, 1, 0, 0, 0, 3, 1, 3, 0, 0}, 0, 1, &two, filled, notFilled);
+}
+
+DAWN_INSTANTIATE_TEST(MultiDrawIndexedIndirectTest,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      OpenGLESBackend(),
+                      VulkanBackend());
@@ -658,3 +658,112 @@ DAWN_INSTANTIATE_TEST(QueueWriteTextureTests,
                       OpenGLBackend(),
                       OpenGLESBackend(),
                       VulkanBackend());
+
+class QueueWriteTextureConversionTests : public DawnTest {
+  protected:
+    std::vector<const char*> GetRequiredExtensions() override {
+        mIsConversionSupported = SupportsExtensions({"texture_data_conversion"});
+        if (!mIsConversionSupported) {
+            return {};
+        }
+        return {"texture_data_conversion"};
+    }
+
+    // Write |sourceFormat| data to a texture of |textureFormat| and check that the texels were
+    // converted. The rows of the data are padded with |rowPadding| bytes.
+    void DoTest(wgpu::TextureDataSourceFormat sourceFormat,
+                wgpu::TextureFormat textureFormat,
+                wgpu::Extent3D size,
+                uint32_t rowPadding) {
+        wgpu::TextureDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.format = textureFormat;
+        descriptor.usage = wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::CopySrc;
+        wgpu::Texture texture = device.CreateTexture(&descriptor);
+
+        const bool isSourceRGB8 = sourceFormat == wgpu::TextureDataSourceFormat::RGB8Unorm;
+        const bool isSourceBGRA8 = sourceFormat == wgpu::TextureDataSourceFormat::BGRA8Unorm;
+        const bool isTextureBGRA8 = textureFormat == wgpu::TextureFormat::BGRA8Unorm;
+        const uint32_t sourceTexelSize = isSourceRGB8 ? 3 : 4;
+
+        wgpu::TextureDataLayout dataLayout;
+        dataLayout.bytesPerRow = size.width * sourceTexelSize + rowPadding;
+        dataLayout.rowsPerImage = size.height;
+
+        const uint32_t texelCount = size.width * size.height * size.depthOrArrayLayers;
+        std::vector<uint8_t> data(uint64_t(dataLayout.bytesPerRow) * size.height *
+                                  size.depthOrArrayLayers);
+        std::vector<RGBA8> expected(texelCount);
+        for (uint32_t row = 0; row < size.height * size.depthOrArrayLayers; ++row) {
+            for (uint32_t x = 0; x < size.width; ++x) {
+                uint32_t texel = row * size.width + x;
+                uint8_t r = static_cast<uint8_t>(texel * 3);
+                uint8_t g = static_cast<uint8_t>(texel * 5 + 1);
+                uint8_t b = static_cast<uint8_t>(texel * 7 + 2);
+                uint8_t a = isSourceRGB8 ? 255 : static_cast<uint8_t>(texel * 11 + 3);
+
+                uint8_t* source = &data[row * dataLayout.bytesPerRow + x * sourceTexelSize];
+                source[0] = isSourceBGRA8 ? b : r;
+                source[1] = g;
+                source[2] = isSourceBGRA8 ? r : b;
+                if (!isSourceRGB8) {
+                    source[3] = a;
+                }
+
+                // The expectations are in the byte order of the texture.
+                expected[texel] = isTextureBGRA8 ? RGBA8(b, g, r, a) : RGBA8(r, g, b, a);
+            }
+        }
+
+        wgpu::TextureDataConversion conversion;
+        conversion.sourceFormat = sourceFormat;
+        dataLayout.nextInChain = &conversion;
+
+        wgpu::ImageCopyTexture imageCopyTexture =
+            utils::CreateImageCopyTexture(texture, 0, {0, 0, 0});
+        queue.WriteTexture(&imageCopyTexture, data.data(), data.size(), &dataLayout, &size);
+
+        EXPECT_TEXTURE_EQ(expected.data(), texture, {0, 0, 0}, size);
+    }
+
+    bool mIsConversionSupported = false;
+};
+
+// Test converting RGB8 data to RGBA8 and BGRA8 textures.
+TEST_P(QueueWriteTextureConversionTests, RGB8) {
+    DAWN_SKIP_TEST_IF(!mIsConversionSupported);
+
+    for (wgpu::TextureFormat format :
+         {wgpu::TextureFormat::RGBA8Unorm, wgpu::TextureFormat::BGRA8Unorm}) {
+        DoTest(wgpu::TextureDataSourceFormat::RGB8Unorm, format, {17, 9, 1}, 0);
+        DoTest(wgpu::TextureDataSourceFormat::RGB8Unorm, format, {17, 9, 1}, 5);
+        DoTest(wgpu::TextureDataSourceFormat::RGB8Unorm, format, {64, 8, 3}, 0);
+    }
+}
+
+// Test swapping the red and blue channels of RGBA8 and BGRA8 data.
+TEST_P(QueueWriteTextureConversionTests, SwapRedAndBlue) {
+    DAWN_SKIP_TEST_IF(!mIsConversionSupported);
+
+    DoTest(wgpu::TextureDataSourceFormat::BGRA8Unorm, wgpu::TextureFormat::RGBA8Unorm, {33, 7, 2},
+           0);
+    DoTest(wgpu::TextureDataSourceFormat::RGBA8Unorm, wgpu::TextureFormat::BGRA8Unorm, {33, 7, 2},
+           4);
+}
+
+// Test that data that is already in the format of the texture is written as is.
+TEST_P(QueueWriteTextureConversionTests, Noop) {
+    DAWN_SKIP_TEST_IF(!mIsConversionSupported);
+
+    DoTest(wgpu::TextureDataSourceFormat::RGBA8Unorm, wgpu::TextureFormat::RGBA8Unorm, {33, 7, 1},
+           0);
+    DoTest(wgpu::TextureDataSourceFormat::BGRA8Unorm, wgpu::TextureFormat::BGRA8Unorm, {33, 7, 1},
+           12);
+}
+
+DAWN_INSTANTIATE_TEST(QueueWriteTextureConversionTests,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      OpenGLESBackend(),
+                      VulkanBackend());
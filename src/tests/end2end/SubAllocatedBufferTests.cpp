@@ -0,0 +1,214 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "utils/WGPUHelpers.h"
+
+#include <array>
+
+// Tests that small buffers placed in ranges of shared buffers by the suballocate_small_buffers
+// toggle behave like buffers with their own allocation. Buffers created one after the other are
+// likely to be neighbours in the same shared buffer, so every test checks that operations on a
+// buffer don't leak into the next one.
+class SubAllocatedBufferTests : public DawnTest {
+  protected:
+    static constexpr uint32_t kBufferCount = 8;
+    static constexpr uint32_t kUintsPerBuffer = 4;
+    static constexpr uint64_t kBufferSize = kUintsPerBuffer * sizeof(uint32_t);
+
+    using BufferData = std::array<uint32_t, kUintsPerBuffer>;
+
+    std::array<wgpu::Buffer, kBufferCount> CreateBuffers(wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = kBufferSize;
+        descriptor.usage = usage;
+
+        std::array<wgpu::Buffer, kBufferCount> buffers;
+        for (wgpu::Buffer& buffer : buffers) {
+            buffer = device.CreateBuffer(&descriptor);
+        }
+        return buffers;
+    }
+
+    BufferData DataForBuffer(uint32_t bufferIndex) {
+        BufferData data;
+        for (uint32_t i = 0; i < kUintsPerBuffer; ++i) {
+            data[i] = (bufferIndex + 1) * 0x100 + i;
+        }
+        return data;
+    }
+};
+
+// Test that WriteBuffer writes each buffer at its own range.
+TEST_P(SubAllocatedBufferTests, WriteBuffer) {
+    std::array<wgpu::Buffer, kBufferCount> buffers =
+        CreateBuffers(wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopySrc |
+                      wgpu::BufferUsage::CopyDst);
+
+    for (uint32_t i = 0; i < kBufferCount; ++i) {
+        BufferData data = DataForBuffer(i);
+        queue.WriteBuffer(buffers[i], 0, data.data(), kBufferSize);
+    }
+
+    for (uint32_t i = 0; i < kBufferCount; ++i) {
+        EXPECT_BUFFER_U32_RANGE_EQ(DataForBuffer(i).data(), buffers[i], 0, kUintsPerBuffer);
+    }
+}
+
+// Test that buffer to buffer copies use the range of both buffers.
+TEST_P(SubAllocatedBufferTests, CopyBufferToBuffer) {
+    std::array<wgpu::Buffer, kBufferCount> buffers =
+        CreateBuffers(wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst);
+
+    for (uint32_t i = 0; i < kBufferCount; ++i) {
+        BufferData data = DataForBuffer(i);
+        queue.WriteBuffer(buffers[i], 0, data.data(), kBufferSize);
+    }
+
+    // Copy the second half of each buffer to the first half of the next one.
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 0; i + 1 < kBufferCount; ++i) {
+        encoder.CopyBufferToBuffer(buffers[i], kBufferSize / 2, buffers[i + 1], 0,
+                                   kBufferSize / 2);
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    // Each copy reads the half of a buffer that isn't written by the previous copy.
+    EXPECT_BUFFER_U32_RANGE_EQ(DataForBuffer(0).data(), buffers[0], 0, kUintsPerBuffer);
+    for (uint32_t i = 1; i < kBufferCount; ++i) {
+        BufferData expected = DataForBuffer(i);
+        BufferData previous = DataForBuffer(i - 1);
+        expected[0] = previous[2];
+        expected[1] = previous[3];
+        EXPECT_BUFFER_U32_RANGE_EQ(expected.data(), buffers[i], 0, kUintsPerBuffer);
+    }
+}
+
+// Test that storage buffer bindings of a compute shader use the range of the buffer.
+TEST_P(SubAllocatedBufferTests, ComputeShaderStorageBuffer) {
+    wgpu::ComputePipelineDescriptor pipelineDescriptor;
+    pipelineDescriptor.computeStage.module = utils::CreateShaderModule(device, R"(
+        [[block]] struct Buf {
+            s : array<u32, 4>;
+        };
+
+        [[group(0), binding(0)]] var<storage> src : [[access(read)]] Buf;
+        [[group(0), binding(1)]] var<storage> dst : [[access(read_write)]] Buf;
+
+        [[stage(compute)]] fn main() {
+            for (var i : u32 = 0u; i < 4u; i = i + 1u) {
+                dst.s[i] = src.s[i] + 1u;
+            }
+        })");
+    pipelineDescriptor.computeStage.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDescriptor);
+
+    std::array<wgpu::Buffer, kBufferCount> buffers =
+        CreateBuffers(wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc |
+                      wgpu::BufferUsage::CopyDst);
+    for (uint32_t i = 0; i < kBufferCount; ++i) {
+        BufferData data = DataForBuffer(i);
+        queue.WriteBuffer(buffers[i], 0, data.data(), kBufferSize);
+    }
+
+    // Each even buffer is read and the next odd buffer is written.
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    for (uint32_t i = 0; i < kBufferCount; i += 2) {
+        wgpu::BindGroup bindGroup = utils::MakeBindGroup(
+            device, pipeline.GetBindGroupLayout(0),
+            {{0, buffers[i], 0, kBufferSize}, {1, buffers[i + 1], 0, kBufferSize}});
+        pass.SetBindGroup(0, bindGroup);
+        pass.Dispatch(1);
+    }
+    pass.EndPass();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    for (uint32_t i = 0; i < kBufferCount; i += 2) {
+        BufferData expected = DataForBuffer(i);
+        EXPECT_BUFFER_U32_RANGE_EQ(expected.data(), buffers[i], 0, kUintsPerBuffer);
+        for (uint32_t& value : expected) {
+            value += 1;
+        }
+        EXPECT_BUFFER_U32_RANGE_EQ(expected.data(), buffers[i + 1], 0, kUintsPerBuffer);
+    }
+}
+
+// Test that resolving queries, including the zeroing of the results of unavailable queries, uses
+// the range of the destination buffer.
+TEST_P(SubAllocatedBufferTests, ResolveQuerySet) {
+    // Each buffer holds the results of two queries.
+    constexpr uint32_t kQueryCount = kBufferSize / sizeof(uint64_t);
+
+    wgpu::QuerySetDescriptor querySetDescriptor;
+    querySetDescriptor.count = kQueryCount;
+    querySetDescriptor.type = wgpu::QueryType::Occlusion;
+    wgpu::QuerySet querySet = device.CreateQuerySet(&querySetDescriptor);
+
+    std::array<wgpu::Buffer, kBufferCount> buffers =
+        CreateBuffers(wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::CopySrc |
+                      wgpu::BufferUsage::CopyDst);
+    for (uint32_t i = 0; i < kBufferCount; ++i) {
+        BufferData data = DataForBuffer(i);
+        queue.WriteBuffer(buffers[i], 0, data.data(), kBufferSize);
+    }
+
+    // The queries are never written so they are unavailable, and the resolve clears the results
+    // of every odd buffer to 0.
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t i = 1; i < kBufferCount; i += 2) {
+        encoder.ResolveQuerySet(querySet, 0, kQueryCount, buffers[i], 0);
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    BufferData zeroes = {};
+    for (uint32_t i = 0; i < kBufferCount; i += 2) {
+        EXPECT_BUFFER_U32_RANGE_EQ(DataForBuffer(i).data(), buffers[i], 0, kUintsPerBuffer);
+        EXPECT_BUFFER_U32_RANGE_EQ(zeroes.data(), buffers[i + 1], 0, kUintsPerBuffer);
+    }
+}
+
+// Test that buffers reusing the range of destroyed buffers are zero-initialized.
+TEST_P(SubAllocatedBufferTests, ReusedRangesAreZeroInitialized) {
+    for (uint32_t iteration = 0; iteration < 2; ++iteration) {
+        std::array<wgpu::Buffer, kBufferCount> buffers =
+            CreateBuffers(wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst);
+
+        BufferData zeroes = {};
+        for (uint32_t i = 0; i < kBufferCount; ++i) {
+            EXPECT_BUFFER_U32_RANGE_EQ(zeroes.data(), buffers[i], 0, kUintsPerBuffer);
+        }
+
+        for (uint32_t i = 0; i < kBufferCount; ++i) {
+            BufferData data = DataForBuffer(i);
+            queue.WriteBuffer(buffers[i], 0, data.data(), kBufferSize);
+        }
+        for (uint32_t i = 0; i < kBufferCount; ++i) {
+            EXPECT_BUFFER_U32_RANGE_EQ(DataForBuffer(i).data(), buffers[i], 0, kUintsPerBuffer);
+        }
+
+        for (wgpu::Buffer& buffer : buffers) {
+            buffer.Destroy();
+        }
+        // Let the ranges of the destroyed buffers be reclaimed.
+        WaitForAllOperations();
+    }
+}
+
+DAWN_INSTANTIATE_TEST(SubAllocatedBufferTests, VulkanBackend({"suballocate_small_buffers"}));
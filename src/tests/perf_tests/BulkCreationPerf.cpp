@@ -0,0 +1,196 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+#include "utils/WGPUHelpers.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumObjects = 1000;
+
+    enum class BulkObjectType {
+        Buffer,
+        BindGroup,
+    };
+
+    enum class CreationMethod {
+        OneByOne,
+        Bulk,
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const BulkObjectType& type) {
+        switch (type) {
+            case BulkObjectType::Buffer:
+                ostream << "Buffer";
+                break;
+            case BulkObjectType::BindGroup:
+                ostream << "BindGroup";
+                break;
+        }
+        return ostream;
+    }
+
+    std::ostream& operator<<(std::ostream& ostream, const CreationMethod& method) {
+        switch (method) {
+            case CreationMethod::OneByOne:
+                ostream << "OneByOne";
+                break;
+            case CreationMethod::Bulk:
+                ostream << "Bulk";
+                break;
+        }
+        return ostream;
+    }
+
+    struct BulkCreationParams : AdapterTestParam {
+        BulkCreationParams(const AdapterTestParam& param,
+                           BulkObjectType type,
+                           CreationMethod method)
+            : AdapterTestParam(param), type(type), method(method) {
+        }
+
+        BulkObjectType type;
+        CreationMethod method;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const BulkCreationParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_" << param.type << "_" << param.method;
+        return ostream;
+    }
+
+}  // anonymous namespace
+
+// Test the CPU cost of creating many small objects like when a scene is loaded, either one by one
+// or with the bulk creation functions of dawn_native.
+class BulkCreationPerf : public DawnPerfTestWithParams<BulkCreationParams> {
+  public:
+    BulkCreationPerf() : DawnPerfTestWithParams(kNumObjects, 1) {
+    }
+    ~BulkCreationPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+    void ReleaseObjects();
+
+    std::vector<wgpu::BufferDescriptor> mBufferDescriptors;
+    std::vector<wgpu::Buffer> mUniformBuffers;
+    std::vector<wgpu::BindGroupEntry> mBindGroupEntries;
+    std::vector<wgpu::BindGroupDescriptor> mBindGroupDescriptors;
+    wgpu::BindGroupLayout mBindGroupLayout;
+
+    std::vector<WGPUBuffer> mBuffers;
+    std::vector<WGPUBindGroup> mBindGroups;
+};
+
+void BulkCreationPerf::SetUp() {
+    DawnPerfTestWithParams<BulkCreationParams>::SetUp();
+
+    // The bulk creation functions are only exposed by dawn_native.
+    DAWN_SKIP_TEST_IF(UsesWire());
+
+    wgpu::BufferDescriptor bufferDescriptor;
+    bufferDescriptor.size = 256;
+    bufferDescriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+    mBufferDescriptors.resize(kNumObjects, bufferDescriptor);
+    mBuffers.resize(kNumObjects, nullptr);
+
+    // Each bind group references a different buffer so that none of them share their descriptor
+    // set content.
+    mBindGroupLayout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform}});
+    mUniformBuffers.resize(kNumObjects);
+    mBindGroupEntries.resize(kNumObjects);
+    mBindGroupDescriptors.resize(kNumObjects);
+    for (unsigned int i = 0; i < kNumObjects; ++i) {
+        mUniformBuffers[i] = device.CreateBuffer(&bufferDescriptor);
+        mBindGroupEntries[i].binding = 0;
+        mBindGroupEntries[i].buffer = mUniformBuffers[i];
+        mBindGroupEntries[i].size = bufferDescriptor.size;
+        mBindGroupDescriptors[i].layout = mBindGroupLayout;
+        mBindGroupDescriptors[i].entryCount = 1;
+        mBindGroupDescriptors[i].entries = &mBindGroupEntries[i];
+    }
+    mBindGroups.resize(kNumObjects, nullptr);
+}
+
+void BulkCreationPerf::TearDown() {
+    ReleaseObjects();
+    DawnPerfTestWithParams<BulkCreationParams>::TearDown();
+}
+
+void BulkCreationPerf::ReleaseObjects() {
+    for (WGPUBuffer& buffer : mBuffers) {
+        wgpu::Buffer::Acquire(buffer);
+        buffer = nullptr;
+    }
+    for (WGPUBindGroup& bindGroup : mBindGroups) {
+        wgpu::BindGroup::Acquire(bindGroup);
+        bindGroup = nullptr;
+    }
+}
+
+void BulkCreationPerf::Step() {
+    // Release the objects of the previous step at once, like when a scene is unloaded.
+    ReleaseObjects();
+
+    switch (GetParam().type) {
+        case BulkObjectType::Buffer: {
+            if (GetParam().method == CreationMethod::Bulk) {
+                dawn_native::CreateBuffers(
+                    backendDevice, kNumObjects,
+                    reinterpret_cast<const WGPUBufferDescriptor*>(mBufferDescriptors.data()),
+                    mBuffers.data());
+            } else {
+                for (unsigned int i = 0; i < kNumObjects; ++i) {
+                    mBuffers[i] = device.CreateBuffer(&mBufferDescriptors[i]).Release();
+                }
+            }
+            break;
+        }
+
+        case BulkObjectType::BindGroup: {
+            if (GetParam().method == CreationMethod::Bulk) {
+                dawn_native::CreateBindGroups(
+                    backendDevice, kNumObjects,
+                    reinterpret_cast<const WGPUBindGroupDescriptor*>(mBindGroupDescriptors.data()),
+                    mBindGroups.data());
+            } else {
+                for (unsigned int i = 0; i < kNumObjects; ++i) {
+                    mBindGroups[i] = device.CreateBindGroup(&mBindGroupDescriptors[i]).Release();
+                }
+            }
+            break;
+        }
+    }
+
+    // Let the backend reclaim the memory and descriptor sets of the released objects.
+    queue.Submit(0, nullptr);
+}
+
+TEST_P(BulkCreationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(BulkCreationPerf,
+                                   {NullBackend(), VulkanBackend()},
+                                   {BulkObjectType::Buffer, BulkObjectType::BindGroup},
+                                   {CreationMethod::OneByOne, CreationMethod::Bulk});
@@ -62,6 +62,19 @@ namespace {
             return vec4<f32>((constants.color + uniforms.color) * (1.0 / 5000.0), 1.0);
         })";
 
+    // Same as kFragmentShaderA, but reading the per-draw data from the immediate data.
+    constexpr char kFragmentShaderImmediate[] = R"(
+        [[block]] struct Immediates {
+            color : vec3<f32>;
+        };
+        [[group(4), binding(0)]] var<uniform> immediates : Immediates;
+        [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+            return vec4<f32>(immediates.color * (1.0 / 5000.0), 1.0);
+        })";
+
+    // The size of the immediate data of kFragmentShaderImmediate, rounded up like the struct.
+    constexpr uint32_t kImmediateDataSize = 4 * sizeof(float);
+
     enum class Pipeline {
         Static,     // Keep the same pipeline for all draws.
         Redundant,  // Use the same pipeline, but redundantly set it.
@@ -79,12 +92,14 @@ namespace {
         NoReuse,    // Create a new bind group every time.
         Multiple,   // Use multiple static bind groups.
         Dynamic,    // Use bind groups with dynamic offsets.
+        Immediate,  // Use SetImmediateData instead of bind groups.
     };
 
     enum class VertexBuffer {
-        NoChange,  // Use one vertex buffer for all draws.
-        Multiple,  // Use multiple static vertex buffers.
-        Dynamic,   // Switch vertex buffers between draws.
+        NoChange,   // Use one vertex buffer for all draws.
+        Redundant,  // Use the same vertex buffer, but redundantly set it.
+        Multiple,   // Use multiple static vertex buffers.
+        Dynamic,    // Switch vertex buffers between draws.
     };
 
     enum class RenderBundle {
@@ -92,16 +107,23 @@ namespace {
         Yes,  // Record commands in a render bundle
     };
 
+    enum class DrawType {
+        Direct,                    // Use Draw for each draw.
+        IndexedIndirect,           // Use DrawIndexedIndirect for each draw.
+        MultiDrawIndexedIndirect,  // Use a single MultiDrawIndexedIndirect for all draws.
+    };
+
     struct DrawCallParam {
         Pipeline pipelineType;
         VertexBuffer vertexBufferType;
         BindGroup bindGroupType;
         UniformData uniformDataType;
         RenderBundle withRenderBundle;
+        DrawType drawType;
     };
 
     using DrawCallParamTuple =
-        std::tuple<Pipeline, VertexBuffer, BindGroup, UniformData, RenderBundle>;
+        std::tuple<Pipeline, VertexBuffer, BindGroup, UniformData, RenderBundle, DrawType>;
 
     template <typename T>
     unsigned int AssignParam(T& lhs, T rhs) {
@@ -117,11 +139,12 @@ namespace {
     //  - BindGroup::NoChange
     //  - UniformData::Static
     //  - RenderBundle::No
+    //  - DrawType::Direct
     template <typename... Ts>
     DrawCallParam MakeParam(Ts... args) {
         // Baseline param
         DrawCallParamTuple paramTuple{Pipeline::Static, VertexBuffer::NoChange, BindGroup::NoChange,
-                                      UniformData::Static, RenderBundle::No};
+                                      UniformData::Static, RenderBundle::No, DrawType::Direct};
 
         unsigned int unused[] = {
             0,  // Avoid making a 0-sized array.
@@ -132,7 +155,7 @@ namespace {
         return DrawCallParam{
             std::get<Pipeline>(paramTuple),     std::get<VertexBuffer>(paramTuple),
             std::get<BindGroup>(paramTuple),    std::get<UniformData>(paramTuple),
-            std::get<RenderBundle>(paramTuple),
+            std::get<RenderBundle>(paramTuple), std::get<DrawType>(paramTuple),
         };
     }
 
@@ -162,6 +185,9 @@ namespace {
         switch (param.vertexBufferType) {
             case VertexBuffer::NoChange:
                 break;
+            case VertexBuffer::Redundant:
+                ostream << "_RedundantVertexBuffer";
+                break;
             case VertexBuffer::Multiple:
                 ostream << "_MultipleVertexBuffers";
                 break;
@@ -184,6 +210,9 @@ namespace {
             case BindGroup::Dynamic:
                 ostream << "_DynamicBindGroup";
                 break;
+            case BindGroup::Immediate:
+                ostream << "_ImmediateData";
+                break;
         }
 
         switch (param.uniformDataType) {
@@ -202,6 +231,17 @@ namespace {
                 break;
         }
 
+        switch (param.drawType) {
+            case DrawType::Direct:
+                break;
+            case DrawType::IndexedIndirect:
+                ostream << "_IndexedIndirect";
+                break;
+            case DrawType::MultiDrawIndexedIndirect:
+                ostream << "_MultiDrawIndexedIndirect";
+                break;
+        }
+
         return ostream;
     }
 
@@ -215,12 +255,16 @@ namespace {
 //   - Static/Multiple/Dynamic vertex buffers: Tests switching buffer bindings. This has
 //     a state tracking cost as well as a GPU driver cost.
 //   - Static/Multiple/Dynamic bind groups: Same rationale as vertex buffers
+//   - Immediate data: Replaces the per-draw bind groups with SetImmediateData, which doesn't
+//     need a buffer or a bind group.
 //   - Static/Dynamic pipelines: In addition to a change to GPU state, changing the pipeline
 //     layout incurs additional state tracking costs in Dawn.
 //   - With/Without render bundles: All of the above can have lower validation costs if
 //     precomputed in a render bundle.
 //   - Static/Dynamic data: Updating data for each draw is a common use case. It also tests
 //     the efficiency of resource transitions.
+//   - Direct/Indirect/Multi draws: GPU-driven renderers encode one indirect draw per object,
+//     which a single multi draw replaces when the state doesn't change between draws.
 class DrawCallPerf : public DawnPerfTestWithParams<DrawCallParamForTest> {
   public:
     DrawCallPerf() : DawnPerfTestWithParams(kNumDraws, 3) {
@@ -234,6 +278,18 @@ class DrawCallPerf : public DawnPerfTestWithParams<DrawCallParamForTest> {
         return DawnPerfTestWithParams::GetParam().param;
     }
 
+    std::vector<const char*> GetRequiredExtensions() override {
+        if (GetParam().drawType == DrawType::MultiDrawIndexedIndirect &&
+            SupportsExtensions({"multi_draw_indirect"})) {
+            return {"multi_draw_indirect"};
+        }
+        if (GetParam().bindGroupType == BindGroup::Immediate &&
+            SupportsExtensions({"immediate_data"})) {
+            return {"immediate_data"};
+        }
+        return {};
+    }
+
     template <typename Encoder>
     void RecordRenderCommands(Encoder encoder);
 
@@ -265,11 +321,20 @@ class DrawCallPerf : public DawnPerfTestWithParams<DrawCallParamForTest> {
     wgpu::TextureView mDepthStencilAttachment;
 
     wgpu::RenderBundle mRenderBundle;
+
+    // The index buffer and the arguments of all the draws for indirect draws.
+    wgpu::Buffer mIndexBuffer;
+    wgpu::Buffer mIndirectBuffer;
 };
 
 void DrawCallPerf::SetUp() {
     DawnPerfTestWithParams::SetUp();
 
+    DAWN_SKIP_TEST_IF(GetParam().drawType == DrawType::MultiDrawIndexedIndirect &&
+                      !SupportsExtensions({"multi_draw_indirect"}));
+    DAWN_SKIP_TEST_IF(GetParam().bindGroupType == BindGroup::Immediate &&
+                      !SupportsExtensions({"immediate_data"}));
+
     // Compute aligned uniform / vertex data sizes.
     mAlignedUniformSize = Align(kUniformSize, kMinDynamicBufferOffsetAlignment);
     mAlignedVertexDataSize = Align(sizeof(kVertexData), 4);
@@ -297,6 +362,7 @@ void DrawCallPerf::SetUp() {
     // Create vertex buffer(s)
     switch (GetParam().vertexBufferType) {
         case VertexBuffer::NoChange:
+        case VertexBuffer::Redundant:
             mVertexBuffers[0] = utils::CreateBufferFromData(
                 device, kVertexData, sizeof(kVertexData), wgpu::BufferUsage::Vertex);
             break;
@@ -321,6 +387,24 @@ void DrawCallPerf::SetUp() {
         }
     }
 
+    // Create the index and indirect buffers.
+    if (GetParam().drawType != DrawType::Direct) {
+        mIndexBuffer =
+            utils::CreateBufferFromData<uint32_t>(device, wgpu::BufferUsage::Index, {0, 1, 2});
+
+        std::vector<uint32_t> indirectData(kNumDraws * kDrawIndexedIndirectSize / sizeof(uint32_t));
+        for (uint32_t i = 0; i < kNumDraws; ++i) {
+            // indexCount, instanceCount, firstIndex, baseVertex, firstInstance
+            uint32_t* draw = &indirectData[i * kDrawIndexedIndirectSize / sizeof(uint32_t)];
+            draw[0] = 3;
+            draw[1] = 1;
+        }
+        mIndirectBuffer =
+            utils::CreateBufferFromData(device, indirectData.data(),
+                                        indirectData.size() * sizeof(uint32_t),
+                                        wgpu::BufferUsage::Indirect);
+    }
+
     // Create the bind group layout.
     switch (GetParam().bindGroupType) {
         case BindGroup::NoChange:
@@ -342,6 +426,10 @@ void DrawCallPerf::SetUp() {
                 });
             break;
 
+        case BindGroup::Immediate:
+            // The per-draw data doesn't use a bind group.
+            break;
+
         default:
             UNREACHABLE();
             break;
@@ -358,13 +446,20 @@ void DrawCallPerf::SetUp() {
 
     // Create the pipeline layout for the first pipeline.
     wgpu::PipelineLayoutDescriptor pipelineLayoutDesc = {};
-    pipelineLayoutDesc.bindGroupLayouts = &mUniformBindGroupLayout;
-    pipelineLayoutDesc.bindGroupLayoutCount = 1;
+    if (GetParam().bindGroupType == BindGroup::Immediate) {
+        pipelineLayoutDesc.bindGroupLayoutCount = 0;
+        pipelineLayoutDesc.immediateDataSize = kImmediateDataSize;
+    } else {
+        pipelineLayoutDesc.bindGroupLayouts = &mUniformBindGroupLayout;
+        pipelineLayoutDesc.bindGroupLayoutCount = 1;
+    }
     wgpu::PipelineLayout pipelineLayout = device.CreatePipelineLayout(&pipelineLayoutDesc);
 
     // Create the shaders for the first pipeline.
     wgpu::ShaderModule vsModule = utils::CreateShaderModule(device, kVertexShader);
-    wgpu::ShaderModule fsModule = utils::CreateShaderModule(device, kFragmentShaderA);
+    wgpu::ShaderModule fsModule = utils::CreateShaderModule(
+        device, GetParam().bindGroupType == BindGroup::Immediate ? kFragmentShaderImmediate
+                                                                 : kFragmentShaderA);
 
     // Create the first pipeline.
     renderPipelineDesc.layout = pipelineLayout;
@@ -374,6 +469,9 @@ void DrawCallPerf::SetUp() {
 
     // If the test is using a dynamic pipeline, create the second pipeline.
     if (GetParam().pipelineType == Pipeline::Dynamic) {
+        // Incompatible. The second pipeline uses the per-draw bind group.
+        ASSERT(GetParam().bindGroupType != BindGroup::Immediate);
+
         // Create another bind group layout. The data for this binding point will be the same for
         // all draws.
         mConstantBindGroupLayout = utils::MakeBindGroupLayout(
@@ -446,6 +544,11 @@ void DrawCallPerf::SetUp() {
             mUniformBindGroups[0] = utils::MakeBindGroup(
                 device, mUniformBindGroupLayout, {{0, mUniformBuffers[0], 0, kUniformSize}});
             break;
+
+        case BindGroup::Immediate:
+            // The per-draw data is set directly when recording the draws.
+            break;
+
         default:
             UNREACHABLE();
             break;
@@ -486,6 +589,20 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
         pass.SetBindGroup(uniformBindGroupIndex, mUniformBindGroups[0]);
     }
 
+    if (GetParam().drawType != DrawType::Direct) {
+        pass.SetIndexBuffer(mIndexBuffer, wgpu::IndexFormat::Uint32);
+    }
+
+    if (GetParam().drawType == DrawType::MultiDrawIndexedIndirect) {
+        // Incompatible. All the draws of a multi draw use the same state.
+        ASSERT(GetParam().pipelineType == Pipeline::Static &&
+               GetParam().vertexBufferType == VertexBuffer::NoChange &&
+               GetParam().bindGroupType == BindGroup::NoChange);
+
+        pass.MultiDrawIndexedIndirect(mIndirectBuffer, 0, kNumDraws, nullptr, 0);
+        return;
+    }
+
     for (unsigned int i = 0; i < kNumDraws; ++i) {
         switch (GetParam().pipelineType) {
             case Pipeline::Static:
@@ -512,6 +629,10 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
             case VertexBuffer::NoChange:
                 break;
 
+            case VertexBuffer::Redundant:
+                pass.SetVertexBuffer(0, mVertexBuffers[0]);
+                break;
+
             case VertexBuffer::Multiple:
                 pass.SetVertexBuffer(0, mVertexBuffers[i]);
                 break;
@@ -547,11 +668,29 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
                 break;
             }
 
+            case BindGroup::Immediate:
+                pass.SetImmediateData(0, mUniformBufferData.data() + i * mNumUniformFloats,
+                                      kUniformSize);
+                break;
+
+            default:
+                UNREACHABLE();
+                break;
+        }
+
+        switch (GetParam().drawType) {
+            case DrawType::Direct:
+                pass.Draw(3);
+                break;
+
+            case DrawType::IndexedIndirect:
+                pass.DrawIndexedIndirect(mIndirectBuffer, i * kDrawIndexedIndirectSize);
+                break;
+
             default:
                 UNREACHABLE();
                 break;
         }
-        pass.Draw(3);
     }
 }
 
@@ -579,6 +718,10 @@ void DrawCallPerf::Step() {
                 queue.WriteBuffer(mUniformBuffers[0], 0, mUniformBufferData.data(),
                                   mUniformBufferData.size() * sizeof(float));
                 break;
+            case BindGroup::Immediate:
+                // The new data is set when recording the draws below, unless it was already
+                // recorded in a render bundle.
+                break;
         }
     }
 
@@ -627,6 +770,13 @@ DAWN_INSTANTIATE_PERF_TEST_SUITE_P(
         // Redundantly set pipeline / bind groups
         MakeParam(Pipeline::Redundant, BindGroup::Redundant),
 
+        // Redundantly set all the state, which the encoders skip
+        MakeParam(Pipeline::Redundant, VertexBuffer::Redundant, BindGroup::Redundant),
+        MakeParam(Pipeline::Redundant,
+                  VertexBuffer::Redundant,
+                  BindGroup::Redundant,
+                  RenderBundle::Yes),
+
         // Switch the pipeline every draw to test state tracking and updates to binding points
         MakeParam(Pipeline::Dynamic,
                   BindGroup::Multiple),  // Multiple bind groups w/ dynamic pipeline
@@ -661,4 +811,15 @@ DAWN_INSTANTIATE_PERF_TEST_SUITE_P(
                   UniformData::Dynamic),  // Update per-draw data: Multiple bind groups
         MakeParam(BindGroup::Dynamic,
                   UniformData::Dynamic),  // Update per-draw data: Dynamic bind groups
+
+        // Set the per-draw data as immediate data instead of through bind groups.
+        MakeParam(BindGroup::Immediate),
+        MakeParam(BindGroup::Immediate, RenderBundle::Yes),
+        MakeParam(BindGroup::Immediate, UniformData::Dynamic),
+
+        // Issue the draws with indirect arguments, one command per draw or a single multi draw.
+        MakeParam(DrawType::IndexedIndirect),
+        MakeParam(DrawType::IndexedIndirect, RenderBundle::Yes),
+        MakeParam(DrawType::MultiDrawIndexedIndirect),
+        MakeParam(DrawType::MultiDrawIndexedIndirect, RenderBundle::Yes),
     });
@@ -0,0 +1,127 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+
+namespace {
+
+    constexpr unsigned int kNumErrors = 1000;
+
+    enum class ErrorSource {
+        ObjectCreation,
+        Encoding,
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ErrorSource& source) {
+        switch (source) {
+            case ErrorSource::ObjectCreation:
+                ostream << "ObjectCreation";
+                break;
+            case ErrorSource::Encoding:
+                ostream << "Encoding";
+                break;
+        }
+        return ostream;
+    }
+
+    struct ErrorPathParams : AdapterTestParam {
+        ErrorPathParams(const AdapterTestParam& param, ErrorSource source)
+            : AdapterTestParam(param), source(source) {
+        }
+
+        ErrorSource source;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ErrorPathParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_" << param.source;
+        return ostream;
+    }
+
+}  // anonymous namespace
+
+// Test the CPU cost of validation errors, for applications that probe for failures in a loop.
+// Each error goes through a few DAWN_TRY's and is captured by an error scope, either when an
+// object is created or when a command encoder is finished.
+class ErrorPathPerf : public DawnPerfTestWithParams<ErrorPathParams> {
+  public:
+    ErrorPathPerf() : DawnPerfTestWithParams(kNumErrors, 1) {
+    }
+    ~ErrorPathPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Buffer mBuffer;
+};
+
+void ErrorPathPerf::SetUp() {
+    DawnPerfTestWithParams<ErrorPathParams>::SetUp();
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 16;
+    descriptor.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+    mBuffer = device.CreateBuffer(&descriptor);
+}
+
+void ErrorPathPerf::Step() {
+    // Only the first error is recorded by the scope, so most errors are dropped after being
+    // handled, like in an application that only checks whether a feature is supported.
+    device.PushErrorScope(wgpu::ErrorFilter::Validation);
+
+    switch (GetParam().source) {
+        case ErrorSource::ObjectCreation: {
+            wgpu::SamplerDescriptor descriptor;
+            descriptor.lodMinClamp = 2.0f;
+            descriptor.lodMaxClamp = 1.0f;
+            for (unsigned int i = 0; i < kNumErrors; ++i) {
+                device.CreateSampler(&descriptor);
+            }
+            break;
+        }
+
+        case ErrorSource::Encoding: {
+            for (unsigned int i = 0; i < kNumErrors; ++i) {
+                wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+                // The copy size must be a multiple of 4.
+                encoder.CopyBufferToBuffer(mBuffer, 0, mBuffer, 8, 2);
+                encoder.Finish();
+            }
+            break;
+        }
+    }
+
+    bool gotError = false;
+    device.PopErrorScope(
+        [](WGPUErrorType type, const char*, void* userdata) {
+            *static_cast<bool*>(userdata) = type == WGPUErrorType_Validation;
+        },
+        &gotError);
+    FlushWire();
+    if (!gotError) {
+        AbortTest();
+    }
+}
+
+TEST_P(ErrorPathPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(ErrorPathPerf,
+                                   {NullBackend(), NullBackend({"record_error_backtraces"})},
+                                   {ErrorSource::ObjectCreation, ErrorSource::Encoding});
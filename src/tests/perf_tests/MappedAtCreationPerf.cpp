@@ -0,0 +1,85 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumBuffers = 1000;
+
+    struct MappedAtCreationParams : AdapterTestParam {
+        MappedAtCreationParams(const AdapterTestParam& param, uint32_t bufferSize)
+            : AdapterTestParam(param), bufferSize(bufferSize) {
+        }
+
+        uint32_t bufferSize;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const MappedAtCreationParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_" << param.bufferSize << "_bytes";
+        return ostream;
+    }
+
+}  // anonymous namespace
+
+// Test the CPU cost of loading many small vertex buffers with mappedAtCreation = true, like
+// when a scene is loaded. The buffers aren't mappable so their data goes through staging memory.
+class MappedAtCreationPerf : public DawnPerfTestWithParams<MappedAtCreationParams> {
+  public:
+    MappedAtCreationPerf()
+        : DawnPerfTestWithParams(kNumBuffers, 1), mData(GetParam().bufferSize, 0x42) {
+    }
+    ~MappedAtCreationPerf() override = default;
+
+  private:
+    void Step() override;
+
+    std::vector<uint8_t> mData;
+    std::vector<wgpu::Buffer> mBuffers;
+};
+
+void MappedAtCreationPerf::Step() {
+    // Release the buffers of the previous step at once, like when a scene is unloaded.
+    mBuffers.clear();
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = mData.size();
+    descriptor.usage = wgpu::BufferUsage::Vertex | wgpu::BufferUsage::Index;
+    descriptor.mappedAtCreation = true;
+
+    for (unsigned int i = 0; i < kNumBuffers; ++i) {
+        wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+        memcpy(buffer.GetMappedRange(), mData.data(), mData.size());
+        buffer.Unmap();
+        mBuffers.push_back(buffer);
+    }
+
+    // Submit the copies of the staging memory.
+    queue.Submit(0, nullptr);
+}
+
+TEST_P(MappedAtCreationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(MappedAtCreationPerf,
+                                   {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                                    VulkanBackend()},
+                                   {64u, 1024u, 16384u});
@@ -0,0 +1,169 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/WGPUHelpers.h"
+
+namespace {
+
+    constexpr unsigned int kNumCreations = 1000;
+
+    constexpr char kVertexShader[] = R"(
+        [[stage(vertex)]] fn main() -> [[builtin(position)]] vec4<f32> {
+            return vec4<f32>(1.0, 0.0, 0.0, 1.0);
+        })";
+
+    constexpr char kFragmentShader[] = R"(
+        [[group(0), binding(0)]] var<uniform> color : vec4<f32>;
+        [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+            return color;
+        })";
+
+    enum class CachedObjectType {
+        BindGroupLayout,
+        RenderPipeline,
+        Sampler,
+        ShaderModule,
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const CachedObjectType& type) {
+        switch (type) {
+            case CachedObjectType::BindGroupLayout:
+                ostream << "BindGroupLayout";
+                break;
+            case CachedObjectType::RenderPipeline:
+                ostream << "RenderPipeline";
+                break;
+            case CachedObjectType::Sampler:
+                ostream << "Sampler";
+                break;
+            case CachedObjectType::ShaderModule:
+                ostream << "ShaderModule";
+                break;
+        }
+        return ostream;
+    }
+
+    struct ObjectCachingParams : AdapterTestParam {
+        ObjectCachingParams(const AdapterTestParam& param, CachedObjectType type)
+            : AdapterTestParam(param), type(type) {
+        }
+        CachedObjectType type;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ObjectCachingParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_" << param.type;
+        return ostream;
+    }
+
+}  // anonymous namespace
+
+// Test the latency of creating an object that is already in the device cache. The first object
+// created in SetUp stays alive so that every creation in Step is a cache hit, and measures the
+// time spent hashing and comparing the descriptors.
+class ObjectCachingPerf : public DawnPerfTestWithParams<ObjectCachingParams> {
+  public:
+    ObjectCachingPerf() : DawnPerfTestWithParams(kNumCreations, 1) {
+    }
+    ~ObjectCachingPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::BindGroupLayout mBindGroupLayout;
+    wgpu::ShaderModule mVertexModule;
+    wgpu::ShaderModule mFragmentModule;
+    wgpu::RenderPipeline mPipeline;
+    wgpu::Sampler mSampler;
+};
+
+void ObjectCachingPerf::SetUp() {
+    DawnPerfTestWithParams<ObjectCachingParams>::SetUp();
+
+    // The cache of the wire client would hide the cost of the device caches.
+    DAWN_SKIP_TEST_IF(UsesWire());
+
+    mBindGroupLayout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform}});
+    mVertexModule = utils::CreateShaderModule(device, kVertexShader);
+    mFragmentModule = utils::CreateShaderModule(device, kFragmentShader);
+
+    utils::ComboRenderPipelineDescriptor2 descriptor;
+    descriptor.vertex.module = mVertexModule;
+    descriptor.cFragment.module = mFragmentModule;
+    descriptor.layout = utils::MakeBasicPipelineLayout(device, &mBindGroupLayout);
+    mPipeline = device.CreateRenderPipeline2(&descriptor);
+
+    mSampler = device.CreateSampler();
+}
+
+void ObjectCachingPerf::Step() {
+    switch (GetParam().type) {
+        case CachedObjectType::BindGroupLayout: {
+            for (unsigned int i = 0; i < kNumCreations; ++i) {
+                utils::MakeBindGroupLayout(
+                    device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform}});
+            }
+            break;
+        }
+
+        case CachedObjectType::RenderPipeline: {
+            wgpu::PipelineLayout layout = utils::MakeBasicPipelineLayout(device, &mBindGroupLayout);
+            utils::ComboRenderPipelineDescriptor2 descriptor;
+            descriptor.vertex.module = mVertexModule;
+            descriptor.cFragment.module = mFragmentModule;
+            descriptor.layout = layout;
+            for (unsigned int i = 0; i < kNumCreations; ++i) {
+                device.CreateRenderPipeline2(&descriptor);
+            }
+            break;
+        }
+
+        case CachedObjectType::Sampler: {
+            for (unsigned int i = 0; i < kNumCreations; ++i) {
+                device.CreateSampler();
+            }
+            break;
+        }
+
+        case CachedObjectType::ShaderModule: {
+            wgpu::ShaderModuleWGSLDescriptor wgslDesc;
+            wgslDesc.source = kFragmentShader;
+            wgpu::ShaderModuleDescriptor descriptor;
+            descriptor.nextInChain = &wgslDesc;
+
+            for (unsigned int i = 0; i < kNumCreations; ++i) {
+                device.CreateShaderModule(&descriptor);
+            }
+            break;
+        }
+    }
+}
+
+TEST_P(ObjectCachingPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(ObjectCachingPerf,
+                                   {D3D12Backend(), MetalBackend(), NullBackend(), OpenGLBackend(),
+                                    VulkanBackend()},
+                                   {CachedObjectType::BindGroupLayout,
+                                    CachedObjectType::RenderPipeline, CachedObjectType::Sampler,
+                                    CachedObjectType::ShaderModule});
@@ -0,0 +1,101 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/SerialQueue.h"
+#include "tests/ParamGenerator.h"
+
+namespace {
+
+    constexpr unsigned int kNumFrames = 10;
+
+    // The number of frames after which the deletions of a frame are done, like for a device
+    // with a few frames in flight.
+    constexpr uint64_t kFramesInFlight = 3;
+
+    struct SerialQueueParams : AdapterTestParam {
+        SerialQueueParams(const AdapterTestParam& param,
+                          uint32_t deletionsPerFrame,
+                          uint32_t submitsPerFrame)
+            : AdapterTestParam(param),
+              deletionsPerFrame(deletionsPerFrame),
+              submitsPerFrame(submitsPerFrame) {
+        }
+
+        uint32_t deletionsPerFrame;
+        uint32_t submitsPerFrame;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const SerialQueueParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_" << param.deletionsPerFrame << "_deletions_" << param.submitsPerFrame
+                << "_submits";
+        return ostream;
+    }
+
+}  // anonymous namespace
+
+// Test the CPU cost of the deferred deletions done with SerialQueue, for example by the
+// FencedDeleter: each frame enqueues the objects deleted by several submits, then iterates over
+// and clears the objects of the frames that completed.
+class SerialQueuePerf : public DawnPerfTestWithParams<SerialQueueParams> {
+  public:
+    SerialQueuePerf() : DawnPerfTestWithParams(kNumFrames, 1) {
+    }
+    ~SerialQueuePerf() override = default;
+
+  private:
+    void Step() override;
+
+    SerialQueue<uint64_t, uint64_t> mQueue;
+    uint64_t mSerial = 0;
+    uint64_t mChecksum = 0;
+};
+
+void SerialQueuePerf::Step() {
+    const SerialQueueParams& params = GetParam();
+    uint32_t deletionsPerSubmit = params.deletionsPerFrame / params.submitsPerFrame;
+
+    for (unsigned int frame = 0; frame < kNumFrames; ++frame) {
+        for (uint32_t submit = 0; submit < params.submitsPerFrame; ++submit) {
+            mSerial++;
+            for (uint32_t i = 0; i < deletionsPerSubmit; ++i) {
+                mQueue.Enqueue(mSerial + i, mSerial);
+            }
+        }
+
+        if (mSerial > kFramesInFlight * params.submitsPerFrame) {
+            uint64_t completedSerial = mSerial - kFramesInFlight * params.submitsPerFrame;
+            for (uint64_t value : mQueue.IterateUpTo(completedSerial)) {
+                mChecksum += value;
+            }
+            mQueue.ClearUpTo(completedSerial);
+        }
+    }
+
+    // Use the values so that the iteration isn't optimized out.
+    if (mChecksum == 0) {
+        AbortTest();
+    }
+}
+
+TEST_P(SerialQueuePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(SerialQueuePerf,
+                                   {NullBackend()},
+                                   {1000u, 10000u, 100000u},
+                                   {1u, 16u});
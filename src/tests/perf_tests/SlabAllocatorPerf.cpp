@@ -0,0 +1,162 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/ConcurrentSlabAllocator.h"
+#include "common/SlabAllocator.h"
+#include "tests/ParamGenerator.h"
+
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // The number of allocations and deallocations done by each thread in a step.
+    constexpr unsigned int kNumAllocations = 100000;
+
+    // Each thread keeps this many objects alive, a bit like the bind groups of a frame.
+    constexpr size_t kLiveObjects = 256;
+
+    // The size of a small frontend object, like a bind group with a few bindings.
+    struct Object {
+        uint64_t data[16];
+    };
+
+    enum class AllocatorType {
+        Malloc,
+        SlabAllocator,
+        ConcurrentSlabAllocator,
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const AllocatorType& type) {
+        switch (type) {
+            case AllocatorType::Malloc:
+                ostream << "Malloc";
+                break;
+            case AllocatorType::SlabAllocator:
+                ostream << "SlabAllocator";
+                break;
+            case AllocatorType::ConcurrentSlabAllocator:
+                ostream << "ConcurrentSlabAllocator";
+                break;
+        }
+        return ostream;
+    }
+
+    struct SlabAllocatorParams : AdapterTestParam {
+        SlabAllocatorParams(const AdapterTestParam& param,
+                            AllocatorType allocatorType,
+                            uint32_t threadCount)
+            : AdapterTestParam(param), allocatorType(allocatorType), threadCount(threadCount) {
+        }
+
+        AllocatorType allocatorType;
+        uint32_t threadCount;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const SlabAllocatorParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_" << param.allocatorType << "_" << param.threadCount << "_threads";
+        return ostream;
+    }
+
+    // Run the same workload on each allocator: every thread replaces its live objects one at a
+    // time in a round-robin order.
+    template <typename AllocateFn, typename DeallocateFn>
+    void AllocateAndDeallocate(AllocateFn allocate, DeallocateFn deallocate) {
+        std::vector<Object*> objects(kLiveObjects, nullptr);
+        for (unsigned int i = 0; i < kNumAllocations; ++i) {
+            Object*& object = objects[i % kLiveObjects];
+            if (object != nullptr) {
+                deallocate(object);
+            }
+            object = allocate();
+            object->data[0] = i;
+        }
+        for (Object* object : objects) {
+            deallocate(object);
+        }
+    }
+
+}  // anonymous namespace
+
+// Test the CPU cost of allocating and deallocating small objects from several threads at the same
+// time with malloc, the single-threaded SlabAllocator behind a lock, and the
+// ConcurrentSlabAllocator.
+class SlabAllocatorPerf : public DawnPerfTestWithParams<SlabAllocatorParams> {
+  public:
+    SlabAllocatorPerf() : DawnPerfTestWithParams(kNumAllocations, 1) {
+    }
+    ~SlabAllocatorPerf() override = default;
+
+  private:
+    void Step() override;
+
+    std::mutex mSlabAllocatorMutex;
+    SlabAllocator<Object> mSlabAllocator{4096};
+    ConcurrentSlabAllocator<Object> mConcurrentSlabAllocator{4096};
+};
+
+void SlabAllocatorPerf::Step() {
+    const SlabAllocatorParams& params = GetParam();
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < params.threadCount; ++t) {
+        threads.emplace_back([this, &params]() {
+            switch (params.allocatorType) {
+                case AllocatorType::Malloc:
+                    AllocateAndDeallocate(
+                        []() { return static_cast<Object*>(malloc(sizeof(Object))); },
+                        [](Object* object) { free(object); });
+                    break;
+
+                case AllocatorType::SlabAllocator:
+                    AllocateAndDeallocate(
+                        [this]() {
+                            std::lock_guard<std::mutex> lock(mSlabAllocatorMutex);
+                            return mSlabAllocator.Allocate();
+                        },
+                        [this](Object* object) {
+                            std::lock_guard<std::mutex> lock(mSlabAllocatorMutex);
+                            mSlabAllocator.Deallocate(object);
+                        });
+                    break;
+
+                case AllocatorType::ConcurrentSlabAllocator:
+                    AllocateAndDeallocate([this]() { return mConcurrentSlabAllocator.Allocate(); },
+                                          [this](Object* object) {
+                                              mConcurrentSlabAllocator.Deallocate(object);
+                                          });
+                    break;
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST_P(SlabAllocatorPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(SlabAllocatorPerf,
+                                   {NullBackend()},
+                                   {AllocatorType::Malloc, AllocatorType::SlabAllocator,
+                                    AllocatorType::ConcurrentSlabAllocator},
+                                   {1u, 2u, 4u, 8u, 16u});
@@ -0,0 +1,79 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_native/DawnNative.h"
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 1;
+
+}  // anonymous namespace
+
+// Test the latency of the startup of a short-lived application: creating an instance, discovering
+// the adapters of the tested backend only and creating a device on the tested adapter.
+class StartupPerf : public DawnPerfTest {
+  public:
+    StartupPerf() : DawnPerfTest(kNumIterations, 1) {
+    }
+    ~StartupPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+};
+
+void StartupPerf::SetUp() {
+    DawnPerfTest::SetUp();
+
+    // The devices are created and destroyed with the native procs.
+    DAWN_SKIP_TEST_IF(UsesWire());
+}
+
+void StartupPerf::Step() {
+    const TestAdapterProperties& properties = GetParam().adapterProperties;
+
+    dawn_native::Instance instance;
+    instance.DiscoverDefaultAdapters(static_cast<WGPUBackendType>(properties.backendType));
+
+    for (dawn_native::Adapter adapter : instance.GetAdapters()) {
+        wgpu::AdapterProperties adapterProperties;
+        adapter.GetProperties(&adapterProperties);
+        if (adapterProperties.backendType != properties.backendType ||
+            adapterProperties.vendorID != properties.vendorID ||
+            adapterProperties.deviceID != properties.deviceID) {
+            continue;
+        }
+
+        WGPUDevice device = adapter.CreateDevice();
+        if (device == nullptr) {
+            AbortTest();
+            return;
+        }
+        dawn_native::GetProcs().deviceRelease(device);
+        return;
+    }
+
+    // The tested adapter must be discovered again by the new instance.
+    AbortTest();
+}
+
+TEST_P(StartupPerf, Run) {
+    RunTest();
+}
+
+// OpenGL isn't tested because its adapters can't be discovered without a context.
+DAWN_INSTANTIATE_TEST(StartupPerf, D3D12Backend(), MetalBackend(), NullBackend(), VulkanBackend());
@@ -0,0 +1,170 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/Math.h"
+#include "tests/ParamGenerator.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 10;
+
+    // The sizes aren't multiples of 64 texels so that the rows need to be repacked to the
+    // optimal row pitch of the backends.
+    enum class UploadSize {
+        Tile_60x60,
+        Texture_1000x1000,
+        Texture_4000x4000,
+        Volume_250x250x16,
+    };
+
+    enum class DataLayout {
+        // The rows and images are tightly packed in the data.
+        Tight,
+        // The rows are padded to 256 bytes, and the images have 4 extra rows.
+        Padded,
+    };
+
+    struct TextureUploadParams : AdapterTestParam {
+        TextureUploadParams(const AdapterTestParam& param,
+                            UploadSize uploadSize,
+                            DataLayout dataLayout)
+            : AdapterTestParam(param), uploadSize(uploadSize), dataLayout(dataLayout) {
+        }
+
+        UploadSize uploadSize;
+        DataLayout dataLayout;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const TextureUploadParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.uploadSize) {
+            case UploadSize::Tile_60x60:
+                ostream << "_Tile_60x60";
+                break;
+            case UploadSize::Texture_1000x1000:
+                ostream << "_Texture_1000x1000";
+                break;
+            case UploadSize::Texture_4000x4000:
+                ostream << "_Texture_4000x4000";
+                break;
+            case UploadSize::Volume_250x250x16:
+                ostream << "_Volume_250x250x16";
+                break;
+        }
+
+        switch (param.dataLayout) {
+            case DataLayout::Tight:
+                ostream << "_Tight";
+                break;
+            case DataLayout::Padded:
+                ostream << "_Padded";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the CPU cost of uploading RGBA8 texture data with Queue::WriteTexture, which repacks the
+// rows of the data to the row pitch of the staging memory.
+class TextureUploadPerf : public DawnPerfTestWithParams<TextureUploadParams> {
+  public:
+    TextureUploadPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~TextureUploadPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Texture mTexture;
+    wgpu::Extent3D mSize;
+    wgpu::TextureDataLayout mDataLayout;
+    std::vector<uint8_t> mData;
+};
+
+void TextureUploadPerf::SetUp() {
+    DawnPerfTestWithParams<TextureUploadParams>::SetUp();
+
+    wgpu::TextureDescriptor descriptor;
+    descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+    descriptor.usage = wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::Sampled;
+    switch (GetParam().uploadSize) {
+        case UploadSize::Tile_60x60:
+            mSize = {60, 60, 1};
+            break;
+        case UploadSize::Texture_1000x1000:
+            mSize = {1000, 1000, 1};
+            break;
+        case UploadSize::Texture_4000x4000:
+            mSize = {4000, 4000, 1};
+            break;
+        case UploadSize::Volume_250x250x16:
+            mSize = {250, 250, 16};
+            descriptor.dimension = wgpu::TextureDimension::e3D;
+            break;
+    }
+    descriptor.size = mSize;
+    mTexture = device.CreateTexture(&descriptor);
+
+    constexpr uint32_t kBytesPerTexel = 4;
+    mDataLayout.offset = 0;
+    switch (GetParam().dataLayout) {
+        case DataLayout::Tight:
+            mDataLayout.bytesPerRow = mSize.width * kBytesPerTexel;
+            mDataLayout.rowsPerImage = mSize.height;
+            break;
+        case DataLayout::Padded:
+            mDataLayout.bytesPerRow = Align(mSize.width * kBytesPerTexel, 256);
+            mDataLayout.rowsPerImage = mSize.height + 4;
+            break;
+    }
+
+    mData.resize(uint64_t(mDataLayout.bytesPerRow) * mDataLayout.rowsPerImage *
+                 mSize.depthOrArrayLayers);
+    for (size_t i = 0; i < mData.size(); ++i) {
+        mData[i] = static_cast<uint8_t>(i);
+    }
+}
+
+void TextureUploadPerf::Step() {
+    wgpu::ImageCopyTexture imageCopyTexture = {};
+    imageCopyTexture.texture = mTexture;
+
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        queue.WriteTexture(&imageCopyTexture, mData.data(), mData.size(), &mDataLayout, &mSize);
+    }
+    // Make sure all WriteTexture's are flushed.
+    queue.Submit(0, nullptr);
+}
+
+TEST_P(TextureUploadPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(
+    TextureUploadPerf,
+    {D3D12Backend(), D3D12Backend({"use_worker_threads_for_large_texture_uploads"}),
+     MetalBackend(), NullBackend(), NullBackend({"use_worker_threads_for_large_texture_uploads"}),
+     OpenGLBackend(), VulkanBackend(),
+     VulkanBackend({"use_worker_threads_for_large_texture_uploads"})},
+    {UploadSize::Tile_60x60, UploadSize::Texture_1000x1000, UploadSize::Texture_4000x4000,
+     UploadSize::Volume_250x250x16},
+    {DataLayout::Tight, DataLayout::Padded});
@@ -0,0 +1,129 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumObjects = 1000;
+
+    // The number of buffers kept alive by the Interleaved variant.
+    constexpr unsigned int kNumLiveBuffers = 10000;
+
+    enum class ChurnPattern {
+        // Objects are destroyed right after their creation, like command encoders.
+        Transient,
+        // Objects are destroyed in an order unrelated to their creation, among many live objects.
+        Interleaved,
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ChurnPattern& pattern) {
+        switch (pattern) {
+            case ChurnPattern::Transient:
+                ostream << "Transient";
+                break;
+            case ChurnPattern::Interleaved:
+                ostream << "Interleaved";
+                break;
+        }
+        return ostream;
+    }
+
+    struct WireObjectChurnParams : AdapterTestParam {
+        WireObjectChurnParams(const AdapterTestParam& param, ChurnPattern pattern)
+            : AdapterTestParam(param), pattern(pattern) {
+        }
+
+        ChurnPattern pattern;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireObjectChurnParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_" << param.pattern;
+        return ostream;
+    }
+
+}  // anonymous namespace
+
+// Test the CPU cost of creating and destroying many objects through the wire, for long-running
+// applications that create transient objects every frame. Each object costs an ID on the client,
+// a slot on the server and an entry in the list of children of its device.
+class WireObjectChurnPerf : public DawnPerfTestWithParams<WireObjectChurnParams> {
+  public:
+    WireObjectChurnPerf() : DawnPerfTestWithParams(kNumObjects, 1) {
+    }
+    ~WireObjectChurnPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::BufferDescriptor mBufferDescriptor;
+    std::vector<wgpu::Buffer> mLiveBuffers;
+    unsigned int mNextBufferToReplace = 0;
+};
+
+void WireObjectChurnPerf::SetUp() {
+    DawnPerfTestWithParams<WireObjectChurnParams>::SetUp();
+
+    // Only the wire allocates IDs and tracks the children of devices.
+    DAWN_SKIP_TEST_IF(!UsesWire());
+
+    mBufferDescriptor.size = 16;
+    mBufferDescriptor.usage = wgpu::BufferUsage::CopyDst;
+    if (GetParam().pattern == ChurnPattern::Interleaved) {
+        mLiveBuffers.resize(kNumLiveBuffers);
+        for (wgpu::Buffer& buffer : mLiveBuffers) {
+            buffer = device.CreateBuffer(&mBufferDescriptor);
+        }
+    }
+}
+
+void WireObjectChurnPerf::Step() {
+    switch (GetParam().pattern) {
+        case ChurnPattern::Transient: {
+            for (unsigned int i = 0; i < kNumObjects; ++i) {
+                wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+                wgpu::CommandBuffer commands = encoder.Finish();
+            }
+            break;
+        }
+
+        case ChurnPattern::Interleaved: {
+            // Replace buffers with a stride that is coprime with the number of live buffers so
+            // that their IDs are freed in a scattered order.
+            constexpr unsigned int kStride = 7919;
+            for (unsigned int i = 0; i < kNumObjects; ++i) {
+                mNextBufferToReplace = (mNextBufferToReplace + kStride) % kNumLiveBuffers;
+                mLiveBuffers[mNextBufferToReplace] = device.CreateBuffer(&mBufferDescriptor);
+            }
+            break;
+        }
+    }
+
+    FlushWire();
+}
+
+TEST_P(WireObjectChurnPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(WireObjectChurnPerf,
+                                   {NullBackend()},
+                                   {ChurnPattern::Transient, ChurnPattern::Interleaved});
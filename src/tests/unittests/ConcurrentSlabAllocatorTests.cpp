@@ -0,0 +1,156 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/ConcurrentSlabAllocator.h"
+#include "common/Math.h"
+
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    struct Foo : public PlacementAllocated {
+        Foo(int value) : value(value) {
+        }
+
+        int value;
+    };
+
+    struct alignas(256) AlignedFoo : public Foo {
+        using Foo::Foo;
+    };
+
+}  // namespace
+
+// Test that a slab allocator of a single object works.
+TEST(ConcurrentSlabAllocatorTests, Single) {
+    ConcurrentSlabAllocator<Foo> allocator(1 * sizeof(Foo));
+
+    Foo* obj = allocator.Allocate(4);
+    EXPECT_EQ(obj->value, 4);
+
+    allocator.Deallocate(obj);
+}
+
+// Allocate multiple objects over several slabs and check their data and alignment are correct.
+TEST(ConcurrentSlabAllocatorTests, AllocateSequential) {
+    ConcurrentSlabAllocator<AlignedFoo> allocator(9 * sizeof(AlignedFoo));
+
+    std::vector<AlignedFoo*> objects;
+    for (int i = 0; i < 100; ++i) {
+        auto* ptr = allocator.Allocate(i);
+        EXPECT_TRUE(std::find(objects.begin(), objects.end(), ptr) == objects.end());
+        objects.push_back(ptr);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        // Check that the value is correct and hasn't been trampled.
+        EXPECT_EQ(objects[i]->value, i);
+
+        // Check that the alignment is correct.
+        EXPECT_TRUE(IsPtrAligned(objects[i], 256));
+    }
+
+    for (AlignedFoo* object : objects) {
+        allocator.Deallocate(object);
+    }
+}
+
+// Test that when reallocating objects on the same thread, all memory is reused, including the
+// blocks that went through the depot.
+TEST(ConcurrentSlabAllocatorTests, ReusesFreedMemory) {
+    ConcurrentSlabAllocator<Foo> allocator(1000 * sizeof(Foo));
+
+    std::set<Foo*> objects;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(objects.insert(allocator.Allocate(i)).second);
+    }
+    for (Foo* object : objects) {
+        allocator.Deallocate(object);
+    }
+
+    std::set<Foo*> reallocatedObjects;
+    for (int i = 0; i < 1000; ++i) {
+        Foo* ptr = allocator.Allocate(i);
+        EXPECT_TRUE(reallocatedObjects.insert(ptr).second);
+        EXPECT_TRUE(objects.find(ptr) != objects.end());
+    }
+
+    for (Foo* object : reallocatedObjects) {
+        allocator.Deallocate(object);
+    }
+}
+
+// Test allocating and deallocating from many threads at the same time, with objects deallocated
+// by other threads than the ones that allocated them.
+TEST(ConcurrentSlabAllocatorTests, MultipleThreads) {
+    // More threads than caches so that some threads share caches.
+    constexpr uint32_t kThreadCount = ConcurrentSlabAllocatorImpl::kCacheCount + 8;
+    constexpr int kObjectsPerThread = 2000;
+
+    ConcurrentSlabAllocator<Foo> allocator(64 * sizeof(Foo));
+
+    // Each thread allocates objects, deallocates half of them, and keeps the others for another
+    // thread to deallocate.
+    std::vector<std::vector<Foo*>> keptObjects(kThreadCount);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&allocator, &keptObjects, t]() {
+            std::vector<Foo*> objects;
+            for (int i = 0; i < kObjectsPerThread; ++i) {
+                objects.push_back(allocator.Allocate(static_cast<int>(t) * kObjectsPerThread + i));
+            }
+            for (int i = 0; i < kObjectsPerThread; ++i) {
+                EXPECT_EQ(objects[i]->value, static_cast<int>(t) * kObjectsPerThread + i);
+                if (i % 2 == 0) {
+                    allocator.Deallocate(objects[i]);
+                } else {
+                    keptObjects[t].push_back(objects[i]);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // All the kept objects are distinct and weren't trampled.
+    std::set<Foo*> allObjects;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        for (Foo* object : keptObjects[t]) {
+            EXPECT_TRUE(allObjects.insert(object).second);
+            EXPECT_EQ(object->value / kObjectsPerThread, static_cast<int>(t));
+        }
+    }
+
+    // Deallocate the kept objects from other threads while allocating new ones.
+    threads.clear();
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&allocator, &keptObjects, t]() {
+            for (Foo* object : keptObjects[(t + 1) % kThreadCount]) {
+                allocator.Deallocate(object);
+                Foo* newObject = allocator.Allocate(static_cast<int>(t));
+                EXPECT_EQ(newObject->value, static_cast<int>(t));
+                allocator.Deallocate(newObject);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
@@ -0,0 +1,126 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/ContentLessObjectCache.h"
+
+#include <memory>
+#include <vector>
+
+using namespace dawn_native;
+
+namespace {
+
+    // An object whose hash is configurable to force collisions.
+    struct CacheTestObject {
+        CacheTestObject(int value, size_t hash) : value(value), hash(hash) {
+        }
+
+        int value;
+        size_t hash;
+
+        struct HashFunc {
+            size_t operator()(const CacheTestObject* object) const {
+                return object->hash;
+            }
+        };
+        struct EqualityFunc {
+            bool operator()(const CacheTestObject* a, const CacheTestObject* b) const {
+                return a->value == b->value;
+            }
+        };
+    };
+
+    using TestCache = ContentLessObjectCache<CacheTestObject>;
+
+}  // anonymous namespace
+
+// Test inserting, finding and erasing objects.
+TEST(ContentLessObjectCacheTests, Basic) {
+    TestCache cache;
+    EXPECT_TRUE(cache.Empty());
+
+    CacheTestObject a(1, 1);
+    CacheTestObject sameAsA(1, 1);
+    CacheTestObject b(2, 2);
+
+    EXPECT_EQ(cache.Find(&a), nullptr);
+
+    EXPECT_EQ(cache.Insert(&a), std::make_pair(&a, true));
+    EXPECT_EQ(cache.Insert(&sameAsA), std::make_pair(&a, false));
+    EXPECT_EQ(cache.Insert(&b), std::make_pair(&b, true));
+    EXPECT_EQ(cache.Size(), 2u);
+
+    EXPECT_EQ(cache.Find(&sameAsA), &a);
+    EXPECT_EQ(cache.Find(&b), &b);
+
+    // Erasing is done by identity, not by value.
+    EXPECT_EQ(cache.Erase(&sameAsA), 0u);
+    EXPECT_EQ(cache.Erase(&a), 1u);
+    EXPECT_EQ(cache.Find(&sameAsA), nullptr);
+    EXPECT_EQ(cache.Find(&b), &b);
+
+    EXPECT_EQ(cache.Erase(&b), 1u);
+    EXPECT_TRUE(cache.Empty());
+}
+
+// Test looking up objects with a hash and a predicate instead of a blueprint.
+TEST(ContentLessObjectCacheTests, FindWithPredicate) {
+    TestCache cache;
+
+    CacheTestObject a(1, 42);
+    CacheTestObject b(2, 42);
+    cache.Insert(&a);
+    cache.Insert(&b);
+
+    EXPECT_EQ(cache.Find(42, [](const CacheTestObject* object) { return object->value == 2; }),
+              &b);
+    EXPECT_EQ(cache.Find(42, [](const CacheTestObject* object) { return object->value == 3; }),
+              nullptr);
+    EXPECT_EQ(cache.Find(43, [](const CacheTestObject*) { return true; }), nullptr);
+}
+
+// Test that erasing objects in the middle of colliding probe sequences keeps the other objects
+// reachable, while the cache grows.
+TEST(ContentLessObjectCacheTests, EraseWithCollisions) {
+    constexpr int kObjectCount = 200;
+
+    std::vector<std::unique_ptr<CacheTestObject>> objects;
+    TestCache cache;
+    for (int i = 0; i < kObjectCount; ++i) {
+        // Only a few distinct hashes so that there are long probe sequences, some of which
+        // wrap around the end of the table.
+        objects.push_back(std::make_unique<CacheTestObject>(i, static_cast<size_t>(i % 7) * 37));
+        ASSERT_TRUE(cache.Insert(objects.back().get()).second);
+    }
+
+    for (int i = 0; i < kObjectCount; i += 3) {
+        ASSERT_EQ(cache.Erase(objects[i].get()), 1u);
+    }
+
+    for (int i = 0; i < kObjectCount; ++i) {
+        CacheTestObject blueprint(i, objects[i]->hash);
+        if (i % 3 == 0) {
+            EXPECT_EQ(cache.Find(&blueprint), nullptr);
+        } else {
+            EXPECT_EQ(cache.Find(&blueprint), objects[i].get());
+        }
+    }
+
+    for (int i = 0; i < kObjectCount; ++i) {
+        cache.Erase(objects[i].get());
+    }
+    EXPECT_TRUE(cache.Empty());
+}
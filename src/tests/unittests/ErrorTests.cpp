@@ -40,7 +40,7 @@ namespace {
         ASSERT_TRUE(result.IsError());
 
         std::unique_ptr<ErrorData> errorData = result.AcquireError();
-        ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
+        ASSERT_STREQ(errorData->GetMessage(), dummyErrorMessage);
     }
 
     // Check returning a success ResultOrError with an implicit conversion
@@ -62,7 +62,7 @@ namespace {
         ASSERT_TRUE(result.IsError());
 
         std::unique_ptr<ErrorData> errorData = result.AcquireError();
-        ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
+        ASSERT_STREQ(errorData->GetMessage(), dummyErrorMessage);
     }
 
     // Check DAWN_TRY handles successes correctly.
@@ -98,7 +98,7 @@ namespace {
         ASSERT_TRUE(result.IsError());
 
         std::unique_ptr<ErrorData> errorData = result.AcquireError();
-        ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
+        ASSERT_STREQ(errorData->GetMessage(), dummyErrorMessage);
     }
 
     // Check DAWN_TRY adds to the backtrace.
@@ -115,6 +115,8 @@ namespace {
             return {};
         };
 
+        ScopedErrorBacktraces backtraces;
+
         MaybeError singleResult = SingleTry();
         ASSERT_TRUE(singleResult.IsError());
 
@@ -169,7 +171,7 @@ namespace {
         ASSERT_TRUE(result.IsError());
 
         std::unique_ptr<ErrorData> errorData = result.AcquireError();
-        ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
+        ASSERT_STREQ(errorData->GetMessage(), dummyErrorMessage);
     }
 
     // Check DAWN_TRY_ASSIGN adds to the backtrace.
@@ -188,6 +190,8 @@ namespace {
             return &dummySuccess;
         };
 
+        ScopedErrorBacktraces backtraces;
+
         ResultOrError<int*> singleResult = SingleTry();
         ASSERT_TRUE(singleResult.IsError());
 
@@ -218,7 +222,7 @@ namespace {
         ASSERT_TRUE(result.IsError());
 
         std::unique_ptr<ErrorData> errorData = result.AcquireError();
-        ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
+        ASSERT_STREQ(errorData->GetMessage(), dummyErrorMessage);
     }
 
     // Check a ResultOrError can be DAWN_TRY_ASSIGNED in a function that returns an Error
@@ -240,7 +244,7 @@ namespace {
         ASSERT_TRUE(result.IsError());
 
         std::unique_ptr<ErrorData> errorData = result.AcquireError();
-        ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
+        ASSERT_STREQ(errorData->GetMessage(), dummyErrorMessage);
     }
 
     // Check a MaybeError can be DAWN_TRIED in a function that returns an ResultOrError
@@ -257,7 +261,7 @@ namespace {
         ASSERT_TRUE(result.IsError());
 
         std::unique_ptr<ErrorData> errorData = result.AcquireError();
-        ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
+        ASSERT_STREQ(errorData->GetMessage(), dummyErrorMessage);
     }
 
     // Check a MaybeError can be DAWN_TRIED in a function that returns an ResultOrError
@@ -274,7 +278,46 @@ namespace {
         ASSERT_TRUE(result.IsError());
 
         std::unique_ptr<ErrorData> errorData = result.AcquireError();
-        ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
+        ASSERT_STREQ(errorData->GetMessage(), dummyErrorMessage);
+    }
+
+    // Check that string literal messages are not copied, while other messages are.
+    TEST(ErrorTests, StaticMessagesAreNotCopied) {
+        static constexpr char kStaticMessage[] = "I am a static error message";
+        std::unique_ptr<ErrorData> staticError = DAWN_VALIDATION_ERROR(kStaticMessage);
+        ASSERT_EQ(staticError->GetMessage(), kStaticMessage);
+
+        std::string dynamicMessage = "I am a dynamic error message";
+        std::unique_ptr<ErrorData> dynamicError = DAWN_VALIDATION_ERROR(dynamicMessage);
+        ASSERT_STREQ(dynamicError->GetMessage(), dynamicMessage.c_str());
+        ASSERT_NE(dynamicError->GetMessage(), dynamicMessage.c_str());
+
+        // Non-const arrays can be reused after the error is created, so they are copied.
+        char bufferMessage[] = "I am a buffer error message";
+        std::unique_ptr<ErrorData> bufferError = DAWN_VALIDATION_ERROR(bufferMessage);
+        bufferMessage[0] = 'X';
+        ASSERT_STREQ(bufferError->GetMessage(), "I am a buffer error message");
+    }
+
+    // Check that backtraces are only recorded while they are enabled.
+    TEST(ErrorTests, BacktracesOnlyRecordedWhenEnabled) {
+        auto ReturnError = []() -> MaybeError { return DAWN_VALIDATION_ERROR(dummyErrorMessage); };
+        auto Try = [ReturnError]() -> MaybeError {
+            DAWN_TRY(ReturnError());
+            return {};
+        };
+
+        ASSERT_FALSE(ErrorData::AreBacktracesEnabled());
+        ASSERT_TRUE(Try().AcquireError()->GetBacktrace().empty());
+
+        {
+            ScopedErrorBacktraces backtraces;
+            ASSERT_TRUE(ErrorData::AreBacktracesEnabled());
+            ASSERT_EQ(Try().AcquireError()->GetBacktrace().size(), 2u);
+        }
+
+        ASSERT_FALSE(ErrorData::AreBacktracesEnabled());
+        ASSERT_TRUE(Try().AcquireError()->GetBacktrace().empty());
     }
 
 }  // anonymous namespace
@@ -0,0 +1,240 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/ResourceHeapAllocator.h"
+#include "dawn_native/SegregatedFitMemoryAllocator.h"
+
+#include <vector>
+
+using namespace dawn_native;
+
+namespace {
+
+    class CountingResourceHeapAllocator : public ResourceHeapAllocator {
+      public:
+        ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(
+            uint64_t size) override {
+            mHeapCount++;
+            return std::make_unique<ResourceHeapBase>();
+        }
+        void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
+            mHeapCount--;
+        }
+
+        uint64_t GetHeapCount() const {
+            return mHeapCount;
+        }
+
+      private:
+        uint64_t mHeapCount = 0;
+    };
+
+    ResourceMemoryAllocation Allocate(SegregatedFitMemoryAllocator* allocator,
+                                      uint64_t allocationSize,
+                                      uint64_t alignment = 1) {
+        ResultOrError<ResourceMemoryAllocation> result =
+            allocator->Allocate(allocationSize, alignment);
+        return result.IsSuccess() ? result.AcquireSuccess() : ResourceMemoryAllocation{};
+    }
+
+}  // anonymous namespace
+
+// Verify that allocations of arbitrary sizes are packed in a single heap.
+TEST(SegregatedFitMemoryAllocatorTests, PacksAllocations) {
+    CountingResourceHeapAllocator heapAllocator;
+    SegregatedFitMemoryAllocator allocator(100, &heapAllocator);
+
+    // Cannot allocate more than the heap size, or nothing.
+    EXPECT_EQ(Allocate(&allocator, 101).GetInfo().mMethod, AllocationMethod::kInvalid);
+    EXPECT_EQ(Allocate(&allocator, 0).GetInfo().mMethod, AllocationMethod::kInvalid);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 0u);
+
+    ResourceMemoryAllocation a1 = Allocate(&allocator, 30);
+    ResourceMemoryAllocation a2 = Allocate(&allocator, 30);
+    ResourceMemoryAllocation a3 = Allocate(&allocator, 40);
+    EXPECT_EQ(a1.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+    EXPECT_EQ(a1.GetResourceHeap(), a2.GetResourceHeap());
+    EXPECT_EQ(a1.GetResourceHeap(), a3.GetResourceHeap());
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 1u);
+    EXPECT_EQ(allocator.GetUsedSize(), 100u);
+    EXPECT_EQ(allocator.GetFreeSize(), 0u);
+
+    // The heap is full so a new one is created.
+    ResourceMemoryAllocation a4 = Allocate(&allocator, 1);
+    EXPECT_NE(a4.GetResourceHeap(), a1.GetResourceHeap());
+    EXPECT_EQ(a4.GetOffset(), 0u);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 2u);
+
+    // Heaps are released as soon as they are empty.
+    allocator.Deallocate(a4);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 1u);
+
+    allocator.Deallocate(a1);
+    allocator.Deallocate(a2);
+    allocator.Deallocate(a3);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 0u);
+    EXPECT_EQ(allocator.GetHeapCount(), 0u);
+}
+
+// Verify that the offsets respect the alignment.
+TEST(SegregatedFitMemoryAllocatorTests, Alignment) {
+    CountingResourceHeapAllocator heapAllocator;
+    SegregatedFitMemoryAllocator allocator(256, &heapAllocator);
+
+    ResourceMemoryAllocation a1 = Allocate(&allocator, 3);
+    ResourceMemoryAllocation a2 = Allocate(&allocator, 16, 64);
+    EXPECT_EQ(a1.GetOffset(), 0u);
+    EXPECT_EQ(a2.GetOffset(), 64u);
+
+    // The padding before the aligned allocation can still be used.
+    ResourceMemoryAllocation a3 = Allocate(&allocator, 8);
+    EXPECT_LT(a3.GetOffset(), 64u);
+    EXPECT_EQ(a3.GetResourceHeap(), a1.GetResourceHeap());
+
+    allocator.Deallocate(a1);
+    allocator.Deallocate(a2);
+    allocator.Deallocate(a3);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 0u);
+}
+
+// Verify that the offsets are aligned relative to the start of their heap when the heap size isn't
+// a power of two.
+TEST(SegregatedFitMemoryAllocatorTests, AlignmentWithNonPowerOfTwoHeapSize) {
+    CountingResourceHeapAllocator heapAllocator;
+    SegregatedFitMemoryAllocator allocator(100, &heapAllocator);
+
+    // Fill the first heap so that the next allocations go in the second heap, which starts at 100
+    // in the range of all the heaps.
+    ResourceMemoryAllocation a1 = Allocate(&allocator, 100);
+    ResourceMemoryAllocation a2 = Allocate(&allocator, 10);
+    ResourceMemoryAllocation a3 = Allocate(&allocator, 16, 32);
+    EXPECT_NE(a2.GetResourceHeap(), a1.GetResourceHeap());
+    EXPECT_EQ(a3.GetResourceHeap(), a2.GetResourceHeap());
+    EXPECT_EQ(a2.GetOffset(), 0u);
+    EXPECT_EQ(a3.GetOffset(), 32u);
+
+    allocator.Deallocate(a1);
+    allocator.Deallocate(a2);
+    allocator.Deallocate(a3);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 0u);
+}
+
+// Verify that freed blocks are merged with their free neighbors.
+TEST(SegregatedFitMemoryAllocatorTests, MergeFreeBlocks) {
+    CountingResourceHeapAllocator heapAllocator;
+    SegregatedFitMemoryAllocator allocator(100, &heapAllocator);
+
+    std::vector<ResourceMemoryAllocation> allocations;
+    for (uint32_t i = 0; i < 10; ++i) {
+        allocations.push_back(Allocate(&allocator, 10));
+    }
+    EXPECT_EQ(allocator.GetLargestFreeBlockSize(), 0u);
+
+    // Free every other block: the free space is fragmented.
+    for (uint32_t i = 0; i < 10; i += 2) {
+        allocator.Deallocate(allocations[i]);
+    }
+    EXPECT_EQ(allocator.GetFreeSize(), 50u);
+    EXPECT_EQ(allocator.GetLargestFreeBlockSize(), 10u);
+
+    // Freeing the blocks in between merges the free blocks.
+    allocator.Deallocate(allocations[1]);
+    allocator.Deallocate(allocations[3]);
+    EXPECT_EQ(allocator.GetLargestFreeBlockSize(), 50u);
+
+    ResourceMemoryAllocation large = Allocate(&allocator, 50);
+    EXPECT_EQ(large.GetOffset(), 0u);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 1u);
+
+    allocator.Deallocate(large);
+    for (uint32_t i = 5; i < 10; i += 2) {
+        allocator.Deallocate(allocations[i]);
+    }
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 0u);
+}
+
+// Verify that blocks of different heaps are not merged together.
+TEST(SegregatedFitMemoryAllocatorTests, NoMergeAcrossHeaps) {
+    CountingResourceHeapAllocator heapAllocator;
+    SegregatedFitMemoryAllocator allocator(64, &heapAllocator);
+
+    ResourceMemoryAllocation a1 = Allocate(&allocator, 48);
+    ResourceMemoryAllocation a2 = Allocate(&allocator, 48);
+    ResourceMemoryAllocation a3 = Allocate(&allocator, 16);
+    ResourceMemoryAllocation a4 = Allocate(&allocator, 16);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 2u);
+    EXPECT_TRUE(allocator.OwnsHeap(a1.GetResourceHeap()));
+    EXPECT_EQ(a3.GetResourceHeap(), a1.GetResourceHeap());
+    EXPECT_EQ(a4.GetResourceHeap(), a2.GetResourceHeap());
+
+    // The end of the first heap and the start of the second one are free but not contiguous.
+    allocator.Deallocate(a3);
+    allocator.Deallocate(a2);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 2u);
+    EXPECT_EQ(allocator.GetLargestFreeBlockSize(), 48u);
+
+    ResourceMemoryAllocation a5 = Allocate(&allocator, 64);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 3u);
+
+    allocator.Deallocate(a1);
+    allocator.Deallocate(a4);
+    allocator.Deallocate(a5);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 0u);
+}
+
+// Verify that a sparse heap can be evacuated into the free space of the other heaps.
+TEST(SegregatedFitMemoryAllocatorTests, EvacuateHeap) {
+    CountingResourceHeapAllocator heapAllocator;
+    SegregatedFitMemoryAllocator allocator(100, &heapAllocator);
+
+    // A single heap is never evacuated.
+    ResourceMemoryAllocation a1 = Allocate(&allocator, 70);
+    EXPECT_EQ(allocator.FindHeapToEvacuate(), nullptr);
+
+    ResourceMemoryAllocation a2 = Allocate(&allocator, 70);
+    ResourceMemoryAllocation a3 = Allocate(&allocator, 20);
+    ResourceMemoryAllocation a4 = Allocate(&allocator, 20);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 2u);
+    EXPECT_EQ(a3.GetResourceHeap(), a1.GetResourceHeap());
+    EXPECT_EQ(a4.GetResourceHeap(), a2.GetResourceHeap());
+
+    // Both heaps are mostly full.
+    EXPECT_EQ(allocator.FindHeapToEvacuate(), nullptr);
+
+    // The second heap is sparse but the first one doesn't have room for its allocations.
+    allocator.Deallocate(a2);
+    EXPECT_EQ(allocator.FindHeapToEvacuate(), nullptr);
+
+    allocator.Deallocate(a3);
+    const ResourceHeapBase* heap = allocator.FindHeapToEvacuate();
+    EXPECT_EQ(heap, a4.GetResourceHeap());
+
+    // Allocations outside of the evacuated heap don't create heaps.
+    EXPECT_EQ(allocator.AllocateOutsideHeap(40, 1, heap).GetInfo().mMethod,
+              AllocationMethod::kInvalid);
+    ResourceMemoryAllocation a5 = allocator.AllocateOutsideHeap(20, 1, heap);
+    EXPECT_EQ(a5.GetResourceHeap(), a1.GetResourceHeap());
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 2u);
+
+    // Freeing the moved allocation releases the evacuated heap.
+    allocator.Deallocate(a4);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 1u);
+    EXPECT_EQ(allocator.GetUsedSize(), 90u);
+
+    allocator.Deallocate(a1);
+    allocator.Deallocate(a5);
+    EXPECT_EQ(heapAllocator.GetHeapCount(), 0u);
+}
@@ -17,6 +17,8 @@
 #include "common/SerialQueue.h"
 #include "common/TypedInteger.h"
 
+#include <memory>
+
 using TestSerialQueue = SerialQueue<uint64_t, int>;
 
 // A number of basic tests for SerialQueue that are difficult to split from one another
@@ -173,3 +175,64 @@ TEST(SerialQueue, TypedInteger) {
     }
     ASSERT_TRUE(expectedValues.empty());
 }
+
+// Test that the values stay in order when the queue wraps around its storage and grows.
+TEST(SerialQueue, WrapAroundAndGrow) {
+    TestSerialQueue queue;
+
+    uint64_t serial = 0;
+    int nextValue = 0;
+    int nextExpectedValue = 0;
+    for (int frame = 0; frame < 100; ++frame) {
+        // Enqueue an increasing number of values on a few serials, and clear the values of the
+        // oldest serials, so that the ring buffers are partially used, wrap and need to grow.
+        // Serials must be enqueued in increasing order.
+        for (int i = 0; i <= frame; ++i) {
+            queue.Enqueue(nextValue++, serial + i * 3 / (frame + 1));
+        }
+        serial += 3;
+
+        // Only clear once there are older serials than the ones just enqueued, otherwise
+        // serial - 4 would wrap around and clear the whole queue.
+        if (serial < 4) {
+            continue;
+        }
+        for (int value : queue.IterateUpTo(serial - 4)) {
+            EXPECT_EQ(value, nextExpectedValue++);
+        }
+        queue.ClearUpTo(serial - 4);
+        ASSERT_FALSE(queue.Empty());
+        EXPECT_EQ(queue.FirstSerial(), serial - 3);
+    }
+
+    for (int value : queue.IterateAll()) {
+        EXPECT_EQ(value, nextExpectedValue++);
+    }
+    EXPECT_EQ(nextExpectedValue, nextValue);
+}
+
+// Test that the values are destroyed when they are cleared and when the queue is destroyed.
+TEST(SerialQueue, ValuesAreDestroyed) {
+    std::shared_ptr<int> tracker = std::make_shared<int>(0);
+    {
+        SerialQueue<uint64_t, std::shared_ptr<int>> queue;
+        for (uint64_t serial = 0; serial < 40; ++serial) {
+            queue.Enqueue(tracker, serial);
+        }
+        EXPECT_EQ(tracker.use_count(), 41);
+
+        queue.ClearUpTo(9);
+        EXPECT_EQ(tracker.use_count(), 31);
+
+        SerialQueue<uint64_t, std::shared_ptr<int>> movedQueue = std::move(queue);
+        EXPECT_TRUE(queue.Empty());
+        EXPECT_EQ(movedQueue.FirstSerial(), 10u);
+
+        movedQueue.Clear();
+        EXPECT_EQ(tracker.use_count(), 1);
+
+        movedQueue.Enqueue(tracker, 50);
+        EXPECT_EQ(tracker.use_count(), 2);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
@@ -0,0 +1,134 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/TextureDataCopy.h"
+#include "dawn_platform/DawnPlatform.h"
+
+#include <vector>
+
+using namespace dawn_native;
+
+namespace {
+
+    constexpr uint8_t kUnwrittenValue = 0xCD;
+
+    TextureDataCopyLayout MakeLayout(uint32_t depth,
+                                     uint32_t rowsPerImage,
+                                     uint32_t bytesPerRow,
+                                     uint32_t srcBytesPerRow,
+                                     uint32_t dstBytesPerRow,
+                                     uint64_t srcImageAdditionalStride) {
+        TextureDataCopyLayout layout;
+        layout.depth = depth;
+        layout.rowsPerImage = rowsPerImage;
+        layout.bytesPerRow = bytesPerRow;
+        layout.srcBytesPerRow = srcBytesPerRow;
+        layout.dstBytesPerRow = dstBytesPerRow;
+        layout.srcImageAdditionalStride = srcImageAdditionalStride;
+        return layout;
+    }
+
+    class TextureDataCopyTests : public testing::Test {
+      protected:
+        // Copy with CopyTextureData and check the result against a simple row by row copy,
+        // including that the padding of the destination rows isn't written.
+        void DoTest(const TextureDataCopyLayout& layout,
+                    uint64_t dstOffset = 0,
+                    dawn_platform::WorkerTaskPool* workerTaskPool = nullptr) {
+            uint64_t srcSize =
+                layout.depth * (uint64_t(layout.rowsPerImage) * layout.srcBytesPerRow +
+                                layout.srcImageAdditionalStride);
+            uint64_t dstSize =
+                dstOffset + uint64_t(layout.depth) * layout.rowsPerImage * layout.dstBytesPerRow;
+
+            std::vector<uint8_t> src(srcSize);
+            for (uint64_t i = 0; i < srcSize; ++i) {
+                src[i] = static_cast<uint8_t>(i * 7 + i / 251);
+            }
+
+            std::vector<uint8_t> expected(dstSize, kUnwrittenValue);
+            const uint8_t* srcRow = src.data();
+            uint8_t* dstRow = expected.data() + dstOffset;
+            for (uint32_t d = 0; d < layout.depth; ++d) {
+                for (uint32_t h = 0; h < layout.rowsPerImage; ++h) {
+                    memcpy(dstRow, srcRow, layout.bytesPerRow);
+                    dstRow += layout.dstBytesPerRow;
+                    srcRow += layout.srcBytesPerRow;
+                }
+                srcRow += layout.srcImageAdditionalStride;
+            }
+
+            std::vector<uint8_t> dst(dstSize, kUnwrittenValue);
+            CopyTextureData(dst.data() + dstOffset, src.data(), layout, workerTaskPool);
+
+            ASSERT_EQ(dst.size(), expected.size());
+            for (uint64_t i = 0; i < dstSize; ++i) {
+                ASSERT_EQ(dst[i], expected[i]) << "at byte " << i;
+            }
+        }
+    };
+
+}  // anonymous namespace
+
+// Test copies where the rows and images are contiguous in both the source and the destination.
+TEST_F(TextureDataCopyTests, Contiguous) {
+    DoTest(MakeLayout(1, 1, 4, 4, 4, 0));
+    DoTest(MakeLayout(1, 16, 256, 256, 256, 0));
+    DoTest(MakeLayout(5, 3, 256, 256, 256, 0));
+}
+
+// Test copies where only the rows of each image are contiguous.
+TEST_F(TextureDataCopyTests, ContiguousRowsWithImagePadding) {
+    DoTest(MakeLayout(4, 3, 256, 256, 256, 512));
+    DoTest(MakeLayout(7, 1, 12, 12, 12, 4));
+}
+
+// Test copies where the source and destination rows have different pitches.
+TEST_F(TextureDataCopyTests, RowByRow) {
+    DoTest(MakeLayout(1, 8, 12, 12, 256, 0));
+    DoTest(MakeLayout(1, 8, 12, 20, 256, 0));
+    DoTest(MakeLayout(3, 5, 100, 128, 256, 3 * 128));
+    DoTest(MakeLayout(3, 5, 256, 256, 512, 0));
+}
+
+// Test large copies that use non-temporal stores, with destinations that aren't aligned to 16
+// bytes and rows that aren't multiples of 16 bytes.
+TEST_F(TextureDataCopyTests, LargeCopies) {
+    const uint32_t kRows = kNonTemporalTextureDataCopyThreshold / 1000 + 1;
+    DoTest(MakeLayout(1, kRows, 1000, 1000, 1000, 0));
+    DoTest(MakeLayout(1, kRows, 1000, 1000, 1000, 0), 3);
+    DoTest(MakeLayout(2, kRows, 1000, 1003, 1024, 7), 0);
+    DoTest(MakeLayout(2, kRows, 1000, 1003, 1024, 7), 9);
+}
+
+// Test that copies split over worker threads give the same result, including when the rows don't
+// split evenly between the tasks and when a task starts in the middle of an image.
+TEST_F(TextureDataCopyTests, WorkerTasks) {
+    dawn_platform::Platform platform;
+    std::unique_ptr<dawn_platform::WorkerTaskPool> pool = platform.CreateWorkerTaskPool();
+
+    const uint32_t kBytesPerRow = 4096;
+    const uint32_t kRows =
+        kMaxTextureDataCopyTasks * kMinTextureDataCopyTaskSize / kBytesPerRow + 3;
+    DoTest(MakeLayout(1, kRows, kBytesPerRow, kBytesPerRow, kBytesPerRow, 0), 0, pool.get());
+    DoTest(MakeLayout(3, kRows / 3, kBytesPerRow, kBytesPerRow, kBytesPerRow, 256), 0,
+           pool.get());
+    DoTest(MakeLayout(5, kRows / 5, kBytesPerRow - 4, kBytesPerRow, kBytesPerRow, 0), 4,
+           pool.get());
+
+    // Copies too small to be split are still done correctly.
+    DoTest(MakeLayout(1, 2, kBytesPerRow, kBytesPerRow, kBytesPerRow, 0), 0, pool.get());
+}
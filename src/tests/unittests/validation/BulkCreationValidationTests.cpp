@@ -0,0 +1,184 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/WGPUHelpers.h"
+
+#include <array>
+
+// The bulk creation functions are only exposed by dawn_native and return its objects, so these
+// tests don't run with the wire.
+class BulkCreationValidationTest : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+        DAWN_SKIP_TEST_IF(UsesWire());
+    }
+
+    wgpu::BufferDescriptor BufferDescriptor(wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = 16;
+        descriptor.usage = usage;
+        return descriptor;
+    }
+
+    template <size_t N>
+    std::array<wgpu::Buffer, N> CreateBuffers(
+        const std::array<wgpu::BufferDescriptor, N>& descriptors) {
+        std::array<WGPUBuffer, N> handles;
+        dawn_native::CreateBuffers(
+            backendDevice, N, reinterpret_cast<const WGPUBufferDescriptor*>(descriptors.data()),
+            handles.data());
+
+        std::array<wgpu::Buffer, N> buffers;
+        for (size_t i = 0; i < N; ++i) {
+            buffers[i] = wgpu::Buffer::Acquire(handles[i]);
+        }
+        return buffers;
+    }
+
+    // Returns whether writing to the buffer produces an error, as it does for error buffers.
+    bool IsErrorBuffer(const wgpu::Buffer& buffer) {
+        uint32_t data = 0;
+        StartExpectDeviceError();
+        device.GetQueue().WriteBuffer(buffer, 0, &data, sizeof(data));
+        return EndExpectDeviceError();
+    }
+};
+
+// Test that valid buffer descriptors create valid buffers.
+TEST_F(BulkCreationValidationTest, Buffers) {
+    std::array<wgpu::BufferDescriptor, 3> descriptors = {
+        BufferDescriptor(wgpu::BufferUsage::CopyDst),
+        BufferDescriptor(wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform),
+        BufferDescriptor(wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Vertex),
+    };
+    std::array<wgpu::Buffer, 3> buffers = CreateBuffers(descriptors);
+
+    for (const wgpu::Buffer& buffer : buffers) {
+        ASSERT_NE(buffer, nullptr);
+        ASSERT_FALSE(IsErrorBuffer(buffer));
+    }
+}
+
+// Test that an invalid descriptor produces a single error and an error buffer, without affecting
+// the other buffers.
+TEST_F(BulkCreationValidationTest, BuffersWithAnInvalidDescriptor) {
+    std::array<wgpu::BufferDescriptor, 3> descriptors = {
+        BufferDescriptor(wgpu::BufferUsage::CopyDst),
+        // MapRead can only be combined with CopyDst.
+        BufferDescriptor(wgpu::BufferUsage::MapRead | wgpu::BufferUsage::Uniform),
+        BufferDescriptor(wgpu::BufferUsage::CopyDst),
+    };
+    std::array<wgpu::Buffer, 3> buffers;
+    ASSERT_DEVICE_ERROR(buffers = CreateBuffers(descriptors));
+
+    ASSERT_FALSE(IsErrorBuffer(buffers[0]));
+    ASSERT_TRUE(IsErrorBuffer(buffers[1]));
+    ASSERT_FALSE(IsErrorBuffer(buffers[2]));
+}
+
+// Test that the buffers created with mappedAtCreation are mapped.
+TEST_F(BulkCreationValidationTest, BuffersMappedAtCreation) {
+    std::array<wgpu::BufferDescriptor, 2> descriptors = {
+        BufferDescriptor(wgpu::BufferUsage::Uniform),
+        BufferDescriptor(wgpu::BufferUsage::MapWrite | wgpu::BufferUsage::CopySrc),
+    };
+    for (wgpu::BufferDescriptor& descriptor : descriptors) {
+        descriptor.mappedAtCreation = true;
+    }
+    std::array<wgpu::Buffer, 2> buffers = CreateBuffers(descriptors);
+
+    for (const wgpu::Buffer& buffer : buffers) {
+        ASSERT_NE(buffer.GetMappedRange(), nullptr);
+        buffer.Unmap();
+    }
+}
+
+// Test that an invalid texture descriptor produces a single error and an error texture.
+TEST_F(BulkCreationValidationTest, TexturesWithAnInvalidDescriptor) {
+    std::array<wgpu::TextureDescriptor, 3> descriptors;
+    for (wgpu::TextureDescriptor& descriptor : descriptors) {
+        descriptor.size = {4, 4, 1};
+        descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+        descriptor.usage = wgpu::TextureUsage::Sampled;
+    }
+    // The size of a texture can't be 0.
+    descriptors[1].size.width = 0;
+
+    std::array<WGPUTexture, 3> handles;
+    ASSERT_DEVICE_ERROR(dawn_native::CreateTextures(
+        backendDevice, 3, reinterpret_cast<const WGPUTextureDescriptor*>(descriptors.data()),
+        handles.data()));
+
+    std::array<wgpu::Texture, 3> textures;
+    for (size_t i = 0; i < 3; ++i) {
+        textures[i] = wgpu::Texture::Acquire(handles[i]);
+    }
+    textures[0].CreateView();
+    ASSERT_DEVICE_ERROR(textures[1].CreateView());
+    textures[2].CreateView();
+}
+
+// Test that an invalid bind group descriptor produces a single error and an error bind group.
+TEST_F(BulkCreationValidationTest, BindGroupsWithAnInvalidDescriptor) {
+    wgpu::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform}});
+    wgpu::BufferDescriptor uniformDescriptor = BufferDescriptor(wgpu::BufferUsage::Uniform);
+    wgpu::Buffer uniformBuffer = device.CreateBuffer(&uniformDescriptor);
+    wgpu::BufferDescriptor copyDescriptor = BufferDescriptor(wgpu::BufferUsage::CopyDst);
+    wgpu::Buffer copyBuffer = device.CreateBuffer(&copyDescriptor);
+
+    std::array<wgpu::BindGroupEntry, 3> entries;
+    std::array<wgpu::BindGroupDescriptor, 3> descriptors;
+    for (size_t i = 0; i < 3; ++i) {
+        entries[i].binding = 0;
+        entries[i].buffer = uniformBuffer;
+        entries[i].size = 16;
+        descriptors[i].layout = layout;
+        descriptors[i].entryCount = 1;
+        descriptors[i].entries = &entries[i];
+    }
+    // The buffer of a uniform binding must have the Uniform usage.
+    entries[1].buffer = copyBuffer;
+
+    std::array<WGPUBindGroup, 3> handles;
+    ASSERT_DEVICE_ERROR(dawn_native::CreateBindGroups(
+        backendDevice, 3, reinterpret_cast<const WGPUBindGroupDescriptor*>(descriptors.data()),
+        handles.data()));
+
+    std::array<wgpu::BindGroup, 3> bindGroups;
+    for (size_t i = 0; i < 3; ++i) {
+        bindGroups[i] = wgpu::BindGroup::Acquire(handles[i]);
+    }
+
+    auto TestSetBindGroup = [&](const wgpu::BindGroup& bindGroup) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetBindGroup(0, bindGroup);
+        pass.EndPass();
+        encoder.Finish();
+    };
+    TestSetBindGroup(bindGroups[0]);
+    ASSERT_DEVICE_ERROR(TestSetBindGroup(bindGroups[1]));
+    TestSetBindGroup(bindGroups[2]);
+}
+
+// Test that creating no objects is valid.
+TEST_F(BulkCreationValidationTest, Empty) {
+    dawn_native::CreateBuffers(backendDevice, 0, nullptr, nullptr);
+    dawn_native::CreateTextures(backendDevice, 0, nullptr, nullptr);
+    dawn_native::CreateBindGroups(backendDevice, 0, nullptr, nullptr);
+}
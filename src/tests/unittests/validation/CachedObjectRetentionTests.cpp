@@ -0,0 +1,112 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+namespace {
+
+    class CachedObjectRetentionTest : public ValidationTest {
+      protected:
+        WGPUDevice CreateTestDevice() override {
+            dawn_native::DeviceDescriptor descriptor;
+            descriptor.samplerRetention.maxCount = 2;
+            return adapter.CreateDevice(&descriptor);
+        }
+
+        wgpu::Sampler CreateSampler(float lodMaxClamp) {
+            wgpu::SamplerDescriptor descriptor;
+            descriptor.lodMaxClamp = lodMaxClamp;
+            return device.CreateSampler(&descriptor);
+        }
+
+        dawn_native::CachedObjectRetentionStats GetSamplerStats() {
+            FlushWire();
+            return dawn_native::GetCachedObjectsRetentionStats(backendDevice).samplers;
+        }
+    };
+
+    // Test that a released sampler is kept alive and found again on recreation.
+    TEST_F(CachedObjectRetentionTest, ReleasedObjectIsReused) {
+        CreateSampler(1.0f);
+        EXPECT_EQ(GetSamplerStats().misses, 1u);
+
+        CreateSampler(1.0f);
+        dawn_native::CachedObjectRetentionStats stats = GetSamplerStats();
+        EXPECT_EQ(stats.misses, 1u);
+        EXPECT_EQ(stats.hits, 1u);
+    }
+
+    // Test that a hit is only counted when the object would have been destroyed otherwise.
+    TEST_F(CachedObjectRetentionTest, LiveObjectIsNotAHit) {
+        wgpu::Sampler sampler = CreateSampler(1.0f);
+        wgpu::Sampler sameSampler = CreateSampler(1.0f);
+        EXPECT_EQ(GetSamplerStats().hits, 0u);
+    }
+
+    // Test that released objects past the count budget are evicted on Tick, least recently used
+    // first.
+    TEST_F(CachedObjectRetentionTest, EvictionOnTick) {
+        CreateSampler(1.0f);
+        CreateSampler(2.0f);
+        CreateSampler(3.0f);
+
+        device.Tick();
+        dawn_native::CachedObjectRetentionStats stats = GetSamplerStats();
+        EXPECT_EQ(stats.evictions, 1u);
+        EXPECT_EQ(stats.retainedCount, 2u);
+        EXPECT_GT(stats.retainedBytes, 0u);
+
+        // The first sampler was evicted, the last one is still retained.
+        CreateSampler(1.0f);
+        CreateSampler(3.0f);
+        stats = GetSamplerStats();
+        EXPECT_EQ(stats.misses, 4u);
+        EXPECT_EQ(stats.hits, 1u);
+    }
+
+    // Test that objects still in use don't count against the budget, so that released objects
+    // are retained even when more objects than the budget are alive.
+    TEST_F(CachedObjectRetentionTest, LiveObjectsDontCountAgainstBudget) {
+        wgpu::Sampler sampler1 = CreateSampler(1.0f);
+        wgpu::Sampler sampler2 = CreateSampler(2.0f);
+        wgpu::Sampler sampler3 = CreateSampler(3.0f);
+        CreateSampler(4.0f);
+        CreateSampler(5.0f);
+
+        device.Tick();
+        dawn_native::CachedObjectRetentionStats stats = GetSamplerStats();
+        EXPECT_EQ(stats.evictions, 0u);
+        EXPECT_EQ(stats.retainedCount, 2u);
+
+        CreateSampler(4.0f);
+        CreateSampler(5.0f);
+        stats = GetSamplerStats();
+        EXPECT_EQ(stats.misses, 5u);
+        EXPECT_EQ(stats.hits, 2u);
+    }
+
+    // Test that all released objects can be dropped explicitly, while live objects are kept.
+    TEST_F(CachedObjectRetentionTest, ReleaseRetainedCachedObjects) {
+        wgpu::Sampler sampler = CreateSampler(1.0f);
+        CreateSampler(2.0f);
+
+        FlushWire();
+        dawn_native::ReleaseRetainedCachedObjects(backendDevice);
+        EXPECT_EQ(GetSamplerStats().evictions, 1u);
+
+        CreateSampler(2.0f);
+        EXPECT_EQ(GetSamplerStats().misses, 3u);
+    }
+
+}  // anonymous namespace
@@ -0,0 +1,78 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include <limits>
+
+namespace {
+
+    constexpr uint64_t kWaitForever = std::numeric_limits<uint64_t>::max();
+
+    class DeviceWaitForPendingWorkTest : public ValidationTest {
+      protected:
+        bool WaitForPendingWork(uint64_t timeoutNs) {
+            FlushWire();
+            bool completed = dawn_native::DeviceWaitForPendingWork(backendDevice, timeoutNs);
+            // Send the callbacks fired by the server back to the client.
+            FlushWire();
+            return completed;
+        }
+    };
+
+    // Test that waiting without pending work returns immediately.
+    TEST_F(DeviceWaitForPendingWorkTest, NoPendingWork) {
+        EXPECT_TRUE(WaitForPendingWork(0));
+    }
+
+    // Test that the map callback is fired by the wait, without ticking the device.
+    TEST_F(DeviceWaitForPendingWorkTest, MapAsync) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = 4;
+        descriptor.usage = wgpu::BufferUsage::MapRead;
+        wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+
+        bool done = false;
+        buffer.MapAsync(
+            wgpu::MapMode::Read, 0, 4,
+            [](WGPUBufferMapAsyncStatus status, void* userdata) {
+                EXPECT_EQ(status, WGPUBufferMapAsyncStatus_Success);
+                *static_cast<bool*>(userdata) = true;
+            },
+            &done);
+
+        EXPECT_TRUE(WaitForPendingWork(kWaitForever));
+        EXPECT_TRUE(done);
+    }
+
+    // Test that the work done callback is fired by the wait, without ticking the device.
+    TEST_F(DeviceWaitForPendingWorkTest, OnSubmittedWorkDone) {
+        wgpu::Queue queue = device.GetQueue();
+        wgpu::CommandBuffer commands = device.CreateCommandEncoder().Finish();
+        queue.Submit(1, &commands);
+
+        bool done = false;
+        queue.OnSubmittedWorkDone(
+            0u,
+            [](WGPUQueueWorkDoneStatus status, void* userdata) {
+                EXPECT_EQ(status, WGPUQueueWorkDoneStatus_Success);
+                *static_cast<bool*>(userdata) = true;
+            },
+            &done);
+
+        EXPECT_TRUE(WaitForPendingWork(kWaitForever));
+        EXPECT_TRUE(done);
+    }
+
+}  // anonymous namespace
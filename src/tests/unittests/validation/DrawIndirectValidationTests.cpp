@@ -160,3 +160,186 @@ TEST_F(DrawIndirectValidationTest, IndirectUsage) {
     TestIndirectOffset(utils::Expectation::Failure, {1, 2, 3, 4, 5}, 0, true,
                        wgpu::BufferUsage::Vertex);
 }
+
+class MultiDrawIndirectValidationTest : public DrawIndirectValidationTest {
+  protected:
+    WGPUDevice CreateTestDevice() override {
+        dawn_native::DeviceDescriptor descriptor;
+        descriptor.requiredExtensions = GetRequiredExtensions();
+        descriptor.forceDisabledToggles.push_back("disallow_unsafe_apis");
+        return adapter.CreateDevice(&descriptor);
+    }
+
+    virtual std::vector<const char*> GetRequiredExtensions() {
+        return {"multi_draw_indirect", "draw_indirect_count"};
+    }
+
+    void TestMultiDraw(utils::Expectation expectation,
+                       uint64_t indirectBufferSize,
+                       uint64_t indirectOffset,
+                       uint32_t maxDrawCount,
+                       wgpu::Buffer drawCountBuffer = nullptr,
+                       uint64_t drawCountBufferOffset = 0,
+                       wgpu::BufferUsage usage = wgpu::BufferUsage::Indirect) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = indirectBufferSize;
+        descriptor.usage = usage;
+        wgpu::Buffer indirectBuffer = device.CreateBuffer(&descriptor);
+
+        wgpu::Buffer indexBuffer = CreateIndexBuffer();
+
+        DummyRenderPass renderPass(device);
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(pipeline);
+        pass.SetIndexBuffer(indexBuffer, wgpu::IndexFormat::Uint32);
+        pass.MultiDrawIndexedIndirect(indirectBuffer, indirectOffset, maxDrawCount,
+                                      drawCountBuffer, drawCountBufferOffset);
+        pass.EndPass();
+
+        ValidateExpectation(encoder, expectation);
+    }
+
+    wgpu::Buffer CreateIndexBuffer() {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = 400;
+        descriptor.usage = wgpu::BufferUsage::Index;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    wgpu::Buffer CreateDrawCountBuffer(uint64_t size,
+                                       wgpu::BufferUsage usage = wgpu::BufferUsage::Indirect) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.usage = usage;
+        return device.CreateBuffer(&descriptor);
+    }
+};
+
+// Verify that all the draws of a multi draw must be in the indirect buffer.
+TEST_F(MultiDrawIndirectValidationTest, IndirectOffsetBounds) {
+    constexpr uint64_t kDrawSize = 5 * sizeof(uint32_t);
+
+    // In bounds
+    TestMultiDraw(utils::Expectation::Success, kDrawSize, 0, 1);
+    TestMultiDraw(utils::Expectation::Success, 10 * kDrawSize, 0, 10);
+    TestMultiDraw(utils::Expectation::Success, 10 * kDrawSize, 4 * kDrawSize, 6);
+    TestMultiDraw(utils::Expectation::Success, 10 * kDrawSize + 4, 4, 10);
+
+    // Zero draws are valid
+    TestMultiDraw(utils::Expectation::Success, kDrawSize, 0, 0);
+
+    // Non-multiple of 4 offsets
+    TestMultiDraw(utils::Expectation::Failure, 10 * kDrawSize, 2, 2);
+
+    // Out of bounds, the last draw doesn't fit
+    TestMultiDraw(utils::Expectation::Failure, 10 * kDrawSize - 4, 0, 10);
+    TestMultiDraw(utils::Expectation::Failure, 10 * kDrawSize, 4, 10);
+    // Out of bounds, offset past the buffer
+    TestMultiDraw(utils::Expectation::Failure, kDrawSize, 2 * kDrawSize, 0);
+    // Out of bounds, offset + size of the draws overflows
+    TestMultiDraw(utils::Expectation::Failure, 10 * kDrawSize,
+                  std::numeric_limits<uint64_t>::max() - 3, 1);
+    TestMultiDraw(utils::Expectation::Failure, 10 * kDrawSize, 0,
+                  std::numeric_limits<uint32_t>::max());
+}
+
+// Check that the indirect buffer must have the indirect usage.
+TEST_F(MultiDrawIndirectValidationTest, IndirectUsage) {
+    TestMultiDraw(utils::Expectation::Failure, 100, 0, 2, nullptr, 0, wgpu::BufferUsage::Vertex);
+}
+
+// Check that the max draw count is limited by the maxDrawIndirectCount of the adapter.
+TEST_F(MultiDrawIndirectValidationTest, MaxDrawIndirectCount) {
+    constexpr uint64_t kDrawSize = 5 * sizeof(uint32_t);
+    const uint32_t maxDrawIndirectCount = adapter.GetAdapterProperties().maxDrawIndirectCount;
+    ASSERT_LT(maxDrawIndirectCount, std::numeric_limits<uint32_t>::max());
+
+    // The indirect buffer is large enough for all the draws so that only the limit fails.
+    const uint64_t indirectBufferSize = (uint64_t(maxDrawIndirectCount) + 1) * kDrawSize;
+    TestMultiDraw(utils::Expectation::Success, indirectBufferSize, 0, maxDrawIndirectCount);
+    TestMultiDraw(utils::Expectation::Failure, indirectBufferSize, 0, maxDrawIndirectCount + 1);
+
+    // The limit also applies when the draw count buffer holds the number of draws.
+    TestMultiDraw(utils::Expectation::Success, indirectBufferSize, 0, maxDrawIndirectCount,
+                  CreateDrawCountBuffer(4), 0);
+    TestMultiDraw(utils::Expectation::Failure, indirectBufferSize, 0, maxDrawIndirectCount + 1,
+                  CreateDrawCountBuffer(4), 0);
+}
+
+// Check the validation of the draw count buffer.
+TEST_F(MultiDrawIndirectValidationTest, DrawCountBuffer) {
+    // In bounds
+    TestMultiDraw(utils::Expectation::Success, 100, 0, 5, CreateDrawCountBuffer(4), 0);
+    TestMultiDraw(utils::Expectation::Success, 100, 0, 5, CreateDrawCountBuffer(16), 12);
+
+    // Non-multiple of 4 offsets
+    TestMultiDraw(utils::Expectation::Failure, 100, 0, 5, CreateDrawCountBuffer(16), 2);
+
+    // Out of bounds
+    TestMultiDraw(utils::Expectation::Failure, 100, 0, 5, CreateDrawCountBuffer(2), 0);
+    TestMultiDraw(utils::Expectation::Failure, 100, 0, 5, CreateDrawCountBuffer(16), 16);
+    TestMultiDraw(utils::Expectation::Failure, 100, 0, 5, CreateDrawCountBuffer(16),
+                  std::numeric_limits<uint64_t>::max() - 3);
+
+    // The draw count buffer must have the indirect usage
+    TestMultiDraw(utils::Expectation::Failure, 100, 0, 5,
+                  CreateDrawCountBuffer(4, wgpu::BufferUsage::Vertex), 0);
+}
+
+// Check that multi draws can be used in render bundles.
+TEST_F(MultiDrawIndirectValidationTest, RenderBundle) {
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 100;
+    descriptor.usage = wgpu::BufferUsage::Indirect;
+    wgpu::Buffer indirectBuffer = device.CreateBuffer(&descriptor);
+
+    DummyRenderPass renderPass(device);
+    wgpu::RenderBundleEncoderDescriptor bundleDesc = {};
+    bundleDesc.colorFormatsCount = 1;
+    bundleDesc.colorFormats = &renderPass.attachmentFormat;
+
+    wgpu::RenderBundleEncoder encoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    encoder.SetPipeline(pipeline);
+    encoder.SetIndexBuffer(CreateIndexBuffer(), wgpu::IndexFormat::Uint32);
+    encoder.MultiDrawIndexedIndirect(indirectBuffer, 0, 5, CreateDrawCountBuffer(4), 0);
+    encoder.Finish();
+
+    // The draw must still be in bounds.
+    encoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    encoder.SetPipeline(pipeline);
+    encoder.SetIndexBuffer(CreateIndexBuffer(), wgpu::IndexFormat::Uint32);
+    encoder.MultiDrawIndexedIndirect(indirectBuffer, 0, 6, nullptr, 0);
+    ASSERT_DEVICE_ERROR(encoder.Finish());
+}
+
+class MultiDrawIndirectWithoutCountValidationTest : public MultiDrawIndirectValidationTest {
+  protected:
+    std::vector<const char*> GetRequiredExtensions() override {
+        return {"multi_draw_indirect"};
+    }
+};
+
+// Check that the draw count buffer requires the draw_indirect_count extension.
+TEST_F(MultiDrawIndirectWithoutCountValidationTest, DrawCountBufferRequiresExtension) {
+    TestMultiDraw(utils::Expectation::Success, 100, 0, 5);
+    TestMultiDraw(utils::Expectation::Failure, 100, 0, 5, CreateDrawCountBuffer(4), 0);
+}
+
+// Check that MultiDrawIndexedIndirect requires the multi_draw_indirect extension.
+TEST_F(DrawIndirectValidationTest, MultiDrawRequiresExtension) {
+    wgpu::Buffer indirectBuffer =
+        utils::CreateBufferFromData<uint32_t>(device, wgpu::BufferUsage::Indirect, {1, 2, 3, 4, 5});
+    uint32_t zeros[100] = {};
+    wgpu::Buffer indexBuffer =
+        utils::CreateBufferFromData(device, zeros, sizeof(zeros), wgpu::BufferUsage::Index);
+
+    DummyRenderPass renderPass(device);
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+    pass.SetPipeline(pipeline);
+    pass.SetIndexBuffer(indexBuffer, wgpu::IndexFormat::Uint32);
+    pass.MultiDrawIndexedIndirect(indirectBuffer, 0, 1, nullptr, 0);
+    pass.EndPass();
+    ASSERT_DEVICE_ERROR(encoder.Finish());
+}
@@ -0,0 +1,304 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "common/Constants.h"
+#include "utils/ComboRenderBundleEncoderDescriptor.h"
+#include "utils/WGPUHelpers.h"
+
+#include <array>
+#include <vector>
+
+class ImmediateDataValidationTest : public ValidationTest {
+  protected:
+    WGPUDevice CreateTestDevice() override {
+        dawn_native::DeviceDescriptor descriptor;
+        descriptor.requiredExtensions = {"immediate_data"};
+        return adapter.CreateDevice(&descriptor);
+    }
+
+    wgpu::PipelineLayout CreatePipelineLayout(uint32_t immediateDataSize) {
+        wgpu::PipelineLayoutDescriptor descriptor;
+        descriptor.bindGroupLayoutCount = 0;
+        descriptor.bindGroupLayouts = nullptr;
+        descriptor.immediateDataSize = immediateDataSize;
+        return device.CreatePipelineLayout(&descriptor);
+    }
+
+    // A compute shader reading 16 bytes of immediate data.
+    wgpu::ShaderModule CreateComputeModule() {
+        return utils::CreateShaderModule(device, R"(
+            [[block]] struct Immediates {
+                value : vec4<u32>;
+            };
+            [[group(4), binding(0)]] var<uniform> immediates : Immediates;
+
+            [[block]] struct Result {
+                value : vec4<u32>;
+            };
+            [[group(0), binding(0)]] var<storage> result : [[access(read_write)]] Result;
+
+            [[stage(compute)]] fn main() {
+                result.value = immediates.value;
+            })");
+    }
+
+    wgpu::ComputePipeline CreateComputePipeline(wgpu::PipelineLayout layout) {
+        wgpu::ComputePipelineDescriptor descriptor;
+        descriptor.layout = layout;
+        descriptor.computeStage.module = CreateComputeModule();
+        descriptor.computeStage.entryPoint = "main";
+        return device.CreateComputePipeline(&descriptor);
+    }
+
+    void TestSetImmediateData(uint32_t offset, uint32_t size, bool success) {
+        std::array<uint8_t, kMaxImmediateDataSize + 4> data = {};
+
+        {
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+            pass.SetImmediateData(offset, data.data(), size);
+            pass.EndPass();
+            if (success) {
+                encoder.Finish();
+            } else {
+                ASSERT_DEVICE_ERROR(encoder.Finish());
+            }
+        }
+
+        {
+            DummyRenderPass renderPass(device);
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+            pass.SetImmediateData(offset, data.data(), size);
+            pass.EndPass();
+            if (success) {
+                encoder.Finish();
+            } else {
+                ASSERT_DEVICE_ERROR(encoder.Finish());
+            }
+        }
+
+        {
+            utils::ComboRenderBundleEncoderDescriptor descriptor = {};
+            descriptor.colorFormatsCount = 1;
+            descriptor.cColorFormats[0] = wgpu::TextureFormat::RGBA8Unorm;
+            wgpu::RenderBundleEncoder encoder = device.CreateRenderBundleEncoder(&descriptor);
+            encoder.SetImmediateData(offset, data.data(), size);
+            if (success) {
+                encoder.Finish();
+            } else {
+                ASSERT_DEVICE_ERROR(encoder.Finish());
+            }
+        }
+    }
+};
+
+class ImmediateDataExtensionValidationTest : public ValidationTest {};
+
+// Test that the immediate data can't be used without the extension.
+TEST_F(ImmediateDataExtensionValidationTest, RequiresExtension) {
+    uint32_t data = 0;
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetImmediateData(0, &data, sizeof(data));
+    pass.EndPass();
+    ASSERT_DEVICE_ERROR(encoder.Finish());
+
+    wgpu::PipelineLayoutDescriptor descriptor;
+    descriptor.bindGroupLayoutCount = 0;
+    descriptor.bindGroupLayouts = nullptr;
+    descriptor.immediateDataSize = 16;
+    ASSERT_DEVICE_ERROR(device.CreatePipelineLayout(&descriptor));
+
+    // The group past the bind groups is not special without the extension. The same shader is
+    // valid with the extension, see ShaderImmediateDataDeclaration.
+    ASSERT_TRUE(ShaderFailsValidation(wgpu::ShaderStage::Fragment, R"(
+        [[block]] struct Immediates {
+            value : vec4<u32>;
+        };
+        [[group(4), binding(0)]] var<uniform> immediates : Immediates;
+
+        [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+            return vec4<f32>(immediates.value);
+        })"));
+}
+
+// Test the alignment and bounds of the immediate data range.
+TEST_F(ImmediateDataValidationTest, SetImmediateDataRange) {
+    // Success cases
+    TestSetImmediateData(0, 4, true);
+    TestSetImmediateData(0, kMaxImmediateDataSize, true);
+    TestSetImmediateData(kMaxImmediateDataSize - 4, 4, true);
+    TestSetImmediateData(16, 32, true);
+
+    // Setting no data is valid, even at the end of the range.
+    TestSetImmediateData(0, 0, true);
+    TestSetImmediateData(kMaxImmediateDataSize, 0, true);
+
+    // Offset and size must be multiples of 4.
+    TestSetImmediateData(2, 4, false);
+    TestSetImmediateData(0, 6, false);
+
+    // The range must be inside the immediate data.
+    TestSetImmediateData(0, kMaxImmediateDataSize + 4, false);
+    TestSetImmediateData(4, kMaxImmediateDataSize, false);
+    TestSetImmediateData(kMaxImmediateDataSize + 4, 0, false);
+}
+
+// Test the validation of the immediate data size of pipeline layouts.
+TEST_F(ImmediateDataValidationTest, PipelineLayoutImmediateDataSize) {
+    CreatePipelineLayout(0);
+    CreatePipelineLayout(4);
+    CreatePipelineLayout(kMaxImmediateDataSize);
+
+    // The size must be a multiple of 4.
+    ASSERT_DEVICE_ERROR(CreatePipelineLayout(6));
+
+    // The size is limited.
+    ASSERT_DEVICE_ERROR(CreatePipelineLayout(kMaxImmediateDataSize + 4));
+}
+
+// Test that the maximum immediate data size can be used with all the other per pipeline layout
+// limits at their maximum, which is what fills the root signature on D3D12.
+TEST_F(ImmediateDataValidationTest, PipelineLayoutImmediateDataSizeAtMaxLimits) {
+    std::array<wgpu::BindGroupLayout, kMaxBindGroups> bindGroupLayouts;
+    uint32_t dynamicUniformBufferCount = 0;
+    uint32_t dynamicStorageBufferCount = 0;
+    for (wgpu::BindGroupLayout& bindGroupLayout : bindGroupLayouts) {
+        std::vector<utils::BindingLayoutEntryInitializationHelper> entries;
+        entries.push_back({0, wgpu::ShaderStage::Compute, wgpu::SamplerBindingType::Filtering});
+        entries.push_back({1, wgpu::ShaderStage::Compute, wgpu::TextureSampleType::Float});
+
+        uint32_t binding = 2;
+        for (uint32_t i = 0; i < kMaxDynamicUniformBuffersPerPipelineLayout / kMaxBindGroups;
+             ++i) {
+            entries.push_back(
+                {binding++, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Uniform, true});
+            dynamicUniformBufferCount++;
+        }
+        for (uint32_t i = 0; i < kMaxDynamicStorageBuffersPerPipelineLayout / kMaxBindGroups;
+             ++i) {
+            entries.push_back(
+                {binding++, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage, true});
+            dynamicStorageBufferCount++;
+        }
+
+        wgpu::BindGroupLayoutDescriptor descriptor;
+        descriptor.entryCount = static_cast<uint32_t>(entries.size());
+        descriptor.entries = entries.data();
+        bindGroupLayout = device.CreateBindGroupLayout(&descriptor);
+    }
+    ASSERT_EQ(dynamicUniformBufferCount, kMaxDynamicUniformBuffersPerPipelineLayout);
+    ASSERT_EQ(dynamicStorageBufferCount, kMaxDynamicStorageBuffersPerPipelineLayout);
+
+    wgpu::PipelineLayoutDescriptor descriptor;
+    descriptor.bindGroupLayoutCount = kMaxBindGroups;
+    descriptor.bindGroupLayouts = bindGroupLayouts.data();
+
+    descriptor.immediateDataSize = kMaxImmediateDataSize;
+    device.CreatePipelineLayout(&descriptor);
+
+    descriptor.immediateDataSize = kMaxImmediateDataSize + 4;
+    ASSERT_DEVICE_ERROR(device.CreatePipelineLayout(&descriptor));
+}
+
+// Test that the immediate data of the shader must fit in the pipeline layout's.
+TEST_F(ImmediateDataValidationTest, ShaderImmediateDataMustFitInLayout) {
+    wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage}});
+
+    auto CreateLayout = [&](uint32_t immediateDataSize) {
+        wgpu::PipelineLayoutDescriptor descriptor;
+        descriptor.bindGroupLayoutCount = 1;
+        descriptor.bindGroupLayouts = &bgl;
+        descriptor.immediateDataSize = immediateDataSize;
+        return device.CreatePipelineLayout(&descriptor);
+    };
+
+    CreateComputePipeline(CreateLayout(16));
+    CreateComputePipeline(CreateLayout(kMaxImmediateDataSize));
+    ASSERT_DEVICE_ERROR(CreateComputePipeline(CreateLayout(0)));
+    ASSERT_DEVICE_ERROR(CreateComputePipeline(CreateLayout(12)));
+}
+
+// Test that the default pipeline layout uses the immediate data size of the shader.
+TEST_F(ImmediateDataValidationTest, DefaultLayoutImmediateDataSize) {
+    wgpu::ComputePipeline pipeline = CreateComputePipeline(nullptr);
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = 16;
+    bufferDesc.usage = wgpu::BufferUsage::Storage;
+    wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+    wgpu::BindGroup bindGroup =
+        utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, buffer}});
+
+    std::array<uint32_t, 4> data = {1, 2, 3, 4};
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bindGroup);
+    pass.SetImmediateData(0, data.data(), sizeof(data));
+    pass.Dispatch(1);
+    pass.EndPass();
+    encoder.Finish();
+}
+
+// Test that the immediate data must be a uniform buffer at binding 0.
+TEST_F(ImmediateDataValidationTest, ShaderImmediateDataDeclaration) {
+    // Control case: a uniform buffer at binding 0 is the immediate data.
+    ASSERT_FALSE(ShaderFailsValidation(wgpu::ShaderStage::Fragment, R"(
+        [[block]] struct Immediates {
+            value : vec4<u32>;
+        };
+        [[group(4), binding(0)]] var<uniform> immediates : Immediates;
+
+        [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+            return vec4<f32>(immediates.value);
+        })"));
+
+    // Binding 1 is not the immediate data.
+    ASSERT_TRUE(ShaderFailsValidation(wgpu::ShaderStage::Fragment, R"(
+        [[block]] struct Immediates {
+            value : vec4<u32>;
+        };
+        [[group(4), binding(1)]] var<uniform> immediates : Immediates;
+
+        [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+            return vec4<f32>(immediates.value);
+        })"));
+
+    // A storage buffer is not the immediate data.
+    ASSERT_TRUE(ShaderFailsValidation(wgpu::ShaderStage::Fragment, R"(
+        [[block]] struct Immediates {
+            value : vec4<u32>;
+        };
+        [[group(4), binding(0)]] var<storage> immediates : [[access(read)]] Immediates;
+
+        [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+            return vec4<f32>(immediates.value);
+        })"));
+
+    // The immediate data must fit in kMaxImmediateDataSize bytes.
+    ASSERT_TRUE(ShaderFailsValidation(wgpu::ShaderStage::Fragment, R"(
+        [[block]] struct Immediates {
+            value : array<vec4<u32>, 9>;
+        };
+        [[group(4), binding(0)]] var<uniform> immediates : Immediates;
+
+        [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+            return vec4<f32>(immediates.value[0]);
+        })"));
+}
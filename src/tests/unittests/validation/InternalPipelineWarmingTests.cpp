@@ -0,0 +1,57 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "dawn_native/Device.h"
+#include "dawn_native/InternalPipelineStore.h"
+
+namespace {
+
+    class InternalPipelineWarmingTest : public ValidationTest {
+      protected:
+        WGPUDevice CreateTestDevice() override {
+            dawn_native::DeviceDescriptor descriptor;
+            descriptor.warmInternalPipelines = true;
+            return adapter.CreateDevice(&descriptor);
+        }
+
+        dawn_native::InternalPipelineStore* GetInternalPipelineStore() {
+            return reinterpret_cast<dawn_native::DeviceBase*>(backendDevice)
+                ->GetInternalPipelineStore();
+        }
+    };
+
+    // Test that the CopyTextureForBrowser pipelines exist for all the destination formats as soon
+    // as the device is created.
+    TEST_F(InternalPipelineWarmingTest, CopyTextureForBrowserPipelinesAreCreated) {
+        dawn_native::InternalPipelineStore* store = GetInternalPipelineStore();
+        EXPECT_NE(store->copyTextureForBrowserVS, nullptr);
+        EXPECT_NE(store->copyTextureForBrowserFS, nullptr);
+        EXPECT_EQ(store->copyTextureForBrowserPipelines.size(), 7u);
+    }
+
+    // Test that the timestamp conversion pipeline isn't created when timestamp queries can't be
+    // used.
+    TEST_F(InternalPipelineWarmingTest, TimestampPipelineRequiresExtension) {
+        EXPECT_EQ(GetInternalPipelineStore()->timestampComputePipeline, nullptr);
+    }
+
+    // Test that the texture data conversion pipeline isn't created when the extension isn't
+    // enabled.
+    TEST_F(InternalPipelineWarmingTest, TextureDataConversionPipelineRequiresExtension) {
+        EXPECT_EQ(GetInternalPipelineStore()->textureDataConversionPipeline, nullptr);
+    }
+
+}  // anonymous namespace
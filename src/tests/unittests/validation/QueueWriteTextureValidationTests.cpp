@@ -86,9 +86,40 @@ namespace {
                                                  0, origin, extent3D));
         }
 
+        void TestWriteTextureWithConversion(wgpu::TextureDataSourceFormat sourceFormat,
+                                            size_t dataSize,
+                                            uint32_t dataBytesPerRow,
+                                            uint32_t dataRowsPerImage,
+                                            wgpu::Texture texture,
+                                            wgpu::Origin3D texOrigin,
+                                            wgpu::Extent3D size) {
+            std::vector<uint8_t> data(dataSize);
+
+            wgpu::TextureDataConversion conversion;
+            conversion.sourceFormat = sourceFormat;
+
+            wgpu::TextureDataLayout textureDataLayout;
+            textureDataLayout.nextInChain = &conversion;
+            textureDataLayout.bytesPerRow = dataBytesPerRow;
+            textureDataLayout.rowsPerImage = dataRowsPerImage;
+
+            wgpu::ImageCopyTexture imageCopyTexture =
+                utils::CreateImageCopyTexture(texture, 0, texOrigin);
+
+            queue.WriteTexture(&imageCopyTexture, data.data(), dataSize, &textureDataLayout, &size);
+        }
+
         wgpu::Queue queue;
     };
 
+    // Test that texture data can't be converted without the texture_data_conversion extension.
+    TEST_F(QueueWriteTextureValidationTest, TextureDataConversionRequiresExtension) {
+        wgpu::Texture destination = Create2DTexture({4, 4, 1}, 1, wgpu::TextureFormat::RGBA8Unorm,
+                                                    wgpu::TextureUsage::CopyDst);
+        ASSERT_DEVICE_ERROR(TestWriteTextureWithConversion(
+            wgpu::TextureDataSourceFormat::RGB8Unorm, 48, 12, 4, destination, {0, 0, 0}, {4, 4, 1}));
+    }
+
     // Test the success case for WriteTexture
     TEST_F(QueueWriteTextureValidationTest, Success) {
         const uint64_t dataSize =
@@ -783,4 +814,82 @@ namespace {
         }
     }
 
+    class WriteTextureTest_TextureDataConversion : public QueueWriteTextureValidationTest {
+      protected:
+        WGPUDevice CreateTestDevice() override {
+            dawn_native::DeviceDescriptor descriptor;
+            descriptor.requiredExtensions = {"texture_data_conversion"};
+            return adapter.CreateDevice(&descriptor);
+        }
+
+        wgpu::Texture CreateDestination(wgpu::TextureFormat format, uint32_t arrayLayers = 1) {
+            return Create2DTexture({16, 16, arrayLayers}, 1, format, wgpu::TextureUsage::CopyDst);
+        }
+    };
+
+    // Test writing RGB8, RGBA8 and BGRA8 data to RGBA8 and BGRA8 textures.
+    TEST_F(WriteTextureTest_TextureDataConversion, Success) {
+        for (wgpu::TextureFormat format :
+             {wgpu::TextureFormat::RGBA8Unorm, wgpu::TextureFormat::RGBA8UnormSrgb,
+              wgpu::TextureFormat::BGRA8Unorm, wgpu::TextureFormat::BGRA8UnormSrgb}) {
+            wgpu::Texture destination = CreateDestination(format, 3);
+
+            // Tightly packed RGB8 rows don't need to be aligned.
+            TestWriteTextureWithConversion(wgpu::TextureDataSourceFormat::RGB8Unorm, 5 * 3 * 7, 15,
+                                           7, destination, {1, 2, 0}, {5, 7, 1});
+            TestWriteTextureWithConversion(wgpu::TextureDataSourceFormat::RGBA8Unorm, 5 * 4 * 7,
+                                           20, 7, destination, {1, 2, 0}, {5, 7, 1});
+            TestWriteTextureWithConversion(wgpu::TextureDataSourceFormat::BGRA8Unorm, 5 * 4 * 7,
+                                           20, 7, destination, {1, 2, 0}, {5, 7, 1});
+
+            // Write to several array layers with padded rows and images.
+            TestWriteTextureWithConversion(wgpu::TextureDataSourceFormat::RGB8Unorm,
+                                           64 * 18 * 2 + 64 * 16, 64, 18, destination, {0, 0, 0},
+                                           {16, 16, 3});
+        }
+    }
+
+    // Test that the size of the data is validated with the texel size of the source format.
+    TEST_F(WriteTextureTest_TextureDataConversion, SourceTexelSize) {
+        wgpu::Texture destination = CreateDestination(wgpu::TextureFormat::RGBA8Unorm);
+
+        // The data is too small for the write.
+        ASSERT_DEVICE_ERROR(TestWriteTextureWithConversion(wgpu::TextureDataSourceFormat::RGB8Unorm,
+                                                           4 * 3 * 4 - 1, 12, 4, destination,
+                                                           {0, 0, 0}, {4, 4, 1}));
+
+        // bytesPerRow is too small for a row of RGB8 texels.
+        ASSERT_DEVICE_ERROR(TestWriteTextureWithConversion(wgpu::TextureDataSourceFormat::RGB8Unorm,
+                                                           256, 11, 4, destination, {0, 0, 0},
+                                                           {4, 4, 1}));
+
+        // The default bytesPerRow and rowsPerImage use the source texel size.
+        TestWriteTextureWithConversion(wgpu::TextureDataSourceFormat::RGB8Unorm, 4 * 3,
+                                       wgpu::kCopyStrideUndefined, wgpu::kCopyStrideUndefined,
+                                       destination, {0, 0, 0}, {4, 1, 1});
+    }
+
+    // Test that texture data can only be converted to RGBA8 and BGRA8 formats.
+    TEST_F(WriteTextureTest_TextureDataConversion, DestinationFormat) {
+        for (wgpu::TextureFormat format :
+             {wgpu::TextureFormat::R8Unorm, wgpu::TextureFormat::RGBA8Uint,
+              wgpu::TextureFormat::RGBA16Float, wgpu::TextureFormat::RGB10A2Unorm}) {
+            wgpu::Texture destination = CreateDestination(format);
+            ASSERT_DEVICE_ERROR(TestWriteTextureWithConversion(
+                wgpu::TextureDataSourceFormat::RGB8Unorm, 4096, 256, 4, destination, {0, 0, 0},
+                {4, 4, 1}));
+        }
+    }
+
+    // Test that the source format must be valid.
+    TEST_F(WriteTextureTest_TextureDataConversion, InvalidSourceFormat) {
+        wgpu::Texture destination = CreateDestination(wgpu::TextureFormat::RGBA8Unorm);
+        ASSERT_DEVICE_ERROR(TestWriteTextureWithConversion(
+            wgpu::TextureDataSourceFormat::Undefined, 4096, 256, 4, destination, {0, 0, 0},
+            {4, 4, 1}));
+        ASSERT_DEVICE_ERROR(TestWriteTextureWithConversion(
+            static_cast<wgpu::TextureDataSourceFormat>(0xFFFF), 4096, 256, 4, destination,
+            {0, 0, 0}, {4, 4, 1}));
+    }
+
 }  // anonymous namespace
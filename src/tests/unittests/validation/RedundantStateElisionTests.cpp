@@ -0,0 +1,291 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/ComboRenderBundleEncoderDescriptor.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/WGPUHelpers.h"
+
+namespace {
+
+    class RedundantStateElisionTest : public ValidationTest {
+      protected:
+        void SetUp() override {
+            ValidationTest::SetUp();
+
+            mBindGroupLayout = utils::MakeBindGroupLayout(
+                device, {{0, wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Compute,
+                          wgpu::BufferBindingType::Uniform, true}});
+            wgpu::PipelineLayout pipelineLayout =
+                utils::MakeBasicPipelineLayout(device, &mBindGroupLayout);
+
+            wgpu::ShaderModule vsModule = utils::CreateShaderModule(device, R"(
+                [[block]] struct S {
+                    value : vec4<f32>;
+                };
+                [[group(0), binding(0)]] var<uniform> uniforms : S;
+
+                [[stage(vertex)]] fn main([[location(0)]] pos : vec4<f32>) -> [[builtin(position)]] vec4<f32> {
+                    return pos + uniforms.value;
+                })");
+            wgpu::ShaderModule fsModule = utils::CreateShaderModule(device, R"(
+                [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+                    return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+                })");
+
+            utils::ComboRenderPipelineDescriptor2 renderDescriptor;
+            renderDescriptor.layout = pipelineLayout;
+            renderDescriptor.vertex.module = vsModule;
+            renderDescriptor.cFragment.module = fsModule;
+            renderDescriptor.vertex.bufferCount = 1;
+            renderDescriptor.cBuffers[0].arrayStride = 4 * sizeof(float);
+            renderDescriptor.cBuffers[0].attributeCount = 1;
+            renderDescriptor.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+            mRenderPipeline = device.CreateRenderPipeline2(&renderDescriptor);
+
+            wgpu::ComputePipelineDescriptor computeDescriptor;
+            computeDescriptor.layout = pipelineLayout;
+            computeDescriptor.computeStage.module = utils::CreateShaderModule(device, R"(
+                [[block]] struct S {
+                    value : vec4<f32>;
+                };
+                [[group(0), binding(0)]] var<uniform> uniforms : S;
+
+                [[stage(compute)]] fn main() {
+                })");
+            computeDescriptor.computeStage.entryPoint = "main";
+            mComputePipeline = device.CreateComputePipeline(&computeDescriptor);
+
+            wgpu::BufferDescriptor bufferDescriptor;
+            bufferDescriptor.size = 512;
+            bufferDescriptor.usage = wgpu::BufferUsage::Uniform;
+            wgpu::Buffer uniformBuffer = device.CreateBuffer(&bufferDescriptor);
+            mBindGroup = utils::MakeBindGroup(device, mBindGroupLayout, {{0, uniformBuffer, 0, 16}});
+
+            bufferDescriptor.usage = wgpu::BufferUsage::Vertex | wgpu::BufferUsage::Index;
+            mBuffer = device.CreateBuffer(&bufferDescriptor);
+
+            mStatsBefore = GetStats();
+        }
+
+        dawn_native::ElidedCommandStats GetStats() {
+            FlushWire();
+            return dawn_native::GetElidedCommandStats(backendDevice);
+        }
+
+        dawn_native::ElidedCommandStats GetElided() {
+            dawn_native::ElidedCommandStats stats = GetStats();
+            stats.setPipeline -= mStatsBefore.setPipeline;
+            stats.setBindGroup -= mStatsBefore.setBindGroup;
+            stats.setVertexBuffer -= mStatsBefore.setVertexBuffer;
+            stats.setIndexBuffer -= mStatsBefore.setIndexBuffer;
+            return stats;
+        }
+
+        wgpu::BindGroupLayout mBindGroupLayout;
+        wgpu::RenderPipeline mRenderPipeline;
+        wgpu::ComputePipeline mComputePipeline;
+        wgpu::BindGroup mBindGroup;
+        wgpu::Buffer mBuffer;
+        dawn_native::ElidedCommandStats mStatsBefore;
+    };
+
+    // Test that setting the same pipeline and bind group again in a render pass is skipped.
+    TEST_F(RedundantStateElisionTest, RenderPassPipelineAndBindGroup) {
+        DummyRenderPass renderPass(device);
+        uint32_t offset = 0;
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetVertexBuffer(0, mBuffer);
+        for (uint32_t i = 0; i < 3; ++i) {
+            pass.SetPipeline(mRenderPipeline);
+            pass.SetBindGroup(0, mBindGroup, 1, &offset);
+            pass.Draw(3);
+        }
+        pass.EndPass();
+        encoder.Finish();
+
+        dawn_native::ElidedCommandStats elided = GetElided();
+        EXPECT_EQ(elided.setPipeline, 2u);
+        EXPECT_EQ(elided.setBindGroup, 2u);
+    }
+
+    // Test that setting the same bind group with different dynamic offsets isn't skipped.
+    TEST_F(RedundantStateElisionTest, DifferentDynamicOffsets) {
+        DummyRenderPass renderPass(device);
+        uint32_t offsets[] = {0, 256, 256, 0};
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(mRenderPipeline);
+        pass.SetVertexBuffer(0, mBuffer);
+        for (uint32_t offset : offsets) {
+            pass.SetBindGroup(0, mBindGroup, 1, &offset);
+            pass.Draw(3);
+        }
+        pass.EndPass();
+        encoder.Finish();
+
+        EXPECT_EQ(GetElided().setBindGroup, 1u);
+    }
+
+    // Test that setting the same vertex and index buffers again is skipped, but not when the
+    // range or the format changes.
+    TEST_F(RedundantStateElisionTest, VertexAndIndexBuffers) {
+        DummyRenderPass renderPass(device);
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetVertexBuffer(0, mBuffer, 0, 256);
+        pass.SetVertexBuffer(0, mBuffer, 0, 256);
+        pass.SetVertexBuffer(0, mBuffer, 16, 256);
+        pass.SetVertexBuffer(0, mBuffer, 16, 128);
+        pass.SetVertexBuffer(1, mBuffer, 16, 128);
+
+        pass.SetIndexBuffer(mBuffer, wgpu::IndexFormat::Uint32);
+        pass.SetIndexBuffer(mBuffer, wgpu::IndexFormat::Uint32);
+        pass.SetIndexBuffer(mBuffer, wgpu::IndexFormat::Uint16);
+        pass.SetIndexBuffer(mBuffer, wgpu::IndexFormat::Uint16, 4);
+        pass.EndPass();
+        encoder.Finish();
+
+        dawn_native::ElidedCommandStats elided = GetElided();
+        EXPECT_EQ(elided.setVertexBuffer, 1u);
+        EXPECT_EQ(elided.setIndexBuffer, 1u);
+    }
+
+    // Test that executing render bundles forgets the state set in the render pass, since the
+    // state isn't inherited after the bundles.
+    TEST_F(RedundantStateElisionTest, StateIsResetAfterExecuteBundles) {
+        DummyRenderPass renderPass(device);
+        uint32_t offset = 0;
+
+        utils::ComboRenderBundleEncoderDescriptor bundleDescriptor;
+        bundleDescriptor.colorFormatsCount = 1;
+        bundleDescriptor.cColorFormats[0] = renderPass.attachmentFormat;
+        wgpu::RenderBundle bundle = device.CreateRenderBundleEncoder(&bundleDescriptor).Finish();
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetPipeline(mRenderPipeline);
+        pass.SetBindGroup(0, mBindGroup, 1, &offset);
+        pass.SetVertexBuffer(0, mBuffer);
+        pass.ExecuteBundles(1, &bundle);
+        pass.SetPipeline(mRenderPipeline);
+        pass.SetBindGroup(0, mBindGroup, 1, &offset);
+        pass.SetVertexBuffer(0, mBuffer);
+        pass.Draw(3);
+        pass.EndPass();
+        encoder.Finish();
+
+        dawn_native::ElidedCommandStats elided = GetElided();
+        EXPECT_EQ(elided.setPipeline, 0u);
+        EXPECT_EQ(elided.setBindGroup, 0u);
+        EXPECT_EQ(elided.setVertexBuffer, 0u);
+    }
+
+    // Test that redundant state is skipped inside render bundles, and that a bundle doesn't
+    // inherit the state set in the one encoded before it.
+    TEST_F(RedundantStateElisionTest, RenderBundles) {
+        utils::ComboRenderBundleEncoderDescriptor bundleDescriptor;
+        bundleDescriptor.colorFormatsCount = 1;
+        bundleDescriptor.cColorFormats[0] = wgpu::TextureFormat::RGBA8Unorm;
+        uint32_t offset = 0;
+
+        for (uint32_t i = 0; i < 2; ++i) {
+            wgpu::RenderBundleEncoder encoder = device.CreateRenderBundleEncoder(&bundleDescriptor);
+            encoder.SetPipeline(mRenderPipeline);
+            encoder.SetBindGroup(0, mBindGroup, 1, &offset);
+            encoder.SetVertexBuffer(0, mBuffer);
+            encoder.Draw(3);
+            encoder.SetPipeline(mRenderPipeline);
+            encoder.SetBindGroup(0, mBindGroup, 1, &offset);
+            encoder.SetVertexBuffer(0, mBuffer);
+            encoder.Draw(3);
+            encoder.Finish();
+        }
+
+        dawn_native::ElidedCommandStats elided = GetElided();
+        EXPECT_EQ(elided.setPipeline, 2u);
+        EXPECT_EQ(elided.setBindGroup, 2u);
+        EXPECT_EQ(elided.setVertexBuffer, 2u);
+    }
+
+    // Test that setting the same pipeline and bind group again in a compute pass is skipped.
+    TEST_F(RedundantStateElisionTest, ComputePass) {
+        uint32_t offset = 0;
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        for (uint32_t i = 0; i < 3; ++i) {
+            pass.SetPipeline(mComputePipeline);
+            pass.SetBindGroup(0, mBindGroup, 1, &offset);
+            pass.Dispatch(1);
+        }
+        pass.EndPass();
+        encoder.Finish();
+
+        dawn_native::ElidedCommandStats elided = GetElided();
+        EXPECT_EQ(elided.setPipeline, 2u);
+        EXPECT_EQ(elided.setBindGroup, 2u);
+    }
+
+    // Test that the state isn't shared between passes.
+    TEST_F(RedundantStateElisionTest, StateIsPerPass) {
+        uint32_t offset = 0;
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (uint32_t i = 0; i < 2; ++i) {
+            wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+            pass.SetPipeline(mComputePipeline);
+            pass.SetBindGroup(0, mBindGroup, 1, &offset);
+            pass.Dispatch(1);
+            pass.EndPass();
+        }
+        encoder.Finish();
+
+        dawn_native::ElidedCommandStats elided = GetElided();
+        EXPECT_EQ(elided.setPipeline, 0u);
+        EXPECT_EQ(elided.setBindGroup, 0u);
+    }
+
+    // Test that a redundant command on a pass that has ended is still an error.
+    TEST_F(RedundantStateElisionTest, RedundantCommandAfterEndPass) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(mComputePipeline);
+        pass.EndPass();
+        pass.SetPipeline(mComputePipeline);
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+
+        EXPECT_EQ(GetElided().setPipeline, 0u);
+    }
+
+    // Test that a command that failed validation doesn't make the same command skipped.
+    TEST_F(RedundantStateElisionTest, FailedCommandIsNotRemembered) {
+        DummyRenderPass renderPass(device);
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetVertexBuffer(0, mBuffer, 1024);
+        pass.SetVertexBuffer(0, mBuffer, 1024);
+        pass.EndPass();
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+
+        EXPECT_EQ(GetElided().setVertexBuffer, 0u);
+    }
+
+}  // anonymous namespace
@@ -14,12 +14,15 @@
 
 #include "common/Constants.h"
 
+#include "dawn_native/Device.h"
 #include "dawn_native/ShaderModule.h"
 
 #include "tests/unittests/validation/ValidationTest.h"
 
+#include "utils/ComboRenderPipelineDescriptor.h"
 #include "utils/WGPUHelpers.h"
 
+#include <cstring>
 #include <sstream>
 
 class ShaderModuleValidationTest : public ValidationTest {};
@@ -56,15 +59,62 @@ TEST_F(ShaderModuleValidationTest, CreationSuccess) {
     utils::CreateShaderModuleFromASM(device, shader);
 }
 
-// Tests that if the output location exceeds kMaxColorAttachments the fragment shader will fail to
-// be compiled.
+// Test that valid shaders don't produce errors in ShaderFailsValidation, which would make the tests
+// using it pass for unrelated reasons.
+TEST_F(ShaderModuleValidationTest, FailsValidationAcceptsValidShaders) {
+    ASSERT_FALSE(ShaderFailsValidation(wgpu::ShaderStage::Vertex, R"(
+        [[stage(vertex)]] fn main() -> [[builtin(position)]] vec4<f32> {
+            return vec4<f32>(0.0, 0.0, 0.0, 1.0);
+        })"));
+
+    ASSERT_FALSE(ShaderFailsValidation(wgpu::ShaderStage::Fragment, R"(
+        [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+            return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+        })"));
+
+    ASSERT_FALSE(ShaderFailsValidation(wgpu::ShaderStage::Compute, R"(
+        [[stage(compute)]] fn main() {
+        })"));
+
+    ASSERT_FALSE(SpirvShaderFailsValidation(wgpu::ShaderStage::Fragment, R"(
+                   OpCapability Shader
+                   OpMemoryModel Logical GLSL450
+                   OpEntryPoint Fragment %main "main" %fragColor
+                   OpExecutionMode %main OriginUpperLeft
+                   OpDecorate %fragColor Location 0
+           %void = OpTypeVoid
+              %3 = OpTypeFunction %void
+          %float = OpTypeFloat 32
+        %v4float = OpTypeVector %float 4
+    %_ptr_Output_v4float = OpTypePointer Output %v4float
+      %fragColor = OpVariable %_ptr_Output_v4float Output
+        %float_1 = OpConstant %float 1
+        %float_0 = OpConstant %float 0
+             %12 = OpConstantComposite %v4float %float_1 %float_0 %float_0 %float_1
+           %main = OpFunction %void None %3
+              %5 = OpLabel
+                   OpStore %fragColor %12
+                   OpReturn
+                   OpFunctionEnd)"));
+
+    // The only difference with FragmentOutputLocationExceedsMaxColorAttachments is the location.
+    std::ostringstream stream;
+    stream << "[[stage(fragment)]] fn main() -> [[location(" << kMaxColorAttachments - 1
+           << R"()]]  vec4<f32> {
+            return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+        })";
+    ASSERT_FALSE(ShaderFailsValidation(wgpu::ShaderStage::Fragment, stream.str().c_str()));
+}
+
+// Tests that if the output location exceeds kMaxColorAttachments the fragment shader can't be used
+// in a pipeline.
 TEST_F(ShaderModuleValidationTest, FragmentOutputLocationExceedsMaxColorAttachments) {
     std::ostringstream stream;
     stream << "[[stage(fragment)]] fn main() -> [[location(" << kMaxColorAttachments
            << R"()]]  vec4<f32> {
             return vec4<f32>(0.0, 1.0, 0.0, 1.0);
         })";
-    ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, stream.str().c_str()));
+    ASSERT_TRUE(ShaderFailsValidation(wgpu::ShaderStage::Fragment, stream.str().c_str()));
 }
 
 // Test that it is invalid to create a shader module with no chained descriptor. (It must be
@@ -112,7 +162,7 @@ TEST_F(ShaderModuleValidationTest, CombinedTextureAndSampler) {
                OpFunctionEnd
         )";
 
-    ASSERT_DEVICE_ERROR(utils::CreateShaderModuleFromASM(device, shader));
+    ASSERT_TRUE(SpirvShaderFailsValidation(wgpu::ShaderStage::Fragment, shader));
 }
 
 // Test that it is not allowed to declare a multisampled-array interface texture.
@@ -153,7 +203,35 @@ TEST_F(ShaderModuleValidationTest, MultisampledArrayTexture) {
                OpFunctionEnd
         )";
 
-    ASSERT_DEVICE_ERROR(utils::CreateShaderModuleFromASM(device, shader));
+    ASSERT_TRUE(SpirvShaderFailsValidation(wgpu::ShaderStage::Fragment, shader));
+}
+
+// Test that entry points are only reflected when a pipeline uses them, so that an invalid entry
+// point doesn't prevent using the other entry points of the module.
+TEST_F(ShaderModuleValidationTest, InvalidEntryPointIsOnlyReportedWhenUsed) {
+    std::ostringstream stream;
+    stream << "[[stage(fragment)]] fn invalid() -> [[location(" << kMaxColorAttachments
+           << R"()]]  vec4<f32> {
+            return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+        }
+
+        [[stage(compute)]] fn main() {
+        })";
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, stream.str().c_str());
+
+    wgpu::ComputePipelineDescriptor computeDescriptor;
+    computeDescriptor.computeStage.module = module;
+    computeDescriptor.computeStage.entryPoint = "main";
+    device.CreateComputePipeline(&computeDescriptor);
+
+    utils::ComboRenderPipelineDescriptor2 renderDescriptor;
+    renderDescriptor.vertex.module = utils::CreateShaderModule(device, R"(
+        [[stage(vertex)]] fn main() -> [[builtin(position)]] vec4<f32> {
+            return vec4<f32>(0.0, 0.0, 0.0, 1.0);
+        })");
+    renderDescriptor.cFragment.module = module;
+    renderDescriptor.cFragment.entryPoint = "invalid";
+    ASSERT_DEVICE_ERROR(device.CreateRenderPipeline2(&renderDescriptor));
 }
 
 // Tests that shader module compilation messages can be queried.
@@ -202,3 +280,177 @@ TEST_F(ShaderModuleValidationTest, GetCompilationMessages) {
 
     shaderModule.GetCompilationInfo(callback, nullptr);
 }
+
+class ShaderModuleParseCacheTest : public ShaderModuleValidationTest {
+  protected:
+    static constexpr char kShader[] = R"(
+        [[block]] struct Data {
+            value : u32;
+        };
+        [[group(0), binding(0)]] var<storage> data : [[access(read_write)]] Data;
+
+        [[stage(compute)]] fn main() {
+            data.value = data.value + 1u;
+        })";
+
+    // Returns whether the parse results of the two modules are the same objects.
+    bool SharesParseResult(const wgpu::ShaderModule& a, const wgpu::ShaderModule& b) {
+        dawn_native::ShaderModuleBase* baseA =
+            reinterpret_cast<dawn_native::ShaderModuleBase*>(a.Get());
+        dawn_native::ShaderModuleBase* baseB =
+            reinterpret_cast<dawn_native::ShaderModuleBase*>(b.Get());
+        return baseA->GetTintProgram() == baseB->GetTintProgram();
+    }
+
+    bool UsesTintGenerator() {
+        return reinterpret_cast<dawn_native::DeviceBase*>(backendDevice)
+            ->IsToggleEnabled(dawn_native::Toggle::UseTintGenerator);
+    }
+};
+
+constexpr char ShaderModuleParseCacheTest::kShader[];
+
+// Test that the parse result of a source is reused by the modules of other devices.
+TEST_F(ShaderModuleParseCacheTest, SharedAcrossDevices) {
+    // This test works assuming ShaderModule is backed by a dawn_native::ShaderModuleBase, which
+    // is not the case on the wire.
+    DAWN_SKIP_TEST_IF(UsesWire());
+
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, kShader);
+
+    wgpu::Device otherDevice = wgpu::Device::Acquire(adapter.CreateDevice());
+    wgpu::ShaderModule otherModule = utils::CreateShaderModule(otherDevice, kShader);
+
+    // The module created from the cached result can be used to create pipelines.
+    wgpu::ComputePipelineDescriptor descriptor;
+    descriptor.computeStage.module = otherModule;
+    descriptor.computeStage.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = otherDevice.CreateComputePipeline(&descriptor);
+    ASSERT_NE(pipeline.Get(), nullptr);
+    pipeline.GetBindGroupLayout(0);
+
+    if (UsesTintGenerator()) {
+        EXPECT_TRUE(SharesParseResult(module, otherModule));
+    }
+}
+
+// Test that the parse cache isn't used by devices that disable it.
+TEST_F(ShaderModuleParseCacheTest, DisabledByToggle) {
+    DAWN_SKIP_TEST_IF(UsesWire());
+    DAWN_SKIP_TEST_IF(!UsesTintGenerator());
+
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, kShader);
+
+    dawn_native::DeviceDescriptor deviceDescriptor;
+    deviceDescriptor.forceEnabledToggles.push_back("disable_shader_parse_cache");
+    wgpu::Device otherDevice = wgpu::Device::Acquire(adapter.CreateDevice(&deviceDescriptor));
+    wgpu::ShaderModule otherModule = utils::CreateShaderModule(otherDevice, kShader);
+
+    EXPECT_FALSE(SharesParseResult(module, otherModule));
+}
+
+// Test that the parse results of devices whose SPIR-V validation can come from their persistent
+// cache aren't shared with the devices that don't persist it.
+TEST_F(ShaderModuleParseCacheTest, SeparatedByPersistSpirvValidation) {
+    DAWN_SKIP_TEST_IF(UsesWire());
+    DAWN_SKIP_TEST_IF(!UsesTintGenerator());
+
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, kShader);
+
+    dawn_native::DeviceDescriptor deviceDescriptor;
+    deviceDescriptor.forceEnabledToggles.push_back("persist_spirv_validation");
+    wgpu::Device otherDevice = wgpu::Device::Acquire(adapter.CreateDevice(&deviceDescriptor));
+    wgpu::ShaderModule otherModule = utils::CreateShaderModule(otherDevice, kShader);
+
+    EXPECT_FALSE(SharesParseResult(module, otherModule));
+}
+
+// Test that the programs of the devices releasing them aren't kept alive by the parse cache.
+TEST_F(ShaderModuleParseCacheTest, ReleasedProgramsAreNotCached) {
+    DAWN_SKIP_TEST_IF(UsesWire());
+    DAWN_SKIP_TEST_IF(!UsesTintGenerator());
+
+    // A source that no other test creates, so that it isn't in the cache yet.
+    constexpr char kReleasedShader[] = R"(
+        [[block]] struct Data {
+            value : u32;
+        };
+        [[group(0), binding(0)]] var<storage> data : [[access(read_write)]] Data;
+
+        [[stage(compute)]] fn main() {
+            data.value = data.value + 2u;
+        })";
+
+    dawn_native::DeviceDescriptor deviceDescriptor;
+    deviceDescriptor.forceEnabledToggles.push_back("release_shader_module_programs");
+    wgpu::Device releasingDevice = wgpu::Device::Acquire(adapter.CreateDevice(&deviceDescriptor));
+    wgpu::ShaderModule releasingModule =
+        utils::CreateShaderModule(releasingDevice, kReleasedShader);
+
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, kReleasedShader);
+
+    EXPECT_FALSE(SharesParseResult(module, releasingModule));
+}
+
+// Test that the program is released once it is used, and parsed again when it is needed.
+TEST_F(ShaderModuleParseCacheTest, ReleaseProgramAfterUse) {
+    DAWN_SKIP_TEST_IF(UsesWire());
+    DAWN_SKIP_TEST_IF(!UsesTintGenerator());
+
+    // Only created by devices releasing the programs, so that the parse cache doesn't keep the
+    // program alive.
+    constexpr char kReleasedShader[] = R"(
+        [[block]] struct Data {
+            value : u32;
+        };
+        [[group(0), binding(0)]] var<storage> data : [[access(read_write)]] Data;
+
+        [[stage(compute)]] fn main() {
+            data.value = data.value + 3u;
+        })";
+
+    dawn_native::DeviceDescriptor deviceDescriptor;
+    deviceDescriptor.forceEnabledToggles.push_back("release_shader_module_programs");
+    wgpu::Device releasingDevice = wgpu::Device::Acquire(adapter.CreateDevice(&deviceDescriptor));
+    wgpu::ShaderModule module = utils::CreateShaderModule(releasingDevice, kReleasedShader);
+    dawn_native::ShaderModuleBase* moduleBase =
+        reinterpret_cast<dawn_native::ShaderModuleBase*>(module.Get());
+
+    dawn_native::ShaderModuleMemoryInfo info =
+        dawn_native::GetShaderModuleMemoryInfo(module.Get());
+    EXPECT_GE(info.retainedBytes, strlen(kReleasedShader));
+    EXPECT_TRUE(info.retainsTintProgram);
+
+    const tint::Program* firstProgram = nullptr;
+    {
+        // The first use takes the only reference to the program.
+        std::shared_ptr<const tint::Program> program =
+            moduleBase->AcquireTintProgram().AcquireSuccess();
+        ASSERT_NE(program.get(), nullptr);
+        EXPECT_FALSE(dawn_native::GetShaderModuleMemoryInfo(module.Get()).retainsTintProgram);
+        firstProgram = program.get();
+
+        // The program is reused while something else keeps it alive.
+        EXPECT_EQ(moduleBase->AcquireTintProgram().AcquireSuccess().get(), firstProgram);
+    }
+
+    // The program is parsed again once it was freed.
+    std::shared_ptr<const tint::Program> program =
+        moduleBase->AcquireTintProgram().AcquireSuccess();
+    ASSERT_NE(program.get(), nullptr);
+
+    info = dawn_native::GetShaderModuleMemoryInfo(module.Get());
+    EXPECT_GE(info.retainedBytes, strlen(kReleasedShader));
+    EXPECT_FALSE(info.retainsTintProgram);
+}
+
+// Test that shaders failing to parse still fail when created again.
+TEST_F(ShaderModuleParseCacheTest, ErrorsAreNotCached) {
+    constexpr char kInvalidShader[] = R"(
+        [[stage(compute)]] fn main() {
+            let value : u32 = 1.0;
+        })";
+
+    ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, kInvalidShader));
+    ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, kInvalidShader));
+}
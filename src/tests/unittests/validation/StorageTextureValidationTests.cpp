@@ -227,32 +227,52 @@ TEST_F(StorageTextureValidationTests, ComputePipeline) {
 
 // Validate read-write storage textures are not currently supported.
 TEST_F(StorageTextureValidationTests, ReadWriteStorageTexture) {
-    // Read-write storage textures cannot be declared in a vertex shader by default.
-    {
-        ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, R"(
-            [[group(0), binding(0)]] var image0 : [[access(read_write)]] texture_storage_2d<rgba8unorm>;
-            [[stage(vertex)]] fn main() {
+    // Only the access of the storage texture differs between the shaders of a stage, so that the
+    // read-only shader checks that the read-write one fails because of its access.
+    auto VertexShader = [](const char* access) {
+        std::ostringstream stream;
+        stream << "[[group(0), binding(0)]] var image0 : [[access(" << access
+               << R"()]] texture_storage_2d<rgba8unorm>;
+            [[stage(vertex)]] fn main() -> [[builtin(position)]] vec4<f32> {
                 textureDimensions(image0);
-            })"));
-    }
-
-    // Read-write storage textures cannot be declared in a fragment shader by default.
-    {
-        ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, R"(
-            [[group(0), binding(0)]] var image0 : [[access(read_write)]] texture_storage_2d<rgba8unorm>;
+                return vec4<f32>(0.0, 0.0, 0.0, 1.0);
+            })";
+        return stream.str();
+    };
+    auto FragmentShader = [](const char* access) {
+        std::ostringstream stream;
+        stream << "[[group(0), binding(0)]] var image0 : [[access(" << access
+               << R"()]] texture_storage_2d<rgba8unorm>;
             [[stage(fragment)]] fn main() {
                 textureDimensions(image0);
-            })"));
-    }
-
-    // Read-write storage textures cannot be declared in a compute shader by default.
-    {
-        ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, R"(
-            [[group(0), binding(0)]] var image0 : [[access(read_write)]] texture_storage_2d<rgba8unorm>;
+            })";
+        return stream.str();
+    };
+    auto ComputeShader = [](const char* access) {
+        std::ostringstream stream;
+        stream << "[[group(0), binding(0)]] var image0 : [[access(" << access
+               << R"()]] texture_storage_2d<rgba8unorm>;
             [[stage(compute)]] fn main() {
                 textureDimensions(image0);
-            })"));
-    }
+            })";
+        return stream.str();
+    };
+
+    // Read-write storage textures cannot be declared in a vertex shader by default.
+    ASSERT_FALSE(ShaderFailsValidation(wgpu::ShaderStage::Vertex, VertexShader("read").c_str()));
+    ASSERT_TRUE(
+        ShaderFailsValidation(wgpu::ShaderStage::Vertex, VertexShader("read_write").c_str()));
+
+    // Read-write storage textures cannot be declared in a fragment shader by default.
+    ASSERT_FALSE(
+        ShaderFailsValidation(wgpu::ShaderStage::Fragment, FragmentShader("read").c_str()));
+    ASSERT_TRUE(
+        ShaderFailsValidation(wgpu::ShaderStage::Fragment, FragmentShader("read_write").c_str()));
+
+    // Read-write storage textures cannot be declared in a compute shader by default.
+    ASSERT_FALSE(ShaderFailsValidation(wgpu::ShaderStage::Compute, ComputeShader("read").c_str()));
+    ASSERT_TRUE(
+        ShaderFailsValidation(wgpu::ShaderStage::Compute, ComputeShader("read_write").c_str()));
 }
 
 // Test that using read-only storage texture and write-only storage texture in
@@ -317,7 +337,8 @@ TEST_F(StorageTextureValidationTests, StorageTextureFormatInShaders) {
             if (utils::TextureFormatSupportsStorageTexture(format)) {
                 utils::CreateShaderModule(device, computeShader.c_str());
             } else {
-                ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, computeShader.c_str()));
+                ASSERT_TRUE(
+                    ShaderFailsValidation(wgpu::ShaderStage::Compute, computeShader.c_str()));
             }
         }
     }
@@ -340,7 +361,7 @@ TEST_F(StorageTextureValidationTests, UnsupportedWGSLStorageTextureFormat) {
     for (wgpu::StorageTextureAccess bindingType : kSupportedStorageTextureAccess) {
         for (wgpu::TextureFormat format : kUnsupportedTextureFormats) {
             std::string computeShader = CreateComputeShaderWithStorageTexture(bindingType, format);
-            ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, computeShader.c_str()));
+            ASSERT_TRUE(ShaderFailsValidation(wgpu::ShaderStage::Compute, computeShader.c_str()));
         }
     }
 }
@@ -357,7 +378,7 @@ TEST_F(StorageTextureValidationTests, UnsupportedTextureViewDimensionInShader) {
         for (wgpu::TextureViewDimension dimension : kUnsupportedTextureViewDimensions) {
             std::string computeShader =
                 CreateComputeShaderWithStorageTexture(bindingType, kFormat, dimension);
-            ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, computeShader.c_str()));
+            ASSERT_TRUE(ShaderFailsValidation(wgpu::ShaderStage::Compute, computeShader.c_str()));
         }
     }
 }
@@ -762,7 +783,7 @@ TEST_F(StorageTextureValidationTests, MultisampledStorageTexture) {
     for (wgpu::StorageTextureAccess bindingType : kSupportedStorageTextureAccess) {
         std::string computeShader =
             CreateComputeShaderWithStorageTexture(bindingType, "", "image2DMS");
-        ASSERT_DEVICE_ERROR(utils::CreateShaderModule(device, computeShader.c_str()));
+        ASSERT_TRUE(ShaderFailsValidation(wgpu::ShaderStage::Compute, computeShader.c_str()));
     }
 }
 
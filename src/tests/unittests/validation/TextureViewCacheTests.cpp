@@ -0,0 +1,106 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+namespace {
+
+    class TextureViewCacheTest : public ValidationTest {
+      protected:
+        void SetUp() override {
+            ValidationTest::SetUp();
+
+            wgpu::TextureDescriptor descriptor;
+            descriptor.size = {16, 16, 2};
+            descriptor.mipLevelCount = 2;
+            descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+            descriptor.usage = wgpu::TextureUsage::Sampled;
+            mTexture = device.CreateTexture(&descriptor);
+
+            mStatsBefore = GetStats();
+        }
+
+        dawn_native::ObjectCacheStats GetStats() {
+            FlushWire();
+            return dawn_native::GetTextureViewCacheStats(backendDevice);
+        }
+
+        uint64_t GetHits() {
+            return GetStats().hits - mStatsBefore.hits;
+        }
+
+        uint64_t GetMisses() {
+            return GetStats().misses - mStatsBefore.misses;
+        }
+
+        wgpu::Texture mTexture;
+        dawn_native::ObjectCacheStats mStatsBefore;
+    };
+
+    // Test that creating a live view again returns it, including when the descriptor only
+    // differs by explicitly spelling the defaults.
+    TEST_F(TextureViewCacheTest, LiveViewIsReused) {
+        wgpu::TextureView view = mTexture.CreateView();
+
+        wgpu::TextureViewDescriptor descriptor;
+        descriptor.dimension = wgpu::TextureViewDimension::e2DArray;
+        descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+        descriptor.mipLevelCount = 2;
+        descriptor.arrayLayerCount = 2;
+        wgpu::TextureView sameView = mTexture.CreateView(&descriptor);
+
+        EXPECT_EQ(GetMisses(), 1u);
+        EXPECT_EQ(GetHits(), 1u);
+    }
+
+    // Test that views with different descriptors aren't shared.
+    TEST_F(TextureViewCacheTest, DifferentViewsAreNotShared) {
+        wgpu::TextureView view = mTexture.CreateView();
+
+        wgpu::TextureViewDescriptor descriptor;
+        descriptor.baseMipLevel = 1;
+        wgpu::TextureView otherView = mTexture.CreateView(&descriptor);
+
+        EXPECT_EQ(GetMisses(), 2u);
+        EXPECT_EQ(GetHits(), 0u);
+    }
+
+    // Test that views with different labels aren't shared, since the label is given to the
+    // backend object.
+    TEST_F(TextureViewCacheTest, ViewsWithDifferentLabelsAreNotShared) {
+        wgpu::TextureViewDescriptor descriptor;
+        descriptor.label = "first";
+        wgpu::TextureView view = mTexture.CreateView(&descriptor);
+
+        descriptor.label = "second";
+        wgpu::TextureView otherView = mTexture.CreateView(&descriptor);
+        wgpu::TextureView unlabeledView = mTexture.CreateView();
+
+        descriptor.label = "first";
+        wgpu::TextureView sameView = mTexture.CreateView(&descriptor);
+
+        EXPECT_EQ(GetMisses(), 3u);
+        EXPECT_EQ(GetHits(), 1u);
+    }
+
+    // Test that the cache doesn't keep views alive.
+    TEST_F(TextureViewCacheTest, ReleasedViewIsNotReused) {
+        mTexture.CreateView();
+        mTexture.CreateView();
+
+        EXPECT_EQ(GetMisses(), 2u);
+        EXPECT_EQ(GetHits(), 0u);
+    }
+
+}  // anonymous namespace
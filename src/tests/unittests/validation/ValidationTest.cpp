@@ -20,6 +20,8 @@
 #include "dawn/webgpu.h"
 #include "dawn_native/NullBackend.h"
 #include "tests/ToggleParser.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/WGPUHelpers.h"
 #include "utils/WireHelper.h"
 
 #include <algorithm>
@@ -179,6 +181,57 @@ bool ValidationTest::HasToggleEnabled(const char* toggle) const {
            }) != toggles.end();
 }
 
+bool ValidationTest::ShaderFailsValidation(wgpu::ShaderStage stage, const char* source) {
+    return ModuleFailsValidation(stage,
+                                 [&]() { return utils::CreateShaderModule(device, source); });
+}
+
+bool ValidationTest::SpirvShaderFailsValidation(wgpu::ShaderStage stage, const char* spirvAsm) {
+    return ModuleFailsValidation(
+        stage, [&]() { return utils::CreateShaderModuleFromASM(device, spirvAsm); });
+}
+
+bool ValidationTest::ModuleFailsValidation(
+    wgpu::ShaderStage stage,
+    const std::function<wgpu::ShaderModule()>& createModule) {
+    FlushWire();
+    device.PushErrorScope(wgpu::ErrorFilter::Validation);
+
+    wgpu::ShaderModule module = createModule();
+    if (stage == wgpu::ShaderStage::Compute) {
+        wgpu::ComputePipelineDescriptor descriptor;
+        descriptor.computeStage.module = module;
+        descriptor.computeStage.entryPoint = "main";
+        device.CreateComputePipeline(&descriptor);
+    } else {
+        utils::ComboRenderPipelineDescriptor2 descriptor;
+        if (stage == wgpu::ShaderStage::Vertex) {
+            descriptor.vertex.module = module;
+            descriptor.cFragment.module = utils::CreateShaderModule(device, R"(
+                [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+                    return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+                })");
+        } else {
+            ASSERT(stage == wgpu::ShaderStage::Fragment);
+            descriptor.vertex.module = utils::CreateShaderModule(device, R"(
+                [[stage(vertex)]] fn main() -> [[builtin(position)]] vec4<f32> {
+                    return vec4<f32>(0.0, 0.0, 0.0, 1.0);
+                })");
+            descriptor.cFragment.module = module;
+        }
+        device.CreateRenderPipeline2(&descriptor);
+    }
+
+    bool failed = false;
+    device.PopErrorScope(
+        [](WGPUErrorType type, const char*, void* userdata) {
+            *static_cast<bool*>(userdata) = type == WGPUErrorType_Validation;
+        },
+        &failed);
+    FlushWire();
+    return failed;
+}
+
 WGPUDevice ValidationTest::CreateTestDevice() {
     // Disabled disallowing unsafe APIs so we can test them.
     dawn_native::DeviceDescriptor deviceDescriptor;
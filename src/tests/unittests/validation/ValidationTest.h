@@ -21,6 +21,8 @@
 
 #include <gtest/gtest.h>
 
+#include <functional>
+
 #define ASSERT_DEVICE_ERROR(statement)                          \
     FlushWire();                                                \
     StartExpectDeviceError();                                   \
@@ -95,6 +97,14 @@ class ValidationTest : public testing::Test {
 
     bool HasToggleEnabled(const char* toggle) const;
 
+    // Shader errors are found either when the module is parsed, or when one of its entry points is
+    // reflected for the first pipeline using it. These return whether creating the module and a
+    // pipeline using its "main" entry point for |stage| produced a validation error. Any
+    // validation error counts, so tests should also check that a valid variant of the shader
+    // doesn't fail.
+    bool ShaderFailsValidation(wgpu::ShaderStage stage, const char* source);
+    bool SpirvShaderFailsValidation(wgpu::ShaderStage stage, const char* spirvAsm);
+
   protected:
     virtual WGPUDevice CreateTestDevice();
 
@@ -108,6 +118,9 @@ class ValidationTest : public testing::Test {
   private:
     std::unique_ptr<utils::WireHelper> mWireHelper;
 
+    bool ModuleFailsValidation(wgpu::ShaderStage stage,
+                               const std::function<wgpu::ShaderModule()>& createModule);
+
     static void OnDeviceError(WGPUErrorType type, const char* message, void* userdata);
     std::string mDeviceErrorMessage;
     bool mExpectError = false;
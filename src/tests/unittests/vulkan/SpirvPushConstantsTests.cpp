@@ -0,0 +1,187 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/Constants.h"
+#include "dawn_native/vulkan/SpirvPushConstants.h"
+
+#include <spirv.hpp>
+
+#include <initializer_list>
+
+using namespace dawn_native::vulkan;
+
+namespace {
+
+    // The ids used by the modules of the tests.
+    enum : uint32_t {
+        kUint = 1,
+        kStruct,
+        kUniformStructPointer,
+        kUniformUintPointer,
+        kImmediateData,
+        kOtherUniform,
+        kZero,
+        kImmediateDataChain,
+        kOtherUniformChain,
+        kImmediateDataCopy,
+        kFirstFreeId,
+    };
+
+    class ModuleBuilder {
+      public:
+        explicit ModuleBuilder(uint32_t bound) {
+            mWords = {spv::MagicNumber, 0x00010000, 0, bound, 0};
+        }
+
+        ModuleBuilder& Add(spv::Op op, std::initializer_list<uint32_t> operands) {
+            uint32_t wordCount = static_cast<uint32_t>(operands.size()) + 1;
+            mWords.push_back((wordCount << spv::WordCountShift) | op);
+            mWords.insert(mWords.end(), operands.begin(), operands.end());
+            return *this;
+        }
+
+        ModuleBuilder& Decorations(uint32_t variable, uint32_t group, uint32_t binding) {
+            Add(spv::OpDecorate, {variable, spv::DecorationDescriptorSet, group});
+            return Add(spv::OpDecorate, {variable, spv::DecorationBinding, binding});
+        }
+
+        const std::vector<uint32_t>& Get() const {
+            return mWords;
+        }
+
+      private:
+        std::vector<uint32_t> mWords;
+    };
+
+    // A module reading the immediate data and another uniform buffer of the same type, through
+    // access chains.
+    std::vector<uint32_t> ModuleWithImmediateData(uint32_t immediateDataGroup) {
+        return ModuleBuilder(kFirstFreeId)
+            .Decorations(kImmediateData, immediateDataGroup, 0)
+            .Decorations(kOtherUniform, 0, 0)
+            .Add(spv::OpTypeInt, {kUint, 32, 0})
+            .Add(spv::OpTypeStruct, {kStruct, kUint})
+            .Add(spv::OpTypePointer, {kUniformStructPointer, spv::StorageClassUniform, kStruct})
+            .Add(spv::OpTypePointer, {kUniformUintPointer, spv::StorageClassUniform, kUint})
+            .Add(spv::OpVariable, {kUniformStructPointer, kImmediateData, spv::StorageClassUniform})
+            .Add(spv::OpVariable, {kUniformStructPointer, kOtherUniform, spv::StorageClassUniform})
+            .Add(spv::OpConstant, {kUint, kZero, 0})
+            .Add(spv::OpAccessChain,
+                 {kUniformUintPointer, kImmediateDataChain, kImmediateData, kZero})
+            .Add(spv::OpAccessChain,
+                 {kUniformUintPointer, kOtherUniformChain, kOtherUniform, kZero})
+            .Add(spv::OpCopyObject, {kUniformUintPointer, kImmediateDataCopy, kImmediateDataChain})
+            .Get();
+    }
+
+}  // anonymous namespace
+
+// Test that modules without immediate data are unchanged.
+TEST(SpirvPushConstantsTests, NoImmediateData) {
+    // The uniform buffer is in a bind group, not at kImmediateDataBindGroup.
+    std::vector<uint32_t> spirv = ModuleWithImmediateData(1);
+    std::vector<uint32_t> expected = spirv;
+
+    ConvertImmediateDataToPushConstants(&spirv);
+    EXPECT_EQ(spirv, expected);
+
+    // A uniform buffer at kImmediateDataBindGroup but another binding isn't the immediate data.
+    spirv = ModuleBuilder(kFirstFreeId)
+                .Decorations(kImmediateData, kImmediateDataBindGroup, 1)
+                .Add(spv::OpTypeInt, {kUint, 32, 0})
+                .Add(spv::OpTypeStruct, {kStruct, kUint})
+                .Add(spv::OpTypePointer, {kUniformStructPointer, spv::StorageClassUniform, kStruct})
+                .Add(spv::OpVariable,
+                     {kUniformStructPointer, kImmediateData, spv::StorageClassUniform})
+                .Get();
+    expected = spirv;
+
+    ConvertImmediateDataToPushConstants(&spirv);
+    EXPECT_EQ(spirv, expected);
+}
+
+// Test that the immediate data and the pointers derived from it are moved to the PushConstant
+// storage class with new pointer types, while the other uniform buffer is unchanged.
+TEST(SpirvPushConstantsTests, ImmediateDataBecomesPushConstants) {
+    std::vector<uint32_t> spirv = ModuleWithImmediateData(kImmediateDataBindGroup);
+    ConvertImmediateDataToPushConstants(&spirv);
+
+    constexpr uint32_t kPushConstantStructPointer = kFirstFreeId;
+    constexpr uint32_t kPushConstantUintPointer = kFirstFreeId + 1;
+    std::vector<uint32_t> expected =
+        ModuleBuilder(kFirstFreeId + 2)
+            .Decorations(kOtherUniform, 0, 0)
+            .Add(spv::OpTypeInt, {kUint, 32, 0})
+            .Add(spv::OpTypeStruct, {kStruct, kUint})
+            .Add(spv::OpTypePointer, {kUniformStructPointer, spv::StorageClassUniform, kStruct})
+            .Add(spv::OpTypePointer,
+                 {kPushConstantStructPointer, spv::StorageClassPushConstant, kStruct})
+            .Add(spv::OpTypePointer, {kUniformUintPointer, spv::StorageClassUniform, kUint})
+            .Add(spv::OpTypePointer,
+                 {kPushConstantUintPointer, spv::StorageClassPushConstant, kUint})
+            .Add(spv::OpVariable,
+                 {kPushConstantStructPointer, kImmediateData, spv::StorageClassPushConstant})
+            .Add(spv::OpVariable, {kUniformStructPointer, kOtherUniform, spv::StorageClassUniform})
+            .Add(spv::OpConstant, {kUint, kZero, 0})
+            .Add(spv::OpAccessChain,
+                 {kPushConstantUintPointer, kImmediateDataChain, kImmediateData, kZero})
+            .Add(spv::OpAccessChain,
+                 {kUniformUintPointer, kOtherUniformChain, kOtherUniform, kZero})
+            .Add(spv::OpCopyObject,
+                 {kPushConstantUintPointer, kImmediateDataCopy, kImmediateDataChain})
+            .Get();
+    EXPECT_EQ(spirv, expected);
+}
+
+// Test that the PushConstant pointer types that already exist in the module are reused.
+TEST(SpirvPushConstantsTests, ExistingPushConstantPointerTypesAreReused) {
+    constexpr uint32_t kPushConstantUintPointer = kFirstFreeId;
+    std::vector<uint32_t> spirv =
+        ModuleBuilder(kFirstFreeId + 1)
+            .Decorations(kImmediateData, kImmediateDataBindGroup, 0)
+            .Add(spv::OpTypeInt, {kUint, 32, 0})
+            .Add(spv::OpTypeStruct, {kStruct, kUint})
+            .Add(spv::OpTypePointer, {kUniformStructPointer, spv::StorageClassUniform, kStruct})
+            .Add(spv::OpTypePointer, {kUniformUintPointer, spv::StorageClassUniform, kUint})
+            .Add(spv::OpTypePointer,
+                 {kPushConstantUintPointer, spv::StorageClassPushConstant, kUint})
+            .Add(spv::OpVariable, {kUniformStructPointer, kImmediateData, spv::StorageClassUniform})
+            .Add(spv::OpConstant, {kUint, kZero, 0})
+            .Add(spv::OpAccessChain,
+                 {kUniformUintPointer, kImmediateDataChain, kImmediateData, kZero})
+            .Get();
+    ConvertImmediateDataToPushConstants(&spirv);
+
+    // Only the pointer to the struct is new.
+    constexpr uint32_t kPushConstantStructPointer = kFirstFreeId + 1;
+    std::vector<uint32_t> expected =
+        ModuleBuilder(kFirstFreeId + 2)
+            .Add(spv::OpTypeInt, {kUint, 32, 0})
+            .Add(spv::OpTypeStruct, {kStruct, kUint})
+            .Add(spv::OpTypePointer, {kUniformStructPointer, spv::StorageClassUniform, kStruct})
+            .Add(spv::OpTypePointer,
+                 {kPushConstantStructPointer, spv::StorageClassPushConstant, kStruct})
+            .Add(spv::OpTypePointer, {kUniformUintPointer, spv::StorageClassUniform, kUint})
+            .Add(spv::OpTypePointer,
+                 {kPushConstantUintPointer, spv::StorageClassPushConstant, kUint})
+            .Add(spv::OpVariable,
+                 {kPushConstantStructPointer, kImmediateData, spv::StorageClassPushConstant})
+            .Add(spv::OpConstant, {kUint, kZero, 0})
+            .Add(spv::OpAccessChain,
+                 {kPushConstantUintPointer, kImmediateDataChain, kImmediateData, kZero})
+            .Get();
+    EXPECT_EQ(spirv, expected);
+}
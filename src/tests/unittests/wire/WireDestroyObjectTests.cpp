@@ -15,6 +15,8 @@
 #include "tests/MockCallback.h"
 #include "tests/unittests/wire/WireTest.h"
 
+#include <array>
+
 using namespace testing;
 using namespace dawn_wire;
 
@@ -54,6 +56,55 @@ TEST_F(WireDestroyObjectTests, DestroyDeviceDestroysChildren) {
     FlushClient(false);
 }
 
+// Test that destroying the device destroys the children that remain after other children are
+// destroyed in any order, including the ones that reuse the ID of a destroyed child.
+TEST_F(WireDestroyObjectTests, DestroyDeviceAfterDestroyingSomeChildren) {
+    std::array<WGPUCommandEncoder, 3> encoders;
+    std::array<WGPUCommandEncoder, 3> apiEncoders;
+    for (size_t i = 0; i < encoders.size(); ++i) {
+        encoders[i] = wgpuDeviceCreateCommandEncoder(device, nullptr);
+        apiEncoders[i] = api.GetNewCommandEncoder();
+    }
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(Return(apiEncoders[0]))
+        .WillOnce(Return(apiEncoders[1]))
+        .WillOnce(Return(apiEncoders[2]));
+    FlushClient();
+
+    // Destroy the encoder in the middle of the list of children, then the most recent one.
+    wgpuCommandEncoderRelease(encoders[1]);
+    wgpuCommandEncoderRelease(encoders[2]);
+    EXPECT_CALL(api, CommandEncoderRelease(apiEncoders[1]));
+    EXPECT_CALL(api, CommandEncoderRelease(apiEncoders[2]));
+    FlushClient();
+
+    // The new encoder reuses the ID of one of the destroyed encoders.
+    wgpuDeviceCreateCommandEncoder(device, nullptr);
+    WGPUCommandEncoder apiReusedEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(Return(apiReusedEncoder));
+    FlushClient();
+
+    wgpuDeviceRelease(device);
+
+    Sequence s1, s2, s3;
+    EXPECT_CALL(api, CommandEncoderRelease(apiEncoders[0])).InSequence(s1);
+    EXPECT_CALL(api, CommandEncoderRelease(apiReusedEncoder)).InSequence(s2);
+    EXPECT_CALL(api, QueueRelease(apiQueue)).InSequence(s3);
+    EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(apiDevice, nullptr, nullptr))
+        .Times(1)
+        .InSequence(s1, s2, s3);
+    EXPECT_CALL(api, OnDeviceSetDeviceLostCallback(apiDevice, nullptr, nullptr))
+        .Times(1)
+        .InSequence(s1, s2, s3);
+    EXPECT_CALL(api, DeviceRelease(apiDevice)).InSequence(s1, s2, s3);
+
+    FlushClient();
+
+    // Signal that we already released and cleared callbacks for |apiDevice|
+    DefaultApiDeviceWasReleased();
+}
+
 // Test that calling a function that would generate an InjectError doesn't crash after
 // the device is destroyed.
 TEST_F(WireDestroyObjectTests, ImplicitInjectErrorAfterDestroyDevice) {
@@ -0,0 +1,91 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "common/vulkan_platform.h"
+#include "dawn_native/ObjectBase.h"
+#include "dawn_native/vulkan/BindGroupVk.h"
+#include "utils/WGPUHelpers.h"
+
+namespace {
+
+    class VulkanDescriptorSetRecyclingTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_SKIP_TEST_IF(UsesWire());
+
+            mLayout = utils::MakeBindGroupLayout(
+                device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform}});
+
+            wgpu::BufferDescriptor descriptor;
+            descriptor.size = 512;
+            descriptor.usage = wgpu::BufferUsage::Uniform;
+            mBuffer = device.CreateBuffer(&descriptor);
+        }
+
+        VkDescriptorSet CreateBindGroupAndGetSet(uint64_t offset) {
+            wgpu::BindGroup bindGroup =
+                utils::MakeBindGroup(device, mLayout, {{0, mBuffer, offset, 16}});
+            return reinterpret_cast<dawn_native::vulkan::BindGroup*>(bindGroup.Get())
+                ->GetHandle();
+        }
+
+        wgpu::BindGroupLayout mLayout;
+        wgpu::Buffer mBuffer;
+    };
+
+}  // anonymous namespace
+
+// Test that recreating an identical bind group reuses the descriptor set of the destroyed one.
+TEST_P(VulkanDescriptorSetRecyclingTests, IdenticalBindGroupReusesSet) {
+    VkDescriptorSet set = CreateBindGroupAndGetSet(0);
+    EXPECT_EQ(CreateBindGroupAndGetSet(0), set);
+}
+
+// Test that a bind group with a different content doesn't reuse the set.
+TEST_P(VulkanDescriptorSetRecyclingTests, DifferentBindGroupDoesNotReuseSet) {
+    VkDescriptorSet set = CreateBindGroupAndGetSet(0);
+    EXPECT_NE(CreateBindGroupAndGetSet(256), set);
+}
+
+// Test that sets referencing a destroyed buffer aren't reused.
+TEST_P(VulkanDescriptorSetRecyclingTests, DestroyedBufferDoesNotReuseSet) {
+    VkDescriptorSet set = CreateBindGroupAndGetSet(0);
+    mBuffer.Destroy();
+    EXPECT_NE(CreateBindGroupAndGetSet(0), set);
+}
+
+// Test that a buffer released by the application is released by the recycled sets that reference
+// it on the next Tick, even when several of them reference it.
+TEST_P(VulkanDescriptorSetRecyclingTests, ReleasedBufferIsReleasedByRecycledSets) {
+    CreateBindGroupAndGetSet(0);
+    CreateBindGroupAndGetSet(256);
+
+    // Keep a reference to the buffer to observe the references held by the recycled sets.
+    dawn_native::ObjectBase* buffer = reinterpret_cast<dawn_native::ObjectBase*>(mBuffer.Get());
+    buffer->Reference();
+    mBuffer = nullptr;
+    EXPECT_EQ(buffer->GetRefCountForTesting(), 2u);
+
+    // Submit some work so that the device ticks.
+    wgpu::CommandBuffer commands = device.CreateCommandEncoder().Finish();
+    queue.Submit(1, &commands);
+    WaitForAllOperations();
+    EXPECT_EQ(buffer->GetRefCountForTesting(), 1u);
+    buffer->Release();
+}
+
+DAWN_INSTANTIATE_TEST(VulkanDescriptorSetRecyclingTests, VulkanBackend());
@@ -0,0 +1,110 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "common/vulkan_platform.h"
+#include "dawn_native/vulkan/AdapterVk.h"
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/FencedDeleter.h"
+
+namespace {
+
+    constexpr uint32_t kSemaphoreCount = 100;
+
+    class VulkanFencedDeleterTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_SKIP_TEST_IF(UsesWire());
+        }
+
+        // Create a device with the options, on the same adapter as the test's device.
+        wgpu::Device CreateDevice(const dawn_native::DeferredDeletionOptions& options) {
+            dawn_native::vulkan::Device* deviceVk =
+                reinterpret_cast<dawn_native::vulkan::Device*>(device.Get());
+            dawn_native::vulkan::Adapter* adapter =
+                reinterpret_cast<dawn_native::vulkan::Adapter*>(deviceVk->GetAdapter());
+
+            dawn_native::DeviceDescriptor descriptor;
+            descriptor.deferredDeletionOptions = options;
+            return wgpu::Device::Acquire(
+                reinterpret_cast<WGPUDevice>(adapter->CreateDevice(&descriptor)));
+        }
+
+        // Delete semaphores through the FencedDeleter and mark them as no longer used by the GPU.
+        void DeleteSemaphores(dawn_native::vulkan::Device* deviceVk) {
+            VkSemaphoreCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+
+            for (uint32_t i = 0; i < kSemaphoreCount; ++i) {
+                VkSemaphore semaphore = VK_NULL_HANDLE;
+                ASSERT_EQ(VK_SUCCESS, deviceVk->fn.CreateSemaphore(deviceVk->GetVkDevice(),
+                                                                   &createInfo, nullptr,
+                                                                   &*semaphore));
+                deviceVk->GetFencedDeleter()->DeleteWhenUnused(semaphore);
+            }
+
+            deviceVk->GetFencedDeleter()->Tick(deviceVk->GetPendingCommandSerial());
+        }
+    };
+
+}  // anonymous namespace
+
+// Test that a Tick with a time budget destroys only part of the objects, and that the rest is
+// destroyed later.
+TEST_P(VulkanFencedDeleterTests, TickTimeBudget) {
+    dawn_native::DeferredDeletionOptions options;
+    options.maxTickDurationNs = 1;
+    wgpu::Device budgetDevice = CreateDevice(options);
+    dawn_native::vulkan::Device* deviceVk =
+        reinterpret_cast<dawn_native::vulkan::Device*>(budgetDevice.Get());
+    dawn_native::vulkan::FencedDeleter* deleter = deviceVk->GetFencedDeleter();
+
+    DeleteSemaphores(deviceVk);
+    size_t remaining = deleter->GetReadyDeletionCountForTesting();
+    EXPECT_GT(remaining, 0u);
+    EXPECT_LT(remaining, kSemaphoreCount);
+
+    // Later ticks continue destroying the objects.
+    deleter->Tick(deviceVk->GetPendingCommandSerial());
+    EXPECT_LT(deleter->GetReadyDeletionCountForTesting(), remaining);
+
+    deleter->DeleteAllReady();
+    EXPECT_EQ(deleter->GetReadyDeletionCountForTesting(), 0u);
+}
+
+// Test that the objects are destroyed by the background thread.
+TEST_P(VulkanFencedDeleterTests, DestroyOnBackgroundThread) {
+    dawn_native::DeferredDeletionOptions options;
+    options.destroyOnBackgroundThread = true;
+    wgpu::Device threadDevice = CreateDevice(options);
+    dawn_native::vulkan::Device* deviceVk =
+        reinterpret_cast<dawn_native::vulkan::Device*>(threadDevice.Get());
+
+    DeleteSemaphores(deviceVk);
+    deviceVk->GetFencedDeleter()->DeleteAllReady();
+    EXPECT_EQ(deviceVk->GetFencedDeleter()->GetReadyDeletionCountForTesting(), 0u);
+
+    // The device is still usable after the objects are destroyed on the other thread.
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::CopyDst;
+    threadDevice.CreateBuffer(&descriptor);
+    DeleteSemaphores(deviceVk);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanFencedDeleterTests, VulkanBackend());
@@ -0,0 +1,82 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "dawn_native/VulkanBackend.h"
+#include "utils/WGPUHelpers.h"
+
+namespace {
+
+    class VulkanFramebufferCacheTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_SKIP_TEST_IF(UsesWire());
+        }
+
+        wgpu::Texture CreateRenderTarget() {
+            wgpu::TextureDescriptor descriptor;
+            descriptor.size = {4, 4, 1};
+            descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+            descriptor.usage = wgpu::TextureUsage::RenderAttachment;
+            return device.CreateTexture(&descriptor);
+        }
+
+        void ClearRenderTarget(const wgpu::TextureView& view) {
+            wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+            utils::ComboRenderPassDescriptor renderPass({view});
+            encoder.BeginRenderPass(&renderPass).EndPass();
+            wgpu::CommandBuffer commands = encoder.Finish();
+            queue.Submit(1, &commands);
+        }
+
+        dawn_native::ObjectCacheStats GetStats() {
+            return dawn_native::vulkan::GetFramebufferCacheStats(device.Get());
+        }
+    };
+
+}  // anonymous namespace
+
+// Test that render passes to the same view reuse the same framebuffer.
+TEST_P(VulkanFramebufferCacheTests, SameAttachmentsReuseFramebuffer) {
+    dawn_native::ObjectCacheStats before = GetStats();
+
+    wgpu::TextureView view = CreateRenderTarget().CreateView();
+    ClearRenderTarget(view);
+    ClearRenderTarget(view);
+
+    dawn_native::ObjectCacheStats stats = GetStats();
+    EXPECT_EQ(stats.misses, before.misses + 1);
+    EXPECT_EQ(stats.hits, before.hits + 1);
+}
+
+// Test that destroying the texture of an attachment removes its framebuffers, and that render
+// passes to another texture, whose view could reuse the same address, create a new one.
+TEST_P(VulkanFramebufferCacheTests, DestroyedTextureInvalidatesFramebuffer) {
+    dawn_native::ObjectCacheStats before = GetStats();
+
+    wgpu::Texture texture = CreateRenderTarget();
+    wgpu::TextureView view = texture.CreateView();
+    ClearRenderTarget(view);
+    texture.Destroy();
+
+    ClearRenderTarget(CreateRenderTarget().CreateView());
+
+    dawn_native::ObjectCacheStats stats = GetStats();
+    EXPECT_EQ(stats.misses, before.misses + 2);
+    EXPECT_EQ(stats.hits, before.hits);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanFramebufferCacheTests, VulkanBackend());
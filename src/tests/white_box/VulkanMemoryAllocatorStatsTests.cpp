@@ -0,0 +1,221 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "dawn_native/VulkanBackend.h"
+#include "utils/WGPUHelpers.h"
+
+namespace {
+
+    class VulkanMemoryAllocatorStatsTests : public DawnTest {
+      protected:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_SKIP_TEST_IF(UsesWire());
+        }
+
+        wgpu::Buffer CreateBuffer(uint64_t size) {
+            wgpu::BufferDescriptor descriptor;
+            descriptor.size = size;
+            descriptor.usage = wgpu::BufferUsage::Storage;
+            return device.CreateBuffer(&descriptor);
+        }
+
+        dawn_native::vulkan::MemoryAllocatorStats GetStats() {
+            return dawn_native::vulkan::GetMemoryAllocatorStats(device.Get());
+        }
+    };
+
+}  // anonymous namespace
+
+// Test that small resources are sub-allocated in heaps while large ones get their own memory.
+TEST_P(VulkanMemoryAllocatorStatsTests, DirectAndSubAllocations) {
+    dawn_native::vulkan::MemoryAllocatorStats before = GetStats();
+
+    wgpu::Buffer smallBuffer = CreateBuffer(4096);
+    wgpu::Buffer largeBuffer = CreateBuffer(64 * 1024 * 1024);
+
+    dawn_native::vulkan::MemoryAllocatorStats stats = GetStats();
+    EXPECT_GE(stats.heapCount, 1u);
+    EXPECT_EQ(stats.largeHeapCount, 0u);
+    EXPECT_EQ(stats.directAllocationCount, before.directAllocationCount + 1);
+    EXPECT_GE(stats.directAllocationBytes, before.directAllocationBytes + 64 * 1024 * 1024);
+
+    largeBuffer.Destroy();
+    stats = GetStats();
+    EXPECT_EQ(stats.directAllocationCount, before.directAllocationCount);
+    EXPECT_EQ(stats.directAllocationBytes, before.directAllocationBytes);
+}
+
+// Test that the memory allocated for resources is accounted in the usage of its memory heap.
+TEST_P(VulkanMemoryAllocatorStatsTests, HeapBudgets) {
+    constexpr uint64_t kSize = 64 * 1024 * 1024;
+
+    auto GetAllocatorUsage = [&]() {
+        uint64_t allocatorUsage = 0;
+        for (const dawn_native::vulkan::MemoryHeapBudget& heap :
+             dawn_native::vulkan::GetMemoryHeapBudgets(device.Get())) {
+            EXPECT_GT(heap.budget, 0u);
+            EXPECT_GE(heap.usage, heap.allocatorUsage);
+            allocatorUsage += heap.allocatorUsage;
+        }
+        return allocatorUsage;
+    };
+
+    uint64_t usageBefore = GetAllocatorUsage();
+
+    wgpu::Buffer buffer = CreateBuffer(kSize);
+    EXPECT_GE(GetAllocatorUsage(), usageBefore + kSize);
+
+    buffer.Destroy();
+    EXPECT_EQ(GetAllocatorUsage(), usageBefore);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanMemoryAllocatorStatsTests, VulkanBackend());
+
+namespace {
+
+    constexpr uint64_t kLargeBufferSize = 16 * 1024 * 1024;
+
+    class VulkanMemoryTypeAllocatorOptionsTests : public VulkanMemoryAllocatorStatsTests {
+      protected:
+        void SetUpDeviceDescriptor(dawn_native::DeviceDescriptor* descriptor) override {
+            // Only enable the sub-allocation of large resources through the per-type options.
+            for (uint32_t i = 0; i < VK_MAX_MEMORY_TYPES; ++i) {
+                dawn_native::MemoryTypeAllocatorOptions typeOptions;
+                typeOptions.memoryTypeIndex = i;
+                typeOptions.maxSizeForLargeSubAllocation = 2 * kLargeBufferSize;
+                descriptor->memoryAllocatorOptions.perMemoryType.push_back(typeOptions);
+            }
+        }
+    };
+
+}  // anonymous namespace
+
+// Test that the options of a memory type override the options of all memory types.
+TEST_P(VulkanMemoryTypeAllocatorOptionsTests, OverridesApply) {
+    dawn_native::vulkan::MemoryAllocatorStats before = GetStats();
+
+    wgpu::Buffer buffer = CreateBuffer(kLargeBufferSize);
+
+    dawn_native::vulkan::MemoryAllocatorStats stats = GetStats();
+    EXPECT_EQ(stats.largeHeapCount, before.largeHeapCount + 1);
+    EXPECT_EQ(stats.largeHeapBytes, before.largeHeapBytes + 4 * kLargeBufferSize);
+    EXPECT_EQ(stats.directAllocationCount, before.directAllocationCount);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanMemoryTypeAllocatorOptionsTests, VulkanBackend());
+
+namespace {
+
+    constexpr uint64_t kRelocatedBufferSize = 8 * 1024 * 1024;
+
+    class VulkanBufferDefragmentationTests : public VulkanMemoryAllocatorStatsTests {
+      protected:
+        void SetUpDeviceDescriptor(dawn_native::DeviceDescriptor* descriptor) override {
+            // Heaps of four buffers, with some room for the alignment of the allocations.
+            descriptor->memoryAllocatorOptions.maxSizeForLargeSubAllocation =
+                2 * kRelocatedBufferSize;
+            descriptor->memoryAllocatorOptions.largeHeapSize =
+                4 * kRelocatedBufferSize + kRelocatedBufferSize / 2;
+        }
+
+        wgpu::Buffer CreateRelocatableBuffer() {
+            wgpu::BufferDescriptor descriptor;
+            descriptor.size = kRelocatedBufferSize;
+            descriptor.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc |
+                               wgpu::BufferUsage::CopyDst;
+            return device.CreateBuffer(&descriptor);
+        }
+
+        // Submits work and waits for it, long enough for the device to be idle for a while.
+        void TickWhileIdle() {
+            for (uint32_t i = 0; i < 100; ++i) {
+                queue.Submit(0, nullptr);
+                WaitForAllOperations();
+            }
+        }
+    };
+
+}  // anonymous namespace
+
+// Test that the buffers of a sparse heap are moved to another heap when the device is idle, with
+// their contents and the bind groups using them.
+TEST_P(VulkanBufferDefragmentationTests, EvacuateSparseHeap) {
+    dawn_native::vulkan::MemoryAllocatorStats before = GetStats();
+
+    // Fill two heaps.
+    std::vector<wgpu::Buffer> buffers;
+    for (uint32_t i = 0; i < 8; ++i) {
+        buffers.push_back(CreateRelocatableBuffer());
+    }
+    EXPECT_EQ(GetStats().largeHeapCount, before.largeHeapCount + 2);
+
+    const std::vector<uint32_t> expected = {1, 2, 3, 4};
+    queue.WriteBuffer(buffers[3], 0, expected.data(), expected.size() * sizeof(uint32_t));
+
+    wgpu::ComputePipelineDescriptor pipelineDescriptor;
+    pipelineDescriptor.computeStage.module = utils::CreateShaderModule(device, R"(
+        [[block]] struct Data {
+            values : array<u32, 4>;
+        };
+        [[group(0), binding(0)]] var<storage> src : [[access(read)]] Data;
+        [[group(0), binding(1)]] var<storage> dst : [[access(read_write)]] Data;
+
+        [[stage(compute)]] fn main() {
+            dst.values[0] = src.values[0];
+            dst.values[1] = src.values[1];
+            dst.values[2] = src.values[2];
+            dst.values[3] = src.values[3];
+        })");
+    pipelineDescriptor.computeStage.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDescriptor);
+
+    wgpu::BufferDescriptor resultDescriptor;
+    resultDescriptor.size = expected.size() * sizeof(uint32_t);
+    resultDescriptor.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc;
+    wgpu::Buffer result = device.CreateBuffer(&resultDescriptor);
+
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(
+        device, pipeline.GetBindGroupLayout(0), {{0, buffers[3], 0, 16}, {1, result}});
+
+    // Leave a single buffer in the first heap, and room for it in the second one.
+    buffers[0].Destroy();
+    buffers[1].Destroy();
+    buffers[2].Destroy();
+    buffers[4].Destroy();
+
+    TickWhileIdle();
+
+    dawn_native::vulkan::MemoryAllocatorStats stats = GetStats();
+    EXPECT_EQ(stats.largeHeapCount, before.largeHeapCount + 1);
+    EXPECT_EQ(stats.relocationCount, before.relocationCount + 1);
+    EXPECT_GE(stats.relocatedBytes, before.relocatedBytes + kRelocatedBufferSize);
+    EXPECT_BUFFER_U32_RANGE_EQ(expected.data(), buffers[3], 0, expected.size());
+
+    // The descriptor set of the bind group uses the new VkBuffer.
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bindGroup);
+    pass.Dispatch(1);
+    pass.EndPass();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+    EXPECT_BUFFER_U32_RANGE_EQ(expected.data(), result, 0, expected.size());
+}
+
+DAWN_INSTANTIATE_TEST(VulkanBufferDefragmentationTests,
+                      VulkanBackend({"defragment_buffer_memory_when_idle"}));
@@ -65,7 +65,7 @@ namespace utils {
             }
 #endif  // defined(DAWN_ENABLE_BACKEND_OPENGL)
         } else {
-            instance->DiscoverDefaultAdapters();
+            instance->DiscoverDefaultAdapters(static_cast<WGPUBackendType>(type));
         }
     }
 